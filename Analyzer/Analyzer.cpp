@@ -34,6 +34,7 @@
 #include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 
 namespace Analyzer {
@@ -157,7 +158,7 @@ std::shared_ptr<Analyzer::Expr> AggExpr::deep_copy() const {
                            aggtype,
                            arg == nullptr ? nullptr : arg->deep_copy(),
                            is_distinct,
-                           error_rate);
+                           arg1);
 }
 
 std::shared_ptr<Analyzer::Expr> CaseExpr::deep_copy() const {
@@ -197,7 +198,7 @@ std::shared_ptr<Analyzer::Expr> OffsetInFragment::deep_copy() const {
 
 std::shared_ptr<Analyzer::Expr> WindowFunction::deep_copy() const {
   return makeExpr<WindowFunction>(
-      type_info, kind_, args_, partition_keys_, order_keys_, collation_);
+      type_info, kind_, args_, partition_keys_, order_keys_, collation_, frame_);
 }
 
 ExpressionPtr ArrayExpr::deep_copy() const {
@@ -1792,7 +1793,7 @@ std::shared_ptr<Analyzer::Expr> AggExpr::rewrite_with_child_targetlist(
                            aggtype,
                            arg ? arg->rewrite_with_child_targetlist(tlist) : nullptr,
                            is_distinct,
-                           error_rate);
+                           arg1);
 }
 
 std::shared_ptr<Analyzer::Expr> AggExpr::rewrite_agg_to_var(
@@ -2167,6 +2168,11 @@ bool AggExpr::operator==(const Expr& rhs) const {
   if (aggtype != rhs_ae.get_aggtype() || is_distinct != rhs_ae.get_is_distinct()) {
     return false;
   }
+  // APPROX_PERCENTILE of the same column at different percentiles
+  if ((arg1 == nullptr) != (rhs_ae.get_arg1() == nullptr) ||
+      (arg1 && !(*arg1 == *rhs_ae.get_arg1()))) {
+    return false;
+  }
   if (arg.get() == rhs_ae.get_arg()) {
     return true;
   }
@@ -2244,7 +2250,8 @@ bool WindowFunction::operator==(const Expr& rhs) const {
   }
   if (kind_ != rhs_window->kind_ || args_.size() != rhs_window->args_.size() ||
       partition_keys_.size() != rhs_window->partition_keys_.size() ||
-      order_keys_.size() != rhs_window->order_keys_.size()) {
+      order_keys_.size() != rhs_window->order_keys_.size() ||
+      frame_ != rhs_window->frame_) {
     return false;
   }
   return expr_list_match(args_, rhs_window->args_) &&
@@ -2538,6 +2545,9 @@ std::string AggExpr::toString() const {
     case kSAMPLE:
       agg = "SAMPLE";
       break;
+    case kAPPROX_PERCENTILE:
+      agg = "APPROX_PERCENTILE";
+      break;
   }
   std::string str{"(" + agg};
   if (is_distinct) {
@@ -2548,6 +2558,9 @@ std::string AggExpr::toString() const {
   } else {
     str += "*";
   }
+  if (arg1) {
+    str += arg1->toString();
+  }
   return str + ") ";
 }
 
@@ -2590,11 +2603,31 @@ std::string OffsetInFragment::toString() const {
   return "(OffsetInFragment) ";
 }
 
+std::string WindowFrame::toString() const {
+  const auto bound_to_string = [](const int64_t bound) -> std::string {
+    if (bound == std::numeric_limits<int64_t>::min()) {
+      return "UNBOUNDED PRECEDING";
+    }
+    if (bound == std::numeric_limits<int64_t>::max()) {
+      return "UNBOUNDED FOLLOWING";
+    }
+    if (bound == 0) {
+      return "CURRENT ROW";
+    }
+    return bound < 0 ? std::to_string(-bound) + " PRECEDING"
+                     : std::to_string(bound) + " FOLLOWING";
+  };
+  return "ROWS BETWEEN " + bound_to_string(lower) + " AND " + bound_to_string(upper);
+}
+
 std::string WindowFunction::toString() const {
   std::string result = "WindowFunction(" + sql_window_function_to_str(kind_);
   for (const auto& arg : args_) {
     result += " " + arg->toString();
   }
+  if (frame_) {
+    result += " " + frame_->toString();
+  }
   return result + ") ";
 }
 
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <iostream>
 #include <list>
+#include <optional>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -1029,7 +1030,7 @@ class AggExpr : public Expr {
           std::shared_ptr<Analyzer::Expr> g,
           bool d,
           std::shared_ptr<Analyzer::Constant> e)
-      : Expr(ti, true), aggtype(a), arg(g), is_distinct(d), error_rate(e) {}
+      : Expr(ti, true), aggtype(a), arg(g), is_distinct(d), arg1(e) {}
   AggExpr(SQLTypes t,
           SQLAgg a,
           Expr* g,
@@ -1040,12 +1041,12 @@ class AggExpr : public Expr {
       , aggtype(a)
       , arg(g)
       , is_distinct(d)
-      , error_rate(e) {}
+      , arg1(e) {}
   SQLAgg get_aggtype() const { return aggtype; }
   Expr* get_arg() const { return arg.get(); }
   std::shared_ptr<Analyzer::Expr> get_own_arg() const { return arg; }
   bool get_is_distinct() const { return is_distinct; }
-  std::shared_ptr<Analyzer::Constant> get_error_rate() const { return error_rate; }
+  std::shared_ptr<Analyzer::Constant> get_arg1() const { return arg1; }
   std::shared_ptr<Analyzer::Expr> deep_copy() const override;
   void group_predicates(std::list<const Expr*>& scan_predicates,
                         std::list<const Expr*>& join_predicates,
@@ -1078,7 +1079,8 @@ class AggExpr : public Expr {
   SQLAgg aggtype;                       // aggregate type: kAVG, kMIN, kMAX, kSUM, kCOUNT
   std::shared_ptr<Analyzer::Expr> arg;  // argument to aggregate
   bool is_distinct;                     // true only if it is for COUNT(DISTINCT x)
-  std::shared_ptr<Analyzer::Constant> error_rate;  // error rate of kAPPROX_COUNT_DISTINCT
+  // error rate of kAPPROX_COUNT_DISTINCT, percentile of kAPPROX_PERCENTILE
+  std::shared_ptr<Analyzer::Constant> arg1;
 };
 
 /*
@@ -1369,6 +1371,22 @@ struct OrderEntry {
   bool nulls_first; /* true if nulls are ordered first.  otherwise last. */
 };
 
+/*
+ * @type WindowFrame
+ * @brief Explicit ROWS frame of an aggregate window function. The bounds are row
+ * offsets relative to the current row, negative for PRECEDING. Unbounded ends are the
+ * int64_t limits.
+ */
+struct WindowFrame {
+  int64_t lower;
+  int64_t upper;
+
+  bool operator==(const WindowFrame& rhs) const {
+    return lower == rhs.lower && upper == rhs.upper;
+  }
+  std::string toString() const;
+};
+
 /*
  * @type WindowFunction
  * @brief A window function.
@@ -1380,13 +1398,15 @@ class WindowFunction : public Expr {
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& args,
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& partition_keys,
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& order_keys,
-                 const std::vector<OrderEntry>& collation)
+                 const std::vector<OrderEntry>& collation,
+                 const std::optional<WindowFrame>& frame = std::nullopt)
       : Expr(ti)
       , kind_(kind)
       , args_(args)
       , partition_keys_(partition_keys)
       , order_keys_(order_keys)
-      , collation_(collation){};
+      , collation_(collation)
+      , frame_(frame){};
 
   std::shared_ptr<Analyzer::Expr> deep_copy() const override;
 
@@ -1407,12 +1427,15 @@ class WindowFunction : public Expr {
 
   const std::vector<OrderEntry>& getCollation() const { return collation_; }
 
+  const std::optional<WindowFrame>& getFrame() const { return frame_; }
+
  private:
   const SqlWindowFunctionKind kind_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> args_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> partition_keys_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> order_keys_;
   const std::vector<OrderEntry> collation_;
+  const std::optional<WindowFrame> frame_;
 };
 
 /*
@@ -0,0 +1,7 @@
+select
+  count(*)
+from
+  ##TAB##
+where
+  arrdelay > 15
+  and depdelay > 15
@@ -0,0 +1,9 @@
+select
+  sum(distance),
+  avg(airtime)
+from
+  ##TAB##
+where
+  distance > 500
+  and cancelled = 0
+  and diverted = 0
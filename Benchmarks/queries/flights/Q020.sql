@@ -0,0 +1,9 @@
+select
+  count(*),
+  avg(arrdelay)
+from
+  ##TAB##
+where
+  dep_timestamp >= TIMESTAMP(0) '1996-07-28 00:00:00'
+  and dep_timestamp < TIMESTAMP(0) '1997-05-18 00:00:00'
+  and taxiout < 20
@@ -26,6 +26,7 @@
 #include "Shared/ConfigResolve.h"
 #include "Shared/Logger.h"
 #include "Shared/MapDParameters.h"
+#include "Shared/StringTransform.h"
 #include "Shared/ThriftClient.h"
 #include "Shared/fixautotools.h"
 #include "Shared/mapd_shared_ptr.h"
@@ -36,6 +37,7 @@
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/transport/TSocket.h>
 #include <thrift/transport/TTransportUtils.h>
+#include <cctype>
 #include <type_traits>
 
 #include "gen-cpp/CalciteServer.h"
@@ -321,7 +323,8 @@ Calcite::Calcite(const MapDParameters& mapd_parameter,
     , ssl_keystore_(mapd_parameter.ssl_keystore)
     , ssl_keystore_password_(mapd_parameter.ssl_keystore_password)
     , ssl_ca_file_(mapd_parameter.ssl_trust_ca_file)
-    , mapd_config_file_(mapd_parameter.config_file) {
+    , mapd_config_file_(mapd_parameter.config_file)
+    , plan_cache_size_(mapd_parameter.calcite_plan_cache_size) {
   init(mapd_parameter.omnisci_server_port,
        mapd_parameter.calcite_port,
        data_dir,
@@ -330,6 +333,7 @@ Calcite::Calcite(const MapDParameters& mapd_parameter,
 }
 
 void Calcite::updateMetadata(std::string catalog, std::string table) {
+  clearPlanCache();
   if (server_available_) {
     auto ms = measure<>::execution([&]() {
       auto clientP = getClient(remote_calcite_port_);
@@ -378,6 +382,52 @@ void checkPermissionForTables(const Catalog_Namespace::SessionInfo& session_info
   }
 }
 
+namespace {
+
+// The SQL text with the runs of whitespace outside of quotes collapsed, empty if the
+// query can't share its plan with other queries.
+std::string normalize_sql_text(const std::string& sql) {
+  std::string normalized;
+  normalized.reserve(sql.size());
+  char quote{0};
+  bool pending_space{false};
+  for (size_t i = 0; i < sql.size(); ++i) {
+    const char c = sql[i];
+    if (quote) {
+      normalized += c;
+      if (c == quote) {
+        quote = 0;
+      }
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      pending_space = !normalized.empty();
+      continue;
+    }
+    if ((c == '-' || c == '/') && i + 1 < sql.size() &&
+        sql[i + 1] == (c == '-' ? '-' : '*')) {
+      // a comment can end at a line break, which doesn't survive the normalization
+      return "";
+    }
+    if (pending_space) {
+      normalized += ' ';
+      pending_space = false;
+    }
+    if (c == '\'' || c == '"' || c == '`') {
+      quote = c;
+    }
+    normalized += c;
+  }
+  const auto upper = to_upper(normalized);
+  if (upper.find("NOW") != std::string::npos ||
+      upper.find("CURRENT_") != std::string::npos) {
+    return "";
+  }
+  return normalized;
+}
+
+}  // namespace
+
 TPlanResult Calcite::process(
     query_state::QueryStateProxy query_state_proxy,
     std::string sql_string,
@@ -386,14 +436,39 @@ TPlanResult Calcite::process(
     const bool is_explain,
     const bool is_view_optimize,
     const std::string& calcite_session_id) {
-  TPlanResult result = processImpl(query_state_proxy,
-                                   std::move(sql_string),
-                                   filter_push_down_info,
-                                   legacy_syntax,
-                                   is_explain,
-                                   is_view_optimize,
-                                   calcite_session_id);
+  std::string plan_cache_key;
+  if (plan_cache_size_ && filter_push_down_info.empty()) {
+    const auto normalized_sql = normalize_sql_text(sql_string);
+    if (!normalized_sql.empty()) {
+      const auto session_ptr = query_state_proxy.getQueryState().getConstSessionInfo();
+      plan_cache_key = session_ptr->get_currentUser().userName + "\n" +
+                       session_ptr->getCatalog().getCurrentDB().dbName + "\n" +
+                       std::to_string(legacy_syntax) + std::to_string(is_explain) +
+                       std::to_string(is_view_optimize) + "\n" + normalized_sql;
+    }
+  }
+  const auto cached_plan =
+      plan_cache_key.empty() ? nullptr : getCachedPlan(plan_cache_key);
+  TPlanResult result;
+  if (cached_plan) {
+    result = *cached_plan;
+    result.execution_time_ms = 0;
+  } else {
+    // a DDL statement running meanwhile clears the cache, our plan may predate it
+    const size_t plan_cache_generation = plan_cache_generation_;
+    result = processImpl(query_state_proxy,
+                         std::move(sql_string),
+                         filter_push_down_info,
+                         legacy_syntax,
+                         is_explain,
+                         is_view_optimize,
+                         calcite_session_id);
+    if (!plan_cache_key.empty() && !result.plan_result.empty()) {
+      putCachedPlan(plan_cache_key, result, plan_cache_generation);
+    }
+  }
 
+  // the privileges are checked on every run, cached plan or not
   AccessPrivileges NOOP;
 
   if (!is_explain) {
@@ -455,6 +530,46 @@ std::vector<std::string> Calcite::get_db_objects(const std::string ra) {
   return v_db_obj;
 }
 
+std::shared_ptr<const TPlanResult> Calcite::getCachedPlan(const std::string& key) {
+  std::lock_guard<std::mutex> plan_cache_lock(plan_cache_mutex_);
+  const auto it = plan_cache_index_.find(key);
+  if (it == plan_cache_index_.end()) {
+    return nullptr;
+  }
+  plan_cache_.splice(plan_cache_.begin(), plan_cache_, it->second);
+  ++plan_cache_hit_count_;
+  return it->second->second;
+}
+
+void Calcite::putCachedPlan(const std::string& key,
+                            const TPlanResult& plan,
+                            const size_t generation) {
+  std::lock_guard<std::mutex> plan_cache_lock(plan_cache_mutex_);
+  if (generation != plan_cache_generation_ || !plan_cache_size_ ||
+      plan_cache_index_.count(key)) {
+    return;
+  }
+  while (plan_cache_.size() >= plan_cache_size_) {
+    plan_cache_index_.erase(plan_cache_.back().first);
+    plan_cache_.pop_back();
+  }
+  plan_cache_.emplace_front(key, std::make_shared<const TPlanResult>(plan));
+  plan_cache_index_.emplace(key, plan_cache_.begin());
+}
+
+void Calcite::clearPlanCache() {
+  std::lock_guard<std::mutex> plan_cache_lock(plan_cache_mutex_);
+  ++plan_cache_generation_;
+  plan_cache_index_.clear();
+  plan_cache_.clear();
+}
+
+void Calcite::setPlanCacheSize(const size_t plan_cache_size) {
+  plan_cache_size_ = plan_cache_size;
+  // the plans in flight see the new generation and aren't stored past the new size
+  clearPlanCache();
+}
+
 TPlanResult Calcite::processImpl(
     query_state::QueryStateProxy query_state_proxy,
     const std::string sql_string,
@@ -598,6 +713,7 @@ std::string Calcite::getRuntimeExtensionFunctionWhitelist() {
 void Calcite::setRuntimeExtensionFunctions(
     const std::vector<TUserDefinedFunction>& udfs,
     const std::vector<TUserDefinedTableFunction>& udtfs) {
+  clearPlanCache();
   if (server_available_) {
     auto clientP = getClient(remote_calcite_port_);
     clientP.first->setRuntimeExtensionFunctions(udfs, udtfs);
@@ -29,8 +29,12 @@
 
 #include <thrift/transport/TTransport.h>
 
+#include <atomic>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace apache::thrift::transport;
@@ -85,6 +89,10 @@ class Calcite final {
   std::string getExtensionFunctionWhitelist();
   std::string getUserDefinedFunctionWhitelist();
   void updateMetadata(std::string catalog, std::string table);
+  void clearPlanCache();
+  // 0 disables the plan cache
+  void setPlanCacheSize(const size_t plan_cache_size);
+  size_t getPlanCacheHitCount() const { return plan_cache_hit_count_; }
   void close_calcite_server(bool log = true);
   ~Calcite();
   std::string getRuntimeExtensionFunctionWhitelist();
@@ -112,6 +120,12 @@ class Calcite final {
                           const bool is_view_optimize,
                           const std::string& calcite_session_id);
   std::vector<std::string> get_db_objects(const std::string ra);
+  std::shared_ptr<const TPlanResult> getCachedPlan(const std::string& key);
+  // Doesn't store the plan if the cache was cleared since plan_cache_generation_ was
+  // generation, the plan could have been made for the catalog before the change.
+  void putCachedPlan(const std::string& key,
+                     const TPlanResult& plan,
+                     const size_t generation);
   void inner_close_calcite_server(bool log);
   std::pair<mapd::shared_ptr<CalciteServerClient>, mapd::shared_ptr<TTransport>>
   getClient(int port);
@@ -129,6 +143,17 @@ class Calcite final {
   std::string ssl_ca_file_;
   std::string mapd_config_file_;
   std::once_flag shutdown_once_flag_;
+
+  // Plans keyed by user, database, options and the SQL text up to whitespace. Cleared
+  // whenever the catalog or the runtime UDFs change.
+  using PlanCacheList =
+      std::list<std::pair<std::string, std::shared_ptr<const TPlanResult>>>;
+  std::atomic<size_t> plan_cache_size_{0};
+  PlanCacheList plan_cache_;  // most recently used first
+  std::unordered_map<std::string, PlanCacheList::iterator> plan_cache_index_;
+  std::atomic<size_t> plan_cache_generation_{0};  // bumped by clearPlanCache()
+  std::atomic<size_t> plan_cache_hit_count_{0};
+  std::mutex plan_cache_mutex_;
 };
 
 #endif /* CALCITE_H */
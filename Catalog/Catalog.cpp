@@ -58,6 +58,7 @@
 #include "../LockMgr/TableLockMgr.h"
 #include "../Parser/ParserNode.h"
 #include "../QueryEngine/Execute.h"
+#include "../QueryEngine/ExternalCacheInvalidators.h"
 #include "../QueryEngine/TableOptimizer.h"
 #include "../Shared/File.h"
 #include "../Shared/StringTransform.h"
@@ -2593,6 +2594,9 @@ void Catalog::doTruncateTable(const TableDescriptor* td) {
   dataMgr_->deleteChunksWithPrefix(chunkKeyPrefix, MemoryLevel::GPU_LEVEL);
 
   dataMgr_->removeTableRelatedDS(currentDB_.dbId, tableId);
+  // the epoch starts over, the join hash tables cached for the old rows must not be
+  // extended with the new ones
+  JoinHashTableCacheInvalidator::invalidateCaches();
 
   std::unique_ptr<StringDictionaryClient> client;
   if (SysCatalog::instance().isAggregator()) {
@@ -3113,6 +3117,8 @@ void Catalog::eraseTablePhysicalData(const TableDescriptor* td) {
   if (!td->isView) {
     INJECT_TIMER(Remove_Table);
     dataMgr_->removeTableRelatedDS(currentDB_.dbId, tableId);
+    // a table created later can get the same id
+    JoinHashTableCacheInvalidator::invalidateCaches();
   }
   calciteMgr_->updateMetadata(currentDB_.dbName, td->tableName);
   {
@@ -3205,6 +3211,8 @@ void Catalog::vacuumDeletedRows(const TableDescriptor* td) const {
                                   updel_roll.memoryLevel,
                                   updel_roll);
       updel_roll.commitUpdate();
+      // the rows moved, the cached join hash tables don't hold a prefix of the table
+      JoinHashTableCacheInvalidator::invalidateCaches();
     }
   }
 }
@@ -317,6 +317,10 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
         } else {
           os << " ENCODING NONE";
         }
+      } else if (ti.get_compression() == kENCODING_RL) {
+        os << " ENCODING RL";
+      } else if (ti.get_compression() == kENCODING_DIFF) {
+        os << " ENCODING DIFF(" << ti.get_comp_param() << ")";
       } else if (ti.get_size() > 0 && ti.get_size() != ti.get_logical_size()) {
         const auto comp_param = ti.get_comp_param() ? ti.get_comp_param() : 32;
         os << " ENCODING " << ti.get_compression_name() << "(" << comp_param << ")";
@@ -264,6 +264,12 @@ ChunkIter Chunk::begin_iterator(const ChunkMetadata& chunk_metadata,
         index_buf->getMemoryPtr() + start_idx * sizeof(StringOffsetT);
     it.end_pos = index_buf->getMemoryPtr() + index_buf->size() - sizeof(StringOffsetT);
     it.second_buf = buffer->getMemoryPtr();
+  } else if (it.type_info.get_compression() == kENCODING_RL ||
+             it.type_info.get_compression() == kENCODING_DIFF) {
+    // positions only count elements, values are decoded from the start of the chunk
+    it.second_buf = buffer->getMemoryPtr();
+    it.current_pos = it.start_pos = it.second_buf + start_idx * it.skip_size;
+    it.end_pos = it.second_buf + chunk_metadata.numElements * it.skip_size;
   } else {
     it.current_pos = it.start_pos = buffer->getMemoryPtr() + start_idx * it.skip_size;
     it.end_pos = buffer->getMemoryPtr() + buffer->size();
@@ -21,6 +21,8 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <map>
 #include <memory>
 
 #ifdef BUFFER_MUTEX
@@ -101,8 +103,35 @@ class AbstractBuffer {
   virtual inline void setUpdated() {
     is_updated_ = true;
     is_dirty_ = true;
+    updated_ranges_.clear();
   }
 
+  // Marks the bytes [offset, offset + num_bytes) as updated in place. As long as the
+  // buffer is only updated this way, only these ranges are written back at checkpoint.
+  void setUpdated(const size_t offset, const size_t num_bytes) {
+    if (is_updated_ && updated_ranges_.empty()) {
+      return;  // the whole buffer is written back already
+    }
+    is_updated_ = true;
+    is_dirty_ = true;
+    size_t begin = offset;
+    size_t end = offset + num_bytes;
+    auto it = updated_ranges_.upper_bound(begin);
+    if (it != updated_ranges_.begin() && std::prev(it)->second >= begin) {
+      --it;
+      begin = it->first;
+    }
+    while (it != updated_ranges_.end() && it->first <= end) {
+      end = std::max(end, it->second);
+      it = updated_ranges_.erase(it);
+    }
+    updated_ranges_.emplace(begin, end);
+  }
+
+  // The [begin, end) byte ranges updated in place since the last checkpoint, empty if
+  // the whole buffer has to be written back.
+  const std::map<size_t, size_t>& getUpdatedRanges() const { return updated_ranges_; }
+
   virtual inline void setAppended() {
     is_appended_ = true;
     is_dirty_ = true;
@@ -113,6 +142,7 @@ class AbstractBuffer {
     is_appended_ = false;
     is_updated_ = false;
     is_dirty_ = false;
+    updated_ranges_.clear();
   }
   void initEncoder(const SQLTypeInfo tmp_sql_type) {
     has_encoder = true;
@@ -129,6 +159,7 @@ class AbstractBuffer {
         initEncoder(src_buffer->sql_type);
       }
       encoder->copyMetadata(src_buffer->encoder.get());
+      encoder->copyBloomFilter(*src_buffer->encoder);
     }
   }
 
@@ -141,6 +172,7 @@ class AbstractBuffer {
   bool is_dirty_;
   bool is_appended_;
   bool is_updated_;
+  std::map<size_t, size_t> updated_ranges_;
   int device_id_;
 
 #ifdef BUFFER_MUTEX
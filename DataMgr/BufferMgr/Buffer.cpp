@@ -111,6 +111,7 @@ void Buffer::write(int8_t* src,
   is_dirty_ = true;
   if (offset < size_) {
     is_updated_ = true;
+    updated_ranges_.clear();
   }
   if (offset + num_bytes > size_) {
     is_appended_ = true;
@@ -57,7 +57,8 @@ BufferMgr::BufferMgr(const int device_id,
     , allocations_capped_(false)
     , parent_mgr_(parent_mgr)
     , max_buffer_id_(0)
-    , buffer_epoch_(0) {
+    , buffer_epoch_(0)
+    , eviction_policy_(std::make_unique<LruEvictionPolicy>()) {
   CHECK(max_buffer_size_ > 0 && max_slab_size_ > 0 && page_size_ > 0 &&
         max_slab_size_ % page_size_ == 0);
   max_num_pages_ = max_buffer_size_ / page_size_;
@@ -92,6 +93,10 @@ void BufferMgr::clear() {
   slabs_.clear();
   slab_segments_.clear();
   unsized_segs_.clear();
+  {
+    std::lock_guard<std::mutex> retired_segs_lock(retired_segs_mutex_);
+    retired_segs_.clear();
+  }
   buffer_epoch_ = 0;
 }
 
@@ -154,6 +159,15 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
       chunk_index_.erase(evict_it->chunk_key);
+      eviction_policy_->recordEviction(evict_it->chunk_key);
+    } else if (evict_it->mem_status == USED) {
+      // retired by reserveBuffer, its buffer was unpinned since
+      std::lock_guard<std::mutex> retired_segs_lock(retired_segs_mutex_);
+      const auto retired_it =
+          std::find(retired_segs_.begin(), retired_segs_.end(), evict_it);
+      if (retired_it != retired_segs_.end()) {
+        retired_segs_.erase(retired_it);
+      }
     }
     evict_it = slab_segments_[slab_num].erase(
         evict_it);  // erase operations returns next iterator - safe if we ever move
@@ -211,21 +225,30 @@ BufferList::iterator BufferMgr::reserveBuffer(
   // Below should be in copy constructor for BufferSeg?
   new_seg_it->buffer = seg_it->buffer;
   new_seg_it->chunk_key = seg_it->chunk_key;
-  int8_t* old_mem = new_seg_it->buffer->mem_;
-  new_seg_it->buffer->mem_ =
-      slabs_[new_seg_it->slab_num] + new_seg_it->start_page * page_size_;
+  new_seg_it->num_accesses = seg_it->num_accesses;
+  int8_t* new_mem = slabs_[new_seg_it->slab_num] + new_seg_it->start_page * page_size_;
 
   // now need to copy over memory
   // only do this if the old segment is valid (i.e. not new w/ unallocated buffer
+  // The copy goes first, a reader which gets the memory pointer of the buffer meanwhile
+  // finds all the data it had either way.
   if (seg_it->start_page >= 0 && seg_it->buffer->mem_ != 0) {
-    new_seg_it->buffer->writeData(old_mem,
-                                  new_seg_it->buffer->size(),
-                                  0,
-                                  new_seg_it->buffer->getType(),
-                                  device_id_);
+    new_seg_it->buffer->readData(new_mem,
+                                 new_seg_it->buffer->size(),
+                                 0,
+                                 new_seg_it->buffer->getType(),
+                                 device_id_);
+  }
+  new_seg_it->buffer->mem_ = new_mem;
+  if (seg_it->slab_num >= 0 && seg_it->buffer->getPinCount() > 1) {
+    // The caller holds one pin, the other ones belong to readers which may still use
+    // the old memory. The segment stays in use until the buffer is unpinned.
+    seg_it->chunk_key.clear();
+    std::lock_guard<std::mutex> retired_segs_lock(retired_segs_mutex_);
+    retired_segs_.push_back(seg_it);
+  } else {
+    removeSegment(seg_it);
   }
-  // Decrement pin count to reverse effect above
-  removeSegment(seg_it);
   {
     std::lock_guard<std::mutex> lock(chunk_index_mutex_);
     chunk_index_[new_seg_it->chunk_key] = new_seg_it;
@@ -262,11 +285,31 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
   return slab_segments_[slab_num].end();
 }
 
+bool BufferMgr::canReserveWithoutEviction(const size_t num_pages_requested) {
+  if (num_pages_requested > max_num_pages_per_slab_) {
+    return false;
+  }
+  if (!allocations_capped_ &&
+      num_pages_allocated_ + num_pages_requested <= max_num_pages_ &&
+      num_pages_requested <= current_max_slab_page_size_) {
+    return true;
+  }
+  for (const auto& segment_list : slab_segments_) {
+    for (const auto& segment : segment_list) {
+      if (segment.mem_status == FREE && segment.num_pages >= num_pages_requested) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
   size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
   if (num_pages_requested > max_num_pages_per_slab_) {
     throw TooBigForSlab(num_bytes);
   }
+  freeRetiredSegments(nullptr);
 
   size_t num_slabs = slab_segments_.size();
 
@@ -336,8 +379,8 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
   size_t min_score = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
-  // This is because score is the sum of the lastTouched score for all pages evicted.
-  // Evicting fewer pages and older pages will lower the score
+  // The score of a run of segments is the highest eviction policy score of the chunks
+  // in it, so runs made only of cold chunks win
   BufferList::iterator best_eviction_start = slab_segments_[0].end();
   int best_eviction_start_slab = -1;
   int slab_num = 0;
@@ -372,7 +415,7 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           // chunk score was larger than one large chunk so it always would evict a large
           // chunk so under memory pressure a query would evict its own current chunks and
           // cause reloads rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+          score = std::max(score, eviction_policy_->getEvictionScore(*evict_it));
         }
         if (page_count >= num_pages_requested) {
           solution_found = true;
@@ -404,7 +447,8 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
   LOG(INFO) << "ALLOCATION failed to find " << num_bytes << "B free. Forcing Eviction."
             << " Eviction start " << best_eviction_start->start_page
             << " Number pages requested " << num_pages_requested
-            << " Best Eviction Start Slab " << best_eviction_start_slab << " "
+            << " Best Eviction Start Slab " << best_eviction_start_slab
+            << " Eviction policy " << eviction_policy_->getName() << " "
             << getStringMgrType() << ":" << device_id_;
   best_eviction_start =
       evict(best_eviction_start, num_pages_requested, best_eviction_start_slab);
@@ -455,10 +499,14 @@ std::string BufferMgr::printSlabs() {
 
 void BufferMgr::clearSlabs() {
   bool pinned_exists = false;
+  freeRetiredSegments(nullptr);
   for (auto& segment_list : slab_segments_) {
     for (auto& segment : segment_list) {
       if (segment.mem_status == FREE) {
         // no need to free
+      } else if (segment.chunk_key.empty()) {
+        // retired, its buffer is still pinned
+        pinned_exists = true;
       } else if (segment.buffer->getPinCount() < 1) {
         deleteBuffer(segment.chunk_key, true);
       } else {
@@ -590,6 +638,7 @@ void BufferMgr::deleteBuffer(const ChunkKey& key, const bool) {
   chunk_index_lock.unlock();
   std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
   if (seg_it->buffer) {
+    freeRetiredSegments(seg_it->buffer);
     delete seg_it->buffer;  // Delete Buffer for segment
     seg_it->buffer = 0;
   }
@@ -617,12 +666,14 @@ void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& key_prefix, const bool)
                      key_prefix.end()) != buffer_it->first.begin() + key_prefix.size()) {
     auto seg_it = buffer_it->second;
     if (seg_it->buffer) {
+      freeRetiredSegments(seg_it->buffer);
       delete seg_it->buffer;  // Delete Buffer for segment
       seg_it->buffer = 0;
     }
     removeSegment(seg_it);
     chunk_index_.erase(buffer_it++);
   }
+  eviction_policy_->forgetKeysWithPrefix(key_prefix);
 }
 
 void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
@@ -656,6 +707,19 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
   }
 }
 
+void BufferMgr::freeRetiredSegments(const Buffer* buffer) {
+  std::lock_guard<std::mutex> retired_segs_lock(retired_segs_mutex_);
+  for (auto retired_it = retired_segs_.begin(); retired_it != retired_segs_.end();) {
+    auto seg_it = *retired_it;
+    if (buffer ? seg_it->buffer == buffer : seg_it->buffer->getPinCount() < 1) {
+      removeSegment(seg_it);
+      retired_it = retired_segs_.erase(retired_it);
+    } else {
+      ++retired_it;
+    }
+  }
+}
+
 void BufferMgr::checkpoint() {
   std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
   std::lock_guard<std::mutex> chunkIndexLock(chunk_index_mutex_);
@@ -702,7 +766,7 @@ void BufferMgr::checkpoint(const int db_id, const int tb_id) {
 /// Returns a pointer to the Buffer holding the chunk, if it exists; otherwise,
 /// throws a runtime_error.
 AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes) {
-  std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
+  auto lock = lockAfterPrefetch(key);  // granular lock
 
   std::unique_lock<std::mutex> sized_segs_lock(sized_segs_mutex_);
   std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
@@ -715,6 +779,8 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
     sized_segs_lock.unlock();
 
     buffer_it->second->last_touched = buffer_epoch_++;  // race
+    ++buffer_it->second->num_accesses;                  // race
+    eviction_policy_->recordAccess(key, true);
 
     if (buffer_it->second->buffer->size() < num_bytes) {
       // need to fetch part of buffer we don't have - up to numBytes
@@ -723,6 +789,7 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
     return buffer_it->second->buffer;
   } else {  // If wasn't in pool then we need to fetch it
     sized_segs_lock.unlock();
+    eviction_policy_->recordAccess(key, false);
     // createChunk pins for us
     AbstractBuffer* buffer = createBuffer(key, page_size_, num_bytes);
     try {
@@ -732,14 +799,93 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
       LOG(FATAL) << "Get chunk - Could not find chunk " << keyToString(key)
                  << " in buffer pool or parent buffer pools. Error was " << error.what();
     }
+    chunk_index_lock.lock();
+    // the chunk is pinned, it can't have been evicted meanwhile
+    const auto new_buffer_it = chunk_index_.find(key);
+    CHECK(new_buffer_it != chunk_index_.end());
+    new_buffer_it->second->num_accesses = 1;
     return buffer;
   }
 }
 
+bool BufferMgr::prefetchBuffer(const ChunkKey& key,
+                               const size_t num_bytes,
+                               const double max_fill_fraction) {
+  AbstractBuffer* buffer{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
+    {
+      std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+      if (chunk_index_.find(key) != chunk_index_.end()) {
+        return false;
+      }
+    }
+    const size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
+    {
+      // deleteBuffer changes the segments without the global lock
+      std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+      if (num_pages_requested == 0 ||
+          getInUseSize() + num_pages_requested * page_size_ >
+              max_fill_fraction * getMaxSize() ||
+          !canReserveWithoutEviction(num_pages_requested)) {
+        return false;
+      }
+    }
+    CHECK(parent_mgr_);
+    // createBuffer pins, the chunk can't be evicted while it loads
+    buffer = createBuffer(key, page_size_, num_bytes);
+    std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+    prefetching_keys_.insert(key);
+  }
+  // The read doesn't hold the global lock, the foreground queries can get other chunks
+  // meanwhile.
+  bool fetched{true};
+  try {
+    parent_mgr_->fetchBuffer(key, buffer, num_bytes);
+    buffer->unPin();
+  } catch (std::runtime_error& error) {
+    LOG(WARNING) << "Prefetch - Could not fetch chunk " << keyToString(key)
+                 << " from parent buffer pool. Error was " << error.what();
+    deleteBuffer(key);
+    fetched = false;
+  }
+  {
+    std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+    prefetching_keys_.erase(key);
+  }
+  prefetch_cv_.notify_all();
+  return fetched;
+}
+
+std::unique_lock<std::mutex> BufferMgr::lockAfterPrefetch(const ChunkKey& key) {
+  const auto not_prefetching = [this, &key] {
+    return prefetching_keys_.find(key) == prefetching_keys_.end();
+  };
+  while (true) {
+    {
+      // the other requests keep going while the prefetch reads the chunk
+      std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
+      prefetch_cv_.wait(chunk_index_lock, not_prefetching);
+    }
+    std::unique_lock<std::mutex> lock(global_mutex_);
+    std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+    // a new prefetch of the chunk may have started before the global lock was taken
+    if (not_prefetching()) {
+      return lock;
+    }
+  }
+}
+
+bool BufferMgr::isFilledPast(const double fill_fraction) {
+  std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
+  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  return getInUseSize() > fill_fraction * getMaxSize();
+}
+
 void BufferMgr::fetchBuffer(const ChunkKey& key,
                             AbstractBuffer* dest_buffer,
                             const size_t num_bytes) {
-  std::unique_lock<std::mutex> lock(global_mutex_);  // granular lock
+  auto lock = lockAfterPrefetch(key);  // granular lock
   std::unique_lock<std::mutex> sized_segs_lock(sized_segs_mutex_);
   std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
 
@@ -750,15 +896,23 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
   if (!found_buffer) {
     sized_segs_lock.unlock();
     CHECK(parent_mgr_ != 0);
+    eviction_policy_->recordAccess(key, false);
     buffer = createBuffer(key, page_size_, num_bytes);  // will pin buffer
     try {
       parent_mgr_->fetchBuffer(key, buffer, num_bytes);
     } catch (std::runtime_error& error) {
       LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
     }
+    chunk_index_lock.lock();
+    const auto new_buffer_it = chunk_index_.find(key);
+    CHECK(new_buffer_it != chunk_index_.end());
+    new_buffer_it->second->num_accesses = 1;
+    chunk_index_lock.unlock();
   } else {
     buffer = buffer_it->second->buffer;
     buffer->pin();
+    ++buffer_it->second->num_accesses;
+    eviction_policy_->recordAccess(key, true);
     if (num_bytes > buffer->size()) {
       try {
         parent_mgr_->fetchBuffer(key, buffer, num_bytes);
@@ -875,7 +1029,37 @@ void BufferMgr::getChunkMetadataVecForKeyPrefix(
   LOG(FATAL) << "getChunkMetadataVecForPrefix not supported for BufferMgr.";
 }
 
+std::vector<ResidentChunk> BufferMgr::getResidentChunks() {
+  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  std::vector<ResidentChunk> resident_chunks;
+  for (const auto& chunk : chunk_index_) {
+    const auto& seg = *chunk.second;
+    // skips the buffers which aren't chunks and the ones still being loaded
+    if (chunk.first[0] == -1 || seg.slab_num < 0 || !seg.buffer) {
+      continue;
+    }
+    resident_chunks.push_back(
+        {chunk.first, seg.buffer->size(), seg.num_accesses, seg.last_touched});
+  }
+  return resident_chunks;
+}
+
 const std::vector<BufferList>& BufferMgr::getSlabSegments() {
   return slab_segments_;
 }
+
+void BufferMgr::setEvictionPolicy(std::unique_ptr<EvictionPolicy> eviction_policy) {
+  CHECK(eviction_policy);
+  std::lock_guard<std::mutex> lock(global_mutex_);
+  eviction_policy_ = std::move(eviction_policy);
+}
+
+std::string BufferMgr::getEvictionPolicyName() const {
+  return eviction_policy_->getName();
+}
+
+EvictionPolicyStats BufferMgr::getEvictionPolicyStats() const {
+  return eviction_policy_->getStats();
+}
 }  // namespace Buffer_Namespace
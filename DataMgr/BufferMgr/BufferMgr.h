@@ -26,16 +26,19 @@
 
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED 1
 
+#include <condition_variable>
 #include <iostream>
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
 
 #include <boost/stacktrace.hpp>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
 #include "DataMgr/BufferMgr/BufferSeg.h"
+#include "DataMgr/BufferMgr/EvictionPolicy.h"
 #include "Shared/types.h"
 
 class OutOfMemory : public std::runtime_error {
@@ -87,6 +90,13 @@ using namespace Data_Namespace;
 
 namespace Buffer_Namespace {
 
+struct ResidentChunk {
+  ChunkKey chunk_key;
+  size_t num_bytes;
+  size_t num_accesses;
+  unsigned int last_touched;
+};
+
 /**
  * @class   BufferMgr
  * @brief
@@ -125,6 +135,13 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   size_t getPageSize();
   bool isAllocationCapped() override;
   const std::vector<BufferList>& getSlabSegments();
+  /// Returns the chunks loaded in the pool, buffers allocated for query results excluded.
+  std::vector<ResidentChunk> getResidentChunks();
+
+  /// Replaces the victim selection policy, resetting its counters.
+  void setEvictionPolicy(std::unique_ptr<EvictionPolicy> eviction_policy);
+  std::string getEvictionPolicyName() const;
+  EvictionPolicyStats getEvictionPolicyStats() const;
 
   /// Creates a chunk with the specified key and page size.
   AbstractBuffer* createBuffer(const ChunkKey& key,
@@ -139,6 +156,24 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   /// Returns the a pointer to the chunk with the specified key.
   AbstractBuffer* getBuffer(const ChunkKey& key, const size_t num_bytes = 0) override;
 
+  /**
+   * @brief Speculatively loads a chunk from the parent buffer manager.
+   *
+   * Unlike getBuffer, the chunk is left unpinned, the access is not reported to the
+   * eviction policy and nothing is loaded if the chunk is already resident or if
+   * loading it would require evicting other chunks or push the pool past
+   * max_fill_fraction of its maximum size. The read from the parent runs without the
+   * global lock; getBuffer and fetchBuffer of the same chunk wait for it to finish.
+   *
+   * @return true if the chunk was loaded
+   */
+  bool prefetchBuffer(const ChunkKey& key,
+                      const size_t num_bytes,
+                      const double max_fill_fraction);
+
+  /// Returns true if the pool is filled past fill_fraction of its maximum size.
+  bool isFilledPast(const double fill_fraction);
+
   /**
    * @brief Puts the contents of d into the Buffer with ChunkKey key.
    * @param key - Unique identifier for a Chunk.
@@ -181,8 +216,16 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
   void removeSegment(BufferList::iterator& seg_it);
+  /// Frees the segments retired by reserveBuffer which belong to buffer, or, if it's
+  /// null, the ones whose buffer nobody pins anymore.
+  void freeRetiredSegments(const Buffer* buffer);
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
+  /// The caller holds sized_segs_mutex_.
+  bool canReserveWithoutEviction(const size_t num_pages_requested);
+  /// Waits, without the global lock, until the chunk isn't being loaded by
+  /// prefetchBuffer, then returns the global lock.
+  std::unique_lock<std::mutex> lockAfterPrefetch(const ChunkKey& key);
   int getBufferId();
   virtual void addSlab(const size_t slab_size) = 0;
   virtual void freeAllMem() = 0;
@@ -194,8 +237,13 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   std::mutex unsized_segs_mutex_;
   std::mutex buffer_id_mutex_;
   std::mutex global_mutex_;
+  std::mutex retired_segs_mutex_;
 
   std::map<ChunkKey, BufferList::iterator> chunk_index_;
+  // chunks in chunk_index_ which prefetchBuffer is still loading, guarded by
+  // chunk_index_mutex_
+  std::set<ChunkKey> prefetching_keys_;
+  std::condition_variable prefetch_cv_;
   size_t max_buffer_size_;  /// max number of bytes allocated for the buffer pool
   size_t max_num_pages_;
   size_t num_pages_allocated_;
@@ -209,6 +257,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   unsigned int buffer_epoch_;
 
   BufferList unsized_segs_;
+  // Segments a buffer moved out of while it was pinned by readers, which may still use
+  // its old memory. They are USED without a chunk key and still point to the buffer, so
+  // they aren't evicted before it's unpinned.
+  std::vector<BufferList::iterator> retired_segs_;
+  std::unique_ptr<EvictionPolicy> eviction_policy_;
 
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/BufferMgr/EvictionPolicy.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "Shared/Logger.h"
+
+namespace Buffer_Namespace {
+
+namespace {
+
+// Chunks with a complete access history always score above the ones without.
+constexpr size_t kFullHistoryScoreBit = size_t(1) << 63;
+
+bool is_temporary_buffer(const ChunkKey& key) {
+  return key.empty() || key[0] == -1;
+}
+
+bool has_prefix(const ChunkKey& key, const ChunkKey& key_prefix) {
+  return key.size() >= key_prefix.size() &&
+         std::equal(key_prefix.begin(), key_prefix.end(), key.begin());
+}
+
+}  // namespace
+
+void EvictionPolicy::recordAccess(const ChunkKey& key, const bool hit) {
+  if (hit) {
+    ++num_hits_;
+  } else {
+    ++num_misses_;
+  }
+}
+
+void EvictionPolicy::recordEviction(const ChunkKey& key) {
+  ++num_evictions_;
+}
+
+EvictionPolicyStats EvictionPolicy::getStats() const {
+  return {num_hits_.load(), num_misses_.load(), num_evictions_.load()};
+}
+
+LruKEvictionPolicy::LruKEvictionPolicy(const size_t k, const size_t max_retained_history)
+    : k_(k), max_retained_history_(max_retained_history), clock_(0) {
+  CHECK_GT(k_, size_t(0));
+}
+
+void LruKEvictionPolicy::recordAccess(const ChunkKey& key, const bool hit) {
+  EvictionPolicy::recordAccess(key, hit);
+  if (is_temporary_buffer(key)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(history_mutex_);
+  auto& history = history_[key];
+  unretire(history);
+  history.accesses.push_front(++clock_);
+  if (history.accesses.size() > k_) {
+    history.accesses.pop_back();
+  }
+}
+
+void LruKEvictionPolicy::recordEviction(const ChunkKey& key) {
+  EvictionPolicy::recordEviction(key);
+  if (is_temporary_buffer(key)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(history_mutex_);
+  auto history_it = history_.find(key);
+  if (history_it == history_.end() || history_it->second.is_retired) {
+    return;
+  }
+  auto& history = history_it->second;
+  history.is_retired = true;
+  history.retired_it = retired_keys_.insert(retired_keys_.end(), key);
+  while (retired_keys_.size() > max_retained_history_) {
+    history_.erase(retired_keys_.front());
+    retired_keys_.pop_front();
+  }
+}
+
+void LruKEvictionPolicy::forgetKeysWithPrefix(const ChunkKey& key_prefix) {
+  std::lock_guard<std::mutex> lock(history_mutex_);
+  auto history_it = history_.lower_bound(key_prefix);
+  while (history_it != history_.end() && has_prefix(history_it->first, key_prefix)) {
+    unretire(history_it->second);
+    history_it = history_.erase(history_it);
+  }
+}
+
+size_t LruKEvictionPolicy::getEvictionScore(const BufferSeg& seg) {
+  if (is_temporary_buffer(seg.chunk_key)) {
+    // Their contents can't be fetched again from a parent. The buffer epoch in
+    // last_touched doesn't compare with clock_ either, they go after every chunk.
+    return std::numeric_limits<size_t>::max();
+  }
+  std::lock_guard<std::mutex> lock(history_mutex_);
+  const auto history_it = history_.find(seg.chunk_key);
+  if (history_it == history_.end() || history_it->second.accesses.empty()) {
+    return 0;
+  }
+  const auto& accesses = history_it->second.accesses;
+  if (accesses.size() < k_) {
+    // Infinite backward K-distance, fall back to plain LRU among these chunks
+    return accesses.front();
+  }
+  return kFullHistoryScoreBit | accesses.back();
+}
+
+void LruKEvictionPolicy::unretire(AccessHistory& history) {
+  if (history.is_retired) {
+    retired_keys_.erase(history.retired_it);
+    history.is_retired = false;
+  }
+}
+
+std::unique_ptr<EvictionPolicy> create_eviction_policy(const std::string& name) {
+  if (name == "lru") {
+    return std::make_unique<LruEvictionPolicy>();
+  }
+  if (name == "lru-k" || name == "lru-2") {
+    return std::make_unique<LruKEvictionPolicy>(2);
+  }
+  throw std::runtime_error("Unknown buffer pool eviction policy '" + name +
+                           "'. Supported policies are 'lru' and 'lru-k'.");
+}
+
+}  // namespace Buffer_Namespace
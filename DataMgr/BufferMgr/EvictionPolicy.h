@@ -0,0 +1,123 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    EvictionPolicy.h
+ * @brief   Pluggable victim selection for the BufferMgr slab allocator.
+ *
+ * The BufferMgr still decides which contiguous runs of unpinned segments can be
+ * evicted; the policy only scores the chunks in a run. The run with the lowest
+ * score (the maximum over its chunks) is evicted, like golf.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "DataMgr/BufferMgr/BufferSeg.h"
+#include "Shared/types.h"
+
+namespace Buffer_Namespace {
+
+struct EvictionPolicyStats {
+  size_t num_hits;
+  size_t num_misses;
+  size_t num_evictions;
+};
+
+class EvictionPolicy {
+ public:
+  EvictionPolicy() : num_hits_(0), num_misses_(0), num_evictions_(0) {}
+  virtual ~EvictionPolicy() {}
+
+  virtual std::string getName() const = 0;
+
+  /// Called whenever a chunk is requested from the pool, resident or not.
+  virtual void recordAccess(const ChunkKey& key, const bool hit);
+  /// Called when a resident chunk is dropped to make room for another one.
+  virtual void recordEviction(const ChunkKey& key);
+  /// Called when chunks are deleted for good (e.g. the table was dropped).
+  virtual void forgetKeysWithPrefix(const ChunkKey& key_prefix) {}
+
+  /// Lower scores are evicted first.
+  virtual size_t getEvictionScore(const BufferSeg& seg) = 0;
+
+  EvictionPolicyStats getStats() const;
+
+ private:
+  std::atomic<size_t> num_hits_;
+  std::atomic<size_t> num_misses_;
+  std::atomic<size_t> num_evictions_;
+};
+
+/**
+ * Historical BufferMgr behavior: evict the least recently touched run, using the
+ * pool epoch stamped on each segment.
+ */
+class LruEvictionPolicy : public EvictionPolicy {
+ public:
+  std::string getName() const override { return "lru"; }
+
+  size_t getEvictionScore(const BufferSeg& seg) override { return seg.last_touched; }
+};
+
+/**
+ * LRU-K (O'Neil et al.): victims are chosen by the time of their K-th most recent
+ * access. Chunks seen fewer than K times, such as the ones brought in by a single
+ * ad-hoc full scan, are always evicted before chunks with a full access history, so
+ * a scan cannot flush the working set. Access history outlives eviction, up to
+ * `max_retained_history` non-resident keys, so that re-loaded hot chunks regain
+ * their priority immediately.
+ */
+class LruKEvictionPolicy : public EvictionPolicy {
+ public:
+  LruKEvictionPolicy(const size_t k = 2, const size_t max_retained_history = 1 << 16);
+
+  std::string getName() const override { return "lru-" + std::to_string(k_); }
+
+  void recordAccess(const ChunkKey& key, const bool hit) override;
+  void recordEviction(const ChunkKey& key) override;
+  void forgetKeysWithPrefix(const ChunkKey& key_prefix) override;
+
+  size_t getEvictionScore(const BufferSeg& seg) override;
+
+ private:
+  struct AccessHistory {
+    std::deque<size_t> accesses;  // most recent first, at most k_ entries
+    bool is_retired{false};
+    std::list<ChunkKey>::iterator retired_it;
+  };
+
+  void unretire(AccessHistory& history);
+
+  const size_t k_;
+  const size_t max_retained_history_;
+  size_t clock_;
+  std::map<ChunkKey, AccessHistory> history_;
+  std::list<ChunkKey> retired_keys_;  // oldest eviction first
+  std::mutex history_mutex_;
+};
+
+/// Throws std::runtime_error for unknown policy names.
+std::unique_ptr<EvictionPolicy> create_eviction_policy(const std::string& name);
+
+}  // namespace Buffer_Namespace
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferPoolWarmer.h"
+#include "DataMgr.h"
+#include "FileMgr/GlobalFileMgr.h"
+#include "Shared/Logger.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace Data_Namespace {
+
+namespace {
+
+// One line of the file: memory level, device id, number of requests, size in bytes and
+// the comma separated chunk key.
+struct RecordedChunk {
+  int level;
+  int device_id;
+  size_t num_accesses;
+  size_t num_bytes;
+  ChunkKey chunk_key;
+};
+
+std::string chunk_key_to_string(const ChunkKey& chunk_key) {
+  std::vector<std::string> key_elems;
+  for (const auto key_elem : chunk_key) {
+    key_elems.push_back(std::to_string(key_elem));
+  }
+  return boost::algorithm::join(key_elems, ",");
+}
+
+bool parse_recorded_chunk(const std::string& line, RecordedChunk& chunk) {
+  std::istringstream line_stream(line);
+  std::string chunk_key_str;
+  if (!(line_stream >> chunk.level >> chunk.device_id >> chunk.num_accesses >>
+        chunk.num_bytes >> chunk_key_str)) {
+    return false;
+  }
+  std::vector<std::string> key_elems;
+  boost::split(key_elems, chunk_key_str, boost::is_any_of(","));
+  chunk.chunk_key.clear();
+  try {
+    for (const auto& key_elem : key_elems) {
+      chunk.chunk_key.push_back(boost::lexical_cast<int>(key_elem));
+    }
+  } catch (const boost::bad_lexical_cast&) {
+    return false;
+  }
+  return chunk.chunk_key.size() >= 2;
+}
+
+}  // namespace
+
+BufferPoolWarmer::BufferPoolWarmer(DataMgr& data_mgr,
+                                   const std::string& path,
+                                   const size_t save_interval_sec,
+                                   const size_t max_mb_per_sec,
+                                   const double max_pool_fill)
+    : data_mgr_(data_mgr)
+    , path_(path)
+    , save_interval_sec_(save_interval_sec)
+    , max_mb_per_sec_(max_mb_per_sec)
+    , max_pool_fill_(max_pool_fill)
+    , stopped_(false)
+    , loaded_(false) {
+  worker_ = std::thread([this] { run(); });
+}
+
+BufferPoolWarmer::~BufferPoolWarmer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  stop_cv_.notify_all();
+  worker_.join();
+  if (loaded_) {
+    saveResidentChunks();
+  }
+}
+
+void BufferPoolWarmer::saveResidentChunks() {
+  const std::string temp_path = path_ + ".tmp";
+  std::ofstream out(temp_path, std::ios::trunc);
+  size_t num_chunks{0};
+  for (size_t level = MemoryLevel::CPU_LEVEL; level < data_mgr_.bufferMgrs_.size();
+       ++level) {
+    for (size_t device_id = 0; device_id < data_mgr_.bufferMgrs_[level].size();
+         ++device_id) {
+      auto buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(
+          data_mgr_.bufferMgrs_[level][device_id]);
+      CHECK(buffer_mgr);
+      auto resident_chunks = buffer_mgr->getResidentChunks();
+      // most recently used first, they go first among the chunks requested as often
+      std::sort(resident_chunks.begin(),
+                resident_chunks.end(),
+                [](const Buffer_Namespace::ResidentChunk& lhs,
+                   const Buffer_Namespace::ResidentChunk& rhs) {
+                  return lhs.last_touched > rhs.last_touched;
+                });
+      for (const auto& chunk : resident_chunks) {
+        out << level << " " << device_id << " " << chunk.num_accesses << " "
+            << chunk.num_bytes << " " << chunk_key_to_string(chunk.chunk_key) << "\n";
+        ++num_chunks;
+      }
+    }
+  }
+  out.close();
+  if (!out) {
+    LOG(WARNING) << "Could not write the buffer pool chunks to '" << temp_path << "'";
+    return;
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(temp_path, path_, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not rename '" << temp_path << "': " << ec.message();
+    return;
+  }
+  VLOG(1) << "Recorded " << num_chunks << " buffer pool chunks in '" << path_ << "'";
+}
+
+void BufferPoolWarmer::waitUntilLoaded() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  loaded_cv_.wait(lock, [this] { return loaded_ || stopped_; });
+}
+
+void BufferPoolWarmer::run() {
+  const bool loaded = loadResidentChunks();
+  std::unique_lock<std::mutex> lock(mutex_);
+  // a reload stopped halfway must not overwrite the file, a finished one records the
+  // pools at shutdown even if stopped right after
+  loaded_ = loaded;
+  loaded_cv_.notify_all();
+  if (stopped_) {
+    return;
+  }
+  while (true) {
+    const auto stop = [this] { return stopped_; };
+    if (save_interval_sec_ == 0) {
+      stop_cv_.wait(lock, stop);
+    } else {
+      stop_cv_.wait_for(lock, std::chrono::seconds(save_interval_sec_), stop);
+    }
+    if (stopped_) {
+      return;
+    }
+    lock.unlock();
+    saveResidentChunks();
+    lock.lock();
+  }
+}
+
+bool BufferPoolWarmer::loadResidentChunks() {
+  std::ifstream in(path_);
+  if (!in) {
+    return true;
+  }
+  std::vector<RecordedChunk> chunks;
+  std::string line;
+  while (std::getline(in, line)) {
+    RecordedChunk chunk;
+    if (!parse_recorded_chunk(line, chunk)) {
+      LOG(WARNING) << "Skipping invalid line in '" << path_ << "': " << line;
+      continue;
+    }
+    // the server may run with fewer GPUs, or none, this time
+    if (chunk.level < MemoryLevel::CPU_LEVEL ||
+        chunk.level >= static_cast<int>(data_mgr_.levelSizes_.size()) ||
+        chunk.device_id < 0 || chunk.device_id >= data_mgr_.levelSizes_[chunk.level]) {
+      continue;
+    }
+    chunks.push_back(chunk);
+  }
+  // the CPU pool first, the GPU pools load their chunks from it
+  std::stable_sort(chunks.begin(),
+                   chunks.end(),
+                   [](const RecordedChunk& lhs, const RecordedChunk& rhs) {
+                     if (lhs.level != rhs.level) {
+                       return lhs.level < rhs.level;
+                     }
+                     return lhs.num_accesses > rhs.num_accesses;
+                   });
+
+  auto& global_file_mgr = *data_mgr_.getGlobalFileMgr();
+  std::set<std::pair<int, int>> full_pools;
+  size_t num_chunks_loaded{0};
+  size_t num_bytes_loaded{0};
+  bool stopped{false};
+  const auto clock_begin = std::chrono::steady_clock::now();
+  for (const auto& chunk : chunks) {
+    if (isStopped()) {
+      stopped = true;
+      break;
+    }
+    const auto pool = std::make_pair(chunk.level, chunk.device_id);
+    if (full_pools.count(pool)) {
+      continue;
+    }
+    auto buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(
+        data_mgr_.bufferMgrs_[chunk.level][chunk.device_id]);
+    CHECK(buffer_mgr);
+    if (buffer_mgr->isFilledPast(max_pool_fill_)) {
+      full_pools.insert(pool);
+      continue;
+    }
+    try {
+      // the table or the fragment may have been dropped since
+      if (!global_file_mgr.isChunkOnDisk(chunk.chunk_key)) {
+        continue;
+      }
+      // loading the chunk from disk could evict others from the CPU pool
+      if (chunk.level == MemoryLevel::GPU_LEVEL &&
+          !data_mgr_.isBufferOnDevice(chunk.chunk_key, MemoryLevel::CPU_LEVEL, 0)) {
+        continue;
+      }
+      if (!buffer_mgr->prefetchBuffer(chunk.chunk_key, chunk.num_bytes, max_pool_fill_)) {
+        continue;
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Could not reload buffer pool chunk: " << e.what();
+      continue;
+    }
+    ++num_chunks_loaded;
+    num_bytes_loaded += chunk.num_bytes;
+    if (max_mb_per_sec_) {
+      const auto load_time =
+          std::chrono::milliseconds(num_bytes_loaded * 1000 / (max_mb_per_sec_ << 20));
+      const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - clock_begin);
+      if (load_time > elapsed && !waitFor(load_time - elapsed)) {
+        stopped = true;
+        break;
+      }
+    }
+  }
+  LOG(INFO) << "Reloaded " << num_chunks_loaded << " of the " << chunks.size()
+            << " recorded buffer pool chunks (" << num_bytes_loaded << " bytes) in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - clock_begin)
+                   .count()
+            << " ms";
+  return !stopped;
+}
+
+bool BufferPoolWarmer::isStopped() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stopped_;
+}
+
+bool BufferPoolWarmer::waitFor(const std::chrono::milliseconds duration) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return !stop_cv_.wait_for(lock, duration, [this] { return stopped_; });
+}
+
+}  // namespace Data_Namespace
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    BufferPoolWarmer.h
+ * @brief   Records the chunks resident in the CPU and GPU buffer pools and loads them
+ * back after a restart.
+ *
+ * The resident chunks of every pool, with the number of times each was requested since
+ * it was loaded, are written to a file in the data directory periodically and at
+ * shutdown. At startup a background thread loads the chunks of that file back, the most
+ * requested first, at a throttled rate. The chunks are loaded the way the chunk
+ * prefetcher does: they are left unpinned, never evict anything and a pool is done once
+ * it is filled past `max_pool_fill`, so the queries which run meanwhile keep priority.
+ * Recording only starts once the reload is done, the file isn't overwritten by the
+ * partially warmed pools.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Data_Namespace {
+
+class DataMgr;
+
+class BufferPoolWarmer {
+ public:
+  BufferPoolWarmer(DataMgr& data_mgr,
+                   const std::string& path,
+                   const size_t save_interval_sec,
+                   const size_t max_mb_per_sec,
+                   const double max_pool_fill);
+
+  /// Stops the reload if it's still running, records the resident chunks otherwise.
+  ~BufferPoolWarmer();
+
+  void saveResidentChunks();
+
+  /// Blocks until the reload is done or stopped.
+  void waitUntilLoaded();
+
+ private:
+  void run();
+  // Returns false if stopped before going through all the recorded chunks.
+  bool loadResidentChunks();
+  bool isStopped();
+  // Sleeps for the given time, returns false if stopped meanwhile.
+  bool waitFor(const std::chrono::milliseconds duration);
+
+  DataMgr& data_mgr_;
+  const std::string path_;
+  const size_t save_interval_sec_;
+  const size_t max_mb_per_sec_;
+  const double max_pool_fill_;
+
+  std::mutex mutex_;
+  std::condition_variable stop_cv_;
+  std::condition_variable loaded_cv_;
+  bool stopped_;
+  bool loaded_;
+  std::thread worker_;
+};
+
+}  // namespace Data_Namespace
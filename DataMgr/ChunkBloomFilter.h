@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkBloomFilter.h
+ * @brief   Bloom filter over the values of a chunk, which lets the executor skip
+ * fragments for equality and IN predicates the min / max stats can't rule out.
+ *
+ * The filter has a fixed size so that it fits the metadata page of the chunk next to the
+ * encoder stats. It is exact for chunks with up to a few thousand distinct values and
+ * degrades gracefully, i.e. it stops ruling out fragments, beyond that.
+ */
+
+#ifndef CHUNK_BLOOM_FILTER_H
+#define CHUNK_BLOOM_FILTER_H
+
+#include "../Shared/sqltypes.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+class ChunkBloomFilter {
+ public:
+  static constexpr size_t kNumBits{24576};  // 3KB, leaves room in the metadata page
+  static constexpr size_t kNumProbes{4};
+
+  ChunkBloomFilter() {
+    for (auto& word : bits_) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // Integer, time and dictionary encoded string columns, whose fragments skipFragment
+  // prunes on.
+  static bool supportsType(const SQLTypeInfo& ti) {
+    return ti.is_integer() || ti.is_time() ||
+           (ti.is_string() && ti.get_compression() == kENCODING_DICT);
+  }
+
+  // Adds the value in place while queries may read the filter. The appends to a chunk
+  // are serialized, so a plain store of each word is enough.
+  void add(const int64_t val) {
+    const auto h = hash(val);
+    for (size_t i = 0; i < kNumProbes; ++i) {
+      const auto bit = probe(h, i);
+      auto& word = bits_[bit / 64];
+      word.store(word.load(std::memory_order_relaxed) | (uint64_t(1) << (bit % 64)),
+                 std::memory_order_relaxed);
+    }
+  }
+
+  bool mayContain(const int64_t val) const {
+    const auto h = hash(val);
+    for (size_t i = 0; i < kNumProbes; ++i) {
+      const auto bit = probe(h, i);
+      if (!(bits_[bit / 64].load(std::memory_order_relaxed) &
+            (uint64_t(1) << (bit % 64)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void write(FILE* f) const {
+    std::array<uint64_t, kNumBits / 64> bits;
+    for (size_t i = 0; i < bits.size(); ++i) {
+      bits[i] = bits_[i].load(std::memory_order_relaxed);
+    }
+    fwrite(bits.data(), sizeof(uint64_t), bits.size(), f);
+  }
+
+  void read(FILE* f) {
+    std::array<uint64_t, kNumBits / 64> bits{};
+    fread(bits.data(), sizeof(uint64_t), bits.size(), f);
+    for (size_t i = 0; i < bits.size(); ++i) {
+      bits_[i].store(bits[i], std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  // MurmurHash3 finalizer
+  static uint64_t hash(const int64_t val) {
+    auto h = static_cast<uint64_t>(val);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  // Double hashing from the two halves of the hash.
+  static size_t probe(const uint64_t h, const size_t i) {
+    const auto h1 = h & 0xffffffff;
+    const auto h2 = (h >> 32) | 1;
+    return (h1 + i * h2) % kNumBits;
+  }
+
+  std::array<std::atomic<uint64_t>, kNumBits / 64> bits_;
+};
+
+#endif  // CHUNK_BLOOM_FILTER_H
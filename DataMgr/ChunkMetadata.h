@@ -18,7 +18,9 @@
 #define CHUNKMETADATA_H
 
 #include <cstddef>
+#include <memory>
 #include "../Shared/sqltypes.h"
+#include "ChunkBloomFilter.h"
 
 #include "Shared/Logger.h"
 
@@ -33,6 +35,8 @@ struct ChunkMetadata {
   size_t numBytes;
   size_t numElements;
   ChunkStats chunkStats;
+  // Snapshot of the values of the chunk, null unless built since the chunk was created.
+  std::shared_ptr<const ChunkBloomFilter> bloomFilter;
 
   template <typename T>
   void fillChunkStats(const T min, const T max, const bool has_nulls) {
@@ -21,6 +21,7 @@
 
 #include "DataMgr.h"
 #include "../CudaMgr/CudaMgr.h"
+#include "BufferPoolWarmer.h"
 #include "BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
 #include "BufferMgr/GpuCudaBufferMgr/GpuCudaBufferMgr.h"
 #include "FileMgr/GlobalFileMgr.h"
@@ -65,9 +66,19 @@ DataMgr::DataMgr(const string& dataDir,
 
   populateMgrs(mapd_parameters, numReaderThreads);
   createTopLevelMetadata();
+  if (mapd_parameters.enable_buffer_pool_warm_restart) {
+    bufferPoolWarmer_ = std::make_unique<BufferPoolWarmer>(
+        *this,
+        dataDir_ + "/buffer_pool_chunks",
+        mapd_parameters.buffer_pool_warm_restart_save_interval,
+        mapd_parameters.buffer_pool_warm_restart_max_mb_per_sec,
+        mapd_parameters.buffer_pool_warm_restart_max_pool_fill);
+  }
 }
 
 DataMgr::~DataMgr() {
+  // records the resident chunks, the buffer managers must still be there
+  bufferPoolWarmer_.reset();
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
     for (size_t device = 0; device < bufferMgrs_[level].size(); device++) {
@@ -98,7 +109,10 @@ size_t DataMgr::getTotalSystemMemory() {
 void DataMgr::populateMgrs(const MapDParameters& mapd_parameters,
                            const size_t userSpecifiedNumReaderThreads) {
   bufferMgrs_.resize(2);
-  bufferMgrs_[0].push_back(new GlobalFileMgr(0, dataDir_, userSpecifiedNumReaderThreads));
+  auto global_file_mgr = new GlobalFileMgr(0, dataDir_, userSpecifiedNumReaderThreads);
+  global_file_mgr->setReadBackend(
+      File_Namespace::parse_file_read_backend(mapd_parameters.file_read_backend));
+  bufferMgrs_[0].push_back(global_file_mgr);
   levelSizes_.push_back(1);
   size_t cpuBufferSize = mapd_parameters.cpu_buffer_mem_bytes;
   if (cpuBufferSize == 0) {  // if size is not specified
@@ -113,8 +127,11 @@ void DataMgr::populateMgrs(const MapDParameters& mapd_parameters,
     LOG(INFO) << "reserved GPU memory is " << (float)reservedGpuMem_ / (1024 * 1024)
               << "M includes render buffer allocation";
     bufferMgrs_.resize(3);
-    bufferMgrs_[1].push_back(new CpuBufferMgr(
-        0, cpuBufferSize, cudaMgr_.get(), cpuSlabSize, 512, bufferMgrs_[0][0]));
+    auto cpu_buffer_mgr = new CpuBufferMgr(
+        0, cpuBufferSize, cudaMgr_.get(), cpuSlabSize, 512, bufferMgrs_[0][0]);
+    cpu_buffer_mgr->setEvictionPolicy(
+        create_eviction_policy(mapd_parameters.buffer_eviction_policy));
+    bufferMgrs_[1].push_back(cpu_buffer_mgr);
     levelSizes_.push_back(1);
     int numGpus = cudaMgr_->getDeviceCount();
     for (int gpuNum = 0; gpuNum < numGpus; ++gpuNum) {
@@ -125,13 +142,19 @@ void DataMgr::populateMgrs(const MapDParameters& mapd_parameters,
       size_t gpuSlabSize = std::min(static_cast<size_t>(1L << 31), gpuMaxMemSize);
       gpuSlabSize -= gpuSlabSize % 512 == 0 ? 0 : 512 - (gpuSlabSize % 512);
       LOG(INFO) << "gpuSlabSize is " << (float)gpuSlabSize / (1024 * 1024) << "M";
-      bufferMgrs_[2].push_back(new GpuCudaBufferMgr(
-          gpuNum, gpuMaxMemSize, cudaMgr_.get(), gpuSlabSize, 512, bufferMgrs_[1][0]));
+      auto gpu_buffer_mgr = new GpuCudaBufferMgr(
+          gpuNum, gpuMaxMemSize, cudaMgr_.get(), gpuSlabSize, 512, bufferMgrs_[1][0]);
+      gpu_buffer_mgr->setEvictionPolicy(
+          create_eviction_policy(mapd_parameters.buffer_eviction_policy));
+      bufferMgrs_[2].push_back(gpu_buffer_mgr);
     }
     levelSizes_.push_back(numGpus);
   } else {
-    bufferMgrs_[1].push_back(new CpuBufferMgr(
-        0, cpuBufferSize, cudaMgr_.get(), cpuSlabSize, 512, bufferMgrs_[0][0]));
+    auto cpu_buffer_mgr = new CpuBufferMgr(
+        0, cpuBufferSize, cudaMgr_.get(), cpuSlabSize, 512, bufferMgrs_[0][0]);
+    cpu_buffer_mgr->setEvictionPolicy(
+        create_eviction_policy(mapd_parameters.buffer_eviction_policy));
+    bufferMgrs_[1].push_back(cpu_buffer_mgr);
     levelSizes_.push_back(1);
   }
 }
@@ -185,6 +208,8 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
     mi.maxNumPages = cpuBuffer->getMaxSize() / mi.pageSize;
     mi.isAllocationCapped = cpuBuffer->isAllocationCapped();
     mi.numPageAllocated = cpuBuffer->getAllocated() / mi.pageSize;
+    mi.evictionPolicy = cpuBuffer->getEvictionPolicyName();
+    mi.evictionPolicyStats = cpuBuffer->getEvictionPolicyStats();
 
     const std::vector<BufferList> slab_segments = cpuBuffer->getSlabSegments();
     size_t numSlabs = slab_segments.size();
@@ -214,6 +239,8 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
       mi.maxNumPages = gpuBuffer->getMaxSize() / mi.pageSize;
       mi.isAllocationCapped = gpuBuffer->isAllocationCapped();
       mi.numPageAllocated = gpuBuffer->getAllocated() / mi.pageSize;
+      mi.evictionPolicy = gpuBuffer->getEvictionPolicyName();
+      mi.evictionPolicyStats = gpuBuffer->getEvictionPolicyStats();
       const std::vector<BufferList> slab_segments = gpuBuffer->getSlabSegments();
       size_t numSlabs = slab_segments.size();
 
@@ -351,6 +378,14 @@ AbstractBuffer* DataMgr::getChunkBuffer(const ChunkKey& key,
   return bufferMgrs_[level][deviceId]->getBuffer(key, numBytes);
 }
 
+bool DataMgr::prefetchChunkBuffer(const ChunkKey& key,
+                                  const size_t numBytes,
+                                  const double maxFillFraction) {
+  auto cpu_buffer_mgr = dynamic_cast<BufferMgr*>(bufferMgrs_[MemoryLevel::CPU_LEVEL][0]);
+  CHECK(cpu_buffer_mgr);
+  return cpu_buffer_mgr->prefetchBuffer(key, numBytes, maxFillFraction);
+}
+
 void DataMgr::deleteChunksWithPrefix(const ChunkKey& keyPrefix) {
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
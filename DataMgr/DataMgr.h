@@ -32,6 +32,7 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,8 @@ class CudaMgr;
 
 namespace Data_Namespace {
 
+class BufferPoolWarmer;
+
 struct MemoryData {
   size_t slabNum;
   int32_t startPage;
@@ -61,10 +64,13 @@ struct MemoryInfo {
   size_t numPageAllocated;
   bool isAllocationCapped;
   std::vector<MemoryData> nodeMemoryData;
+  std::string evictionPolicy;
+  Buffer_Namespace::EvictionPolicyStats evictionPolicyStats;
 };
 
 class DataMgr {
   friend class GlobalFileMgr;
+  friend class BufferPoolWarmer;
 
  public:
   DataMgr(const std::string& dataDir,
@@ -84,6 +90,10 @@ class DataMgr {
                                  const MemoryLevel memoryLevel,
                                  const int deviceId = 0,
                                  const size_t numBytes = 0);
+  // loads a chunk into the CPU buffer pool ahead of use, see BufferMgr::prefetchBuffer
+  bool prefetchChunkBuffer(const ChunkKey& key,
+                           const size_t numBytes,
+                           const double maxFillFraction);
   void deleteChunksWithPrefix(const ChunkKey& keyPrefix);
   void deleteChunksWithPrefix(const ChunkKey& keyPrefix, const MemoryLevel memLevel);
   AbstractBuffer* alloc(const MemoryLevel memoryLevel,
@@ -135,6 +145,7 @@ class DataMgr {
   size_t reservedGpuMem_;
   std::map<ChunkKey, std::shared_ptr<mapd_shared_mutex>> chunkMutexMap_;
   mapd_shared_mutex chunkMutexMapMutex_;
+  std::unique_ptr<BufferPoolWarmer> bufferPoolWarmer_;
 };
 }  // namespace Data_Namespace
 
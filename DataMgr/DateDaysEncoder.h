@@ -42,6 +42,7 @@ class DateDaysEncoder : public Encoder {
     CHECK(ti.is_date_in_days());
     T* unencodedData = reinterpret_cast<T*>(srcData);
     auto encodedData = std::make_unique<V[]>(numAppendElems);
+    auto bloom_filter = bloomFilterForAppend();
     for (size_t i = 0; i < numAppendElems; ++i) {
       size_t ri = replicating ? 0 : i;
       if (unencodedData[ri] == std::numeric_limits<V>::min()) {
@@ -54,6 +55,9 @@ class DateDaysEncoder : public Encoder {
         const T data = DateConverters::get_epoch_seconds_from_days(encodedData.get()[i]);
         dataMax = std::max(dataMax, data);
         dataMin = std::min(dataMin, data);
+        if (bloom_filter) {
+          bloom_filter->add(static_cast<int64_t>(data));
+        }
       }
     }
     num_elems_ += numAppendElems;
@@ -103,7 +107,7 @@ class DateDaysEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const DateDaysEncoder<T, V>&>(that);
+    const auto& that_typed = static_cast<const DateDaysEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
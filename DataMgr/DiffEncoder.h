@@ -0,0 +1,203 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DIFF_ENCODER_H
+#define DIFF_ENCODER_H
+
+#include "Shared/EncodedChunkLayout.h"
+#include "Shared/Logger.h"
+
+#include <memory>
+#include <stdexcept>
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+
+/**
+ * @brief Stores the values of a chunk as differences of type V from a per chunk
+ * baseline, see EncodedChunkLayout.h. Sorted or clustered columns (timestamps, ids)
+ * fit in a fraction of their logical width while keeping random access.
+ */
+template <typename T, typename V>
+class DiffEncoder : public Encoder {
+ public:
+  DiffEncoder(Data_Namespace::AbstractBuffer* buffer)
+      : Encoder(buffer)
+      , dataMin(std::numeric_limits<T>::max())
+      , dataMax(std::numeric_limits<T>::min())
+      , has_nulls(false) {}
+
+  ChunkMetadata appendData(int8_t*& srcData,
+                           const size_t numAppendElems,
+                           const SQLTypeInfo& ti,
+                           const bool replicating = false) override {
+    T* unencodedData = reinterpret_cast<T*>(srcData);
+    int64_t baseline{0};
+    if (buffer_->size() > 0) {
+      buffer_->read(reinterpret_cast<int8_t*>(&baseline), DIFF_ENCODING_HEADER_SIZE);
+    }
+    // as long as the chunk only holds nulls, the baseline can still be moved to the
+    // first non-null value
+    bool rewrite_baseline = false;
+    if (dataMin > dataMax) {
+      for (size_t i = 0; i < numAppendElems; ++i) {
+        const auto data = unencodedData[replicating ? 0 : i];
+        if (data != inline_int_null_value<T>()) {
+          baseline = data;
+          rewrite_baseline = true;
+          break;
+        }
+      }
+    }
+    // encode everything before touching the buffer, an overflow leaves the chunk intact
+    auto encodedData = std::make_unique<V[]>(numAppendElems);
+    T new_min = dataMin;
+    T new_max = dataMax;
+    bool new_has_nulls = has_nulls;
+    // values added before an overflow only make the filter less selective
+    auto bloom_filter = bloomFilterForAppend();
+    for (size_t i = 0; i < numAppendElems; ++i) {
+      const T data = unencodedData[replicating ? 0 : i];
+      if (data == inline_int_null_value<T>()) {
+        new_has_nulls = true;
+        encodedData.get()[i] = std::numeric_limits<V>::min();
+        continue;
+      }
+      decimal_overflow_validator_.validate(data);
+      int64_t diff;
+      if (__builtin_sub_overflow(static_cast<int64_t>(data), baseline, &diff) ||
+          diff <= std::numeric_limits<V>::min() || diff > std::numeric_limits<V>::max()) {
+        throw std::runtime_error("Diff encoding overflow: value " + std::to_string(data) +
+                                 " is too far from the chunk baseline " +
+                                 std::to_string(baseline) + " for DIFF(" +
+                                 std::to_string(sizeof(V) * 8) + ") encoding");
+      }
+      encodedData.get()[i] = static_cast<V>(diff);
+      new_min = std::min(new_min, data);
+      new_max = std::max(new_max, data);
+      if (bloom_filter) {
+        bloom_filter->add(static_cast<int64_t>(data));
+      }
+    }
+    if (buffer_->size() == 0) {
+      buffer_->append(reinterpret_cast<int8_t*>(&baseline), DIFF_ENCODING_HEADER_SIZE);
+    } else if (rewrite_baseline) {
+      buffer_->write(reinterpret_cast<int8_t*>(&baseline), DIFF_ENCODING_HEADER_SIZE, 0);
+    }
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = new_has_nulls;
+    num_elems_ += numAppendElems;
+
+    buffer_->append((int8_t*)(encodedData.get()), numAppendElems * sizeof(V));
+    ChunkMetadata chunkMetadata;
+    getMetadata(chunkMetadata);
+    if (!replicating) {
+      srcData += numAppendElems * sizeof(T);
+    }
+    return chunkMetadata;
+  }
+
+  void getMetadata(ChunkMetadata& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata.fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  ChunkMetadata getMetadata(const SQLTypeInfo& ti) override {
+    ChunkMetadata chunk_metadata{ti, 0, 0, ChunkStats{}};
+    chunk_metadata.fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto& that_typed = static_cast<const DiffEncoder<T, V>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const DiffEncoder<T, V>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+};  // DiffEncoder
+
+#endif  // DIFF_ENCODER_H
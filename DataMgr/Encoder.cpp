@@ -17,12 +17,16 @@
 #include "Encoder.h"
 #include "ArrayNoneEncoder.h"
 #include "DateDaysEncoder.h"
+#include "DiffEncoder.h"
 #include "FixedLengthArrayNoneEncoder.h"
 #include "FixedLengthEncoder.h"
 #include "NoneEncoder.h"
+#include "RunLengthEncoder.h"
 #include "Shared/Logger.h"
 #include "StringNoneEncoder.h"
 
+bool g_enable_chunk_bloom_filters{false};
+
 Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
                          const SQLTypeInfo sqlType) {
   switch (sqlType.get_compression()) {
@@ -171,6 +175,78 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
       }  // switch (sqlType)
       break;
     }  // Case: kENCODING_FIXED
+    case kENCODING_RL: {
+      switch (sqlType.get_type()) {
+        case kBOOLEAN:
+        case kTINYINT:
+          return new RunLengthEncoder<int8_t>(buffer);
+        case kSMALLINT:
+          return new RunLengthEncoder<int16_t>(buffer);
+        case kINT:
+          return new RunLengthEncoder<int32_t>(buffer);
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new RunLengthEncoder<int64_t>(buffer);
+        default: {
+          return 0;
+        }
+      }
+      break;
+    }
+    case kENCODING_DIFF: {
+      // the parser validates the width, fail the statement rather than the server on a
+      // column descriptor which bypassed it, e.g. restored from a dump
+      const auto unsupported_diff_width = [&sqlType]() {
+        return std::runtime_error("DIFF(" + std::to_string(sqlType.get_comp_param()) +
+                                  ") encoding is not supported for " +
+                                  sqlType.get_type_name() + " columns.");
+      };
+      switch (sqlType.get_type()) {
+        case kSMALLINT: {
+          switch (sqlType.get_comp_param()) {
+            case 8:
+              return new DiffEncoder<int16_t, int8_t>(buffer);
+            default:
+              throw unsupported_diff_width();
+          }
+        }
+        case kINT: {
+          switch (sqlType.get_comp_param()) {
+            case 8:
+              return new DiffEncoder<int32_t, int8_t>(buffer);
+            case 16:
+              return new DiffEncoder<int32_t, int16_t>(buffer);
+            default:
+              throw unsupported_diff_width();
+          }
+        }
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE: {
+          switch (sqlType.get_comp_param()) {
+            case 8:
+              return new DiffEncoder<int64_t, int8_t>(buffer);
+            case 16:
+              return new DiffEncoder<int64_t, int16_t>(buffer);
+            case 32:
+              return new DiffEncoder<int64_t, int32_t>(buffer);
+            default:
+              throw unsupported_diff_width();
+          }
+        }
+        default: {
+          return 0;
+        }
+      }
+      break;
+    }
     case kENCODING_DICT: {
       if (sqlType.get_type() == kARRAY) {
         CHECK(IS_STRING(sqlType.get_subtype()));
@@ -222,11 +298,56 @@ Encoder::Encoder(Data_Namespace::AbstractBuffer* buffer)
     : num_elems_(0)
     , buffer_(buffer)
     , decimal_overflow_validator_(buffer ? buffer->sql_type : SQLTypeInfo())
-    , date_days_overflow_validator_(buffer ? buffer->sql_type : SQLTypeInfo()){};
+    , date_days_overflow_validator_(buffer ? buffer->sql_type : SQLTypeInfo()) {
+  if (buffer && g_enable_chunk_bloom_filters &&
+      ChunkBloomFilter::supportsType(buffer->sql_type)) {
+    bloom_filter_ = std::make_shared<ChunkBloomFilter>();
+  }
+}
 
 void Encoder::getMetadata(ChunkMetadata& chunkMetadata) {
   // chunkMetadata = metadataTemplate_; // invoke copy constructor
   chunkMetadata.sqlType = buffer_->sql_type;
   chunkMetadata.numBytes = buffer_->size();
   chunkMetadata.numElements = num_elems_;
+  chunkMetadata.bloomFilter = getBloomFilter();
+}
+
+std::shared_ptr<ChunkBloomFilter> Encoder::bloomFilterForAppend() {
+  std::lock_guard<std::mutex> bloom_filter_lock(bloom_filter_mutex_);
+  return bloom_filter_;
+}
+
+bool Encoder::hasBloomFilter() const {
+  std::lock_guard<std::mutex> bloom_filter_lock(bloom_filter_mutex_);
+  return bloom_filter_ != nullptr;
+}
+
+void Encoder::writeBloomFilter(FILE* f) const {
+  std::lock_guard<std::mutex> bloom_filter_lock(bloom_filter_mutex_);
+  CHECK(bloom_filter_);
+  bloom_filter_->write(f);
+}
+
+void Encoder::readBloomFilter(FILE* f) {
+  auto bloom_filter = std::make_shared<ChunkBloomFilter>();
+  bloom_filter->read(f);
+  std::lock_guard<std::mutex> bloom_filter_lock(bloom_filter_mutex_);
+  bloom_filter_ = bloom_filter;
+}
+
+void Encoder::copyBloomFilter(const Encoder& that) {
+  const auto bloom_filter = that.getBloomFilter();
+  std::lock_guard<std::mutex> bloom_filter_lock(bloom_filter_mutex_);
+  bloom_filter_ = bloom_filter;
+}
+
+void Encoder::dropBloomFilter() {
+  std::lock_guard<std::mutex> bloom_filter_lock(bloom_filter_mutex_);
+  bloom_filter_.reset();
+}
+
+std::shared_ptr<ChunkBloomFilter> Encoder::getBloomFilter() const {
+  std::lock_guard<std::mutex> bloom_filter_lock(bloom_filter_mutex_);
+  return bloom_filter_;
 }
@@ -25,6 +25,8 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -35,6 +37,8 @@ class AbstractBuffer;
 // default max input buffer size to 1MB
 #define MAX_INPUT_BUF_SIZE 1048576
 
+extern bool g_enable_chunk_bloom_filters;
+
 class DecimalOverflowValidator {
  public:
   DecimalOverflowValidator(SQLTypeInfo type) {
@@ -175,7 +179,20 @@ class Encoder {
   size_t getNumElems() const { return num_elems_; }
   void setNumElems(const size_t num_elems) { num_elems_ = num_elems; }
 
+  // The bloom filter goes after the encoder specific metadata, in the same page.
+  bool hasBloomFilter() const;
+  void writeBloomFilter(FILE* f) const;
+  void readBloomFilter(FILE* f);
+  void copyBloomFilter(const Encoder& that);
+  // Stops filtering for the chunk, e.g. once values have been updated in place.
+  void dropBloomFilter();
+
  protected:
+  // Returns the bloom filter to add the appended values to, null if the chunk has none.
+  // The values are added in place, the metadata handed out before shares the filter and
+  // only gains values.
+  std::shared_ptr<ChunkBloomFilter> bloomFilterForAppend();
+
   size_t num_elems_;
 
   Data_Namespace::AbstractBuffer* buffer_;
@@ -183,6 +200,12 @@ class Encoder {
 
   DecimalOverflowValidator decimal_overflow_validator_;
   DateDaysOverflowValidator date_days_overflow_validator_;
+
+ private:
+  std::shared_ptr<ChunkBloomFilter> getBloomFilter() const;
+
+  std::shared_ptr<ChunkBloomFilter> bloom_filter_;
+  mutable std::mutex bloom_filter_mutex_;  // guards bloom_filter_, not its bits
 };
 
 #endif  // Encoder_h
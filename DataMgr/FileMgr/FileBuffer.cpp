@@ -202,33 +202,41 @@ static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS)
   size_t totalBytesRead = 0;
   bool isFirstPage = threadDS.t_isFirstPage;
 
-  // Traverse the logical pages
-  for (size_t pageNum = startPage; pageNum < endPage; ++pageNum) {
+  // Traverse the logical pages, reading each run of pages that are consecutive within
+  // the same file with a single call
+  size_t pageNum = startPage;
+  while (pageNum < endPage) {
     CHECK(threadDS.multiPages[pageNum].pageSize == fileBuffer->pageSize());
     Page page = threadDS.multiPages[pageNum].current();
 
+    size_t numPagesInRun = 1;
+    while (pageNum + numPagesInRun < endPage) {
+      Page nextPage = threadDS.multiPages[pageNum + numPagesInRun].current();
+      if (nextPage.fileId != page.fileId ||
+          nextPage.pageNum != page.pageNum + numPagesInRun) {
+        break;
+      }
+      ++numPagesInRun;
+    }
+
     FileInfo* fileInfo = threadDS.t_fm->getFileInfoForFileId(page.fileId);
     CHECK(fileInfo);
 
-    // Read the page into the destination (dst) buffer at its
+    // Read the pages into the destination (dst) buffer at its
     // current (cur) location
-    size_t bytesRead = 0;
-    if (isFirstPage) {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset +
-              fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize() - threadDS.t_startPageOffset, bytesLeft),
-          curPtr);
-      isFirstPage = false;
-    } else {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize(), bytesLeft),
-          curPtr);
-    }
+    const size_t startPageOffset = isFirstPage ? threadDS.t_startPageOffset : 0;
+    isFirstPage = false;
+    size_t bytesRead = fileInfo->readPageData(
+        page.pageNum,
+        numPagesInRun,
+        fileBuffer->reservedHeaderSize(),
+        startPageOffset,
+        min(numPagesInRun * fileBuffer->pageDataSize() - startPageOffset, bytesLeft),
+        curPtr);
     curPtr += bytesRead;
     bytesLeft -= bytesRead;
     totalBytesRead += bytesRead;
+    pageNum += numPagesInRun;
   }
   CHECK(bytesLeft == 0);
 
@@ -344,7 +352,7 @@ void FileBuffer::copyPage(Page& srcPage,
                           const size_t offset) {
   // FILE *srcFile = fm_->files_[srcPage.fileId]->f;
   // FILE *destFile = fm_->files_[destPage.fileId]->f;
-  CHECK(offset + numBytes < pageDataSize_);
+  CHECK_LE(offset + numBytes, pageDataSize_);
   FileInfo* srcFileInfo = fm_->getFileInfoForFileId(srcPage.fileId);
   FileInfo* destFileInfo = fm_->getFileInfoForFileId(destPage.fileId);
 
@@ -395,7 +403,8 @@ void FileBuffer::readMetadata(const Page& page) {
                                        // encodingType, encodingBits all as int
   fread((int8_t*)&(typeData[0]), sizeof(int), typeData.size(), f);
   int version = typeData[0];
-  CHECK(version == METADATA_VERSION);  // add backward compatibility code here
+  // add backward compatibility code here
+  CHECK(version == METADATA_VERSION || version == METADATA_VERSION_BLOOM_FILTER);
   has_encoder = static_cast<bool>(typeData[1]);
   if (has_encoder) {
     sql_type.set_type(static_cast<SQLTypes>(typeData[2]));
@@ -408,6 +417,12 @@ void FileBuffer::readMetadata(const Page& page) {
     sql_type.set_size(typeData[9]);
     initEncoder(sql_type);
     encoder->readMetadata(f);
+    if (version == METADATA_VERSION_BLOOM_FILTER) {
+      encoder->readBloomFilter(f);
+    } else {
+      // the chunk was written without a filter, an empty one would exclude every value
+      encoder->dropBloomFilter();
+    }
   }
 }
 
@@ -422,7 +437,9 @@ void FileBuffer::writeMetadata(const int epoch) {
   fwrite((int8_t*)&size_, sizeof(size_t), 1, f);
   vector<int> typeData(NUM_METADATA);  // assumes we will encode hasEncoder, bufferType,
                                        // encodingType, encodingBits all as int
-  typeData[0] = METADATA_VERSION;
+  // chunks without a bloom filter stay readable by servers which predate them
+  const bool has_bloom_filter = has_encoder && encoder->hasBloomFilter();
+  typeData[0] = has_bloom_filter ? METADATA_VERSION_BLOOM_FILTER : METADATA_VERSION;
   typeData[1] = static_cast<int>(has_encoder);
   if (has_encoder) {
     typeData[2] = static_cast<int>(sql_type.get_type());
@@ -438,6 +455,9 @@ void FileBuffer::writeMetadata(const int epoch) {
   if (has_encoder) {  // redundant
     encoder->writeMetadata(f);
   }
+  if (has_bloom_filter) {
+    encoder->writeBloomFilter(f);
+  }
   metadataPages_.epochs.push_back(epoch);
   metadataPages_.pageVersions.push_back(page);
 }
@@ -512,6 +532,7 @@ void FileBuffer::write(int8_t* src,
     is_updated_ = true;
   }
   bool tempIsAppended = false;
+  const size_t initialSize = size_;
 
   if (offset + numBytes > size_) {
     tempIsAppended = true;  // because is_appended_ could have already been true - to
@@ -554,13 +575,12 @@ void FileBuffer::write(int8_t* src,
         // about it
         copyPage(lastPage, page, startPageOffset, 0);
       }
-      if (pageNum == startPage + numPagesToWrite &&
-          bytesLeft > 0) {  // bytesLeft should always > 0
-        copyPage(lastPage,
-                 page,
-                 pageDataSize_ - bytesLeft,
-                 bytesLeft);  // these would be empty if we're appending but we won't
-                              // worry about it right now
+      // keep the rest of the last page when only part of the chunk is rewritten
+      const size_t pageWriteBegin = pageNum == startPage ? startPageOffset : 0;
+      const size_t pageWriteEnd =
+          pageWriteBegin + std::min(pageDataSize_ - pageWriteBegin, bytesLeft);
+      if (pageWriteEnd < pageDataSize_ && offset + numBytes < initialSize) {
+        copyPage(lastPage, page, pageDataSize_ - pageWriteEnd, pageWriteEnd);
       }
       writeHeader(page, pageNum, epoch);
     } else {
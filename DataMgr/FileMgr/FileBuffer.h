@@ -34,6 +34,7 @@ using namespace Data_Namespace;
 
 #define NUM_METADATA 10
 #define METADATA_VERSION 0
+#define METADATA_VERSION_BLOOM_FILTER 1  // the chunk bloom filter follows the encoder
 
 namespace File_Namespace {
 
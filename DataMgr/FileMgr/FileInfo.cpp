@@ -15,7 +15,11 @@
  */
 
 #include "FileInfo.h"
+#include <unistd.h>
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include "../../Shared/File.h"
 #include "FileMgr.h"
 #include "Page.h"
@@ -25,13 +29,36 @@ using namespace std;
 
 namespace File_Namespace {
 
+namespace {
+
+// Upper bound on the bounce buffer used for a single direct read
+constexpr size_t kMaxDirectReadSize{32 * 1024 * 1024};
+
+}  // namespace
+
+FileReadBackend parse_file_read_backend(const std::string& name) {
+  if (name == "buffered") {
+    return FileReadBackend::BUFFERED;
+  }
+  if (name == "direct") {
+    return FileReadBackend::DIRECT;
+  }
+  throw std::runtime_error("Unknown file read backend '" + name +
+                           "'. Supported backends are 'buffered' and 'direct'.");
+}
+
 FileInfo::FileInfo(FileMgr* fileMgr,
                    const int fileId,
                    FILE* f,
                    const size_t pageSize,
                    size_t numPages,
                    bool init)
-    : fileMgr(fileMgr), fileId(fileId), f(f), pageSize(pageSize), numPages(numPages) {
+    : fileMgr(fileMgr)
+    , fileId(fileId)
+    , f(f)
+    , directFd(-1)
+    , pageSize(pageSize)
+    , numPages(numPages) {
   if (init) {
     initNewFile();
   }
@@ -42,6 +69,9 @@ FileInfo::~FileInfo() {
   if (f) {
     close(f);
   }
+  if (directFd >= 0) {
+    ::close(directFd);
+  }
 }
 
 void FileInfo::initNewFile() {
@@ -66,6 +96,68 @@ size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
   return File_Namespace::read(f, offset, size, buf);
 }
 
+bool FileInfo::enableDirectReads(const std::string& path) {
+  CHECK_LT(directFd, 0);
+  if (pageSize % DIRECT_IO_ALIGNMENT != 0) {
+    LOG(WARNING) << "Page size " << pageSize << " of file " << path
+                 << " is not a multiple of " << DIRECT_IO_ALIGNMENT
+                 << " bytes, falling back to buffered reads";
+    return false;
+  }
+  directFd = openDirect(path);
+  return directFd >= 0;
+}
+
+size_t FileInfo::readPageData(const size_t pageNum,
+                              const size_t numPages,
+                              const size_t headerSize,
+                              const size_t startOffset,
+                              const size_t size,
+                              int8_t* buf) {
+  const size_t pageDataSize = pageSize - headerSize;
+  CHECK_LE(startOffset + size, numPages * pageDataSize);
+  size_t bytesRead = 0;
+  size_t pageOffset = startOffset;
+  if (directFd < 0) {
+    for (size_t i = 0; i < numPages && bytesRead < size; ++i) {
+      bytesRead += read((pageNum + i) * pageSize + headerSize + pageOffset,
+                        std::min(pageDataSize - pageOffset, size - bytesRead),
+                        buf + bytesRead);
+      pageOffset = 0;
+    }
+    return bytesRead;
+  }
+
+  {
+    // Pages written through the file stream may still be in its buffer
+    std::lock_guard<std::mutex> lock(readWriteMutex_);
+    CHECK_EQ(fflush(f), 0);
+  }
+  const size_t maxPagesPerRead = std::max(kMaxDirectReadSize / pageSize, size_t(1));
+  const size_t pagesPerRead = std::min(maxPagesPerRead, numPages);
+  void* alignedBuf{nullptr};
+  CHECK_EQ(posix_memalign(&alignedBuf, DIRECT_IO_ALIGNMENT, pagesPerRead * pageSize), 0);
+  std::unique_ptr<int8_t, decltype(&free)> pageBuf(static_cast<int8_t*>(alignedBuf),
+                                                   &free);
+  for (size_t firstPage = 0; firstPage < numPages && bytesRead < size;
+       firstPage += pagesPerRead) {
+    const size_t numPagesToRead = std::min(pagesPerRead, numPages - firstPage);
+    readDirect(directFd,
+               (pageNum + firstPage) * pageSize,
+               numPagesToRead * pageSize,
+               pageBuf.get());
+    for (size_t i = 0; i < numPagesToRead && bytesRead < size; ++i) {
+      const size_t numBytes = std::min(pageDataSize - pageOffset, size - bytesRead);
+      memcpy(buf + bytesRead,
+             pageBuf.get() + i * pageSize + headerSize + pageOffset,
+             numBytes);
+      bytesRead += numBytes;
+      pageOffset = 0;
+    }
+  }
+  return bytesRead;
+}
+
 void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec,
                                 const int fileMgrEpoch) {
   // HeaderInfo is defined in Page.h
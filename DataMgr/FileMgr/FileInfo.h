@@ -22,6 +22,7 @@
 #include <cstring>
 #include <mutex>
 #include <set>
+#include <string>
 #include <vector>
 #include "../../Shared/types.h"
 #include "Page.h"
@@ -47,11 +48,24 @@ struct Page;
  */
 #define DELETE_CONTINGENT (-1)
 
+/**
+ * @type FileReadBackend
+ * @brief How FileInfo reads page data from disk.
+ *
+ * BUFFERED goes through the file stream and the OS page cache. DIRECT bypasses the page
+ * cache with O_DIRECT, so data pages are only cached once, in the buffer pool, and reads
+ * runs of consecutive pages with a single aligned request.
+ */
+enum class FileReadBackend { BUFFERED, DIRECT };
+
+FileReadBackend parse_file_read_backend(const std::string& name);
+
 class FileMgr;
 struct FileInfo {
   FileMgr* fileMgr;
   int fileId;       /// unique file identifier (i.e., used for a file name)
   FILE* f;          /// file stream object for the represented file
+  int directFd;     /// O_DIRECT descriptor for page data reads, -1 if reads are buffered
   size_t pageSize;  /// the fixed size of each page in the file
   size_t numPages;  /// the number of pages in the file
   // std::vector<Page*> pages;			/// Page pointers for each page (including
@@ -81,6 +95,19 @@ struct FileInfo {
   size_t write(const size_t offset, const size_t size, int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
 
+  /// Switches page data reads to direct I/O, if the file system supports it
+  bool enableDirectReads(const std::string& path);
+
+  /// Reads the data of numPages consecutive pages starting at pageNum, skipping the
+  /// headerSize bytes at the start of each page and startOffset more bytes of the first
+  /// page, until size bytes have been copied to buf
+  size_t readPageData(const size_t pageNum,
+                      const size_t numPages,
+                      const size_t headerSize,
+                      const size_t startOffset,
+                      const size_t size,
+                      int8_t* buf);
+
   void openExistingFile(std::vector<HeaderInfo>& headerVec, const int fileMgrEpoch);
   /// Prints a summary of the file to stdout
   void print(bool pagesummary);
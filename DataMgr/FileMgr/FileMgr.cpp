@@ -25,12 +25,14 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cstring>
 #include <future>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include <boost/crc.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/system/error_code.hpp>
@@ -41,11 +43,69 @@
 
 #define EPOCH_FILENAME "epoch"
 #define DB_META_FILENAME "dbmeta"
+#define CHUNK_INDEX_SNAPSHOT_FILENAME "chunk_index"
+
+bool g_enable_chunk_index_snapshot{false};
 
 using namespace std;
 
 namespace File_Namespace {
 
+namespace {
+
+constexpr int32_t CHUNK_INDEX_SNAPSHOT_VERSION{1};
+
+template <typename T>
+void append_value(std::vector<int8_t>& buf, const T val) {
+  const auto val_ptr = reinterpret_cast<const int8_t*>(&val);
+  buf.insert(buf.end(), val_ptr, val_ptr + sizeof(T));
+}
+
+// Reads the values appended by append_value, fails past the end of the buffer.
+class SnapshotReader {
+ public:
+  SnapshotReader(const std::vector<int8_t>& buf, const size_t size)
+      : buf_(buf), size_(size), pos_(0) {}
+
+  template <typename T>
+  bool read(T& val) {
+    if (pos_ + sizeof(T) > size_) {
+      return false;
+    }
+    memcpy(&val, &buf_[pos_], sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool atEnd() const { return pos_ == size_; }
+
+ private:
+  const std::vector<int8_t>& buf_;
+  const size_t size_;
+  size_t pos_;
+};
+
+uint32_t get_checksum(const std::vector<int8_t>& buf, const size_t size) {
+  boost::crc_32_type crc;
+  crc.process_bytes(buf.data(), size);
+  return crc.checksum();
+}
+
+void sync_directory(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(WARNING) << "Could not open directory '" << path
+                 << "' to sync it: " << std::strerror(errno);
+    return;
+  }
+  if (fsync(fd) != 0) {
+    LOG(WARNING) << "Could not sync directory '" << path << "': " << std::strerror(errno);
+  }
+  ::close(fd);
+}
+
+}  // namespace
+
 bool headerCompare(const HeaderInfo& firstElem, const HeaderInfo& secondElem) {
   // HeaderInfo.first is a pair of Chunk key with a vector containing
   // pageId and version
@@ -150,7 +210,7 @@ void FileMgr::init(const size_t num_reader_threads) {
     int fileCount = 0;
     int threadCount = std::thread::hardware_concurrency();
     std::vector<HeaderInfo> headerVec;
-    std::vector<std::future<std::vector<HeaderInfo>>> file_futures;
+    std::vector<FileMetadata> fileMetadataVec;
     for (boost::filesystem::directory_iterator fileIt(path); fileIt != endItr; ++fileIt) {
       if (boost::filesystem::is_regular_file(fileIt->status())) {
         // note that boost::filesystem leaves preceding dot on
@@ -182,28 +242,46 @@ void FileMgr::init(const size_t num_reader_threads) {
           VLOG(4) << "File id: " << fileId << " Page size: " << pageSize
                   << " Num pages: " << numPages;
 
-          file_futures.emplace_back(std::async(
-              std::launch::async, [filePath, fileId, pageSize, numPages, this] {
-                std::vector<HeaderInfo> tempHeaderVec;
-                openExistingFile(filePath, fileId, pageSize, numPages, tempHeaderVec);
-                return tempHeaderVec;
-              }));
+          fileMetadataVec.push_back({filePath, fileId, pageSize, numPages});
           fileCount++;
-          if (fileCount % threadCount == 0) {
-            processFileFutures(file_futures, headerVec);
-          }
         }
       }
     }
 
-    if (file_futures.size() > 0) {
-      processFileFutures(file_futures, headerVec);
+    const bool readSnapshot = g_enable_chunk_index_snapshot &&
+                              readChunkIndexSnapshot(fileMetadataVec, headerVec);
+    if (!readSnapshot) {
+      // a stale snapshot must not be found again once the table gets back to the epoch
+      // it was written at, after a rollback
+      removeChunkIndexSnapshot();
+      std::vector<std::future<std::vector<HeaderInfo>>> file_futures;
+      for (const auto& fileMetadata : fileMetadataVec) {
+        file_futures.emplace_back(
+            std::async(std::launch::async, [fileMetadata, this] {
+              std::vector<HeaderInfo> tempHeaderVec;
+              openExistingFile(fileMetadata.filePath,
+                               fileMetadata.fileId,
+                               fileMetadata.pageSize,
+                               fileMetadata.numPages,
+                               tempHeaderVec);
+              return tempHeaderVec;
+            }));
+        if (file_futures.size() % threadCount == 0) {
+          processFileFutures(file_futures, headerVec);
+        }
+      }
+
+      if (file_futures.size() > 0) {
+        processFileFutures(file_futures, headerVec);
+      }
     }
     int64_t queue_time_ms = timer_stop(clock_begin);
 
-    LOG(INFO) << "Completed Reading table's file metadata, Elapsed time : "
-              << queue_time_ms << "ms Epoch: " << epoch_ << " files read: " << fileCount
-              << " table location: '" << fileMgrBasePath_ << "'";
+    LOG(INFO) << "Completed Reading table's file metadata"
+              << (readSnapshot ? " from the chunk index snapshot" : "")
+              << ", Elapsed time : " << queue_time_ms << "ms Epoch: " << epoch_
+              << " files read: " << fileCount << " table location: '"
+              << fileMgrBasePath_ << "'";
 
     /* Sort headerVec so that all HeaderInfos
      * from a chunk will be grouped together
@@ -606,6 +684,11 @@ void FileMgr::checkpoint() {
     free_page.first->freePageDeferred(free_page.second);
   }
   free_pages.clear();
+  freePagesWriteLock.unlock();
+
+  if (g_enable_chunk_index_snapshot) {
+    writeChunkIndexSnapshot();
+  }
 }
 
 AbstractBuffer* FileMgr::createBuffer(const ChunkKey& key,
@@ -634,6 +717,7 @@ bool FileMgr::isBufferOnDevice(const ChunkKey& key) {
 }
 
 void FileMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
+  invalidateChunkIndexSnapshot();
   mapd_unique_lock<mapd_shared_mutex> chunkIndexWriteLock(chunkIndexMutex_);
   auto chunkIt = chunkIndex_.find(key);
   // ensure the Chunk exists
@@ -651,6 +735,7 @@ void FileMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
 }
 
 void FileMgr::deleteBuffersWithPrefix(const ChunkKey& keyPrefix, const bool purge) {
+  invalidateChunkIndexSnapshot();
   mapd_unique_lock<mapd_shared_mutex> chunkIndexWriteLock(chunkIndexMutex_);
   auto chunkIt = chunkIndex_.lower_bound(keyPrefix);
   if (chunkIt == chunkIndex_.end()) {
@@ -765,13 +850,33 @@ AbstractBuffer* FileMgr::putBuffer(const ChunkKey& key,
     if (0 == numBytes && !chunk->isDirty()) {
       chunk->setSize(newChunkSize);
     }
-    //@todo use dirty flags to only flush pages of chunk that need to
-    // be flushed
-    chunk->write((int8_t*)srcBuffer->getMemoryPtr(),
-                 newChunkSize,
-                 0,
-                 srcBuffer->getType(),
-                 srcBuffer->getDeviceId());
+    const auto& updatedRanges = srcBuffer->getUpdatedRanges();
+    if (!updatedRanges.empty() && newChunkSize == oldChunkSize) {
+      // rows updated in place, only the pages holding them get a new version
+      auto rangeIt = updatedRanges.begin();
+      while (rangeIt != updatedRanges.end()) {
+        const size_t begin = rangeIt->first;
+        size_t end = rangeIt->second;
+        // ranges a page apart at most share pages, write them at once
+        for (++rangeIt; rangeIt != updatedRanges.end() &&
+                        rangeIt->first < end + chunk->pageSize();
+             ++rangeIt) {
+          end = rangeIt->second;
+        }
+        CHECK_LE(end, newChunkSize);
+        chunk->write((int8_t*)srcBuffer->getMemoryPtr() + begin,
+                     end - begin,
+                     begin,
+                     srcBuffer->getType(),
+                     srcBuffer->getDeviceId());
+      }
+    } else {
+      chunk->write((int8_t*)srcBuffer->getMemoryPtr(),
+                   newChunkSize,
+                   0,
+                   srcBuffer->getType(),
+                   srcBuffer->getDeviceId());
+    }
   } else if (srcBuffer->isAppended()) {
     CHECK_LT(oldChunkSize, newChunkSize);
     chunk->append((int8_t*)srcBuffer->getMemoryPtr() + oldChunkSize,
@@ -797,6 +902,7 @@ void FileMgr::free(AbstractBuffer* buffer) {
 }
 
 Page FileMgr::requestFreePage(size_t pageSize, const bool isMetadata) {
+  invalidateChunkIndexSnapshot();
   std::lock_guard<std::mutex> lock(getPageMutex_);
 
   auto candidateFiles = fileIndex_.equal_range(pageSize);
@@ -826,6 +932,7 @@ void FileMgr::requestFreePages(size_t numPagesRequested,
                                const bool isMetadata) {
   // not used currently
   // @todo add method to FileInfo to get more than one page
+  invalidateChunkIndexSnapshot();
   std::lock_guard<std::mutex> lock(getPageMutex_);
   auto candidateFiles = fileIndex_.equal_range(pageSize);
   size_t numPagesNeeded = numPagesRequested;
@@ -873,6 +980,9 @@ FileInfo* FileMgr::openExistingFile(const std::string& path,
   FILE* f = open(path);
   FileInfo* fInfo = new FileInfo(
       this, fileId, f, pageSize, numPages, false);  // false means don't init file
+  if (gfm_ && gfm_->getReadBackend() == FileReadBackend::DIRECT) {
+    fInfo->enableDirectReads(path);
+  }
 
   fInfo->openExistingFile(headerVec, epoch_);
   mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
@@ -903,6 +1013,10 @@ FileInfo* FileMgr::createFile(const size_t pageSize, const size_t numPages) {
   FileInfo* fInfo =
       new FileInfo(this, fileId, f, pageSize, numPages, true);  // true means init file
   CHECK(fInfo);
+  if (gfm_ && gfm_->getReadBackend() == FileReadBackend::DIRECT) {
+    fInfo->enableDirectReads(fileMgrBasePath_ + "/" + std::to_string(fileId) + "." +
+                             std::to_string(pageSize) + std::string(MAPD_FILE_EXT));
+  }
 
   mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
   // update file manager data structures
@@ -995,8 +1109,269 @@ void FileMgr::setEpoch(int epoch) {
 }
 
 void FileMgr::free_page(std::pair<FileInfo*, int>&& page) {
+  invalidateChunkIndexSnapshot();
   std::unique_lock<mapd_shared_mutex> lock(mutex_free_page);
   free_pages.push_back(page);
 }
 
+/*
+ * Snapshot layout, all values in host byte order:
+ *   version, epoch
+ *   file count, then for each file: id, page size, page count, free page count and
+ *     the free page numbers
+ *   header count, then for each header: chunk key size and ints, page id, version
+ *     epoch, file id and page number
+ *   CRC32 of all of the above
+ */
+void FileMgr::writeChunkIndexSnapshot() {
+  std::unique_lock<std::mutex> snapshotLock(chunkIndexSnapshotMutex_);
+  pagesChangedSinceSnapshot_ = false;
+  snapshotLock.unlock();
+
+  std::vector<int8_t> buf;
+  append_value(buf, CHUNK_INDEX_SNAPSHOT_VERSION);
+  append_value(buf, static_cast<int32_t>(epoch_));
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
+    const auto fileCount = std::count_if(
+        files_.begin(), files_.end(), [](const FileInfo* f) { return f != nullptr; });
+    append_value(buf, static_cast<uint64_t>(fileCount));
+    for (auto fileInfo : files_) {
+      if (!fileInfo) {
+        continue;
+      }
+      std::lock_guard<std::mutex> freePagesLock(fileInfo->freePagesMutex_);
+      append_value(buf, static_cast<int32_t>(fileInfo->fileId));
+      append_value(buf, static_cast<uint64_t>(fileInfo->pageSize));
+      append_value(buf, static_cast<uint64_t>(fileInfo->numPages));
+      append_value(buf, static_cast<uint64_t>(fileInfo->freePages.size()));
+      for (const auto pageNum : fileInfo->freePages) {
+        append_value(buf, static_cast<uint64_t>(pageNum));
+      }
+    }
+  }
+  {
+    std::vector<int8_t> headerBuf;
+    uint64_t headerCount{0};
+    auto appendHeaders = [this, &headerBuf, &headerCount](
+                             const ChunkKey& chunkKey,
+                             const int pageId,
+                             const MultiPage& multiPage) {
+      for (size_t i = 0; i < multiPage.pageVersions.size(); ++i) {
+        // written by a concurrent load after the epoch was, the header scan would drop
+        // this page
+        if (multiPage.epochs[i] >= epoch_) {
+          return false;
+        }
+        append_value(headerBuf, static_cast<int32_t>(chunkKey.size()));
+        for (const auto keyElem : chunkKey) {
+          append_value(headerBuf, static_cast<int32_t>(keyElem));
+        }
+        append_value(headerBuf, static_cast<int32_t>(pageId));
+        append_value(headerBuf, static_cast<int32_t>(multiPage.epochs[i]));
+        append_value(headerBuf, static_cast<int32_t>(multiPage.pageVersions[i].fileId));
+        append_value(headerBuf, static_cast<uint64_t>(multiPage.pageVersions[i].pageNum));
+        ++headerCount;
+      }
+      return true;
+    };
+    mapd_shared_lock<mapd_shared_mutex> chunkIndexReadLock(chunkIndexMutex_);
+    for (const auto& chunk : chunkIndex_) {
+      if (!appendHeaders(chunk.first, -1, chunk.second->metadataPages_)) {
+        return;
+      }
+      for (size_t pageId = 0; pageId < chunk.second->multiPages_.size(); ++pageId) {
+        if (!appendHeaders(chunk.first, pageId, chunk.second->multiPages_[pageId])) {
+          return;
+        }
+      }
+    }
+    chunkIndexReadLock.unlock();
+    append_value(buf, headerCount);
+    buf.insert(buf.end(), headerBuf.begin(), headerBuf.end());
+  }
+  append_value(buf, get_checksum(buf, buf.size()));
+
+  const std::string snapshotPath(fileMgrBasePath_ + "/" + CHUNK_INDEX_SNAPSHOT_FILENAME);
+  const std::string tempSnapshotPath(snapshotPath + ".tmp");
+  FILE* f = create(tempSnapshotPath, buf.size());
+  write(f, 0, buf.size(), buf.data());
+  if (fflush(f) != 0 || fsync(fileno(f)) != 0) {
+    LOG(WARNING) << "Could not sync chunk index snapshot '" << tempSnapshotPath
+                 << "' to disk: " << std::strerror(errno);
+    close(f);
+    boost::filesystem::remove(tempSnapshotPath);
+    return;
+  }
+  close(f);
+
+  snapshotLock.lock();
+  if (pagesChangedSinceSnapshot_) {
+    // pages were allocated or freed while building the snapshot, it is out of date
+    boost::filesystem::remove(tempSnapshotPath);
+    return;
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tempSnapshotPath, snapshotPath, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not rename chunk index snapshot '" << tempSnapshotPath
+                 << "': " << ec.message();
+    boost::filesystem::remove(tempSnapshotPath);
+    return;
+  }
+  sync_directory(fileMgrBasePath_);
+  hasChunkIndexSnapshot_ = true;
+}
+
+bool FileMgr::readChunkIndexSnapshot(const std::vector<FileMetadata>& fileMetadataVec,
+                                     std::vector<HeaderInfo>& headerVec) {
+  const std::string snapshotPath(fileMgrBasePath_ + "/" + CHUNK_INDEX_SNAPSHOT_FILENAME);
+  if (!boost::filesystem::exists(snapshotPath)) {
+    return false;
+  }
+  const size_t snapshotSize = boost::filesystem::file_size(snapshotPath);
+  if (snapshotSize < sizeof(uint32_t)) {
+    LOG(WARNING) << "Chunk index snapshot '" << snapshotPath << "' is truncated";
+    return false;
+  }
+  std::vector<int8_t> buf(snapshotSize);
+  FILE* f = open(snapshotPath);
+  read(f, 0, snapshotSize, buf.data());
+  close(f);
+
+  const size_t payloadSize = snapshotSize - sizeof(uint32_t);
+  uint32_t checksum;
+  memcpy(&checksum, &buf[payloadSize], sizeof(uint32_t));
+  if (checksum != get_checksum(buf, payloadSize)) {
+    LOG(WARNING) << "Chunk index snapshot '" << snapshotPath << "' is corrupt";
+    return false;
+  }
+
+  SnapshotReader reader(buf, payloadSize);
+  int32_t version;
+  int32_t snapshotEpoch;
+  if (!reader.read(version) || version != CHUNK_INDEX_SNAPSHOT_VERSION ||
+      !reader.read(snapshotEpoch)) {
+    return false;
+  }
+  if (snapshotEpoch != epoch_) {
+    VLOG(1) << "Chunk index snapshot '" << snapshotPath << "' is for epoch "
+            << snapshotEpoch << ", opening epoch " << epoch_;
+    return false;
+  }
+
+  // the files on disk must be exactly the ones of the snapshot
+  std::map<int, const FileMetadata*> fileMetadataById;
+  for (const auto& fileMetadata : fileMetadataVec) {
+    fileMetadataById.emplace(fileMetadata.fileId, &fileMetadata);
+  }
+  uint64_t fileCount;
+  if (!reader.read(fileCount) || fileCount != fileMetadataVec.size()) {
+    return false;
+  }
+  std::map<int, std::set<size_t>> freePagesById;
+  for (uint64_t i = 0; i < fileCount; ++i) {
+    int32_t fileId;
+    uint64_t pageSize;
+    uint64_t numPages;
+    uint64_t freePageCount;
+    if (!reader.read(fileId) || !reader.read(pageSize) || !reader.read(numPages) ||
+        !reader.read(freePageCount)) {
+      return false;
+    }
+    const auto it = fileMetadataById.find(fileId);
+    if (it == fileMetadataById.end() || it->second->pageSize != pageSize ||
+        it->second->numPages != numPages || freePagesById.count(fileId)) {
+      return false;
+    }
+    auto& freePages = freePagesById[fileId];
+    for (uint64_t j = 0; j < freePageCount; ++j) {
+      uint64_t pageNum;
+      if (!reader.read(pageNum) || pageNum >= numPages) {
+        return false;
+      }
+      freePages.insert(freePages.end(), pageNum);
+    }
+  }
+
+  uint64_t headerCount;
+  if (!reader.read(headerCount)) {
+    return false;
+  }
+  std::vector<HeaderInfo> snapshotHeaderVec;
+  for (uint64_t i = 0; i < headerCount; ++i) {
+    int32_t keySize;
+    if (!reader.read(keySize) || keySize < 2) {
+      return false;
+    }
+    ChunkKey chunkKey(keySize);
+    for (auto& keyElem : chunkKey) {
+      if (!reader.read(keyElem)) {
+        return false;
+      }
+    }
+    // always derive dbid/tbid from FileMgr, as the header scan does
+    chunkKey[0] = fileMgrKey_.first;
+    chunkKey[1] = fileMgrKey_.second;
+    int32_t pageId;
+    int32_t versionEpoch;
+    int32_t fileId;
+    uint64_t pageNum;
+    if (!reader.read(pageId) || !reader.read(versionEpoch) || !reader.read(fileId) ||
+        !reader.read(pageNum)) {
+      return false;
+    }
+    const auto it = fileMetadataById.find(fileId);
+    if (it == fileMetadataById.end() || pageNum >= it->second->numPages) {
+      return false;
+    }
+    snapshotHeaderVec.emplace_back(chunkKey, pageId, versionEpoch, Page(fileId, pageNum));
+  }
+  if (!reader.atEnd()) {
+    return false;
+  }
+
+  for (const auto& fileMetadata : fileMetadataVec) {
+    FileInfo* fInfo = new FileInfo(this,
+                                   fileMetadata.fileId,
+                                   open(fileMetadata.filePath),
+                                   fileMetadata.pageSize,
+                                   fileMetadata.numPages,
+                                   false);  // false means don't init file
+    if (gfm_ && gfm_->getReadBackend() == FileReadBackend::DIRECT) {
+      fInfo->enableDirectReads(fileMetadata.filePath);
+    }
+    fInfo->freePages = std::move(freePagesById[fileMetadata.fileId]);
+    mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
+    if (fileMetadata.fileId >= static_cast<int>(files_.size())) {
+      files_.resize(fileMetadata.fileId + 1);
+    }
+    files_[fileMetadata.fileId] = fInfo;
+    fileIndex_.insert(std::pair<size_t, int>(fileMetadata.pageSize, fileMetadata.fileId));
+  }
+  headerVec = std::move(snapshotHeaderVec);
+  std::lock_guard<std::mutex> snapshotLock(chunkIndexSnapshotMutex_);
+  hasChunkIndexSnapshot_ = true;
+  return true;
+}
+
+void FileMgr::removeChunkIndexSnapshot() {
+  const std::string snapshotPath(fileMgrBasePath_ + "/" + CHUNK_INDEX_SNAPSHOT_FILENAME);
+  boost::system::error_code ec;
+  if (boost::filesystem::remove(snapshotPath, ec)) {
+    sync_directory(fileMgrBasePath_);
+  }
+}
+
+void FileMgr::invalidateChunkIndexSnapshot() {
+  std::lock_guard<std::mutex> snapshotLock(chunkIndexSnapshotMutex_);
+  pagesChangedSinceSnapshot_ = true;
+  if (hasChunkIndexSnapshot_) {
+    // must be gone from disk before the pages change, a crash would otherwise leave a
+    // snapshot which doesn't match the page headers
+    removeChunkIndexSnapshot();
+    hasChunkIndexSnapshot_ = false;
+  }
+}
+
 }  // namespace File_Namespace
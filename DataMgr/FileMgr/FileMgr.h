@@ -30,6 +30,7 @@
 #include <map>
 #include <mutex>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "DataMgr/AbstractBuffer.h"
@@ -39,6 +40,8 @@
 #include "DataMgr/FileMgr/Page.h"
 #include "Shared/mapd_shared_mutex.h"
 
+extern bool g_enable_chunk_index_snapshot;
+
 using namespace Data_Namespace;
 
 namespace File_Namespace {
@@ -78,6 +81,17 @@ using Chunk = FileBuffer;
  */
 typedef std::map<ChunkKey, FileBuffer*> ChunkKeyToChunkMap;
 
+/**
+ * @type FileMetadata
+ * @brief Path, id, page size and number of pages of a data file found at startup.
+ */
+struct FileMetadata {
+  std::string filePath;
+  int fileId;
+  size_t pageSize;
+  size_t numPages;
+};
+
 /**
  * @class   FileMgr
  * @brief
@@ -256,6 +270,10 @@ class FileMgr : public AbstractBufferMgr {  // implements
   mutable mapd_shared_mutex mutex_free_page;
   std::vector<std::pair<FileInfo*, int>> free_pages;
 
+  std::mutex chunkIndexSnapshotMutex_;
+  bool hasChunkIndexSnapshot_{false};  /// the snapshot on disk matches the table
+  bool pagesChangedSinceSnapshot_{false};
+
   /**
    * @brief Adds a file to the file manager repository.
    *
@@ -287,6 +305,19 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void setEpoch(int epoch);  // resets current value of epoch at startup
   void processFileFutures(std::vector<std::future<std::vector<HeaderInfo>>>& file_futures,
                           std::vector<HeaderInfo>& headerVec);
+
+  /**
+   * @brief Chunk index snapshot, the page headers and free pages of all the files of the
+   * table as of the last checkpoint.
+   *
+   * Loading it at startup replaces reading the header of every page. It is only valid
+   * until pages are allocated or freed again, the first such change removes it.
+   */
+  void writeChunkIndexSnapshot();
+  bool readChunkIndexSnapshot(const std::vector<FileMetadata>& fileMetadataVec,
+                              std::vector<HeaderInfo>& headerVec);
+  void removeChunkIndexSnapshot();
+  void invalidateChunkIndexSnapshot();
 };
 
 }  // namespace File_Namespace
@@ -44,6 +44,7 @@ GlobalFileMgr::GlobalFileMgr(const int deviceId,
     : AbstractBufferMgr(deviceId)
     , basePath_(basePath)
     , num_reader_threads_(num_reader_threads)
+    , read_backend_(FileReadBackend::BUFFERED)
     , epoch_(-1)
     ,  // set the default epoch for all tables corresponding to the time of
        // last checkpoint
@@ -145,6 +146,18 @@ FileMgr* GlobalFileMgr::findFileMgr(const int db_id,
   return fm;
 }
 
+bool GlobalFileMgr::isChunkOnDisk(const ChunkKey& key) {
+  CHECK_GE(key.size(), size_t(2));
+  if (!findFileMgr(key[0], key[1])) {
+    const std::string fileMgrBasePath(basePath_ + "table_" + std::to_string(key[0]) +
+                                      "_" + std::to_string(key[1]));
+    if (!boost::filesystem::exists(fileMgrBasePath)) {
+      return false;
+    }
+  }
+  return getFileMgr(key)->isBufferOnDevice(key);
+}
+
 FileMgr* GlobalFileMgr::getFileMgr(const int db_id, const int tb_id) {
   { /* check if FileMgr already exists for (db_id, tb_id) */
     FileMgr* fm = findFileMgr(db_id, tb_id);
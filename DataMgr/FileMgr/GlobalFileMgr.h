@@ -67,6 +67,10 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
     return getFileMgr(key)->isBufferOnDevice(key);
   }
 
+  /// Like isBufferOnDevice, but doesn't create the data directory of a table which
+  /// doesn't exist (anymore).
+  bool isChunkOnDisk(const ChunkKey& key);
+
   /// Deletes the chunk with the specified key
   // Purge == true means delete the data chunks -
   // can't undelete and revert to previous
@@ -143,6 +147,15 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
    */
   inline size_t getNumReaderThreads() { return num_reader_threads_; }
 
+  /**
+   * @brief Selects how data files are read. Only affects files opened by FileMgrs created
+   * after the call, so it must be set before any table is accessed.
+   */
+  void setReadBackend(const FileReadBackend read_backend) {
+    read_backend_ = read_backend;
+  }
+  FileReadBackend getReadBackend() const { return read_backend_; }
+
   size_t getNumChunks() override;
 
   FileMgr* findFileMgr(const int db_id,
@@ -165,7 +178,8 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
 
  private:
   std::string basePath_;       /// The OS file system path containing the files.
-  size_t num_reader_threads_;  /// number of threads used when loading data
+  size_t num_reader_threads_;     /// number of threads used when loading data
+  FileReadBackend read_backend_;  /// how the FileMgrs read pages from their data files
   int epoch_; /* the current epoch (time of last checkpoint) will be used for all
                * tables except of the one for which the value of the epoch has been reset
                * using --start-epoch option at start up to rollback this table's updates.
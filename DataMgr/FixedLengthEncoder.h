@@ -41,6 +41,7 @@ class FixedLengthEncoder : public Encoder {
                            const bool replicating = false) override {
     T* unencodedData = reinterpret_cast<T*>(srcData);
     auto encodedData = std::make_unique<V[]>(numAppendElems);
+    auto bloom_filter = bloomFilterForAppend();
     for (size_t i = 0; i < numAppendElems; ++i) {
       size_t ri = replicating ? 0 : i;
       encodedData.get()[i] = static_cast<V>(unencodedData[ri]);
@@ -57,6 +58,9 @@ class FixedLengthEncoder : public Encoder {
           decimal_overflow_validator_.validate(data);
           dataMin = std::min(dataMin, data);
           dataMax = std::max(dataMax, data);
+          if (bloom_filter) {
+            bloom_filter->add(static_cast<int64_t>(data));
+          }
         }
       }
     }
@@ -108,7 +112,7 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
+    const auto& that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
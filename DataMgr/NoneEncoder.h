@@ -46,6 +46,7 @@ class NoneEncoder : public Encoder {
     if (replicating) {
       encoded_data.resize(numAppendElems);
     }
+    auto bloom_filter = bloomFilterForAppend();
     for (size_t i = 0; i < numAppendElems; ++i) {
       size_t ri = replicating ? 0 : i;
       T data = unencodedData[ri];
@@ -58,6 +59,9 @@ class NoneEncoder : public Encoder {
         decimal_overflow_validator_.validate(data);
         dataMin = std::min(dataMin, data);
         dataMax = std::max(dataMax, data);
+        if (bloom_filter) {
+          bloom_filter->add(static_cast<int64_t>(data));
+        }
       }
     }
     num_elems_ += numAppendElems;
@@ -108,7 +112,7 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
-    const auto that_typed = static_cast<const NoneEncoder&>(that);
+    const auto& that_typed = static_cast<const NoneEncoder&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
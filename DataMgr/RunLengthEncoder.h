@@ -0,0 +1,206 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RUN_LENGTH_ENCODER_H
+#define RUN_LENGTH_ENCODER_H
+
+#include "Shared/EncodedChunkLayout.h"
+#include "Shared/Logger.h"
+
+#include <vector>
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+
+/**
+ * @brief Stores a chunk as runs of equal values, see EncodedChunkLayout.h. Appends
+ * extend the last run of the chunk in place when they start with its value. A chunk
+ * without repeated values takes twice the space of the uncompressed column, or 8 bytes
+ * per value for BOOLEAN, TINYINT and SMALLINT columns.
+ */
+template <typename T>
+class RunLengthEncoder : public Encoder {
+ public:
+  RunLengthEncoder(Data_Namespace::AbstractBuffer* buffer)
+      : Encoder(buffer)
+      , dataMin(std::numeric_limits<T>::max())
+      , dataMax(std::numeric_limits<T>::min())
+      , has_nulls(false) {}
+
+  ChunkMetadata appendData(int8_t*& srcData,
+                           const size_t numAppendElems,
+                           const SQLTypeInfo&,
+                           const bool replicating = false) override {
+    T* unencodedData = reinterpret_cast<T*>(srcData);
+    int64_t run_count{0};
+    std::vector<RunLengthRun<T>> runs;
+    if (buffer_->size() > 0) {
+      buffer_->read(reinterpret_cast<int8_t*>(&run_count), RL_ENCODING_HEADER_SIZE);
+      CHECK_GT(run_count, 0);
+      RunLengthRun<T> last_run;
+      buffer_->read(reinterpret_cast<int8_t*>(&last_run),
+                    sizeof(RunLengthRun<T>),
+                    last_run_offset(run_count));
+      CHECK_EQ(last_run.end_pos, static_cast<int64_t>(num_elems_));
+      runs.push_back(last_run);
+    }
+    CHECK_LE(num_elems_ + numAppendElems,
+             static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+    auto bloom_filter = bloomFilterForAppend();
+    for (size_t i = 0; i < numAppendElems; ++i) {
+      const T data = unencodedData[replicating ? 0 : i];
+      if (data == inline_int_null_value<T>()) {
+        has_nulls = true;
+      } else {
+        decimal_overflow_validator_.validate(data);
+        dataMin = std::min(dataMin, data);
+        dataMax = std::max(dataMax, data);
+        if (bloom_filter) {
+          bloom_filter->add(static_cast<int64_t>(data));
+        }
+      }
+      const int32_t end_pos = num_elems_ + i + 1;
+      if (!runs.empty() && runs.back().value == data) {
+        runs.back().end_pos = end_pos;
+      } else {
+        runs.push_back({data, end_pos});
+      }
+    }
+    if (!runs.empty()) {
+      if (run_count == 0) {
+        run_count = runs.size();
+        buffer_->append(reinterpret_cast<int8_t*>(&run_count), RL_ENCODING_HEADER_SIZE);
+        buffer_->append(reinterpret_cast<int8_t*>(runs.data()),
+                        runs.size() * sizeof(RunLengthRun<T>));
+      } else {
+        // the first run is the last run of the chunk, possibly extended
+        buffer_->write(reinterpret_cast<int8_t*>(runs.data()),
+                       sizeof(RunLengthRun<T>),
+                       last_run_offset(run_count));
+        if (runs.size() > 1) {
+          buffer_->append(reinterpret_cast<int8_t*>(runs.data() + 1),
+                          (runs.size() - 1) * sizeof(RunLengthRun<T>));
+        }
+        run_count += runs.size() - 1;
+        buffer_->write(
+            reinterpret_cast<int8_t*>(&run_count), RL_ENCODING_HEADER_SIZE, 0);
+      }
+    }
+    num_elems_ += numAppendElems;
+
+    ChunkMetadata chunkMetadata;
+    getMetadata(chunkMetadata);
+    if (!replicating) {
+      srcData += numAppendElems * sizeof(T);
+    }
+    return chunkMetadata;
+  }
+
+  void getMetadata(ChunkMetadata& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata.fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  ChunkMetadata getMetadata(const SQLTypeInfo& ti) override {
+    ChunkMetadata chunk_metadata{ti, 0, 0, ChunkStats{}};
+    chunk_metadata.fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto& that_typed = static_cast<const RunLengthEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const RunLengthEncoder<T>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, sizeof(T), 1, f);
+    fread((int8_t*)&dataMax, sizeof(T), 1, f);
+    fread((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ private:
+  static size_t last_run_offset(const int64_t run_count) {
+    return RL_ENCODING_HEADER_SIZE + (run_count - 1) * sizeof(RunLengthRun<T>);
+  }
+
+};  // RunLengthEncoder
+
+#endif  // RUN_LENGTH_ENCODER_H
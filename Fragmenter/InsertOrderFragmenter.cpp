@@ -25,6 +25,7 @@
 #include "../DataMgr/AbstractBuffer.h"
 #include "../DataMgr/DataMgr.h"
 #include "../LockMgr/LockMgr.h"
+#include "../Shared/EncodedChunkLayout.h"
 #include "../Shared/checked_alloc.h"
 #include "../Shared/thread_count.h"
 #include "Shared/Logger.h"
@@ -144,6 +145,11 @@ void InsertOrderFragmenter::getChunkMetadata() {
       varLenColInfo_.insert(std::make_pair(colIt->first, 0));
       size = 8;  // b/c we use this for string and array indices - gross to have magic
                  // number here
+    } else if (colIt->second.get_column_desc()->columnType.get_compression() ==
+               kENCODING_RL) {
+      // worst case, a run for every row
+      size = size == sizeof(int64_t) ? sizeof(RunLengthRun<int64_t>)
+                                     : sizeof(RunLengthRun<int32_t>);
     }
     maxFixedColSize = std::max(maxFixedColSize, size);
   }
@@ -58,6 +58,32 @@ inline bool is_integral(const SQLTypeInfo& t) {
   return t.is_integer() || t.is_boolean() || t.is_time() || t.is_timeinterval();
 }
 
+// RL and DIFF chunks can't be modified in place, rows don't map to fixed offsets
+inline void check_chunk_rewritable(const ColumnDescriptor* cd, const std::string& op) {
+  const auto compression = cd->columnType.get_compression();
+  if (compression == kENCODING_RL || compression == kENCODING_DIFF) {
+    throw std::runtime_error(op + " is not supported on table with RL or DIFF " +
+                             "encoded column " + cd->columnName);
+  }
+}
+
+// Marks the rows at the given offsets as updated in place, the checkpoint then only
+// writes back the pages holding them instead of the whole chunk.
+inline void set_rows_updated(Data_Namespace::AbstractBuffer* buffer,
+                             std::vector<uint64_t> frag_offsets,
+                             const size_t element_size) {
+  std::sort(frag_offsets.begin(), frag_offsets.end());
+  for (size_t i = 0; i < frag_offsets.size();) {
+    size_t j = i + 1;
+    while (j < frag_offsets.size() && frag_offsets[j] <= frag_offsets[j - 1] + 1) {
+      ++j;
+    }
+    buffer->setUpdated(frag_offsets[i] * element_size,
+                       (frag_offsets[j - 1] - frag_offsets[i] + 1) * element_size);
+    i = j;
+  }
+}
+
 bool FragmentInfo::unconditionalVacuum_{false};
 
 void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catalog,
@@ -338,6 +364,10 @@ void InsertOrderFragmenter::updateColumns(
     executor = Executor::getExecutor(catalog->getCurrentDB().dbId);
   }
 
+  for (const auto& chunk : chunks) {
+    check_chunk_rewritable(chunk->get_column_desc(), "UPDATE");
+  }
+
   std::shared_ptr<Chunk_NS::Chunk> deletedChunk;
   for (size_t indexOfChunk = 0; indexOfChunk < chunks.size(); indexOfChunk++) {
     auto chunk = chunks[indexOfChunk];
@@ -502,6 +532,7 @@ void InsertOrderFragmenter::updateColumns(
   updelRoll.dirtyChunkeys.insert(chunkey);
   bool* deletedChunkBuffer =
       reinterpret_cast<bool*>(deletedChunk->get_buffer()->getMemoryPtr());
+  std::vector<uint64_t> deletedOffsets(num_rows);
 
   std::atomic<size_t> row_idx{0};
 
@@ -510,6 +541,7 @@ void InsertOrderFragmenter::updateColumns(
                         &indexOffFragmentOffsetColumn,
                         &chunkConverters,
                         &deletedChunkBuffer,
+                        &deletedOffsets,
                         &row_idx](size_t indexOfEntry) -> void {
     // convert the source data
     const auto row = sourceDataProvider.getEntryAt(indexOfEntry);
@@ -537,6 +569,7 @@ void InsertOrderFragmenter::updateColumns(
 
     // now mark the row as deleted
     deletedChunkBuffer[indexInChunkBuffer] = true;
+    deletedOffsets[indexOfRow] = indexInChunkBuffer;
   };
 
   bool can_go_parallel = num_rows > 20000;
@@ -604,7 +637,8 @@ void InsertOrderFragmenter::updateColumns(
     // elements
     deletedChunk->get_buffer()->encoder->setNumElems(shadowDeletedChunkMeta.numElements);
   }
-  deletedChunk->get_buffer()->setUpdated();
+  deletedOffsets.resize(row_idx);
+  set_rows_updated(deletedChunk->get_buffer(), deletedOffsets, sizeof(bool));
 }
 
 void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catalog,
@@ -616,6 +650,7 @@ void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catal
                                          const SQLTypeInfo& rhs_type,
                                          const Data_Namespace::MemoryLevel memory_level,
                                          UpdelRoll& updel_roll) {
+  check_chunk_rewritable(cd, "UPDATE");
   updel_roll.catalog = catalog;
   updel_roll.logicalTableId = catalog->getLogicalTableId(td->tableId);
   updel_roll.memoryLevel = memory_level;
@@ -653,9 +688,9 @@ void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catal
   const auto segsz = (nrow + ncore - 1) / ncore;
   auto dbuf = chunk->get_buffer();
   auto dbuf_addr = dbuf->getMemoryPtr();
-  dbuf->setUpdated();
   {
     std::lock_guard<std::mutex> lck(updel_roll.mutex);
+    set_rows_updated(dbuf, frag_offsets, get_element_size(cd->columnType));
     if (updel_roll.dirtyChunks.count(chunk.get()) == 0) {
       updel_roll.dirtyChunks.emplace(chunk.get(), chunk);
     }
@@ -986,6 +1021,8 @@ void InsertOrderFragmenter::updateColumnMetadata(const ColumnDescriptor* cd,
              !(lhs_type.is_string() && kENCODING_DICT != lhs_type.get_compression())) {
     update_stats(min_int64t_per_chunk, max_int64t_per_chunk, has_null_per_chunk);
   }
+  // the bloom filter doesn't have the new values and can't forget the old ones
+  buffer->encoder->dropBloomFilter();
   buffer->encoder->getMetadata(chunkMetadata[cd->columnId]);
 
   // removed as @alex suggests. keep it commented in case of any chance to revisit
@@ -1214,6 +1251,9 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
                                         UpdelRoll& updel_roll) {
   auto& fragment = getFragmentInfoFromId(fragment_id);
   auto chunks = getChunksForAllColumns(td, fragment, memory_level);
+  for (const auto& chunk : chunks) {
+    check_chunk_rewritable(chunk->get_column_desc(), "VACUUM");
+  }
   const auto ncol = chunks.size();
 
   std::vector<int8_t> has_null_per_thread(ncol, 0);
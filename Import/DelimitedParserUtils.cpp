@@ -22,6 +22,8 @@
 
 #include "Import/DelimitedParserUtils.h"
 
+#include <cstring>
+
 #include "Shared/Logger.h"
 #include "StringDictionary/StringDictionary.h"
 
@@ -77,46 +79,53 @@ size_t DelimitedParserUtils::find_end(const char* buffer,
                                       size_t size,
                                       const Importer_NS::CopyParams& copy_params,
                                       unsigned int& num_rows_this_buffer) {
-  size_t last_line_delim_pos = 0;
+  const char* const buffer_end = buffer + size;
+  const char* last_line_delim = nullptr;
+  const auto find_line_delims = [&](const char* begin, const char* end) {
+    for (const char* p = begin;
+         (p = static_cast<const char*>(memchr(p, copy_params.line_delim, end - p)));
+         ++p) {
+      last_line_delim = p;
+      ++num_rows_this_buffer;
+    }
+  };
   if (copy_params.quoted) {
     const char* current = buffer;
-    bool in_quote = false;
-
-    while (current < buffer + size) {
-      while (!in_quote && current < buffer + size) {
-        // We are outside of quotes. We have to find the last possible line delimiter.
-        if (*current == copy_params.line_delim) {
-          last_line_delim_pos = current - buffer;
-          ++num_rows_this_buffer;
-        } else if (*current == copy_params.quote) {
-          in_quote = true;
-        }
-        ++current;
+    while (current < buffer_end) {
+      // We are outside of quotes. We have to find the last possible line delimiter.
+      const auto quote = static_cast<const char*>(
+          memchr(current, copy_params.quote, buffer_end - current));
+      find_line_delims(current, quote ? quote : buffer_end);
+      if (!quote) {
+        break;
       }
-
-      while (in_quote && current < buffer + size) {
-        // We are in a quoted field. We have to find the ending quote.
-        if ((*current == copy_params.escape) && (current < buffer + size - 1) &&
-            (*(current + 1) == copy_params.quote)) {
+      current = quote + 1;
+      // We are in a quoted field. We have to find the ending quote.
+      while (current < buffer_end) {
+        const auto end_quote = static_cast<const char*>(
+            memchr(current, copy_params.quote, buffer_end - current));
+        if (!end_quote) {
+          current = buffer_end;
+          break;
+        }
+        current = end_quote + 1;
+        const bool escaped =
+            copy_params.escape == copy_params.quote
+                ? current < buffer_end && *current == copy_params.quote
+                : *(end_quote - 1) == copy_params.escape;
+        if (!escaped) {
+          break;
+        }
+        if (copy_params.escape == copy_params.quote) {
           ++current;
-        } else if (*current == copy_params.quote) {
-          in_quote = false;
         }
-        ++current;
       }
     }
   } else {
-    const char* current = buffer;
-    while (current < buffer + size) {
-      if (*current == copy_params.line_delim) {
-        last_line_delim_pos = current - buffer;
-        ++num_rows_this_buffer;
-      }
-      ++current;
-    }
+    find_line_delims(buffer, buffer_end);
   }
 
-  if (last_line_delim_pos <= 0) {
+  if (!last_line_delim || last_line_delim == buffer) {
     size_t slen = size < 50 ? size : 50;
     std::string showMsgStr(buffer, buffer + slen);
     LOG(ERROR) << "No line delimiter in block. Block was of size " << size
@@ -124,7 +133,7 @@ size_t DelimitedParserUtils::find_end(const char* buffer,
     return size;
   }
 
-  return last_line_delim_pos + 1;
+  return last_line_delim - buffer + 1;
 }
 
 const char* DelimitedParserUtils::get_row(const char* buf,
@@ -134,6 +143,31 @@ const char* DelimitedParserUtils::get_row(const char* buf,
                                           const bool* is_array,
                                           std::vector<std::string>& row,
                                           bool& try_single_thread) {
+  std::vector<std::string_view> row_views;
+  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  const auto p = get_row(buf,
+                         buf_end,
+                         entire_buf_end,
+                         copy_params,
+                         is_array,
+                         row_views,
+                         tmp_buffers,
+                         try_single_thread);
+  for (const auto& field : row_views) {
+    row.emplace_back(field);
+  }
+  return p;
+}
+
+const char* DelimitedParserUtils::get_row(
+    const char* buf,
+    const char* buf_end,
+    const char* entire_buf_end,
+    const Importer_NS::CopyParams& copy_params,
+    const bool* is_array,
+    std::vector<std::string_view>& row,
+    std::vector<std::unique_ptr<char[]>>& tmp_buffers,
+    bool& try_single_thread) {
   const char* field = buf;
   const char* p;
   bool in_quote = false;
@@ -184,6 +218,7 @@ const char* DelimitedParserUtils::get_row(const char* buf,
           trim_space(field_begin, field_end);
           trim_quotes(field_begin, field_end, copy_params);
           row.emplace_back(field_begin, field_end - field_begin);
+          tmp_buffers.push_back(std::move(field_buf));
         }
         field = p + 1;
         has_escape = false;
@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Import/CopyParams.h"
@@ -47,7 +49,9 @@ class DelimitedParserUtils {
                                const CopyParams& copy_params);
 
   /**
-   * @brief Finds the closest possible row ending to the end of the given buffer.
+   * @brief Finds the closest possible row ending to the end of the given buffer. Uses
+   * memchr to skip to the next line delimiter or quote, which compares many bytes at a
+   * time.
    *
    * @param buffer               Given buffer which has the rows in csv format. (NOT OWN)
    * @param size                 Size of the buffer.
@@ -84,6 +88,22 @@ class DelimitedParserUtils {
                              std::vector<std::string>& row,
                              bool& try_single_thread);
 
+  /**
+   * @brief Same as above, without copying the fields out of the buffer.
+   *
+   * @param row                  Given vector to be populated with views of the fields.
+   * @param tmp_buffers          Holds the unescaped copies of fields with escaped quotes,
+   * must outlive the views in row.
+   */
+  static const char* get_row(const char* buf,
+                             const char* buf_end,
+                             const char* entire_buf_end,
+                             const Importer_NS::CopyParams& copy_params,
+                             const bool* is_array,
+                             std::vector<std::string_view>& row,
+                             std::vector<std::unique_ptr<char[]>>& tmp_buffers,
+                             bool& try_single_thread);
+
   /**
    * @brief Parses given string array and inserts into given vector of strings.
    *
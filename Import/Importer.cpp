@@ -26,15 +26,20 @@
 #include <arrow/io/api.h>
 #include <gdal.h>
 #include <ogrsf_frmts.h>
+#include <sys/resource.h>
 #include <unistd.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/variant.hpp>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <fstream>
 #include <future>
 #include <iomanip>
@@ -111,6 +116,33 @@ struct OGRSpatialReferenceDeleter {
 using OGRSpatialReferenceUqPtr =
     std::unique_ptr<OGRSpatialReference, OGRSpatialReferenceDeleter>;
 
+// Like std::stoi / std::stoll, i.e. parses the longest prefix which is a number, without
+// copying the field out of the input block.
+template <typename T>
+T parse_integer(const std::string_view str) {
+  T val{0};
+  const auto result = std::from_chars(str.data(), str.data() + str.size(), val);
+  if (result.ec == std::errc::invalid_argument) {
+    throw std::invalid_argument("Invalid integer: " + std::string(str));
+  }
+  if (result.ec == std::errc::result_out_of_range) {
+    throw std::out_of_range("Integer out of range: " + std::string(str));
+  }
+  return val;
+}
+
+// Like std::atof, from a null terminated copy of the field on the stack; longer fields,
+// which aren't plain numbers anyway, fall back to a std::string.
+double parse_double(const std::string_view str) {
+  char buf[64];
+  if (str.size() >= sizeof(buf)) {
+    return std::atof(std::string(str).c_str());
+  }
+  memcpy(buf, str.data(), str.size());
+  buf[str.size()] = '\0';
+  return std::atof(buf);
+}
+
 }  // namespace
 
 // For logging std::vector<std::string> row.
@@ -124,6 +156,17 @@ formatting_ostream& operator<<(formatting_ostream& out, std::vector<std::string>
   out << ']';
   return out;
 }
+
+formatting_ostream& operator<<(formatting_ostream& out,
+                               std::vector<std::string_view>& row) {
+  out << '[';
+  for (size_t i = 0; i < row.size(); ++i) {
+    out << (i ? ", " : "");
+    out.write(row[i].data(), row[i].size());
+  }
+  out << ']';
+  return out;
+}
 }  // namespace log
 }  // namespace boost
 
@@ -504,7 +547,7 @@ ArrayDatum TDatumToArrayDatum(const TDatum& datum, const SQLTypeInfo& ti) {
 }
 
 void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
-                                  const std::string& val,
+                                  const std::string_view val,
                                   const bool is_null,
                                   const CopyParams& copy_params,
                                   const int64_t replicate_count) {
@@ -519,14 +562,14 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
         addBoolean(inline_fixed_encoding_null_val(cd->columnType));
       } else {
         SQLTypeInfo ti = cd->columnType;
-        Datum d = StringToDatum(val, ti);
+        Datum d = StringToDatum(std::string(val), ti);
         addBoolean((int8_t)d.boolval);
       }
       break;
     }
     case kTINYINT: {
-      if (!is_null && (isdigit(val[0]) || val[0] == '-')) {
-        addTinyint(std::stoi(val));
+      if (!is_null && !val.empty() && (isdigit(val[0]) || val[0] == '-')) {
+        addTinyint(parse_integer<int>(val));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -536,8 +579,8 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       break;
     }
     case kSMALLINT: {
-      if (!is_null && (isdigit(val[0]) || val[0] == '-')) {
-        addSmallint(std::stoi(val));
+      if (!is_null && !val.empty() && (isdigit(val[0]) || val[0] == '-')) {
+        addSmallint(parse_integer<int>(val));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -547,8 +590,8 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       break;
     }
     case kINT: {
-      if (!is_null && (isdigit(val[0]) || val[0] == '-')) {
-        addInt(std::stoi(val));
+      if (!is_null && !val.empty() && (isdigit(val[0]) || val[0] == '-')) {
+        addInt(parse_integer<int>(val));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -558,8 +601,8 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       break;
     }
     case kBIGINT: {
-      if (!is_null && (isdigit(val[0]) || val[0] == '-')) {
-        addBigint(std::stoll(val));
+      if (!is_null && !val.empty() && (isdigit(val[0]) || val[0] == '-')) {
+        addBigint(parse_integer<int64_t>(val));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -572,7 +615,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
     case kNUMERIC: {
       if (!is_null) {
         SQLTypeInfo ti(kNUMERIC, 0, 0, false);
-        Datum d = StringToDatum(val, ti);
+        Datum d = StringToDatum(std::string(val), ti);
         const auto converted_decimal_value =
             convert_decimal_value_to_scale(d.bigintval, ti, cd->columnType);
         addBigint(converted_decimal_value);
@@ -585,8 +628,9 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       break;
     }
     case kFLOAT:
-      if (!is_null && (val[0] == '.' || isdigit(val[0]) || val[0] == '-')) {
-        addFloat((float)std::atof(val.c_str()));
+      if (!is_null && !val.empty() &&
+          (val[0] == '.' || isdigit(val[0]) || val[0] == '-')) {
+        addFloat((float)parse_double(val));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -595,8 +639,9 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       }
       break;
     case kDOUBLE:
-      if (!is_null && (val[0] == '.' || isdigit(val[0]) || val[0] == '-')) {
-        addDouble(std::atof(val.c_str()));
+      if (!is_null && !val.empty() &&
+          (val[0] == '.' || isdigit(val[0]) || val[0] == '-')) {
+        addDouble(parse_double(val));
       } else {
         if (cd->columnType.get_notnull()) {
           throw std::runtime_error("NULL for column " + cd->columnName);
@@ -626,9 +671,9 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
     case kTIME:
     case kTIMESTAMP:
     case kDATE:
-      if (!is_null && (isdigit(val[0]) || val[0] == '-')) {
+      if (!is_null && !val.empty() && (isdigit(val[0]) || val[0] == '-')) {
         SQLTypeInfo ti = cd->columnType;
-        Datum d = StringToDatum(val, ti);
+        Datum d = StringToDatum(std::string(val), ti);
         addBigint(d.bigintval);
       } else {
         if (cd->columnType.get_notnull()) {
@@ -645,7 +690,8 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       if (IS_STRING(ti.get_subtype())) {
         std::vector<std::string> string_vec;
         // Just parse string array, don't push it to buffer yet as we might throw
-        Importer_NS::DelimitedParserUtils::parseStringArray(val, copy_params, string_vec);
+        Importer_NS::DelimitedParserUtils::parseStringArray(
+            std::string(val), copy_params, string_vec);
         if (!is_null) {
           // TODO: add support for NULL string arrays
           if (ti.get_size() > 0) {
@@ -672,13 +718,13 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
         }
       } else {
         if (!is_null) {
-          ArrayDatum d = StringToArray(val, ti, copy_params);
+          ArrayDatum d = StringToArray(std::string(val), ti, copy_params);
           if (d.is_null) {  // val could be "NULL"
             addArray(NullArray(ti));
           } else {
             if (ti.get_size() > 0 && static_cast<size_t>(ti.get_size()) != d.length) {
               throw std::runtime_error("Fixed length array for column " + cd->columnName +
-                                       " has incorrect length: " + val);
+                                       " has incorrect length: " + std::string(val));
             }
             addArray(d);
           }
@@ -1772,6 +1818,133 @@ int64_t explode_collections_step2(
   return us;
 }
 
+/*
+ * Reader stage of the delimited import: reads the file block by block on its own thread
+ * and cuts every block at its last row boundary, the partial row at the end moves to the
+ * next block. At most max_queued_blocks blocks wait for a parser, which bounds the memory
+ * of the stage to (max_queued_blocks + 1) * block_size.
+ */
+class DelimitedBlockReader {
+ public:
+  struct Block {
+    std::unique_ptr<char[]> buffer;
+    size_t size;  // of the complete rows at the start of the buffer
+    size_t first_row_index;
+  };
+
+  DelimitedBlockReader(FILE* file,
+                       const CopyParams& copy_params,
+                       const size_t block_size,
+                       const size_t max_queued_blocks)
+      : file_(file)
+      , copy_params_(copy_params)
+      , block_size_(block_size)
+      , max_queued_blocks_(max_queued_blocks)
+      , done_(false)
+      , stop_(false)
+      , read_ms_(0)
+      , split_ms_(0)
+      , peak_queued_bytes_(0) {
+    thread_ = std::thread(&DelimitedBlockReader::run, this);
+  }
+
+  ~DelimitedBlockReader() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  // Returns false once the whole file has been handed out.
+  bool next(Block& block) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return done_ || !blocks_.empty(); });
+    if (blocks_.empty()) {
+      return false;
+    }
+    block = std::move(blocks_.front());
+    blocks_.pop_front();
+    cv_.notify_all();
+    return true;
+  }
+
+  int64_t readMs() const { return read_ms_; }
+  int64_t splitMs() const { return split_ms_; }
+  size_t peakQueuedBytes() const { return peak_queued_bytes_; }
+
+ private:
+  void run() {
+    std::unique_ptr<char[]> residual;
+    size_t residual_size{0};
+    size_t first_row_index{0};
+    while (true) {
+      auto buffer = std::make_unique<char[]>(block_size_);
+      if (residual_size) {
+        memcpy(buffer.get(), residual.get(), residual_size);
+      }
+      size_t size{0};
+      read_ms_ += measure<>::execution([&] {
+        size = residual_size +
+               fread(buffer.get() + residual_size, 1, block_size_ - residual_size, file_);
+      });
+      if (size == 0) {
+        break;
+      }
+      unsigned int num_rows{0};
+      size_t end_pos{0};
+      split_ms_ += measure<>::execution([&] {
+        end_pos =
+            DelimitedParserUtils::find_end(buffer.get(), size, copy_params_, num_rows);
+      });
+      residual_size = size - end_pos;
+      if (residual_size) {
+        residual = std::make_unique<char[]>(residual_size);
+        memcpy(residual.get(), buffer.get() + end_pos, residual_size);
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || blocks_.size() < max_queued_blocks_; });
+      if (stop_) {
+        break;
+      }
+      blocks_.push_back({std::move(buffer), end_pos, first_row_index});
+      peak_queued_bytes_ =
+          std::max(peak_queued_bytes_.load(), (blocks_.size() + 1) * block_size_);
+      cv_.notify_all();
+      first_row_index += num_rows;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    cv_.notify_all();
+  }
+
+  FILE* file_;
+  const CopyParams& copy_params_;
+  const size_t block_size_;
+  const size_t max_queued_blocks_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Block> blocks_;
+  bool done_;
+  bool stop_;
+
+  std::atomic<int64_t> read_ms_;
+  std::atomic<int64_t> split_ms_;
+  std::atomic<size_t> peak_queued_bytes_;
+  std::thread thread_;
+};
+
+// Peak resident set size of the process, in bytes.
+size_t get_peak_rss() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage)) {
+    return 0;
+  }
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
 }  // namespace
 
 static ImportStatus import_thread_delimited(
@@ -1814,10 +1987,13 @@ static ImportStatus import_thread_delimited(
     for (const auto& p : import_buffers) {
       p->clear();
     }
-    std::vector<std::string> row;
+    // the fields point into the block, only fields with escaped quotes are copied
+    std::vector<std::string_view> row;
+    std::vector<std::unique_ptr<char[]>> tmp_buffers;
     size_t row_index_plus_one = 0;
     for (const char* p = thread_buf; p < thread_buf_end; p++) {
       row.clear();
+      tmp_buffers.clear();
       if (DEBUG_TIMING) {
         us = measure<std::chrono::microseconds>::execution([&]() {
           p = Importer_NS::DelimitedParserUtils::get_row(p,
@@ -1826,6 +2002,7 @@ static ImportStatus import_thread_delimited(
                                                          copy_params,
                                                          importer->get_is_array(),
                                                          row,
+                                                         tmp_buffers,
                                                          try_single_thread);
         });
         total_get_row_time_us += us;
@@ -1836,6 +2013,7 @@ static ImportStatus import_thread_delimited(
                                                        copy_params,
                                                        importer->get_is_array(),
                                                        row,
+                                                       tmp_buffers,
                                                        try_single_thread);
       }
       row_index_plus_one++;
@@ -1891,7 +2069,7 @@ static ImportStatus import_thread_delimited(
                   cd, copy_params.null_str, true, copy_params);
 
               // WKT from string we're not storing
-              auto const& wkt = row[import_idx];
+              const std::string wkt{row[import_idx]};
 
               // next
               ++import_idx;
@@ -2035,7 +2213,7 @@ static ImportStatus import_thread_delimited(
         std::string collection_col_name = std::get<2>(collection_idx_type_name);
         // pull out the collection WKT
         CHECK_LT(collection_col_idx, (int)row.size()) << "column index out of range";
-        auto const& collection_wkt = row[collection_col_idx];
+        const std::string collection_wkt{row[collection_col_idx]};
         // convert to OGR
         OGRGeometry* ogr_geometry = nullptr;
         ScopeGuard destroy_ogr_geometry = [&] {
@@ -2076,6 +2254,8 @@ static ImportStatus import_thread_delimited(
   }
 
   import_status.thread_id = thread_id;
+  import_status.parse_ms = ms - load_ms;
+  import_status.load_ms = load_ms;
   // LOG(INFO) << " return " << import_status.thread_id << std::endl;
 
   return import_status;
@@ -3831,14 +4011,8 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
     }
   }
 
-  auto scratch_buffer = std::make_unique<char[]>(alloc_size);
   size_t current_pos = 0;
-  size_t end_pos;
-  size_t begin_pos = 0;
-
   (void)fseek(p_file, current_pos, SEEK_SET);
-  size_t size =
-      fread(reinterpret_cast<void*>(scratch_buffer.get()), 1, alloc_size, p_file);
 
   // make render group analyzers for each poly column
   ColumnIdToRenderGroupAnalyzerMapType columnIdToRenderGroupAnalyzerMap;
@@ -3858,6 +4032,11 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
   ChunkKey chunkKey = {loader->getCatalog().getCurrentDB().dbId,
                        loader->getTableDesc()->tableId};
   auto start_epoch = loader->getTableEpoch();
+  const auto import_timer = timer_start();
+  int64_t reader_read_ms{0};
+  int64_t reader_split_ms{0};
+  size_t reader_peak_bytes{0};
+  size_t parser_peak_bytes{0};
   {
     std::list<std::future<ImportStatus>> threads;
 
@@ -3867,51 +4046,33 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
     for (size_t i = 0; i < max_threads; i++) {
       stack_thread_ids.push(i);
     }
-    // added for true row index on error
-    size_t first_row_index_this_buffer = 0;
-
-    while (size > 0) {
-      unsigned int num_rows_this_buffer = 0;
-      CHECK(scratch_buffer);
-      end_pos = DelimitedParserUtils::find_end(
-          scratch_buffer.get(), size, copy_params, num_rows_this_buffer);
-
-      // unput residual
-      int nresidual = size - end_pos;
-      std::unique_ptr<char[]> unbuf;
-      if (nresidual > 0) {
-        unbuf = std::make_unique<char[]>(nresidual);
-        memcpy(unbuf.get(), scratch_buffer.get() + end_pos, nresidual);
-      }
 
+    // reading the file and finding the row boundaries overlaps with parsing, one block
+    // per thread can be in flight plus two read ahead
+    DelimitedBlockReader block_reader(p_file, copy_params, alloc_size, 2);
+    DelimitedBlockReader::Block block;
+    bool has_block = block_reader.next(block);
+    while (has_block) {
       // get a thread_id not in use
       auto thread_id = stack_thread_ids.top();
       stack_thread_ids.pop();
       // LOG(INFO) << " stack_thread_ids.pop " << thread_id << std::endl;
 
+      const auto block_size = block.size;
       threads.push_back(std::async(std::launch::async,
                                    import_thread_delimited,
                                    thread_id,
                                    this,
-                                   std::move(scratch_buffer),
-                                   begin_pos,
-                                   end_pos,
-                                   end_pos,
+                                   std::move(block.buffer),
+                                   0,
+                                   block_size,
+                                   block_size,
                                    columnIdToRenderGroupAnalyzerMap,
-                                   first_row_index_this_buffer));
-
-      first_row_index_this_buffer += num_rows_this_buffer;
-
-      current_pos += end_pos;
-      scratch_buffer = std::make_unique<char[]>(alloc_size);
-      CHECK(scratch_buffer);
-      memcpy(scratch_buffer.get(), unbuf.get(), nresidual);
-      size = nresidual + fread(scratch_buffer.get() + nresidual,
-                               1,
-                               copy_params.buffer_size - nresidual,
-                               p_file);
+                                   block.first_row_index));
+      parser_peak_bytes = std::max(parser_peak_bytes, threads.size() * alloc_size);
 
-      begin_pos = 0;
+      current_pos += block_size;
+      has_block = block_reader.next(block);
 
       while (threads.size() > 0) {
         int nready = 0;
@@ -3953,11 +4114,12 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
         }
 
         if (nready == 0) {
-          std::this_thread::yield();
+          // don't spin, the parser threads need the cores
+          threads.front().wait_for(std::chrono::milliseconds(1));
         }
 
         // on eof, wait all threads to finish
-        if (0 == size) {
+        if (!has_block) {
           continue;
         }
 
@@ -3986,8 +4148,27 @@ ImportStatus Importer::importDelimited(const std::string& file_path,
     for (auto& p : threads) {
       p.wait();
     }
+    reader_read_ms = block_reader.readMs();
+    reader_split_ms = block_reader.splitMs();
+    reader_peak_bytes = block_reader.peakQueuedBytes();
   }
 
+  const auto import_ms = std::max(timer_stop(import_timer), int64_t(1));
+  const auto rows_per_sec = [&import_status](const int64_t ms) {
+    return ms ? static_cast<int64_t>(import_status.rows_completed * 1000. / ms)
+              : int64_t(0);
+  };
+  LOG(INFO) << "Imported " << import_status.rows_completed << " rows from " << file_path
+            << " in " << import_ms << "ms using " << max_threads
+            << " threads, stages (busy ms, rows/s, buffered MB): read " << reader_read_ms
+            << ", " << rows_per_sec(reader_read_ms) << ", "
+            << reader_peak_bytes / (1024 * 1024) << "; split " << reader_split_ms << ", "
+            << rows_per_sec(reader_split_ms) << "; parse " << import_status.parse_ms
+            << ", " << rows_per_sec(import_status.parse_ms) << ", "
+            << parser_peak_bytes / (1024 * 1024) << "; load " << import_status.load_ms
+            << ", " << rows_per_sec(import_status.load_ms)
+            << "; peak RSS: " << get_peak_rss() / (1024 * 1024) << "MB";
+
   checkpoint(start_epoch);
 
   // must set import_status.load_truncated before closing this end of pipe
@@ -42,6 +42,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "../Catalog/Catalog.h"
@@ -236,9 +237,9 @@ class TypedImportBuffer : boost::noncopyable {
 
   void addDouble(const double v) { double_buffer_->push_back(v); }
 
-  void addString(const std::string& v) { string_buffer_->push_back(v); }
+  void addString(const std::string_view v) { string_buffer_->emplace_back(v); }
 
-  void addGeoString(const std::string& v) { geo_string_buffer_->push_back(v); }
+  void addGeoString(const std::string_view v) { geo_string_buffer_->emplace_back(v); }
 
   void addArray(const ArrayDatum& v) { array_buffer_->push_back(v); }
 
@@ -483,7 +484,7 @@ class TypedImportBuffer : boost::noncopyable {
                           BadRowsTracker* bad_rows_tracker);
 
   void add_value(const ColumnDescriptor* cd,
-                 const std::string& val,
+                 const std::string_view val,
                  const bool is_null,
                  const CopyParams& copy_params,
                  const int64_t replicate_count = 0);
@@ -615,6 +616,9 @@ struct ImportStatus {
   std::chrono::duration<size_t, std::milli> elapsed;
   bool load_truncated;
   int thread_id;  // to recall thread_id after thread exit
+  // time the import threads spent parsing rows and loading them, summed over threads
+  int64_t parse_ms;
+  int64_t load_ms;
   ImportStatus()
       : start(std::chrono::steady_clock::now())
       , rows_completed(0)
@@ -622,11 +626,15 @@ struct ImportStatus {
       , rows_rejected(0)
       , elapsed(0)
       , load_truncated(0)
-      , thread_id(0) {}
+      , thread_id(0)
+      , parse_ms(0)
+      , load_ms(0) {}
 
   ImportStatus& operator+=(const ImportStatus& is) {
     rows_completed += is.rows_completed;
     rows_rejected += is.rows_rejected;
+    parse_ms += is.parse_ms;
+    load_ms += is.load_ms;
 
     return *this;
   }
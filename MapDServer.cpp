@@ -36,6 +36,7 @@
 #include "MapDRelease.h"
 
 #include "Archive/S3Archive.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "Shared/Logger.h"
 #include "Shared/MapDParameters.h"
 #include "Shared/file_delete.h"
@@ -79,6 +80,9 @@ extern size_t g_max_memory_allocation_size;
 extern size_t g_min_memory_allocation_size;
 extern bool g_enable_experimental_string_functions;
 extern bool g_enable_table_functions;
+extern bool g_enable_chunk_bloom_filters;
+extern bool g_enable_chunk_index_snapshot;
+extern int g_approx_percentile_compression;
 
 bool g_enable_thrift_logs{false};
 
@@ -383,10 +387,39 @@ void MapDProgramOptions::fillOptions() {
                               ->default_value(g_bigint_count)
                               ->implicit_value(false),
                           "Use 64-bit count.");
+  help_desc.add_options()(
+      "buffer-eviction-policy",
+      po::value<std::string>(&mapd_parameters.buffer_eviction_policy)
+          ->default_value(mapd_parameters.buffer_eviction_policy),
+      "Eviction policy for the CPU and GPU buffer pools: 'lru' (least recently used) "
+      "or 'lru-k' (scan resistant, ranks chunks by their second most recent access).");
+  help_desc.add_options()(
+      "buffer-pool-warm-restart-max-mb-per-sec",
+      po::value<size_t>(&mapd_parameters.buffer_pool_warm_restart_max_mb_per_sec)
+          ->default_value(mapd_parameters.buffer_pool_warm_restart_max_mb_per_sec),
+      "Max rate, in MB per second, of the buffer pool reload at startup (0 is "
+      "unthrottled).");
+  help_desc.add_options()(
+      "buffer-pool-warm-restart-max-pool-fill",
+      po::value<double>(&mapd_parameters.buffer_pool_warm_restart_max_pool_fill)
+          ->default_value(mapd_parameters.buffer_pool_warm_restart_max_pool_fill),
+      "Stop reloading chunks into a buffer pool once this fraction of it is in use.");
+  help_desc.add_options()(
+      "buffer-pool-warm-restart-save-interval",
+      po::value<size_t>(&mapd_parameters.buffer_pool_warm_restart_save_interval)
+          ->default_value(mapd_parameters.buffer_pool_warm_restart_save_interval),
+      "Interval, in seconds, between the recordings of the buffer pool chunks (0 only "
+      "records them at shutdown).");
   help_desc.add_options()("calcite-max-mem",
                           po::value<size_t>(&mapd_parameters.calcite_max_mem)
                               ->default_value(mapd_parameters.calcite_max_mem),
                           "Max memory available to calcite JVM.");
+  help_desc.add_options()(
+      "calcite-plan-cache-size",
+      po::value<size_t>(&mapd_parameters.calcite_plan_cache_size)
+          ->default_value(mapd_parameters.calcite_plan_cache_size),
+      "Number of query plans returned by the calcite server to keep for queries with the "
+      "same text, user and database. 0 disables the cache.");
   if (!dist_v5_) {
     help_desc.add_options()("calcite-port",
                             po::value<int>(&mapd_parameters.calcite_port)
@@ -431,6 +464,12 @@ void MapDProgramOptions::fillOptions() {
                               ->default_value(dynamic_watchdog_time_limit)
                               ->implicit_value(10000),
                           "Dynamic watchdog time limit, in milliseconds.");
+  help_desc.add_options()(
+      "enable-buffer-pool-warm-restart",
+      po::value<bool>(&mapd_parameters.enable_buffer_pool_warm_restart)
+          ->default_value(mapd_parameters.enable_buffer_pool_warm_restart)
+          ->implicit_value(true),
+      "Record the chunks in the CPU and GPU buffer pools and reload them at startup.");
   help_desc.add_options()("enable-debug-timer",
                           po::value<bool>(&g_enable_debug_timer)
                               ->default_value(g_enable_debug_timer)
@@ -471,6 +510,12 @@ void MapDProgramOptions::fillOptions() {
                               ->default_value(enable_watchdog)
                               ->implicit_value(true),
                           "Enable watchdog.");
+  help_desc.add_options()(
+      "file-read-backend",
+      po::value<std::string>(&mapd_parameters.file_read_backend)
+          ->default_value(mapd_parameters.file_read_backend),
+      "How table data pages are read from disk: 'buffered' (through the OS page cache) "
+      "or 'direct' (O_DIRECT, bypasses the OS page cache).");
   help_desc.add_options()(
       "filter-push-down-low-frac",
       po::value<float>(&g_filter_push_down_low_frac)
@@ -510,6 +555,13 @@ void MapDProgramOptions::fillOptions() {
           ->default_value(g_hll_precision_bits)
           ->implicit_value(g_hll_precision_bits),
       "Number of bits used from the hash value used to specify the bucket number.");
+  help_desc.add_options()(
+      "approx-percentile-compression",
+      po::value<int>(&g_approx_percentile_compression)
+          ->default_value(g_approx_percentile_compression)
+          ->implicit_value(g_approx_percentile_compression),
+      "Accuracy of APPROX_PERCENTILE, the number of centroids its digests keep per "
+      "group. Higher is more accurate and uses more memory.");
   if (!dist_v5_) {
     help_desc.add_options()("http-port",
                             po::value<int>(&http_port)->default_value(http_port),
@@ -605,6 +657,21 @@ void MapDProgramOptions::fillAdvancedOptions() {
           ->implicit_value(true),
       "Enable additional calcite (query plan) optimizations when a view is part of the "
       "query.");
+  developer_desc.add_options()(
+      "enable-chunk-bloom-filters",
+      po::value<bool>(&g_enable_chunk_bloom_filters)
+          ->default_value(g_enable_chunk_bloom_filters)
+          ->implicit_value(true),
+      "Build bloom filters for the integer, time and dictionary encoded string chunks "
+      "created from now on, to skip fragments for equality and IN predicates. Takes "
+      "3KB of memory per chunk.");
+  developer_desc.add_options()(
+      "enable-chunk-index-snapshot",
+      po::value<bool>(&g_enable_chunk_index_snapshot)
+          ->default_value(g_enable_chunk_index_snapshot)
+          ->implicit_value(true),
+      "Save the page headers and free pages of each table at checkpoint and load them "
+      "at startup instead of reading the header of every page.");
   developer_desc.add_options()(
       "enable-columnar-output",
       po::value<bool>(&g_enable_columnar_output)
@@ -628,6 +695,13 @@ void MapDProgramOptions::fillAdvancedOptions() {
           ->default_value(g_enable_smem_group_by)
           ->implicit_value(true),
       "Enable using GPU shared memory for some GROUP BY queries.");
+  developer_desc.add_options()(
+      "enable-tagged-baseline-hash",
+      po::value<bool>(&g_enable_tagged_baseline_hash)
+          ->default_value(g_enable_tagged_baseline_hash)
+          ->implicit_value(true),
+      "Use power of two sized baseline hash tables with a hash tag per entry for CPU "
+      "GROUP BY queries.");
   developer_desc.add_options()("enable-direct-columnarization",
                                po::value<bool>(&g_enable_direct_columnarization)
                                    ->default_value(g_enable_direct_columnarization)
@@ -657,6 +731,19 @@ void MapDProgramOptions::fillAdvancedOptions() {
           ->default_value(intel_jit_profile)
           ->implicit_value(true),
       "Enable runtime support for the JIT code profiling using Intel VTune.");
+  developer_desc.add_options()(
+      "enable-persistent-code-cache",
+      po::value<bool>(&g_enable_persistent_code_cache)
+          ->default_value(g_enable_persistent_code_cache)
+          ->implicit_value(true),
+      "Keep the object code of CPU query kernels under the data directory, so that "
+      "queries don't have to be compiled again after a server restart.");
+  developer_desc.add_options()(
+      "persistent-code-cache-max-size",
+      po::value<size_t>(&g_persistent_code_cache_max_size)
+          ->default_value(g_persistent_code_cache_max_size),
+      "Maximum size in bytes of the persistent code cache. The least recently used "
+      "kernels are removed first.");
   developer_desc.add_options()(
       "skip-intermediate-count",
       po::value<bool>(&g_skip_intermediate_count)
@@ -700,6 +787,83 @@ void MapDProgramOptions::fillAdvancedOptions() {
                                "to CPU after execution. When disabled, pre-flight "
                                "count queries are used to size "
                                "the output buffer for projection queries.");
+  developer_desc.add_options()(
+      "chunk-prefetch-depth",
+      po::value<size_t>(&g_chunk_prefetch_depth)->default_value(g_chunk_prefetch_depth),
+      "Number of fragment kernels ahead of the completed ones whose outer table chunks "
+      "are loaded into the CPU buffer pool in the background. 0 disables prefetching.");
+  developer_desc.add_options()(
+      "max-cpu-kernels-per-query",
+      po::value<size_t>(&g_max_cpu_kernels_per_query)
+          ->default_value(g_max_cpu_kernels_per_query),
+      "Maximum number of fragment kernels of one query which run concurrently in the "
+      "shared CPU kernel pool. 0 lets a query use every worker of the pool.");
+  developer_desc.add_options()(
+      "max-concurrent-queries",
+      po::value<size_t>(&g_max_concurrent_queries)
+          ->default_value(g_max_concurrent_queries),
+      "Maximum number of queries which execute at the same time, each on its own "
+      "executor. Further queries wait in line. 1 runs queries one after the other.");
+  developer_desc.add_options()(
+      "enable-external-aggregation",
+      po::value<bool>(&g_enable_external_aggregation)
+          ->default_value(g_enable_external_aggregation)
+          ->implicit_value(true),
+      "Run group by queries with more groups than fit in memory in several passes, one "
+      "per partition of a group key.");
+  developer_desc.add_options()(
+      "external-aggregation-threshold",
+      po::value<size_t>(&g_external_aggregation_threshold)
+          ->default_value(g_external_aggregation_threshold),
+      "Estimated number of groups above which a group by query runs partitioned.");
+  developer_desc.add_options()(
+      "external-aggregation-partitions",
+      po::value<size_t>(&g_external_aggregation_partitions)
+          ->default_value(g_external_aggregation_partitions),
+      "Initial number of partitions of a partitioned group by query. It doubles when a "
+      "partition still doesn't fit.");
+  developer_desc.add_options()(
+      "enable-vectorized-cpu-codegen",
+      po::value<bool>(&g_enable_vectorized_cpu_codegen)
+          ->default_value(g_enable_vectorized_cpu_codegen)
+          ->implicit_value(true),
+      "Evaluate the simple filters of CPU aggregate queries on batches of rows, in loops "
+      "the JIT compiles to SIMD instructions of the host CPU.");
+  developer_desc.add_options()(
+      "enable-count-distinct-hash-set",
+      po::value<bool>(&g_enable_count_distinct_hash_set)
+          ->default_value(g_enable_count_distinct_hash_set)
+          ->implicit_value(true),
+      "Use open addressing hash sets instead of std::set for the exact COUNT(DISTINCT) "
+      "of arguments whose range is too wide for a bitmap.");
+  developer_desc.add_options()(
+      "enable-query-result-cache",
+      po::value<bool>(&g_enable_query_result_cache)
+          ->default_value(g_enable_query_result_cache)
+          ->implicit_value(true),
+      "Cache the results of SELECT statements until the tables they read change.");
+  developer_desc.add_options()(
+      "query-result-cache-max-bytes",
+      po::value<size_t>(&g_query_result_cache_max_bytes)
+          ->default_value(g_query_result_cache_max_bytes),
+      "Maximum size in bytes of the cached query results, the least recently used "
+      "results are evicted first.");
+  developer_desc.add_options()(
+      "join-hash-table-cache-max-bytes",
+      po::value<size_t>(&g_join_hash_table_cache_max_bytes)
+          ->default_value(g_join_hash_table_cache_max_bytes),
+      "Maximum size in bytes of each of the perfect and baseline join hash table caches, "
+      "the least recently used tables are evicted first. 0 means no limit.");
+  developer_desc.add_options()(
+      "chunk-prefetch-max-pool-fill",
+      po::value<double>(&g_chunk_prefetch_max_pool_fill)
+          ->default_value(g_chunk_prefetch_max_pool_fill),
+      "Stop prefetching chunks once the CPU buffer pool is filled past this fraction.");
+  developer_desc.add_options()(
+      "chunk-prefetch-io-threads",
+      po::value<size_t>(&g_chunk_prefetch_io_threads)
+          ->default_value(g_chunk_prefetch_io_threads),
+      "Number of threads, shared by all the queries, which read the prefetched chunks.");
 
   developer_desc.add_options()("ssl-cert",
                                po::value<std::string>(&mapd_parameters.ssl_cert_file)
@@ -944,6 +1108,12 @@ boost::optional<int> MapDProgramOptions::parse_command_line(int argc,
     return 1;
   }
 
+  if (g_approx_percentile_compression < 10 || g_approx_percentile_compression > 10000) {
+    std::cerr << "approx-percentile-compression must be between 10 and 10000."
+              << std::endl;
+    return 1;
+  }
+
   if (!g_from_table_reordering) {
     LOG(INFO) << " From clause table reordering is disabled";
   }
@@ -1099,6 +1269,11 @@ int startMapdServer(MapDProgramOptions& prog_config_opts, bool start_http_server
     std::locale::global(generator.generate(""));
   }
 
+  if (g_enable_persistent_code_cache) {
+    PersistentCodeCache::init(prog_config_opts.base_path,
+                              g_persistent_code_cache_max_size);
+  }
+
   try {
     g_mapd_handler =
         mapd::make_shared<MapDHandler>(prog_config_opts.db_leaves,
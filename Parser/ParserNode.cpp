@@ -3112,14 +3112,59 @@ void DDLStmt::setColumnDescriptor(ColumnDescriptor& cd, const ColumnDef* coldef)
       }
     } else if (boost::iequals(comp, "rl")) {
       // run length encoding
+      if (!cd.columnType.is_integer() && !cd.columnType.is_time() &&
+          !cd.columnType.is_decimal() && !cd.columnType.is_boolean()) {
+        throw std::runtime_error(cd.columnName +
+                                 ": RL encoding is only supported for integer, "
+                                 "boolean, decimal or time columns.");
+      }
+      if (compression->get_encoding_param() != 0) {
+        throw std::runtime_error(cd.columnName +
+                                 ": RL encoding doesn't take a compression parameter.");
+      }
       cd.columnType.set_compression(kENCODING_RL);
       cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("RL(Run Length) encoding not supported yet.");
     } else if (boost::iequals(comp, "diff")) {
       // differential encoding
+      if (!cd.columnType.is_integer() && !cd.columnType.is_time() &&
+          !cd.columnType.is_decimal()) {
+        throw std::runtime_error(
+            cd.columnName +
+            ": DIFF encoding is only supported for integer, decimal or time columns.");
+      }
+      if (compression->get_encoding_param() == 0) {
+        comp_param = type == kSMALLINT ? 8 : 16;  // default to 16-bits
+      } else {
+        comp_param = compression->get_encoding_param();
+      }
+      switch (type) {
+        case kTINYINT:
+          throw std::runtime_error(cd.columnName +
+                                   ": DIFF encoding is not supported for TINYINT.");
+        case kSMALLINT:
+          if (comp_param != 8) {
+            throw std::runtime_error(cd.columnName +
+                                     ": Compression parameter for DIFF encoding on "
+                                     "SMALLINT must be 8.");
+          }
+          break;
+        case kINT:
+          if (comp_param != 8 && comp_param != 16) {
+            throw std::runtime_error(cd.columnName +
+                                     ": Compression parameter for DIFF encoding on "
+                                     "INTEGER must be 8 or 16.");
+          }
+          break;
+        default:
+          if (comp_param != 8 && comp_param != 16 && comp_param != 32) {
+            throw std::runtime_error(cd.columnName +
+                                     ": Compression parameter for DIFF encoding must "
+                                     "be 8, 16 or 32.");
+          }
+          break;
+      }
       cd.columnType.set_compression(kENCODING_DIFF);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("DIFF(differential) encoding not supported yet.");
+      cd.columnType.set_comp_param(comp_param);
     } else if (boost::iequals(comp, "dict")) {
       if (!cd.columnType.is_string() && !cd.columnType.is_string_array()) {
         throw std::runtime_error(
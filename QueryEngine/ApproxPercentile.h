@@ -0,0 +1,200 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ApproxPercentile.h
+ * @brief   Functions used to work with the t-digests of APPROX_PERCENTILE.
+ *
+ * Every group owns a fixed size buffer, its slot in the group by buffer holds the address
+ * of it like for the count distinct bitmaps. The buffer starts with a header, followed by
+ * room for twice the compression centroids. The values are appended as centroids of
+ * weight one; once the buffer is full, the centroids are sorted and the neighbours which
+ * fit in the same unit of the k1 scale function of the t-digest are merged, which leaves
+ * at most compression + 2 of them. Two digests are merged by adding the centroids of one
+ * to the other the same way, the partial results can be reduced in any order.
+ */
+
+#ifndef QUERYENGINE_APPROXPERCENTILE_H
+#define QUERYENGINE_APPROXPERCENTILE_H
+
+#include "../Shared/Logger.h"
+#include "../Shared/sqltypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+extern int g_approx_percentile_compression;
+
+struct ApproxPercentileCentroid {
+  double mean;
+  double weight;
+};
+
+struct ApproxPercentileDigest {
+  double percentile;  // between 0 and 1
+  double min;
+  double max;
+  double total_weight;
+  uint32_t capacity;  // number of centroids the buffer has room for
+  uint32_t size;      // number of centroids in use
+};
+
+inline size_t approx_percentile_buffer_size(const int compression) {
+  return sizeof(ApproxPercentileDigest) +
+         2 * static_cast<size_t>(compression) * sizeof(ApproxPercentileCentroid);
+}
+
+inline ApproxPercentileCentroid* approx_percentile_centroids(
+    ApproxPercentileDigest* digest) {
+  return reinterpret_cast<ApproxPercentileCentroid*>(digest + 1);
+}
+
+inline const ApproxPercentileCentroid* approx_percentile_centroids(
+    const ApproxPercentileDigest* digest) {
+  return reinterpret_cast<const ApproxPercentileCentroid*>(digest + 1);
+}
+
+inline void approx_percentile_init(int8_t* buffer,
+                                   const double percentile,
+                                   const int compression) {
+  auto digest = reinterpret_cast<ApproxPercentileDigest*>(buffer);
+  digest->percentile = percentile;
+  digest->min = std::numeric_limits<double>::max();
+  digest->max = std::numeric_limits<double>::lowest();
+  digest->total_weight = 0;
+  digest->capacity = 2 * compression;
+  digest->size = 0;
+}
+
+inline void approx_percentile_sort(ApproxPercentileCentroid* centroids,
+                                   const size_t size) {
+  std::sort(centroids,
+            centroids + size,
+            [](const ApproxPercentileCentroid& lhs, const ApproxPercentileCentroid& rhs) {
+              return lhs.mean < rhs.mean;
+            });
+}
+
+inline void approx_percentile_compress(ApproxPercentileDigest* digest) {
+  if (!digest->size) {
+    return;
+  }
+  auto centroids = approx_percentile_centroids(digest);
+  approx_percentile_sort(centroids, digest->size);
+  const double compression = digest->capacity / 2;
+  // Weight at which the k1 scale, compression / (2 * pi) * asin(2 * q - 1), is one unit
+  // past the given weight.
+  const auto weight_limit = [compression, digest](const double weight) {
+    const double q = weight / digest->total_weight;
+    const double k = compression / (2 * M_PI) * std::asin(2 * q - 1) + 1;
+    if (k >= compression / 4) {
+      return digest->total_weight;
+    }
+    return (std::sin(k * 2 * M_PI / compression) + 1) / 2 * digest->total_weight;
+  };
+  uint32_t last = 0;
+  double weight_so_far = centroids[0].weight;
+  double limit = weight_limit(0);
+  for (uint32_t i = 1; i < digest->size; ++i) {
+    const auto centroid = centroids[i];
+    if (weight_so_far + centroid.weight <= limit) {
+      auto& merged = centroids[last];
+      merged.weight += centroid.weight;
+      merged.mean += (centroid.mean - merged.mean) * centroid.weight / merged.weight;
+    } else {
+      limit = weight_limit(weight_so_far);
+      centroids[++last] = centroid;
+    }
+    weight_so_far += centroid.weight;
+  }
+  digest->size = last + 1;
+}
+
+inline void approx_percentile_add(ApproxPercentileDigest* digest,
+                                  const double mean,
+                                  const double weight) {
+  if (digest->size == digest->capacity) {
+    approx_percentile_compress(digest);
+  }
+  approx_percentile_centroids(digest)[digest->size++] = {mean, weight};
+  digest->total_weight += weight;
+  digest->min = std::min(digest->min, mean);
+  digest->max = std::max(digest->max, mean);
+}
+
+// Merges the digest of a partial result into the one of the slot. A slot of an empty
+// input doesn't have a digest yet, it takes over the other one.
+inline void approx_percentile_merge(const int64_t new_digest_handle,
+                                    int64_t* old_digest_handle_ptr) {
+  CHECK(old_digest_handle_ptr);
+  if (!new_digest_handle) {
+    return;
+  }
+  if (!*old_digest_handle_ptr) {
+    *old_digest_handle_ptr = new_digest_handle;
+    return;
+  }
+  auto new_digest = reinterpret_cast<const ApproxPercentileDigest*>(new_digest_handle);
+  auto old_digest = reinterpret_cast<ApproxPercentileDigest*>(*old_digest_handle_ptr);
+  if (new_digest == old_digest) {
+    return;
+  }
+  const auto new_centroids = approx_percentile_centroids(new_digest);
+  for (uint32_t i = 0; i < new_digest->size; ++i) {
+    approx_percentile_add(old_digest, new_centroids[i].mean, new_centroids[i].weight);
+  }
+}
+
+// Interpolates between the centroids, which stand for the values around their weight
+// midpoint, and between the extreme centroids and the minimum and maximum values.
+inline double approx_percentile_value(const int64_t digest_handle) {
+  const auto digest = reinterpret_cast<const ApproxPercentileDigest*>(digest_handle);
+  if (!digest || !digest->size) {
+    return NULL_DOUBLE;
+  }
+  // the digest may be read concurrently, sort a copy of the centroids
+  const auto centroids_begin = approx_percentile_centroids(digest);
+  std::vector<ApproxPercentileCentroid> centroids(centroids_begin,
+                                                  centroids_begin + digest->size);
+  approx_percentile_sort(centroids.data(), centroids.size());
+  const double target_weight = digest->percentile * digest->total_weight;
+  double prev_mean = digest->min;
+  double prev_weight = 0;
+  double weight_so_far = 0;
+  for (const auto& centroid : centroids) {
+    const double mid_weight = weight_so_far + centroid.weight / 2;
+    if (target_weight <= mid_weight) {
+      if (mid_weight == prev_weight) {
+        return centroid.mean;
+      }
+      return prev_mean + (centroid.mean - prev_mean) * (target_weight - prev_weight) /
+                             (mid_weight - prev_weight);
+    }
+    prev_mean = centroid.mean;
+    prev_weight = mid_weight;
+    weight_so_far += centroid.weight;
+  }
+  if (digest->total_weight == prev_weight) {
+    return digest->max;
+  }
+  return prev_mean + (digest->max - prev_mean) * (target_weight - prev_weight) /
+                         (digest->total_weight - prev_weight);
+}
+
+#endif  // QUERYENGINE_APPROXPERCENTILE_H
@@ -140,7 +140,7 @@ std::vector<llvm::Value*> CodeGenerator::codegenArrayExpr(
     cgen_state_->emitExternalCall(
         "register_buffer_with_executor_rsm",
         llvm::Type::getVoidTy(cgen_state_->context_),
-        {cgen_state_->llInt(reinterpret_cast<int64_t>(executor())),
+        {cgen_state_->llHostAddress(executor()),
          allocated_target_buffer});
   }
   llvm::Value* casted_allocated_target_buffer =
@@ -170,13 +170,15 @@ class ArrowResultSetConverter {
                           const ExecutorDeviceType device_type,
                           const int32_t device_id,
                           const std::vector<std::string>& col_names,
-                          const int32_t first_n)
+                          const int32_t first_n,
+                          const size_t record_batch_rows = 0)
       : results_(results)
       , data_mgr_(data_mgr)
       , device_type_(device_type)
       , device_id_(device_id)
       , col_names_(col_names)
-      , top_n_(first_n) {}
+      , top_n_(first_n)
+      , record_batch_rows_(record_batch_rows) {}
 
   ArrowResult getArrowResult() const { return getArrowResultImpl(); }
 
@@ -185,10 +187,14 @@ class ArrowResultSetConverter {
                           const std::vector<std::string>& col_names,
                           const int32_t first_n)
       : results_(results), col_names_(col_names), top_n_(first_n) {}
-  std::shared_ptr<arrow::RecordBatch> convertToArrow(
-      arrow::ipc::DictionaryMemo& memo) const;
+  std::shared_ptr<arrow::Schema> getArrowSchema(arrow::ipc::DictionaryMemo& memo) const;
+  size_t getEntryCount() const;
+  // Converts the entries in [first_entry, last_entry) to a record batch, the empty
+  // entries are skipped.
   std::shared_ptr<arrow::RecordBatch> getArrowBatch(
-      const std::shared_ptr<arrow::Schema>& schema) const;
+      const std::shared_ptr<arrow::Schema>& schema,
+      const size_t first_entry,
+      const size_t last_entry) const;
   ArrowResult getArrowResultImpl() const;
   std::shared_ptr<arrow::Field> makeField(
       const std::string name,
@@ -203,6 +209,8 @@ class ArrowResultSetConverter {
     std::shared_ptr<arrow::Buffer> records;
   };
   SerializedArrowOutput getSerializedArrowOutput() const;
+  std::shared_ptr<arrow::Buffer> serializeRecordBatch(
+      const arrow::RecordBatch& record_batch) const;
 
   struct ColumnBuilder {
     std::shared_ptr<arrow::Field> field;
@@ -234,6 +242,9 @@ class ArrowResultSetConverter {
   int32_t device_id_ = 0;
   std::vector<std::string> col_names_;
   int32_t top_n_;
+  // Clients opt into data frames made of several record batches, which they have to read
+  // to the end of the buffer; 0 keeps the single record batch layout.
+  size_t record_batch_rows_ = 0;
 
   friend class ArrowResultSet;
 };
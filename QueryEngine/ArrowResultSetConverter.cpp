@@ -152,10 +152,9 @@ void create_or_append_validity(const ScalarTargetValue& value,
 
 namespace arrow {
 
-key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
-  if (!data->size()) {
-    return IPC_PRIVATE;
-  }
+// Creates a new shared memory segment of shmsz bytes and attaches it at *ipc_ptr.
+key_t create_and_attach_shm(const int64_t shmsz, void** ipc_ptr) {
+  CHECK_GT(shmsz, 0);
   // Generate a new key for a shared memory segment. Keys to shared memory segments
   // are OS global, so we need to try a new key if we encounter a collision. It seems
   // incremental keygen would be deterministically worst-case. If we use a hash
@@ -163,7 +162,6 @@ key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
   // the same nonce, so using rand() in lieu of a better approach
   // TODO(ptaylor): Is this common? Are these assumptions true?
   auto key = static_cast<key_t>(rand());
-  const auto shmsz = data->size();
   int shmid = -1;
   // IPC_CREAT - indicates we want to create a new segment for this key if it doesn't
   // exist IPC_EXCL - ensures failure if a segment already exists for this key
@@ -182,20 +180,91 @@ key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
     key = static_cast<key_t>(rand());
   }
   // get a pointer to the shared memory segment
-  auto ipc_ptr = shmat(shmid, NULL, 0);
-  if (reinterpret_cast<int64_t>(ipc_ptr) == -1) {
+  *ipc_ptr = shmat(shmid, NULL, 0);
+  if (reinterpret_cast<int64_t>(*ipc_ptr) == -1) {
+    shmctl(shmid, IPC_RMID, 0);
     throw std::runtime_error("failed to attach a shared memory");
   }
+  return key;
+}
 
-  // copy the arrow records buffer to shared memory
-  // TODO(ptaylor): I'm sure it's possible to tell Arrow's RecordBatchStreamWriter to
-  // write directly to the shared memory segment as a sink
+key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
+  if (!data->size()) {
+    return IPC_PRIVATE;
+  }
+  void* ipc_ptr{nullptr};
+  const auto key = create_and_attach_shm(data->size(), &ipc_ptr);
+  // copy the arrow buffer to shared memory
   memcpy(ipc_ptr, data->data(), data->size());
   // detach from the shared memory segment
   shmdt(ipc_ptr);
   return key;
 }
 
+// Shared memory segment the record batches are serialized into as soon as they are
+// converted, so only one converted batch is alive at a time. System V segments can't
+// grow, so a batch which doesn't fit moves the records written so far to a new segment
+// at least twice as big. The segment is removed unless release() was called.
+class ShmRecordWriter {
+ public:
+  ~ShmRecordWriter() {
+    if (ipc_ptr_) {
+      removeSegment();
+    }
+  }
+
+  // Appends the batch to the segment. The first segment is sized assuming the
+  // batches_left batches still to come serialize to as many bytes as this one.
+  void write(const RecordBatch& record_batch, const size_t batches_left) {
+    ARROW_THROW_NOT_OK(record_batch.Validate());
+    int64_t batch_size{0};
+    ARROW_THROW_NOT_OK(ipc::GetRecordBatchSize(record_batch, &batch_size));
+    if (size_ + batch_size > capacity_) {
+      const auto capacity =
+          std::max(size_ + batch_size * static_cast<int64_t>(batches_left + 1),
+                   2 * capacity_);
+      void* ipc_ptr{nullptr};
+      const auto key = create_and_attach_shm(capacity, &ipc_ptr);
+      if (ipc_ptr_) {
+        memcpy(ipc_ptr, ipc_ptr_, size_);
+        removeSegment();
+      }
+      key_ = key;
+      ipc_ptr_ = ipc_ptr;
+      capacity_ = capacity;
+    }
+    auto shm_buffer = std::make_shared<MutableBuffer>(
+        static_cast<uint8_t*>(ipc_ptr_) + size_, batch_size);
+    io::FixedSizeBufferWriter shm_writer(shm_buffer);
+    ARROW_THROW_NOT_OK(
+        ipc::SerializeRecordBatch(record_batch, default_memory_pool(), &shm_writer));
+    size_ += batch_size;
+  }
+
+  // Detaches from the segment and hands it over to the client, which only reads the
+  // first records_size bytes. Returns IPC_PRIVATE if there are no records.
+  key_t release(int64_t& records_size) {
+    records_size = size_;
+    if (ipc_ptr_) {
+      shmdt(ipc_ptr_);
+      ipc_ptr_ = nullptr;
+    }
+    return key_;
+  }
+
+ private:
+  void removeSegment() {
+    shmdt(ipc_ptr_);
+    ipc_ptr_ = nullptr;
+    shmctl(shmget(key_, capacity_, 0666), IPC_RMID, 0);
+  }
+
+  key_t key_{IPC_PRIVATE};
+  void* ipc_ptr_{nullptr};
+  int64_t capacity_{0};
+  int64_t size_{0};
+};
+
 }  // namespace arrow
 
 // WARN(ptaylor): users are responsible for detaching and removing shared memory segments,
@@ -215,9 +284,11 @@ key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
 //
 // TODO(miyu): verify if the server still needs to free its own copies after last uses
 ArrowResult ArrowResultSetConverter::getArrowResultImpl() const {
-  const auto serialized_arrow_output = getSerializedArrowOutput();
-  const auto& serialized_schema = serialized_arrow_output.schema;
-  const auto& serialized_records = serialized_arrow_output.records;
+  arrow::ipc::DictionaryMemo dict_memo;
+  const auto schema = getArrowSchema(dict_memo);
+  std::shared_ptr<arrow::Buffer> serialized_schema;
+  ARROW_THROW_NOT_OK(arrow::ipc::SerializeSchema(
+      *schema, arrow::default_memory_pool(), &serialized_schema));
 
   const auto schema_key = arrow::get_and_copy_to_shm(serialized_schema);
   CHECK(schema_key != IPC_PRIVATE);
@@ -226,7 +297,24 @@ ArrowResult ArrowResultSetConverter::getArrowResultImpl() const {
          reinterpret_cast<const unsigned char*>(&schema_key),
          sizeof(key_t));
   if (device_type_ == ExecutorDeviceType::CPU) {
-    const auto record_key = arrow::get_and_copy_to_shm(serialized_records);
+    // Converts the result to record batches of at most record_batch_rows_ entries, or
+    // to a single record batch if it's 0, and writes each of them to shared memory
+    // right away. Empty batches are left out.
+    const auto entry_count = getEntryCount();
+    const auto batch_entry_count = record_batch_rows_ ? record_batch_rows_ : entry_count;
+    arrow::ShmRecordWriter shm_writer;
+    for (size_t start_entry = 0; start_entry < entry_count;
+         start_entry += batch_entry_count) {
+      const auto end_entry = std::min(entry_count, start_entry + batch_entry_count);
+      const auto record_batch = getArrowBatch(schema, start_entry, end_entry);
+      if (record_batch->num_rows()) {
+        const auto batches_left =
+            (entry_count - end_entry + batch_entry_count - 1) / batch_entry_count;
+        shm_writer.write(*record_batch, batches_left);
+      }
+    }
+    int64_t records_size{0};
+    const auto record_key = shm_writer.release(records_size);
     std::vector<char> record_handle_buffer(sizeof(key_t), 0);
     memcpy(&record_handle_buffer[0],
            reinterpret_cast<const unsigned char*>(&record_key),
@@ -235,10 +323,12 @@ ArrowResult ArrowResultSetConverter::getArrowResultImpl() const {
     return {schema_handle_buffer,
             serialized_schema->size(),
             record_handle_buffer,
-            serialized_records->size(),
+            records_size,
             nullptr};
   }
 #ifdef HAVE_CUDA
+  const auto serialized_records =
+      serializeRecordBatch(*getArrowBatch(schema, 0, getEntryCount()));
   if (serialized_records->size()) {
     CHECK(data_mgr_);
     const auto cuda_mgr = data_mgr_->getCudaMgr();
@@ -269,23 +359,28 @@ ArrowResult ArrowResultSetConverter::getArrowResultImpl() const {
 ArrowResultSetConverter::SerializedArrowOutput
 ArrowResultSetConverter::getSerializedArrowOutput() const {
   arrow::ipc::DictionaryMemo dict_memo;
-  std::shared_ptr<arrow::RecordBatch> arrow_copy = convertToArrow(dict_memo);
-  std::shared_ptr<arrow::Buffer> serialized_records, serialized_schema;
-
+  const auto schema = getArrowSchema(dict_memo);
+  std::shared_ptr<arrow::Buffer> serialized_schema;
   ARROW_THROW_NOT_OK(arrow::ipc::SerializeSchema(
-      *arrow_copy->schema(), arrow::default_memory_pool(), &serialized_schema));
+      *schema, arrow::default_memory_pool(), &serialized_schema));
+  const auto arrow_copy = getArrowBatch(schema, 0, getEntryCount());
+  return {serialized_schema, serializeRecordBatch(*arrow_copy)};
+}
 
-  if (arrow_copy->num_rows()) {
-    ARROW_THROW_NOT_OK(arrow_copy->Validate());
+std::shared_ptr<arrow::Buffer> ArrowResultSetConverter::serializeRecordBatch(
+    const arrow::RecordBatch& record_batch) const {
+  std::shared_ptr<arrow::Buffer> serialized_records;
+  if (record_batch.num_rows()) {
+    ARROW_THROW_NOT_OK(record_batch.Validate());
     ARROW_THROW_NOT_OK(arrow::ipc::SerializeRecordBatch(
-        *arrow_copy, arrow::default_memory_pool(), &serialized_records));
+        record_batch, arrow::default_memory_pool(), &serialized_records));
   } else {
     ARROW_THROW_NOT_OK(arrow::AllocateBuffer(0, &serialized_records));
   }
-  return {serialized_schema, serialized_records};
+  return serialized_records;
 }
 
-std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow(
+std::shared_ptr<arrow::Schema> ArrowResultSetConverter::getArrowSchema(
     arrow::ipc::DictionaryMemo& memo) const {
   const auto col_count = results_->colCount();
   std::vector<std::shared_ptr<arrow::Field>> fields;
@@ -312,16 +407,22 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow(
     }
     fields.push_back(makeField(col_names_.empty() ? "" : col_names_[i], ti, dict));
   }
-  return getArrowBatch(arrow::schema(fields));
+  return arrow::schema(fields);
+}
+
+size_t ArrowResultSetConverter::getEntryCount() const {
+  return top_n_ < 0 ? results_->entryCount()
+                    : std::min(size_t(top_n_), results_->entryCount());
 }
 
 std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
-    const std::shared_ptr<arrow::Schema>& schema) const {
+    const std::shared_ptr<arrow::Schema>& schema,
+    const size_t first_entry,
+    const size_t last_entry) const {
   std::vector<std::shared_ptr<arrow::Array>> result_columns;
 
-  const size_t entry_count = top_n_ < 0
-                                 ? results_->entryCount()
-                                 : std::min(size_t(top_n_), results_->entryCount());
+  CHECK_LE(first_entry, last_entry);
+  const size_t entry_count = last_entry - first_entry;
   if (!entry_count) {
     return ARROW_RECORDBATCH_MAKE(schema, 0, result_columns);
   }
@@ -440,9 +541,9 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
     std::vector<std::vector<std::shared_ptr<std::vector<bool>>>> null_bitmap_segs(
         cpu_count, std::vector<std::shared_ptr<std::vector<bool>>>(col_count, nullptr));
     const auto stride = (entry_count + cpu_count - 1) / cpu_count;
-    for (size_t i = 0, start_entry = 0; start_entry < entry_count;
+    for (size_t i = 0, start_entry = first_entry; start_entry < last_entry;
          ++i, start_entry += stride) {
-      const auto end_entry = std::min(entry_count, start_entry + stride);
+      const auto end_entry = std::min(last_entry, start_entry + stride);
       child_threads.push_back(std::async(std::launch::async,
                                          fetch,
                                          std::ref(column_value_segs[i]),
@@ -463,9 +564,12 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       }
     }
   } else {
-    row_count = fetch(column_values, null_bitmaps, size_t(0), entry_count);
+    row_count = fetch(column_values, null_bitmaps, first_entry, last_entry);
     for (int i = 0; i < schema->num_fields(); ++i) {
       reserveColumnBuilderSize(builders[i], row_count);
+      if (!column_values[i]) {
+        continue;
+      }
       append(builders[i], *column_values[i], null_bitmaps[i]);
     }
   }
@@ -24,10 +24,9 @@
 
 #include <future>
 
-std::vector<std::pair<BaselineJoinHashTable::HashTableCacheKey,
-                      BaselineJoinHashTable::HashTableCacheValue>>
+HashTableCache<BaselineJoinHashTable::HashTableCacheKey,
+               BaselineJoinHashTable::HashTableCacheValue>
     BaselineJoinHashTable::hash_table_cache_;
-std::mutex BaselineJoinHashTable::hash_table_cache_mutex_;
 
 //! Make hash table from an in-flight SQL query's parse tree etc.
 std::shared_ptr<BaselineJoinHashTable> BaselineJoinHashTable::getInstance(
@@ -1264,54 +1263,42 @@ void BaselineJoinHashTable::checkHashJoinReplicationConstraint(const int table_i
   }
 }
 
-const BaselineJoinHashTable::HashTableCacheValue*
-BaselineJoinHashTable::findHashTableOnCpuInCache(const HashTableCacheKey& key) {
-  std::lock_guard<std::mutex> hash_table_cache_lock(hash_table_cache_mutex_);
-  for (const auto& kv : hash_table_cache_) {
-    if (kv.first == key) {
-      return &kv.second;
-    }
-  }
-  return nullptr;
-}
-
 void BaselineJoinHashTable::initHashTableOnCpuFromCache(const HashTableCacheKey& key) {
-  std::lock_guard<std::mutex> hash_table_cache_lock(hash_table_cache_mutex_);
-  for (const auto& kv : hash_table_cache_) {
-    if (kv.first == key) {
-      cpu_hash_table_buff_ = kv.second.buffer;
-      layout_ = kv.second.type;
-      entry_count_ = kv.second.entry_count;
-      emitted_keys_count_ = kv.second.emitted_keys_count;
-      break;
-    }
+  const auto cached = hash_table_cache_.get(key, getInnerTableEpoch());
+  if (cached) {
+    cpu_hash_table_buff_ = cached->buffer;
+    layout_ = cached->type;
+    entry_count_ = cached->entry_count;
+    emitted_keys_count_ = cached->emitted_keys_count;
   }
 }
 
 void BaselineJoinHashTable::putHashTableOnCpuToCache(const HashTableCacheKey& key) {
-  std::lock_guard<std::mutex> hash_table_cache_lock(hash_table_cache_mutex_);
-  for (const auto& kv : hash_table_cache_) {
-    if (std::get<0>(kv) == key) {
-      return;
-    }
-  }
-  hash_table_cache_.emplace_back(
+  hash_table_cache_.put(
       key,
       HashTableCacheValue{
-          cpu_hash_table_buff_, layout_, entry_count_, emitted_keys_count_});
+          cpu_hash_table_buff_, layout_, entry_count_, emitted_keys_count_},
+      cpu_hash_table_buff_->size(),
+      getInnerTableEpoch());
 }
 
 std::pair<ssize_t, size_t> BaselineJoinHashTable::getApproximateTupleCountFromCache(
     const HashTableCacheKey& key) const {
-  std::lock_guard<std::mutex> hash_table_cache_lock(hash_table_cache_mutex_);
-  for (const auto& kv : hash_table_cache_) {
-    if (kv.first == key) {
-      return std::make_pair(kv.second.entry_count / 2, kv.second.emitted_keys_count);
-    }
+  const auto cached = hash_table_cache_.get(key, getInnerTableEpoch());
+  if (cached) {
+    return std::make_pair(cached->entry_count / 2, cached->emitted_keys_count);
   }
   return std::make_pair(-1, 0);
 }
 
+int32_t BaselineJoinHashTable::getInnerTableEpoch() const {
+  const auto inner_table_id = getInnerTableId();
+  if (inner_table_id <= 0) {
+    return -1;
+  }
+  return catalog_->getTableEpoch(catalog_->getCurrentDB().dbId, inner_table_id);
+}
+
 bool BaselineJoinHashTable::isBitwiseEq() const {
   return condition_->get_optype() == kBW_EQ;
 }
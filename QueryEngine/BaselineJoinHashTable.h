@@ -21,12 +21,15 @@
 #include "ColumnarResults.h"
 #include "Descriptors/RowSetMemoryOwner.h"
 #include "HashJoinRuntime.h"
+#include "HashTableCache.h"
 #include "InputMetadata.h"
 #include "JoinHashTableInterface.h"
 
 #ifdef HAVE_CUDA
 #include <cuda.h>
 #endif
+#include <boost/functional/hash.hpp>
+
 #include <cstdint>
 #include <map>
 #include <mutex>
@@ -101,10 +104,7 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
   size_t payloadBufferOff() const noexcept override;
 
   static auto yieldCacheInvalidator() -> std::function<void()> {
-    return []() -> void {
-      std::lock_guard<std::mutex> guard(hash_table_cache_mutex_);
-      hash_table_cache_.clear();
-    };
+    return []() -> void { hash_table_cache_.clear(); };
   }
 
   virtual ~BaselineJoinHashTable() {}
@@ -233,6 +233,15 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
              optype < that.optype && !oeq &&
              overlaps_hashjoin_bucket_threshold < that.overlaps_hashjoin_bucket_threshold;
     }
+
+    // The overlaps threshold is compared with a tolerance, it can't be part of the hash.
+    size_t hash() const {
+      size_t seed = 0;
+      boost::hash_combine(seed, num_elements);
+      boost::hash_combine(seed, chunk_keys);
+      boost::hash_combine(seed, static_cast<int>(optype));
+      return seed;
+    }
   };
 
   void initHashTableOnCpuFromCache(const HashTableCacheKey&);
@@ -242,6 +251,8 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
   std::pair<ssize_t, size_t> getApproximateTupleCountFromCache(
       const HashTableCacheKey&) const;
 
+  int32_t getInnerTableEpoch() const;
+
   bool isBitwiseEq() const;
 
   void freeHashBufferMemory();
@@ -280,10 +291,7 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
     const size_t emitted_keys_count;
   };
 
-  const HashTableCacheValue* findHashTableOnCpuInCache(const HashTableCacheKey&);
-
-  static std::vector<std::pair<HashTableCacheKey, HashTableCacheValue>> hash_table_cache_;
-  static std::mutex hash_table_cache_mutex_;
+  static HashTableCache<HashTableCacheKey, HashTableCacheValue> hash_table_cache_;
 
   static const int ERR_FAILED_TO_FETCH_COLUMN{-3};
   static const int ERR_FAILED_TO_JOIN_ON_VIRTUAL_COLUMN{-4};
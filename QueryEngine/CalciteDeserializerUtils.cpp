@@ -34,6 +34,7 @@ SQLTypeInfo get_agg_type(const SQLAgg agg_kind, const Analyzer::Expr* arg_expr)
       return arg_expr->get_type_info().is_integer() ? SQLTypeInfo(kBIGINT, false)
                                                     : arg_expr->get_type_info();
     case kAVG:
+    case kAPPROX_PERCENTILE:
       return SQLTypeInfo(kDOUBLE, false);
     case kAPPROX_COUNT_DISTINCT:
       return SQLTypeInfo(kBIGINT, false);
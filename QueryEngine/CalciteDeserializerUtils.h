@@ -116,6 +116,10 @@ inline SQLAgg to_agg_kind(const std::string& agg_name) {
   if (agg_name == std::string("SINGLE_VALUE")) {
     return kSINGLE_VALUE;
   }
+  if (agg_name == std::string("APPROX_PERCENTILE") ||
+      agg_name == std::string("APPROX_MEDIAN")) {
+    return kAPPROX_PERCENTILE;
+  }
   throw std::runtime_error("Aggregate function " + agg_name + " not supported");
 }
 
@@ -39,6 +39,8 @@ struct CgenState {
       , outer_join_match_found_per_level_(std::max(query_infos.size(), size_t(1)) - 1)
       , query_infos_(query_infos)
       , needs_error_check_(false)
+      , embeds_host_addresses_(false)
+      , batch_filter_br_(nullptr)
       , query_func_(nullptr)
       , query_func_entry_ir_builder_(context_){};
 
@@ -261,6 +263,12 @@ struct CgenState {
 
   llvm::ConstantInt* llBool(const bool v) const { return ::ll_bool(v, context_); }
 
+  // Address of a host object as a constant, only valid in the current process.
+  llvm::ConstantInt* llHostAddress(const void* ptr) {
+    embeds_host_addresses_ = true;
+    return llInt(reinterpret_cast<int64_t>(ptr));
+  }
+
   void emitErrorCheck(llvm::Value* condition, llvm::Value* errorCode, std::string label);
 
   llvm::Module* module_;
@@ -284,6 +292,9 @@ struct CgenState {
   std::vector<std::unique_ptr<const InValuesBitmap>> in_values_bitmaps_;
   const std::vector<InputTableInfo>& query_infos_;
   bool needs_error_check_;
+  bool embeds_host_addresses_;
+  // branch on the quals evaluated by the batch filter of a vectorized work unit
+  llvm::BranchInst* batch_filter_br_;
 
   llvm::Function* query_func_;
   llvm::IRBuilder<> query_func_entry_ir_builder_;
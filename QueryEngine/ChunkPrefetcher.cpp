@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChunkPrefetcher.h"
+
+#include "Catalog/Catalog.h"
+#include "DataMgr/DataMgr.h"
+#include "Shared/Logger.h"
+
+#include <algorithm>
+
+extern size_t g_chunk_prefetch_io_threads;
+
+ChunkPrefetcher::ChunkPrefetcher(const Catalog_Namespace::Catalog& cat,
+                                 const size_t depth,
+                                 const double max_pool_fill)
+    : cat_(cat)
+    , depth_(depth)
+    , max_pool_fill_(max_pool_fill)
+    , num_kernels_done_(0)
+    , num_kernels_scheduled_(0)
+    , num_chunks_prefetched_(0)
+    , num_bytes_prefetched_(0)
+    , stopped_(false) {
+  CHECK_GT(depth_, size_t(0));
+}
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  if (!io_tasks_) {
+    return;
+  }
+  // the tasks which didn't start yet return right away
+  io_tasks_.reset();
+  VLOG(1) << "Prefetched " << num_chunks_prefetched_ << " chunks ("
+          << num_bytes_prefetched_ << "B) for " << kernel_chunk_requests_.size()
+          << " kernels";
+}
+
+WorkStealingPool& ChunkPrefetcher::getIoPool() {
+  static WorkStealingPool pool(std::max(g_chunk_prefetch_io_threads, size_t(1)));
+  return pool;
+}
+
+void ChunkPrefetcher::addKernel(std::vector<ChunkRequest>&& chunk_requests) {
+  CHECK(!io_tasks_);
+  kernel_chunk_requests_.emplace_back(std::move(chunk_requests));
+}
+
+void ChunkPrefetcher::addChunkRequests(std::vector<ChunkRequest>& chunk_requests,
+                                       const ChunkKey& chunk_key,
+                                       const ChunkMetadata& chunk_metadata,
+                                       const bool is_varlen) {
+  if (is_varlen) {
+    // Same layout as Chunk::getChunkBuffer: 1 for the data, 2 for the offsets
+    auto data_key = chunk_key;
+    data_key.push_back(1);
+    chunk_requests.push_back({data_key, chunk_metadata.numBytes});
+    auto index_key = chunk_key;
+    index_key.push_back(2);
+    chunk_requests.push_back(
+        {index_key, (chunk_metadata.numElements + 1) * sizeof(StringOffsetT)});
+  } else {
+    chunk_requests.push_back({chunk_key, chunk_metadata.numBytes});
+  }
+}
+
+void ChunkPrefetcher::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(!io_tasks_);
+  if (kernel_chunk_requests_.empty()) {
+    return;
+  }
+  // one task at a time, the chunks are read in dispatch order
+  io_tasks_ = std::make_unique<WorkStealingPool::TaskGroup>(getIoPool(), 1);
+  scheduleWindow();
+}
+
+void ChunkPrefetcher::kernelDone() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_kernels_done_;
+  // the kernels may finish before all of them are dispatched
+  if (io_tasks_) {
+    scheduleWindow();
+  }
+}
+
+void ChunkPrefetcher::scheduleWindow() {
+  while (!stopped_ && num_kernels_scheduled_ < kernel_chunk_requests_.size() &&
+         num_kernels_scheduled_ < num_kernels_done_ + depth_) {
+    const auto kernel_idx = num_kernels_scheduled_++;
+    io_tasks_->submit([this, kernel_idx] { prefetchKernel(kernel_idx); });
+  }
+}
+
+void ChunkPrefetcher::prefetchKernel(const size_t kernel_idx) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // already executed, its chunks were loaded on demand
+    if (stopped_ || kernel_idx < num_kernels_done_) {
+      return;
+    }
+  }
+  auto& data_mgr = cat_.getDataMgr();
+  for (const auto& chunk_request : kernel_chunk_requests_[kernel_idx]) {
+    try {
+      if (data_mgr.prefetchChunkBuffer(
+              chunk_request.key, chunk_request.num_bytes, max_pool_fill_)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++num_chunks_prefetched_;
+        num_bytes_prefetched_ += chunk_request.num_bytes;
+      }
+    } catch (const std::exception& e) {
+      // Prefetching is only a hint, the kernels will fetch their chunks themselves
+      LOG(WARNING) << "Chunk prefetch failed: " << e.what();
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+      return;
+    }
+  }
+}
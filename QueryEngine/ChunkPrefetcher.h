@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkPrefetcher.h
+ * @brief   Loads the outer table chunks of upcoming fragment kernels into the CPU buffer
+ * pool while earlier kernels execute.
+ *
+ * Kernels are registered in dispatch order. Their chunks are loaded from disk by tasks of
+ * a process-wide I/O pool, one kernel per task and one task of a query at a time, staying
+ * at most `depth` kernels ahead of the number of completed kernels. Prefetched chunks
+ * are left unpinned, and the pool refuses to prefetch when doing so would evict resident
+ * chunks or fill the pool past `max_pool_fill`, so prefetching never takes memory away
+ * from running kernels.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "DataMgr/ChunkMetadata.h"
+#include "Shared/WorkStealingPool.h"
+#include "Shared/types.h"
+
+namespace Catalog_Namespace {
+class Catalog;
+}
+
+class ChunkPrefetcher {
+ public:
+  ChunkPrefetcher(const Catalog_Namespace::Catalog& cat,
+                  const size_t depth,
+                  const double max_pool_fill);
+
+  ~ChunkPrefetcher();
+
+  struct ChunkRequest {
+    ChunkKey key;
+    size_t num_bytes;
+  };
+
+  /// Registers the chunks of the next kernel, in dispatch order. Must precede start().
+  void addKernel(std::vector<ChunkRequest>&& chunk_requests);
+
+  /// Builds the requests for one column chunk, splitting varlen columns into their
+  /// data and offset buffers.
+  static void addChunkRequests(std::vector<ChunkRequest>& chunk_requests,
+                               const ChunkKey& chunk_key,
+                               const ChunkMetadata& chunk_metadata,
+                               const bool is_varlen);
+
+  void start();
+
+  /// Signals that one kernel has finished, which opens up the prefetch window.
+  void kernelDone();
+
+  /// Process-wide pool which reads the prefetched chunks, sized by
+  /// g_chunk_prefetch_io_threads.
+  static WorkStealingPool& getIoPool();
+
+ private:
+  // Submits the kernels which entered the prefetch window, the caller holds mutex_.
+  void scheduleWindow();
+  void prefetchKernel(const size_t kernel_idx);
+
+  const Catalog_Namespace::Catalog& cat_;
+  const size_t depth_;
+  const double max_pool_fill_;
+  std::vector<std::vector<ChunkRequest>> kernel_chunk_requests_;
+
+  std::mutex mutex_;
+  size_t num_kernels_done_;
+  size_t num_kernels_scheduled_;
+  size_t num_chunks_prefetched_;
+  size_t num_bytes_prefetched_;
+  bool stopped_;
+  // created by start(), waits for the prefetch tasks still in the pool
+  std::unique_ptr<WorkStealingPool::TaskGroup> io_tasks_;
+};
@@ -21,6 +21,8 @@
 #include "../Analyzer/Analyzer.h"
 #include "Execute.h"
 
+class PersistentObjectCache;
+
 // Code generation utility to be used for queries and scalar expressions.
 class CodeGenerator {
  public:
@@ -72,7 +74,8 @@ class CodeGenerator {
   static ExecutionEngineWrapper generateNativeCPUCode(
       llvm::Function* func,
       const std::unordered_set<llvm::Function*>& live_funcs,
-      const CompilationOptions& co);
+      const CompilationOptions& co,
+      PersistentObjectCache* object_cache = nullptr);
 
   static std::string generatePTX(const std::string& cuda_llir,
                                  llvm::TargetMachine* nvptx_target_machine,
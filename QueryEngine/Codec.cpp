@@ -54,8 +54,12 @@ llvm::Instruction* FixedWidthUnsigned::codegenDecode(llvm::Value* byte_stream,
   return llvm::CallInst::Create(f, args);
 }
 
-DiffFixedWidthInt::DiffFixedWidthInt(const size_t byte_width, const int64_t baseline)
-    : byte_width_{byte_width}, baseline_{baseline} {}
+DiffFixedWidthInt::DiffFixedWidthInt(const size_t byte_width,
+                                     const int64_t ret_null_val)
+    : byte_width_{byte_width}
+    , null_val_{byte_width == 1 ? NULL_TINYINT
+                                : byte_width == 2 ? NULL_SMALLINT : NULL_INT}
+    , ret_null_val_{ret_null_val} {}
 
 llvm::Instruction* DiffFixedWidthInt::codegenDecode(llvm::Value* byte_stream,
                                                     llvm::Value* pos,
@@ -66,7 +70,23 @@ llvm::Instruction* DiffFixedWidthInt::codegenDecode(llvm::Value* byte_stream,
   llvm::Value* args[] = {
       byte_stream,
       llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), byte_width_),
-      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), baseline_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), ret_null_val_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
+RunLengthInt::RunLengthInt(const size_t byte_width) : byte_width_{byte_width} {}
+
+llvm::Instruction* RunLengthInt::codegenDecode(llvm::Value* byte_stream,
+                                               llvm::Value* pos,
+                                               llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("run_length_int_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), byte_width_),
       pos};
   return llvm::CallInst::Create(f, args);
 }
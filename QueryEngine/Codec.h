@@ -55,14 +55,26 @@ class FixedWidthUnsigned : public Decoder {
 
 class DiffFixedWidthInt : public Decoder {
  public:
-  DiffFixedWidthInt(const size_t byte_width, const int64_t baseline);
+  DiffFixedWidthInt(const size_t byte_width, const int64_t ret_null_val);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* module) const override;
+
+ private:
+  const size_t byte_width_;
+  const int64_t null_val_;
+  const int64_t ret_null_val_;
+};
+
+class RunLengthInt : public Decoder {
+ public:
+  RunLengthInt(const size_t byte_width);
   llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
                                    llvm::Value* pos,
                                    llvm::Module* module) const override;
 
  private:
   const size_t byte_width_;
-  const int64_t baseline_;
 };
 
 class FixedWidthReal : public Decoder {
@@ -239,6 +239,11 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
         }
         auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
         CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+        const auto compression = chunk_meta_it->second.sqlType.get_compression();
+        if (compression == kENCODING_RL || compression == kENCODING_DIFF) {
+          throw std::runtime_error(
+              "Columns with RL or DIFF encoding can't be linearized across fragments");
+        }
         auto col_buffer = getOneTableColumnFragment(table_id,
                                                     static_cast<int>(frag_id),
                                                     col_id,
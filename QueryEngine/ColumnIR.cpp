@@ -73,6 +73,13 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
       return col_var->get_comp_param() == 16 ? std::make_shared<FixedWidthSmallDate>(2)
                                              : std::make_shared<FixedWidthSmallDate>(4);
     }
+    case kENCODING_DIFF: {
+      const auto bit_width = col_var->get_comp_param();
+      CHECK_EQ(0, bit_width % 8);
+      return std::make_shared<DiffFixedWidthInt>(bit_width / 8, inline_int_null_val(ti));
+    }
+    case kENCODING_RL:
+      return std::make_shared<RunLengthInt>(ti.get_size());
     default:
       abort();
   }
@@ -223,7 +230,7 @@ llvm::Value* CodeGenerator::codegenWindowPosition(
     llvm::Value* pos_arg) {
   const auto window_position = cgen_state_->emitCall(
       "row_number_window_func",
-      {cgen_state_->llInt(reinterpret_cast<const int64_t>(window_func_context->output())),
+      {cgen_state_->llHostAddress(window_func_context->output()),
        pos_arg});
   window_func_context->setRowNumber(window_position);
   return window_position;
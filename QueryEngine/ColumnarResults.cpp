@@ -27,7 +27,10 @@ namespace {
 
 inline int64_t fixed_encoding_nullable_val(const int64_t val,
                                            const SQLTypeInfo& type_info) {
-  if (type_info.get_compression() != kENCODING_NONE) {
+  // RL and DIFF columns are decoded to their logical values, nulls included
+  if (type_info.get_compression() != kENCODING_NONE &&
+      type_info.get_compression() != kENCODING_RL &&
+      type_info.get_compression() != kENCODING_DIFF) {
     CHECK(type_info.get_compression() == kENCODING_FIXED ||
           type_info.get_compression() == kENCODING_DICT);
     auto logical_ti = get_logical_type_info(type_info);
@@ -157,32 +160,55 @@ void ColumnarResults::materializeAllColumnsThroughIteration(const ResultSet& row
   };
   if (isParallelConversion()) {
     const size_t worker_count = cpu_threads();
-    std::vector<std::future<void>> conversion_threads;
     const auto entry_count = rows.entryCount();
-    for (size_t i = 0,
-                start_entry = 0,
-                stride = (entry_count + worker_count - 1) / worker_count;
-         i < worker_count && start_entry < entry_count;
+    const size_t stride = (entry_count + worker_count - 1) / worker_count;
+    // The rows of every range are counted first, so that each thread writes its rows
+    // after the ones of the previous ranges and the columns keep the order of the result
+    // set, e.g. for the rows of a sorted result which are sent to the client.
+    std::vector<std::future<size_t>> count_threads;
+    for (size_t start_entry = 0; start_entry < entry_count; start_entry += stride) {
+      const auto end_entry = std::min(start_entry + stride, entry_count);
+      count_threads.push_back(std::async(
+          std::launch::async,
+          [&rows](const size_t start, const size_t end) {
+            size_t non_empty_count{0};
+            for (size_t i = start; i < end; ++i) {
+              if (!rows.isRowAtEmpty(i)) {
+                ++non_empty_count;
+              }
+            }
+            return non_empty_count;
+          },
+          start_entry,
+          end_entry));
+    }
+    std::vector<size_t> range_offsets(count_threads.size() + 1, 0);
+    for (size_t i = 0; i < count_threads.size(); ++i) {
+      range_offsets[i + 1] = range_offsets[i] + count_threads[i].get();
+    }
+    std::vector<std::future<void>> conversion_threads;
+    for (size_t i = 0, start_entry = 0; start_entry < entry_count;
          ++i, start_entry += stride) {
       const auto end_entry = std::min(start_entry + stride, entry_count);
       conversion_threads.push_back(std::async(
           std::launch::async,
-          [&rows, &do_work, &row_idx](const size_t start, const size_t end) {
+          [&rows, &do_work](const size_t start, const size_t end, size_t out_idx) {
             for (size_t i = start; i < end; ++i) {
               const auto crt_row = rows.getRowAtNoTranslations(i);
               if (!crt_row.empty()) {
-                do_work(crt_row, row_idx.fetch_add(1));
+                do_work(crt_row, out_idx++);
               }
             }
           },
           start_entry,
-          end_entry));
+          end_entry,
+          range_offsets[i]));
     }
     for (auto& child : conversion_threads) {
-      child.wait();
+      child.get();
     }
 
-    num_rows_ = row_idx;
+    num_rows_ = range_offsets.back();
     rows.setCachedRowCount(num_rows_);
     return;
   }
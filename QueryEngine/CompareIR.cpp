@@ -521,8 +521,8 @@ llvm::Value* CodeGenerator::codegenQualifierCmp(const SQLOps optype,
          posArg(arr_expr),
          lhs_lvs[1],
          lhs_lvs[2],
-         cgen_state_->llInt(int64_t(executor()->getStringDictionaryProxy(
-             elem_ti.get_comp_param(), executor()->getRowSetMemoryOwner(), true))),
+         cgen_state_->llHostAddress(executor()->getStringDictionaryProxy(
+             elem_ti.get_comp_param(), executor()->getRowSetMemoryOwner(), true)),
          cgen_state_->inlineIntNull(elem_ti)});
   }
   if (target_ti.is_integer() || target_ti.is_boolean() || target_ti.is_string()) {
@@ -32,6 +32,7 @@ struct CompilationOptions {
   const bool with_dynamic_watchdog_;
   const ExecutorExplainType explain_type_{ExecutorExplainType::Default};
   const bool register_intel_jit_listener_{false};
+  const bool vectorize_{false};  // batch-at-a-time filters, see VectorizedCodegen.h
 };
 
 struct ExecutionOptions {
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    CountDistinctHashSet.h
+ * @brief   Set of 64-bit values for exact COUNT(DISTINCT) on arguments with a range too
+ * wide for a bitmap.
+ *
+ * The values are kept in a single power of two sized array with linear probing, so an
+ * insert doesn't allocate unless the table grows and a union is a scan of a flat array.
+ * The table is at most half full. The marker of the empty slots can't be stored in the
+ * array, whether the set contains it is tracked separately.
+ */
+
+#ifndef QUERYENGINE_COUNTDISTINCTHASHSET_H
+#define QUERYENGINE_COUNTDISTINCTHASHSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class CountDistinctHashSet {
+ public:
+  CountDistinctHashSet() : size_(0), has_empty_key_(false) {}
+
+  void insert(const int64_t val) {
+    if (val == kEmptyKey) {
+      insertEmptyKey();
+      return;
+    }
+    if (2 * (size_ + 1) > slots_.size()) {
+      reserve(size_ + 1);
+    }
+    insertNoGrow(val);
+  }
+
+  size_t size() const { return size_; }
+
+  // Adds all the values of other, growing the table at most once.
+  void merge(const CountDistinctHashSet& other) {
+    if (this == &other) {
+      return;
+    }
+    reserve(size_ + other.size_);
+    for (const auto val : other.slots_) {
+      if (val != kEmptyKey) {
+        insertNoGrow(val);
+      }
+    }
+    if (other.has_empty_key_) {
+      insertEmptyKey();
+    }
+  }
+
+  template <typename FUNC>
+  void forEach(FUNC func) const {
+    for (const auto val : slots_) {
+      if (val != kEmptyKey) {
+        func(val);
+      }
+    }
+    if (has_empty_key_) {
+      func(kEmptyKey);
+    }
+  }
+
+ private:
+  static constexpr int64_t kEmptyKey{std::numeric_limits<int64_t>::min()};
+  static constexpr size_t kMinCapacity{16};
+
+  // Finalizer of MurmurHash3, the low bits of the values alone are often clustered.
+  static uint64_t hash(const int64_t val) {
+    auto h = static_cast<uint64_t>(val);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  void insertEmptyKey() {
+    if (!has_empty_key_) {
+      has_empty_key_ = true;
+      ++size_;
+    }
+  }
+
+  void insertNoGrow(const int64_t val) {
+    const auto mask = slots_.size() - 1;
+    for (auto slot_idx = hash(val) & mask;; slot_idx = (slot_idx + 1) & mask) {
+      auto& slot = slots_[slot_idx];
+      if (slot == val) {
+        return;
+      }
+      if (slot == kEmptyKey) {
+        slot = val;
+        ++size_;
+        return;
+      }
+    }
+  }
+
+  // Makes room for value_count values without exceeding the load factor.
+  void reserve(const size_t value_count) {
+    auto capacity = slots_.empty() ? kMinCapacity : slots_.size();
+    while (capacity < 2 * value_count) {
+      capacity *= 2;
+    }
+    if (capacity == slots_.size()) {
+      return;
+    }
+    std::vector<int64_t> old_slots(capacity, kEmptyKey);
+    old_slots.swap(slots_);
+    size_ = has_empty_key_ ? 1 : 0;
+    for (const auto val : old_slots) {
+      if (val != kEmptyKey) {
+        insertNoGrow(val);
+      }
+    }
+  }
+
+  std::vector<int64_t> slots_;
+  size_t size_;
+  bool has_empty_key_;
+};
+
+#endif  // QUERYENGINE_COUNTDISTINCTHASHSET_H
@@ -25,6 +25,7 @@
 #define QUERYENGINE_DECODERSIMPL_H
 
 #include <cstdint>
+#include "../Shared/EncodedChunkLayout.h"
 #include "../Shared/funcannotations.h"
 
 extern "C" DEVICE ALWAYS_INLINE int64_t
@@ -96,9 +97,75 @@ SUFFIX(fixed_width_unsigned_decode_noinline)(const int8_t* byte_stream,
 extern "C" DEVICE ALWAYS_INLINE int64_t
 SUFFIX(diff_fixed_width_int_decode)(const int8_t* byte_stream,
                                     const int32_t byte_width,
-                                    const int64_t baseline,
+                                    const int64_t null_val,
+                                    const int64_t ret_null_val,
                                     const int64_t pos) {
-  return SUFFIX(fixed_width_int_decode)(byte_stream, byte_width, pos) + baseline;
+  const auto baseline = *reinterpret_cast<const int64_t*>(byte_stream);
+  const auto diff = SUFFIX(fixed_width_int_decode)(
+      byte_stream + DIFF_ENCODING_HEADER_SIZE, byte_width, pos);
+  return diff == null_val ? ret_null_val : diff + baseline;
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(diff_fixed_width_int_decode_noinline)(const int8_t* byte_stream,
+                                             const int32_t byte_width,
+                                             const int64_t null_val,
+                                             const int64_t ret_null_val,
+                                             const int64_t pos) {
+  return SUFFIX(diff_fixed_width_int_decode)(
+      byte_stream, byte_width, null_val, ret_null_val, pos);
+}
+
+template <typename T>
+DEVICE inline int64_t SUFFIX(run_length_decode)(const int8_t* byte_stream,
+                                                const int64_t pos) {
+  const auto run_count = *reinterpret_cast<const int64_t*>(byte_stream);
+  const auto runs =
+      reinterpret_cast<const RunLengthRun<T>*>(byte_stream + RL_ENCODING_HEADER_SIZE);
+  // find the first run which ends after pos
+  int64_t lo = 0;
+  int64_t hi = run_count - 1;
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (runs[mid].end_pos <= pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return static_cast<int64_t>(runs[lo].value);
+}
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(run_length_int_decode)(const int8_t* byte_stream,
+                              const int32_t byte_width,
+                              const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  switch (byte_width) {
+    case 1:
+      return SUFFIX(run_length_decode)<int8_t>(byte_stream, pos);
+    case 2:
+      return SUFFIX(run_length_decode)<int16_t>(byte_stream, pos);
+    case 4:
+      return SUFFIX(run_length_decode)<int32_t>(byte_stream, pos);
+    case 8:
+      return SUFFIX(run_length_decode)<int64_t>(byte_stream, pos);
+    default:
+#ifdef __CUDACC__
+      return -1;
+#else
+      return std::numeric_limits<int64_t>::min() + 1;
+#endif
+  }
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(run_length_int_decode_noinline)(const int8_t* byte_stream,
+                                       const int32_t byte_width,
+                                       const int64_t pos) {
+  return SUFFIX(run_length_int_decode)(byte_stream, byte_width, pos);
 }
 
 extern "C" DEVICE ALWAYS_INLINE float SUFFIX(
@@ -168,7 +168,8 @@ class DeepCopyVisitor : public ScalarExprVisitor<std::shared_ptr<Analyzer::Expr>
                                               args_copy,
                                               partition_keys_copy,
                                               order_keys_copy,
-                                              window_func->getCollation());
+                                              window_func->getCollation(),
+                                              window_func->getFrame());
   }
 
   RetType visitFunctionOper(const Analyzer::FunctionOper* func_oper) const override {
@@ -216,7 +217,7 @@ class DeepCopyVisitor : public ScalarExprVisitor<std::shared_ptr<Analyzer::Expr>
                                        agg->get_aggtype(),
                                        arg,
                                        agg->get_is_distinct(),
-                                       agg->get_error_rate());
+                                       agg->get_arg1());
   }
 
   RetType visitOffsetInFragment(const Analyzer::OffsetInFragment*) const override {
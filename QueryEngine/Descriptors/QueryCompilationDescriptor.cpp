@@ -32,6 +32,7 @@ std::unique_ptr<QueryMemoryDescriptor> QueryCompilationDescriptor::compile(
   CHECK(executor);
   std::unique_ptr<QueryMemoryDescriptor> query_mem_desc;
   const auto cat = executor->getCatalog();
+  std::lock_guard<std::recursive_mutex> llvm_lock(getGlobalLLVMContextMutex());
   try {
     std::tie(compilation_result_, query_mem_desc) = executor->compileWorkUnit(
         table_infos,
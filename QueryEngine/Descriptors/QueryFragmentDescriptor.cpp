@@ -119,7 +119,8 @@ void QueryFragmentDescriptor::buildFragmentPerKernelMap(
     const auto& fragment = (*outer_fragments)[i];
     const auto skip_frag = executor->skipFragment(
         outer_table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
-    if (skip_frag.first) {
+    if (skip_frag.first || executor->skipFragmentOnBloomFilters(
+                               outer_table_desc, fragment, ra_exe_unit.quals)) {
       continue;
     }
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
@@ -200,7 +201,8 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
       skip_frag = executor->skipFragmentInnerJoins(
           outer_table_desc, ra_exe_unit, fragment, frag_offsets, outer_frag_id);
     }
-    if (skip_frag.first) {
+    if (skip_frag.first || executor->skipFragmentOnBloomFilters(
+                               outer_table_desc, fragment, ra_exe_unit.quals)) {
       continue;
     }
     const int device_id =
@@ -24,10 +24,19 @@
 #include "ColSlotContext.h"
 
 bool g_enable_smem_group_by{true};
+bool g_enable_tagged_baseline_hash{false};
 extern bool g_enable_columnar_output;
 
 namespace {
 
+size_t next_power_of_two(const size_t n) {
+  size_t pow2{1};
+  while (pow2 < n) {
+    pow2 <<= 1;
+  }
+  return pow2;
+}
+
 bool is_int_and_no_bigger_than(const SQLTypeInfo& ti, const size_t byte_width) {
   if (!ti.is_integer()) {
     return false;
@@ -210,6 +219,7 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
   auto sharing = GroupByMemSharing::Shared;
   bool interleaved_bins_on_gpu = false;
   bool keyless_hash = false;
+  bool hash_tags = false;
   bool shared_mem_for_group_by = false;
   int8_t group_col_compact_width = 0;
   int32_t idx_target_as_key = -1;
@@ -306,6 +316,13 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
       entry_count = shard_count
                         ? (max_groups_buffer_entry_count + shard_count - 1) / shard_count
                         : max_groups_buffer_entry_count;
+      hash_tags = g_enable_tagged_baseline_hash &&
+                  device_type == ExecutorDeviceType::CPU &&
+                  !(render_info && render_info->isPotentialInSituRender()) &&
+                  entry_count <= (size_t(1) << 30);
+      if (hash_tags) {
+        entry_count = next_power_of_two(entry_count);
+      }
       target_groupby_indices = target_expr_group_by_indices(ra_exe_unit.groupby_exprs,
                                                             ra_exe_unit.target_exprs);
       col_slot_context = ColSlotContext(ra_exe_unit.target_exprs, target_groupby_indices);
@@ -347,7 +364,7 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
       UNREACHABLE() << "Unknown query type";
   }
 
-  return std::make_unique<QueryMemoryDescriptor>(
+  auto query_mem_desc = std::make_unique<QueryMemoryDescriptor>(
       executor,
       ra_exe_unit,
       query_infos,
@@ -368,6 +385,8 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
       output_columnar,
       render_info && render_info->isPotentialInSituRender(),
       must_use_baseline_sort);
+  query_mem_desc->setHasHashTags(hash_tags);
+  return query_mem_desc;
 }
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(
@@ -412,6 +431,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(
     , must_use_baseline_sort_(must_use_baseline_sort)
     , is_table_function_(false)
     , force_4byte_float_(false)
+    , hash_tags_(false)
     , col_slot_context_(col_slot_context) {
   col_slot_context_.setAllUnsetSlotsPaddedSize(8);
   col_slot_context_.validate();
@@ -488,7 +508,8 @@ QueryMemoryDescriptor::QueryMemoryDescriptor()
     , render_output_(false)
     , must_use_baseline_sort_(false)
     , is_table_function_(false)
-    , force_4byte_float_(false) {}
+    , force_4byte_float_(false)
+    , hash_tags_(false) {}
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(const Executor* executor,
                                              const size_t entry_count,
@@ -512,7 +533,8 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(const Executor* executor,
     , render_output_(false)
     , must_use_baseline_sort_(false)
     , is_table_function_(is_table_function)
-    , force_4byte_float_(false) {}
+    , force_4byte_float_(false)
+    , hash_tags_(false) {}
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(const QueryDescriptionType query_desc_type,
                                              const int64_t min_val,
@@ -538,7 +560,8 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(const QueryDescriptionType query_de
     , render_output_(false)
     , must_use_baseline_sort_(false)
     , is_table_function_(false)
-    , force_4byte_float_(false) {}
+    , force_4byte_float_(false)
+    , hash_tags_(false) {}
 
 bool QueryMemoryDescriptor::operator==(const QueryMemoryDescriptor& other) const {
   // Note that this method does not check ptr reference members (e.g. executor_) or
@@ -558,6 +581,9 @@ bool QueryMemoryDescriptor::operator==(const QueryMemoryDescriptor& other) const
   if (force_4byte_float_ != other.force_4byte_float_) {
     return false;
   }
+  if (hash_tags_ != other.hash_tags_) {
+    return false;
+  }
   if (group_col_widths_ != other.group_col_widths_) {
     return false;
   }
@@ -945,6 +971,9 @@ size_t QueryMemoryDescriptor::getBufferSizeBytes(const ExecutorDeviceType device
   } else {
     total_bytes = getRowSize() * entry_count;
   }
+  if (hash_tags_) {
+    total_bytes = align_to_int64(total_bytes) + align_to_int64(entry_count);
+  }
 
   return total_bytes;
 }
@@ -954,6 +983,11 @@ size_t QueryMemoryDescriptor::getBufferSizeBytes(
   return getBufferSizeBytes(device_type, entry_count_);
 }
 
+size_t QueryMemoryDescriptor::getHashTagsOffInBytes() const {
+  CHECK(hash_tags_);
+  return getBufferSizeBytes(ExecutorDeviceType::CPU) - align_to_int64(entry_count_);
+}
+
 void QueryMemoryDescriptor::setOutputColumnar(const bool val) {
   output_columnar_ = val;
   if (isLogicalSizedColumnsAllowed()) {
@@ -1149,6 +1183,7 @@ std::string QueryMemoryDescriptor::toString() const {
   str += "\tOutput Columnar: " + boolToString(output_columnar_) + "\n";
   str += "\tRender Output: " + boolToString(render_output_) + "\n";
   str += "\tUse Baseline Sort: " + boolToString(must_use_baseline_sort_) + "\n";
+  str += "\tHash Tags: " + boolToString(hash_tags_) + "\n";
   return str;
 }
 
@@ -173,6 +173,12 @@ class QueryMemoryDescriptor {
   bool hasKeylessHash() const { return keyless_hash_; }
   void setHasKeylessHash(const bool val) { keyless_hash_ = val; }
 
+  // Baseline hash on CPU only: a tag byte per entry after the entries, which speeds up
+  // probing, see get_group_value_tagged. The entry count is a power of two.
+  bool hasHashTags() const { return hash_tags_; }
+  void setHasHashTags(const bool val) { hash_tags_ = val; }
+  size_t getHashTagsOffInBytes() const;
+
   bool hasInterleavedBinsOnGpu() const { return interleaved_bins_on_gpu_; }
   void setHasInterleavedBinsOnGpu(const bool val) { interleaved_bins_on_gpu_ = val; }
 
@@ -355,6 +361,7 @@ class QueryMemoryDescriptor {
   bool is_table_function_;
 
   bool force_4byte_float_;
+  bool hash_tags_;
 
   ColSlotContext col_slot_context_;
 
@@ -24,6 +24,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../CountDistinctHashSet.h"
 #include "DataMgr/AbstractBuffer.h"
 #include "Shared/Logger.h"
 #include "StringDictionary/StringDictionaryProxy.h"
@@ -45,6 +46,16 @@ class RowSetMemoryOwner : boost::noncopyable {
     count_distinct_sets_.push_back(count_distinct_set);
   }
 
+  void addCountDistinctHashSet(CountDistinctHashSet* count_distinct_hash_set) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    count_distinct_hash_sets_.push_back(count_distinct_hash_set);
+  }
+
+  void addApproxPercentileBuffer(int8_t* approx_percentile_buffer) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    approx_percentile_buffers_.push_back(approx_percentile_buffer);
+  }
+
   void addGroupByBuffer(int64_t* group_by_buffer) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     group_by_buffers_.push_back(group_by_buffer);
@@ -126,6 +137,12 @@ class RowSetMemoryOwner : boost::noncopyable {
     for (auto count_distinct_set : count_distinct_sets_) {
       delete count_distinct_set;
     }
+    for (auto count_distinct_hash_set : count_distinct_hash_sets_) {
+      delete count_distinct_hash_set;
+    }
+    for (auto approx_percentile_buffer : approx_percentile_buffers_) {
+      free(approx_percentile_buffer);
+    }
     for (auto group_by_buffer : group_by_buffers_) {
       free(group_by_buffer);
     }
@@ -154,6 +171,8 @@ class RowSetMemoryOwner : boost::noncopyable {
 
   std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
   std::vector<std::set<int64_t>*> count_distinct_sets_;
+  std::vector<CountDistinctHashSet*> count_distinct_hash_sets_;
+  std::vector<int8_t*> approx_percentile_buffers_;
   std::vector<int64_t*> group_by_buffers_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
@@ -18,6 +18,7 @@
 
 #include "AggregateUtils.h"
 #include "BaselineJoinHashTable.h"
+#include "ChunkPrefetcher.h"
 #include "CodeGenerator.h"
 #include "ColumnFetcher.h"
 #include "Descriptors/QueryCompilationDescriptor.h"
@@ -40,6 +41,7 @@
 
 #include "TableFunctions/TableFunctionCompilationContext.h"
 #include "TableFunctions/TableFunctionExecutionContext.h"
+#include "VectorizedCodegen.h"
 
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
@@ -47,6 +49,7 @@
 #include "Shared/ExperimentalTypeUtilities.h"
 #include "Shared/MapDParameters.h"
 #include "Shared/TypedDataAccessors.h"
+#include "Shared/WorkStealingPool.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/measure.h"
 #include "Shared/scope.h"
@@ -99,6 +102,19 @@ size_t g_min_memory_allocation_size{
 bool g_enable_bump_allocator{false};
 double g_bump_allocator_step_reduction{0.75};
 bool g_enable_direct_columnarization{true};
+size_t g_chunk_prefetch_depth{0};  // 0 disables chunk prefetching
+double g_chunk_prefetch_max_pool_fill{0.8};
+size_t g_chunk_prefetch_io_threads{4};
+size_t g_max_cpu_kernels_per_query{0};  // 0 means as many as the kernel pool has workers
+bool g_enable_persistent_code_cache{false};
+size_t g_persistent_code_cache_max_size{1UL << 30};  // 1GB
+size_t g_max_concurrent_queries{1};
+bool g_enable_external_aggregation{false};
+size_t g_external_aggregation_threshold{100000000};  // estimated groups
+size_t g_external_aggregation_partitions{16};
+bool g_enable_vectorized_cpu_codegen{false};
+bool g_enable_count_distinct_hash_set{true};
+size_t g_join_hash_table_cache_max_bytes{0};  // 0 means no limit
 extern bool g_enable_experimental_string_functions;
 
 int const Executor::max_gpu_count;
@@ -127,9 +143,10 @@ Executor::Executor(const int db_id,
 std::shared_ptr<Executor> Executor::getExecutor(const int db_id,
                                                 const std::string& debug_dir,
                                                 const std::string& debug_file,
-                                                const MapDParameters mapd_parameters) {
+                                                const MapDParameters mapd_parameters,
+                                                const size_t executor_slot) {
   INJECT_TIMER(getExecutor);
-  const auto executor_key = db_id;
+  const auto executor_key = std::make_pair(db_id, executor_slot);
   {
     mapd_shared_lock<mapd_shared_mutex> read_lock(executors_cache_mutex_);
     auto it = executors_.find(executor_key);
@@ -154,12 +171,71 @@ std::shared_ptr<Executor> Executor::getExecutor(const int db_id,
   }
 }
 
+Executor::Lease::Lease(std::shared_ptr<Executor> executor,
+                       const int db_id,
+                       const size_t slot)
+    : executor_(executor), db_id_(db_id), slot_(slot) {}
+
+Executor::Lease::~Lease() {
+  {
+    std::lock_guard<std::mutex> lock(executor_leases_mutex_);
+    auto& slots = leased_executor_slots_[db_id_];
+    CHECK_LT(slot_, slots.size());
+    CHECK(slots[slot_]);
+    slots[slot_] = false;
+    CHECK_GT(leased_executor_count_, size_t(0));
+    --leased_executor_count_;
+  }
+  CHECK_GT(leases_held_by_thread_, size_t(0));
+  --leases_held_by_thread_;
+  executor_leases_cv_.notify_all();
+}
+
+std::unique_ptr<Executor::Lease> Executor::leaseExecutor(
+    const int db_id,
+    const std::string& debug_dir,
+    const std::string& debug_file,
+    const MapDParameters mapd_parameters) {
+  INJECT_TIMER(leaseExecutor);
+  size_t slot{0};
+  {
+    std::unique_lock<std::mutex> lock(executor_leases_mutex_);
+    // a nested lease would deadlock once the outer leases exhaust the limit
+    executor_leases_cv_.wait(lock, [] {
+      return leases_held_by_thread_ > 0 ||
+             leased_executor_count_ < std::max(g_max_concurrent_queries, size_t(1));
+    });
+    auto& slots = leased_executor_slots_[db_id];
+    // reuse the lowest idle slot, its executor has the warmest code cache
+    slot = std::find(slots.begin(), slots.end(), false) - slots.begin();
+    if (slot == slots.size()) {
+      slots.push_back(false);
+    }
+    slots[slot] = true;
+    ++leased_executor_count_;
+  }
+  ++leases_held_by_thread_;
+  // the lease returns the slot if getting the executor throws
+  std::unique_ptr<Lease> lease(new Lease(nullptr, db_id, slot));
+  lease->executor_ = getExecutor(db_id, debug_dir, debug_file, mapd_parameters, slot);
+  return lease;
+}
+
+void Executor::interruptExecutors(const int db_id) {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(executors_cache_mutex_);
+  for (auto it = executors_.lower_bound(std::make_pair(db_id, size_t(0)));
+       it != executors_.end() && it->first.first == db_id;
+       ++it) {
+    it->second->interrupt();
+  }
+}
+
 void Executor::clearMemory(const Data_Namespace::MemoryLevel memory_level) {
   switch (memory_level) {
     case Data_Namespace::MemoryLevel::CPU_LEVEL:
     case Data_Namespace::MemoryLevel::GPU_LEVEL: {
-      std::lock_guard<std::mutex> flush_lock(
-          execute_mutex_);  // Don't flush memory while queries are running
+      mapd_unique_lock<mapd_shared_mutex> flush_lock(
+          execute_gate_mutex_);  // Don't flush memory while queries are running
 
       Catalog_Namespace::SysCatalog::instance().getDataMgr().clearMemory(memory_level);
       if (memory_level == Data_Namespace::MemoryLevel::CPU_LEVEL) {
@@ -1183,6 +1259,8 @@ ResultSetPtr Executor::executeWorkUnitImpl(
   }
 
   int8_t crt_min_byte_width{get_min_byte_width()};
+  const bool vectorize = co.vectorize_ && device_type == ExecutorDeviceType::CPU &&
+                         vectorized_codegen::can_vectorize(ra_exe_unit, eo);
   do {
     ExecutionDispatch execution_dispatch(
         this, ra_exe_unit, query_infos, cat, row_set_mem_owner, render_info);
@@ -1199,7 +1277,8 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                       co.opt_level_,
                                       co.with_dynamic_watchdog_,
                                       co.explain_type_,
-                                      co.register_intel_jit_listener_},
+                                      co.register_intel_jit_listener_,
+                                      vectorize},
                                      eo,
                                      column_fetcher,
                                      has_cardinality_estimation);
@@ -1360,6 +1439,8 @@ ResultSetPtr Executor::executeTableFunction(
     const ExecutionOptions& eo,
     const Catalog_Namespace::Catalog& cat) {
   INJECT_TIMER(Exec_executeTableFunction);
+  // the compilation context owns LLVM objects until the function has run
+  std::lock_guard<std::recursive_mutex> llvm_lock(getGlobalLLVMContextMutex());
   nukeOldState(false, table_infos, nullptr);
 
   ColumnCacheMap column_cache;  // Note: if we add retries to the table function
@@ -1453,9 +1534,17 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
         entry.push_back(reinterpret_cast<int64_t>(count_distinct_set));
         continue;
       }
+      if (count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet) {
+        auto count_distinct_set = new CountDistinctHashSet();
+        CHECK(row_set_mem_owner);
+        row_set_mem_owner->addCountDistinctHashSet(count_distinct_set);
+        entry.push_back(reinterpret_cast<int64_t>(count_distinct_set));
+        continue;
+      }
     }
     const bool float_argument_input = takes_float_argument(agg_info);
-    if (agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
+    if (agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT ||
+        agg_info.agg_kind == kAPPROX_PERCENTILE) {
       entry.push_back(0);
     } else if (agg_info.agg_kind == kAVG) {
       entry.push_back(inline_null_val(agg_info.sql_type, float_argument_input));
@@ -1697,6 +1786,59 @@ bool has_lazy_fetched_columns(const std::vector<ColumnLazyFetchInfo>& fetched_co
   return false;
 }
 
+// Outer table columns read by every kernel, excluding lazily fetched ones.
+std::vector<const ColumnDescriptor*> get_outer_fetched_columns(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::set<std::pair<TableId, ColumnId>>& columns_to_fetch,
+    const Catalog_Namespace::Catalog& cat) {
+  std::vector<const ColumnDescriptor*> outer_cds;
+  for (const auto& col_desc : ra_exe_unit.input_col_descs) {
+    const auto& scan_desc = col_desc->getScanDesc();
+    if (scan_desc.getNestLevel() != 0 ||
+        scan_desc.getSourceType() != InputSourceType::TABLE ||
+        !columns_to_fetch.count(
+            std::make_pair(scan_desc.getTableId(), col_desc->getColId()))) {
+      continue;
+    }
+    const auto cd = try_get_column_descriptor(col_desc.get(), cat);
+    if (cd && !cd->isVirtualCol) {
+      outer_cds.push_back(cd);
+    }
+  }
+  return outer_cds;
+}
+
+std::vector<ChunkPrefetcher::ChunkRequest> get_outer_chunk_requests(
+    const FragmentsList& frag_list,
+    const std::vector<const ColumnDescriptor*>& outer_cds,
+    const TableFragments& outer_fragments,
+    const int db_id) {
+  std::vector<ChunkPrefetcher::ChunkRequest> chunk_requests;
+  CHECK(!frag_list.empty());
+  for (const auto frag_id : frag_list.front().fragment_ids) {
+    CHECK_LT(frag_id, outer_fragments.size());
+    const auto& fragment = outer_fragments[frag_id];
+    if (fragment.isEmptyPhysicalFragment()) {
+      continue;
+    }
+    const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+    for (const auto cd : outer_cds) {
+      const auto chunk_metadata_it = chunk_metadata_map.find(cd->columnId);
+      if (chunk_metadata_it == chunk_metadata_map.end()) {
+        continue;
+      }
+      const bool is_varlen =
+          cd->columnType.is_varlen() && !cd->columnType.is_fixlen_array();
+      ChunkPrefetcher::addChunkRequests(
+          chunk_requests,
+          {db_id, fragment.physicalTableId, cd->columnId, fragment.fragmentId},
+          chunk_metadata_it->second,
+          is_varlen);
+    }
+  }
+  return chunk_requests;
+}
+
 }  // namespace
 
 void Executor::dispatchFragments(
@@ -1718,6 +1860,10 @@ void Executor::dispatchFragments(
     QueryFragmentDescriptor& fragment_descriptor,
     std::unordered_set<int>& available_gpus,
     int& available_cpus) {
+  // must outlive the kernels, which report their completion to it
+  std::unique_ptr<ChunkPrefetcher> chunk_prefetcher;
+  // waits for the CPU kernels still in the pool when it goes out of scope
+  std::unique_ptr<WorkStealingPool::TaskGroup> cpu_kernel_group;
   std::vector<std::future<void>> query_threads;
   const auto& ra_exe_unit = execution_dispatch.getExecutionUnit();
   CHECK(!ra_exe_unit.input_descs.empty());
@@ -1785,11 +1931,39 @@ void Executor::dispatchFragments(
       }
     }
 
+    const int outer_table_id = ra_exe_unit.input_descs.front().getTableId();
+    std::vector<const ColumnDescriptor*> outer_cds;
+    const TableFragments* outer_fragments{nullptr};
+    if (g_chunk_prefetch_depth > 0 && outer_table_id > 0) {
+      outer_cds = get_outer_fetched_columns(
+          ra_exe_unit, plan_state_->columns_to_fetch_, *catalog_);
+      std::map<int, const TableFragments*> all_tables_fragments;
+      QueryFragmentDescriptor::computeAllTablesFragments(
+          all_tables_fragments, ra_exe_unit, table_infos);
+      const auto outer_fragments_it = all_tables_fragments.find(outer_table_id);
+      CHECK(outer_fragments_it != all_tables_fragments.end());
+      outer_fragments = outer_fragments_it->second;
+      if (!outer_cds.empty()) {
+        chunk_prefetcher = std::make_unique<ChunkPrefetcher>(
+            *catalog_, g_chunk_prefetch_depth, g_chunk_prefetch_max_pool_fill);
+      }
+    }
+
+    if (device_type == ExecutorDeviceType::CPU) {
+      cpu_kernel_group = std::make_unique<WorkStealingPool::TaskGroup>(
+          WorkStealingPool::getCpuKernelPool(), g_max_cpu_kernels_per_query);
+    }
+
     size_t frag_list_idx{0};
-    auto fragment_per_kernel_dispatch = [&query_threads,
+    auto fragment_per_kernel_dispatch = [this,
+                                         &query_threads,
+                                         &cpu_kernel_group,
                                          &dispatch,
                                          &frag_list_idx,
                                          &device_type,
+                                         &chunk_prefetcher,
+                                         &outer_cds,
+                                         outer_fragments,
                                          query_comp_desc,
                                          query_mem_desc](const int device_id,
                                                          const FragmentsList& frag_list,
@@ -1799,21 +1973,50 @@ void Executor::dispatchFragments(
       }
       CHECK_GE(device_id, 0);
 
-      query_threads.push_back(std::async(std::launch::async,
-                                         dispatch,
-                                         device_type,
-                                         device_id,
-                                         query_comp_desc,
-                                         query_mem_desc,
-                                         frag_list,
-                                         ExecutorDispatchMode::KernelPerFragment,
-                                         rowid_lookup_key));
+      if (chunk_prefetcher) {
+        CHECK(outer_fragments);
+        chunk_prefetcher->addKernel(get_outer_chunk_requests(
+            frag_list, outer_cds, *outer_fragments, catalog_->getCurrentDB().dbId));
+      }
+      auto prefetcher = chunk_prefetcher.get();
+      auto run_kernel = [&dispatch, prefetcher, device_type, device_id, rowid_lookup_key](
+                            const QueryCompilationDescriptor& query_comp_desc,
+                            const QueryMemoryDescriptor& query_mem_desc,
+                            const FragmentsList& frag_list) {
+        ScopeGuard notify_prefetcher = [prefetcher] {
+          if (prefetcher) {
+            prefetcher->kernelDone();
+          }
+        };
+        dispatch(device_type,
+                 device_id,
+                 query_comp_desc,
+                 query_mem_desc,
+                 frag_list,
+                 ExecutorDispatchMode::KernelPerFragment,
+                 rowid_lookup_key);
+      };
+      if (cpu_kernel_group) {
+        query_threads.push_back(cpu_kernel_group->submit(
+            [run_kernel, query_comp_desc, query_mem_desc, frag_list] {
+              run_kernel(query_comp_desc, query_mem_desc, frag_list);
+            }));
+      } else {
+        query_threads.push_back(std::async(std::launch::async,
+                                           run_kernel,
+                                           query_comp_desc,
+                                           query_mem_desc,
+                                           frag_list));
+      }
 
       ++frag_list_idx;
     };
 
     fragment_descriptor.assignFragsToKernelDispatch(fragment_per_kernel_dispatch,
                                                     ra_exe_unit);
+    if (chunk_prefetcher) {
+      chunk_prefetcher->start();
+    }
   }
   for (auto& child : query_threads) {
     child.wait();
@@ -2189,6 +2392,10 @@ class AggregateReductionEgress {
       CHECK(agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT);
       val1 = out_vec[out_vec_idx][0];
       error_code = 0;
+    } else if (is_approx_percentile_target(agg_info)) {
+      // the digest, like a count distinct set, is shared by the entries
+      val1 = out_vec[out_vec_idx][0];
+      error_code = 0;
     } else {
       const auto chosen_bytes = static_cast<size_t>(
           query_exe_context->query_mem_desc_.getPaddedSlotWidthBytes(out_vec_idx));
@@ -2605,7 +2812,6 @@ void Executor::executeSimpleInsert(const Planner::RootPlan* root_plan) {
     throw std::runtime_error(
         "Only simple INSERT of immediate tuples is currently supported");
   }
-  row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>();
   const auto& targets = values_plan->get_targetlist();
   const int table_id = root_plan->get_result_table_id();
   const auto& col_id_list = root_plan->get_result_col_list();
@@ -3090,6 +3296,21 @@ int64_t get_hpt_scaled_value(const int64_t& val,
                      : val * DateTimeUtils::get_timestamp_precision_scale(rdim - ldim);
 }
 
+// Same value as CodeGenerator::codegenIntConst, without going through LLVM.
+int64_t get_int_constant_value(const Analyzer::Constant* constant) {
+  const auto& ti = constant->get_type_info();
+  if (constant->get_is_null()) {
+    return inline_int_null_val(ti);
+  }
+  switch (ti.get_type()) {
+    case kINTERVAL_DAY_TIME:
+    case kINTERVAL_YEAR_MONTH:
+      return constant->get_constval().bigintval;
+    default:
+      return extract_from_datum(constant->get_constval(), ti);
+  }
+}
+
 }  // namespace
 
 std::pair<bool, int64_t> Executor::skipFragment(
@@ -3165,8 +3386,7 @@ std::pair<bool, int64_t> Executor::skipFragment(
       chunk_min = get_hpt_scaled_value(chunk_min, lhs_dimen, rhs_dimen);
       chunk_max = get_hpt_scaled_value(chunk_max, lhs_dimen, rhs_dimen);
     }
-    CodeGenerator code_generator(this);
-    const auto rhs_val = code_generator.codegenIntConst(rhs_const)->getSExtValue();
+    const auto rhs_val = get_int_constant_value(rhs_const);
     switch (comp_expr->get_optype()) {
       case kGE:
         if (chunk_max < rhs_val) {
@@ -3193,6 +3413,11 @@ std::pair<bool, int64_t> Executor::skipFragment(
           return {true, -1};
         } else if (is_rowid) {
           return {false, rhs_val - start_rowid};
+        } else if (lhs == lhs_col &&
+                   lhs_col->get_type_info().get_dimension() ==
+                       rhs_const->get_type_info().get_dimension() &&
+                   bloomFilterExcludes(fragment, lhs_col, {rhs_val})) {
+          return {true, -1};
         }
         break;
       default:
@@ -3247,18 +3472,153 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
                                      temp_qual.simple_quals.begin(),
                                      temp_qual.simple_quals.end());
     }
+    std::list<std::shared_ptr<Analyzer::Expr>> inner_join_quals;
+    for (auto& qual : inner_join.quals) {
+      auto temp_qual = qual_to_conjunctive_form(qual);
+      inner_join_quals.insert(
+          inner_join_quals.end(), temp_qual.quals.begin(), temp_qual.quals.end());
+    }
     auto temp_skip_frag = skipFragment(
         table_desc, fragment, inner_join_simple_quals, frag_offsets, frag_idx);
     if (temp_skip_frag.second != -1) {
       skip_frag.second = temp_skip_frag.second;
       return skip_frag;
     } else {
-      skip_frag.first = skip_frag.first || temp_skip_frag.first;
+      skip_frag.first =
+          skip_frag.first || temp_skip_frag.first ||
+          skipFragmentOnBloomFilters(table_desc, fragment, inner_join_quals);
     }
   }
   return skip_frag;
 }
 
+/*
+ *   Skips the fragment if a qual only holds for values of a column which the bloom
+ * filter of the column chunk rules out: `x = c`, `x IN (c1, c2, ...)` and
+ * `x = c1 OR x = c2 ...` where x is an integer, time or dictionary encoded string
+ * column. Integer equalities are simple quals, skipFragment consults the bloom filter for
+ * those; dictionary encoded strings only get here.
+ */
+bool Executor::skipFragmentOnBloomFilters(
+    const InputDescriptor& table_desc,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals) {
+  for (const auto& qual : quals) {
+    const Analyzer::ColumnVar* col_var{nullptr};
+    std::vector<int64_t> values;
+    bool all_equalities{true};
+    for (const auto& disjunct : qual_to_disjunctive_form(qual)) {
+      if (!getEqualityValues(disjunct.get(), table_desc.getTableId(), col_var, values)) {
+        all_equalities = false;
+        break;
+      }
+    }
+    if (all_equalities && col_var && bloomFilterExcludes(fragment, col_var, values)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Executor::getEqualityValues(const Analyzer::Expr* qual,
+                                 const int table_id,
+                                 const Analyzer::ColumnVar*& col_var,
+                                 std::vector<int64_t>& values) {
+  const Analyzer::Expr* arg{nullptr};
+  std::vector<const Analyzer::Expr*> value_exprs;
+  if (const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual)) {
+    if (bin_oper->get_optype() != kEQ || bin_oper->get_qualifier() != kONE) {
+      return false;
+    }
+    arg = bin_oper->get_left_operand();
+    value_exprs.push_back(bin_oper->get_right_operand());
+    if (!dynamic_cast<const Analyzer::ColumnVar*>(arg)) {
+      std::swap(arg, value_exprs.front());
+    }
+  } else if (const auto in_values = dynamic_cast<const Analyzer::InValues*>(qual)) {
+    arg = in_values->get_arg();
+    for (const auto& value_expr : in_values->get_value_list()) {
+      value_exprs.push_back(value_expr.get());
+    }
+  } else if (const auto in_set = dynamic_cast<const Analyzer::InIntegerSet*>(qual)) {
+    arg = in_set->get_arg();
+    values.insert(
+        values.end(), in_set->get_value_list().begin(), in_set->get_value_list().end());
+  } else {
+    return false;
+  }
+  const auto arg_col_var = dynamic_cast<const Analyzer::ColumnVar*>(arg);
+  if (!arg_col_var || dynamic_cast<const Analyzer::Var*>(arg) ||
+      arg_col_var->get_table_id() != table_id || arg_col_var->get_rte_idx()) {
+    return false;
+  }
+  if (col_var && col_var->get_column_id() != arg_col_var->get_column_id()) {
+    return false;
+  }
+  col_var = arg_col_var;
+  const auto& col_ti = col_var->get_type_info();
+  if (!ChunkBloomFilter::supportsType(col_ti)) {
+    return false;
+  }
+  for (const auto value_expr : value_exprs) {
+    if (col_ti.is_string()) {
+      // dictionary encoded literals are casts of none encoded ones
+      const auto cast_expr = dynamic_cast<const Analyzer::UOper*>(value_expr);
+      const auto str_const =
+          cast_expr && cast_expr->get_optype() == kCAST
+              ? dynamic_cast<const Analyzer::Constant*>(cast_expr->get_operand())
+              : nullptr;
+      if (!str_const || !row_set_mem_owner_) {
+        return false;
+      }
+      if (str_const->get_is_null()) {
+        continue;
+      }
+      const auto sdp =
+          getStringDictionaryProxy(col_ti.get_comp_param(), row_set_mem_owner_, true);
+      CHECK(sdp);
+      values.push_back(sdp->getIdOfString(*str_const->get_constval().stringval));
+      continue;
+    }
+    const auto constant = dynamic_cast<const Analyzer::Constant*>(value_expr);
+    if (!constant) {
+      return false;
+    }
+    const auto& const_ti = constant->get_type_info();
+    if (col_ti.is_time()
+            ? const_ti.get_type() != col_ti.get_type() ||
+                  const_ti.get_dimension() != col_ti.get_dimension()
+            : !const_ti.is_integer()) {
+      return false;
+    }
+    if (!constant->get_is_null()) {
+      values.push_back(get_int_constant_value(constant));
+    }
+  }
+  return true;
+}
+
+bool Executor::bloomFilterExcludes(const Fragmenter_Namespace::FragmentInfo& fragment,
+                                   const Analyzer::ColumnVar* col_var,
+                                   const std::vector<int64_t>& values) {
+  const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+  const auto chunk_meta_it = chunk_metadata_map.find(col_var->get_column_id());
+  if (chunk_meta_it == chunk_metadata_map.end()) {
+    return false;
+  }
+  const auto bloom_filter = chunk_meta_it->second.bloomFilter;
+  if (!bloom_filter) {
+    return false;
+  }
+  for (const auto value : values) {
+    if (bloom_filter->mayContain(value)) {
+      return false;
+    }
+  }
+  ++bloom_filter_skipped_fragment_count_;
+  return true;
+}
+
 AggregatedColRange Executor::computeColRangesCache(
     const std::unordered_set<PhysicalInput>& phys_inputs) {
   AggregatedColRange agg_col_range_cache;
@@ -3326,6 +3686,12 @@ void Executor::setupCaching(const std::unordered_set<PhysicalInput>& phys_inputs
   table_generations_ = computeTableGenerations(phys_table_ids);
 }
 
-std::map<int, std::shared_ptr<Executor>> Executor::executors_;
-std::mutex Executor::execute_mutex_;
+std::map<std::pair<int, size_t>, std::shared_ptr<Executor>> Executor::executors_;
+mapd_shared_mutex Executor::execute_gate_mutex_;
 mapd_shared_mutex Executor::executors_cache_mutex_;
+std::mutex Executor::executor_leases_mutex_;
+std::condition_variable Executor::executor_leases_cv_;
+std::map<int, std::vector<bool>> Executor::leased_executor_slots_;
+size_t Executor::leased_executor_count_{0};
+thread_local size_t Executor::leases_held_by_thread_{0};
+std::atomic<size_t> Executor::bloom_filter_skipped_fragment_count_{0};
@@ -54,6 +54,7 @@
 #include <rapidjson/document.h>
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
@@ -90,6 +91,19 @@ extern bool g_enable_table_functions;
 extern size_t g_max_memory_allocation_size;
 extern double g_bump_allocator_step_reduction;
 extern bool g_enable_direct_columnarization;
+extern size_t g_chunk_prefetch_depth;
+extern double g_chunk_prefetch_max_pool_fill;
+extern size_t g_chunk_prefetch_io_threads;
+extern size_t g_max_cpu_kernels_per_query;
+extern bool g_enable_persistent_code_cache;
+extern size_t g_persistent_code_cache_max_size;
+extern size_t g_max_concurrent_queries;
+extern bool g_enable_external_aggregation;
+extern size_t g_external_aggregation_threshold;
+extern size_t g_external_aggregation_partitions;
+extern bool g_enable_vectorized_cpu_codegen;
+extern bool g_enable_count_distinct_hash_set;
+extern size_t g_join_hash_table_cache_max_bytes;
 
 class QueryCompilationDescriptor;
 using QueryCompilationDescriptorOwned = std::unique_ptr<QueryCompilationDescriptor>;
@@ -339,21 +353,75 @@ class Executor {
            const std::string& debug_dir,
            const std::string& debug_file);
 
+  /**
+   * The executor in the given slot of the database, slot 0 by default. Slot 0 is also
+   * handed out by leaseExecutor, so callers which don't hold a lease share it with a
+   * leased query: executions on an executor are serialized by its execute_mutex_, the
+   * caller waits for the leased query to finish rather than run next to it.
+   */
   static std::shared_ptr<Executor> getExecutor(
+      const int db_id,
+      const std::string& debug_dir = "",
+      const std::string& debug_file = "",
+      const MapDParameters mapd_parameters = MapDParameters(),
+      const size_t executor_slot = 0);
+
+  /**
+   * Exclusive use of one of the executors of a database by a query, for the lifetime of
+   * the lease. Queries holding leases on different executors run concurrently.
+   */
+  class Lease {
+   public:
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    ~Lease();
+
+    Executor* get() const { return executor_.get(); }
+
+   private:
+    Lease(std::shared_ptr<Executor> executor, const int db_id, const size_t slot);
+
+    std::shared_ptr<Executor> executor_;
+    const int db_id_;
+    const size_t slot_;
+
+    friend class Executor;
+  };
+
+  /**
+   * Leases an idle executor of the database. At most g_max_concurrent_queries executors
+   * are leased out server-wide, further callers wait for a lease to be returned. The
+   * executor returned by getExecutor, which DDL and import paths share, is the first
+   * executor of the database, so with the default limit of one all queries are
+   * serialized as before.
+   *
+   * A thread which already holds a lease doesn't wait for the limit, the lease it would
+   * wait for could be its own. A lease must be released on the thread which took it.
+   */
+  static std::unique_ptr<Lease> leaseExecutor(
       const int db_id,
       const std::string& debug_dir = "",
       const std::string& debug_file = "",
       const MapDParameters mapd_parameters = MapDParameters());
 
   static void nukeCacheOfExecutors() {
-    std::lock_guard<std::mutex> flush_lock(
-        execute_mutex_);  // don't want native code to vanish while executing
+    mapd_unique_lock<mapd_shared_mutex> flush_lock(
+        execute_gate_mutex_);  // don't want native code to vanish while executing
     mapd_unique_lock<mapd_shared_mutex> lock(executors_cache_mutex_);
     (decltype(executors_){}).swap(executors_);
   }
 
   static void clearMemory(const Data_Namespace::MemoryLevel memory_level);
 
+  // Interrupts the queries running on any executor of the database.
+  static void interruptExecutors(const int db_id);
+
+  // Number of fragments the chunk bloom filters ruled out, over all the executors.
+  static size_t getBloomFilterSkippedFragmentCount() {
+    return bloom_filter_skipped_fragment_count_;
+  }
+
   typedef std::tuple<std::string, const Analyzer::Expr*, int64_t, const size_t> AggInfo;
 
   std::shared_ptr<ResultSet> execute(const Planner::RootPlan* root_plan,
@@ -425,6 +493,10 @@ class Executor {
   // Generate code for an aggregate window function target.
   llvm::Value* codegenWindowFunctionAggregate(const CompilationOptions& co);
 
+  // Generate code which reads the value of an aggregate over a ROWS frame, computed
+  // upfront by the window function context.
+  llvm::Value* codegenWindowFunctionRowsFrame();
+
   // The aggregate state requires a state reset when starting a new partition. Generate
   // the new partition check and return the continuation basic block.
   llvm::BasicBlock* codegenWindowResetStateControlFlow();
@@ -880,6 +952,23 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  bool skipFragmentOnBloomFilters(
+      const InputDescriptor& table_desc,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const std::list<std::shared_ptr<Analyzer::Expr>>& quals);
+
+  // Collects the values of col_var the qual holds for, as stored in the chunks of the
+  // column. Returns false if the qual isn't an equality or IN on a single column.
+  bool getEqualityValues(const Analyzer::Expr* qual,
+                         const int table_id,
+                         const Analyzer::ColumnVar*& col_var,
+                         std::vector<int64_t>& values);
+
+  // True if the fragment has a bloom filter for the column which rules out all values.
+  bool bloomFilterExcludes(const Fragmenter_Namespace::FragmentInfo& fragment,
+                           const Analyzer::ColumnVar* col_var,
+                           const std::vector<int64_t>& values);
+
   AggregatedColRange computeColRangesCache(
       const std::unordered_set<PhysicalInput>& phys_inputs);
   StringDictionaryGenerations computeStringDictionaryGenerations(
@@ -963,10 +1052,24 @@ class Executor {
   StringDictionaryGenerations string_dictionary_generations_;
   TableGenerations table_generations_;
 
-  static std::map<int, std::shared_ptr<Executor>> executors_;
-  static std::mutex execute_mutex_;
+  // Serializes the queries running on this executor.
+  std::mutex execute_mutex_;
+
+  // Taken shared by queries, on top of execute_mutex_, and exclusively by whatever must
+  // not run concurrently with any query, e.g. clearing memory.
+  static mapd_shared_mutex execute_gate_mutex_;
+
+  static std::map<std::pair<int, size_t>, std::shared_ptr<Executor>> executors_;
   static mapd_shared_mutex executors_cache_mutex_;
 
+  static std::mutex executor_leases_mutex_;
+  static std::condition_variable executor_leases_cv_;
+  static std::map<int, std::vector<bool>> leased_executor_slots_;
+  static size_t leased_executor_count_;
+  static thread_local size_t leases_held_by_thread_;
+
+  static std::atomic<size_t> bloom_filter_skipped_fragment_count_;
+
  public:
   static const int32_t ERR_DIV_BY_ZERO{1};
   static const int32_t ERR_OUT_OF_GPU_MEM{2};
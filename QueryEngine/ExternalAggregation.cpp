@@ -0,0 +1,200 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ExternalAggregation.h"
+#include "Execute.h"
+#include "ResultSetBufferAccessors.h"
+
+#include <cstring>
+
+namespace external_aggregation {
+
+namespace {
+
+bool is_unnest(const Analyzer::Expr* expr) {
+  const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr);
+  return uoper && uoper->get_optype() == kUNNEST;
+}
+
+// Strings produced by an expression may live in a transient dictionary owned by the
+// pass, only strings read straight from a column can outlive it.
+bool is_string_from_column(const Analyzer::Expr* expr) {
+  return !expr->get_type_info().is_string() ||
+         dynamic_cast<const Analyzer::ColumnVar*>(expr);
+}
+
+std::shared_ptr<Analyzer::Expr> bigint_constant(const int64_t val) {
+  Datum d;
+  d.bigintval = val;
+  return makeExpr<Analyzer::Constant>(kBIGINT, false, d);
+}
+
+std::shared_ptr<Analyzer::Expr> make_eq(std::shared_ptr<Analyzer::Expr> lhs,
+                                        const int64_t val) {
+  return makeExpr<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, lhs, bigint_constant(val));
+}
+
+std::shared_ptr<Analyzer::Expr> make_or(std::shared_ptr<Analyzer::Expr> lhs,
+                                        std::shared_ptr<Analyzer::Expr> rhs) {
+  return makeExpr<Analyzer::BinOper>(kBOOLEAN, kOR, kONE, lhs, rhs);
+}
+
+}  // namespace
+
+int get_partition_key_idx(const RelAlgExecutionUnit& ra_exe_unit) {
+  if (ra_exe_unit.estimator ||
+      ra_exe_unit.sort_info.algorithm != SortAlgorithm::Default) {
+    return -1;
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    const auto target_info = get_target_info(target_expr, g_bigint_count);
+    if (target_info.is_distinct || target_info.agg_kind == kAPPROX_COUNT_DISTINCT ||
+        is_approx_percentile_target(target_info) || target_info.sql_type.is_varlen()) {
+      return -1;
+    }
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    if (agg_expr && agg_expr->get_arg() && !is_string_from_column(agg_expr->get_arg())) {
+      return -1;
+    }
+  }
+  int key_idx{-1};
+  int crt_idx{0};
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    if (!groupby_expr || is_unnest(groupby_expr.get()) ||
+        !is_string_from_column(groupby_expr.get())) {
+      return -1;
+    }
+    const auto& groupby_ti = groupby_expr->get_type_info();
+    if (key_idx < 0 &&
+        (groupby_ti.is_integer() || groupby_ti.is_dict_encoded_string())) {
+      key_idx = crt_idx;
+    }
+    ++crt_idx;
+  }
+  return key_idx;
+}
+
+RelAlgExecutionUnit partition_execution_unit(const RelAlgExecutionUnit& ra_exe_unit,
+                                             const int key_idx,
+                                             const size_t num_partitions,
+                                             const size_t partition) {
+  CHECK_GE(key_idx, 0);
+  CHECK_LT(static_cast<size_t>(key_idx), ra_exe_unit.groupby_exprs.size());
+  CHECK_LT(partition, num_partitions);
+  const auto key_expr = *std::next(ra_exe_unit.groupby_exprs.begin(), key_idx);
+  CHECK(key_expr);
+  auto key = key_expr->get_type_info().is_string()
+                 ? makeExpr<Analyzer::KeyForStringExpr>(key_expr->deep_copy())
+                 : key_expr->deep_copy();
+  const bool key_nullable = !key->get_type_info().get_notnull();
+  key = key->add_cast(SQLTypeInfo(kBIGINT, !key_nullable));
+  const auto remainder = makeExpr<Analyzer::BinOper>(
+      SQLTypeInfo(kBIGINT, !key_nullable),
+      false,
+      kMODULO,
+      kONE,
+      key,
+      bigint_constant(static_cast<int64_t>(num_partitions)));
+  // the remainder of negative keys is negative, they go to the partition of its
+  // complement; the null key goes to the first partition
+  auto partition_qual = make_eq(remainder, partition);
+  if (partition > 0) {
+    partition_qual = make_or(
+        partition_qual,
+        make_eq(remainder, static_cast<int64_t>(partition) -
+                               static_cast<int64_t>(num_partitions)));
+  } else if (key_nullable) {
+    partition_qual =
+        make_or(partition_qual, makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, key));
+  }
+  auto partition_exe_unit = ra_exe_unit;
+  partition_exe_unit.quals.push_back(partition_qual);
+  return partition_exe_unit;
+}
+
+void PassResults::add(const ResultSet& rows) {
+  const auto storage = rows.getStorage();
+  if (!storage) {
+    return;
+  }
+  const auto& query_mem_desc = rows.getQueryMemDesc();
+  CHECK(query_mem_desc.getQueryDescriptionType() ==
+            QueryDescriptionType::GroupByPerfectHash ||
+        query_mem_desc.getQueryDescriptionType() ==
+            QueryDescriptionType::GroupByBaselineHash);
+  // Only the groups of the pass are kept, the empty entries and the headroom of the
+  // output buffers go with them.
+  std::vector<size_t> entries;
+  for (size_t entry_idx = 0; entry_idx < query_mem_desc.getEntryCount(); ++entry_idx) {
+    if (!rows.isRowAtEmpty(entry_idx)) {
+      entries.push_back(entry_idx);
+    }
+  }
+  auto compact_mem_desc = query_mem_desc;
+  compact_mem_desc.setEntryCount(entries.size());
+  // the compacted entries are never probed again
+  compact_mem_desc.setHasHashTags(false);
+  auto pass_rows = std::make_shared<ResultSet>(rows.getTargetInfos(),
+                                               ExecutorDeviceType::CPU,
+                                               compact_mem_desc,
+                                               row_set_mem_owner_,
+                                               executor_);
+  if (entries.empty()) {
+    // without storage, stands for the result until a pass has groups
+    if (!rows_) {
+      rows_ = pass_rows;
+    }
+    return;
+  }
+  const auto pass_storage = pass_rows->allocateStorage(rows.getTargetInitVals());
+  const auto src = storage->getUnderlyingBuffer();
+  const auto dst = pass_storage->getUnderlyingBuffer();
+  if (query_mem_desc.didOutputColumnar()) {
+    const auto copy_column = [&entries, src, dst](const size_t src_off,
+                                                  const size_t dst_off,
+                                                  const size_t width) {
+      for (size_t i = 0; i < entries.size(); ++i) {
+        memcpy(dst + dst_off + i * width, src + src_off + entries[i] * width, width);
+      }
+    };
+    if (!query_mem_desc.hasKeylessHash()) {
+      for (size_t key_idx = 0; key_idx < query_mem_desc.getGroupbyColCount();
+           ++key_idx) {
+        copy_column(query_mem_desc.getPrependedGroupColOffInBytes(key_idx),
+                    compact_mem_desc.getPrependedGroupColOffInBytes(key_idx),
+                    query_mem_desc.groupColWidth(key_idx));
+      }
+    }
+    for (size_t slot_idx = 0; slot_idx < query_mem_desc.getSlotCount(); ++slot_idx) {
+      copy_column(query_mem_desc.getColOffInBytes(slot_idx),
+                  compact_mem_desc.getColOffInBytes(slot_idx),
+                  query_mem_desc.getPaddedSlotWidthBytes(slot_idx));
+    }
+  } else {
+    const auto row_bytes = get_row_bytes(query_mem_desc);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      memcpy(dst + i * row_bytes, src + entries[i] * row_bytes, row_bytes);
+    }
+  }
+  if (rows_ && rows_->getStorage()) {
+    rows_->append(*pass_rows);
+  } else {
+    rows_ = pass_rows;
+  }
+  bytes_ += compact_mem_desc.getBufferSizeBytes(ExecutorDeviceType::CPU);
+}
+
+}  // namespace external_aggregation
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ExternalAggregation.h
+ * @brief   Partitioned execution of group by queries with more groups than fit the
+ * output buffers of their kernels.
+ *
+ * The work unit runs once per partition of the values of one of its group keys, with an
+ * extra filter which only lets the rows of the partition through. Since the passes have
+ * disjoint groups, the reduced result of every pass is final. Its groups are copied out
+ * of the output buffers of the pass, without the empty entries, and the buffers are freed
+ * before the next pass runs. Only the working set of one pass is in memory along with
+ * the groups of the finished ones.
+ */
+
+#pragma once
+
+#include "RelAlgExecutionUnit.h"
+#include "ResultSet.h"
+
+#include <memory>
+
+namespace external_aggregation {
+
+/**
+ * Returns the index of the group key to partition on, or -1 if the work unit can't run
+ * partitioned. Targets which point into memory owned by the pass, e.g. COUNT(DISTINCT)
+ * sets and variable length values, rule out partitioning.
+ */
+int get_partition_key_idx(const RelAlgExecutionUnit& ra_exe_unit);
+
+/// Copy of the work unit which only aggregates the rows of the given partition.
+RelAlgExecutionUnit partition_execution_unit(const RelAlgExecutionUnit& ra_exe_unit,
+                                             const int key_idx,
+                                             const size_t num_partitions,
+                                             const size_t partition);
+
+/**
+ * Results of the finished passes, compacted to their groups in buffers of the result
+ * set rather than held in the output buffers of the passes.
+ */
+class PassResults {
+ public:
+  PassResults(const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+              const Executor* executor)
+      : row_set_mem_owner_(row_set_mem_owner), executor_(executor), bytes_(0) {}
+
+  /// Copies the groups of rows, which must be the reduced result of a pass.
+  void add(const ResultSet& rows);
+
+  /// All the passes added so far as one result set.
+  ResultSetPtr getRows() const { return rows_; }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner_;
+  const Executor* executor_;
+  ResultSetPtr rows_;
+  size_t bytes_;
+};
+
+}  // namespace external_aggregation
@@ -17,6 +17,7 @@
 #include "GroupByAndAggregate.h"
 #include "AggregateUtils.h"
 #include "Allocators/CudaAllocator.h"
+#include "ApproxPercentile.h"
 
 #include "CardinalityEstimator.h"
 #include "CodeGenerator.h"
@@ -49,6 +50,7 @@
 bool g_cluster{false};
 bool g_bigint_count{false};
 int g_hll_precision_bits{11};
+int g_approx_percentile_compression{100};
 extern size_t g_leaf_count;
 
 namespace {
@@ -103,6 +105,15 @@ bool has_count_distinct(const RelAlgExecutionUnit& ra_exe_unit) {
   return false;
 }
 
+bool has_approx_percentile(const RelAlgExecutionUnit& ra_exe_unit) {
+  for (const auto& target_expr : ra_exe_unit.target_exprs) {
+    if (is_approx_percentile_target(get_target_info(target_expr, g_bigint_count))) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool is_column_range_too_big_for_perfect_hash(const ColRangeInfo& col_range_info,
                                               const int64_t max_entry_count) {
   try {
@@ -393,6 +404,9 @@ std::unique_ptr<QueryMemoryDescriptor> GroupByAndAggregate::initQueryMemoryDescr
             130000000))) {
     throw WatchdogException("Query would use too much memory");
   }
+  // the digests of APPROX_PERCENTILE are only allocated for row-wise groups
+  const bool output_columnar =
+      output_columnar_hint && !has_approx_percentile(ra_exe_unit_);
   return QueryMemoryDescriptor::init(executor_,
                                      ra_exe_unit_,
                                      query_infos_,
@@ -407,7 +421,7 @@ std::unique_ptr<QueryMemoryDescriptor> GroupByAndAggregate::initQueryMemoryDescr
                                      render_info,
                                      count_distinct_descriptors,
                                      must_use_baseline_sort,
-                                     output_columnar_hint);
+                                     output_columnar);
 }
 
 void GroupByAndAggregate::addTransientStringLiterals() {
@@ -533,7 +547,7 @@ CountDistinctDescriptors GroupByAndAggregate::initCountDistinctDescriptors() {
       CountDistinctImplType count_distinct_impl_type{CountDistinctImplType::StdSet};
       int64_t bitmap_sz_bits{0};
       if (agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
-        const auto error_rate = agg_expr->get_error_rate();
+        const auto error_rate = agg_expr->get_arg1();
         if (error_rate) {
           CHECK(error_rate->get_type_info().get_type() == kINT);
           CHECK_GE(error_rate->get_constval().intval, 1);
@@ -573,6 +587,10 @@ CountDistinctDescriptors GroupByAndAggregate::initCountDistinctDescriptors() {
           count_distinct_impl_type == CountDistinctImplType::StdSet) {
         throw WatchdogException("Cannot use a fast path for COUNT distinct");
       }
+      if (g_enable_count_distinct_hash_set &&
+          count_distinct_impl_type == CountDistinctImplType::StdSet) {
+        count_distinct_impl_type = CountDistinctImplType::HashSet;
+      }
       const auto sub_bitmap_count =
           get_count_distinct_sub_bitmap_count(bitmap_sz_bits, ra_exe_unit_, device_type_);
       count_distinct_descriptors.emplace_back(
@@ -1349,7 +1367,16 @@ GroupByAndAggregate::codegenMultiColumnBaselineHash(
     func_args.push_back(&*arg_it);
   }
   if (co.with_dynamic_watchdog_) {
+    // no tagged variant, the tags stay zero and unused
     func_name += "_with_watchdog";
+  } else if (query_mem_desc.hasHashTags()) {
+    CHECK(co.device_type_ == ExecutorDeviceType::CPU);
+    func_name += "_tagged";
+    auto tags_lv = LL_BUILDER.CreateGEP(
+        LL_BUILDER.CreatePointerCast(groups_buffer,
+                                     llvm::Type::getInt8PtrTy(LL_CONTEXT)),
+        LL_INT(static_cast<int64_t>(query_mem_desc.getHashTagsOffInBytes())));
+    func_args.push_back(tags_lv);
   }
   if (query_mem_desc.didOutputColumnar()) {
     return std::make_tuple(groups_buffer, emitCall(func_name, func_args));
@@ -1461,7 +1488,9 @@ llvm::Value* GroupByAndAggregate::codegenWindowRowPointer(
     DiamondCodegen& diamond_codegen) {
   const auto window_func_context =
       WindowProjectNodeContext::getActiveWindowFunctionContext();
-  if (window_func_context && window_function_is_aggregate(window_func->getKind())) {
+  // aggregates over a ROWS frame are computed upfront, they're projected like ranks
+  if (window_func_context && window_function_is_aggregate(window_func->getKind()) &&
+      !window_func->getFrame()) {
     const int32_t row_size_quad = query_mem_desc.didOutputColumnar()
                                       ? 0
                                       : query_mem_desc.getRowSize() / sizeof(int64_t);
@@ -1472,7 +1501,7 @@ llvm::Value* GroupByAndAggregate::codegenWindowRowPointer(
       CHECK(window_func->getKind() == SqlWindowFunctionKind::COUNT);
       window_func_context->setRowNumber(emitCall(
           "row_number_window_func",
-          {LL_INT(reinterpret_cast<const int64_t>(window_func_context->output())),
+          {executor_->cgen_state_->llHostAddress(window_func_context->output()),
            code_generator.posArg(nullptr)}));
     }
     const auto pos_in_window = LL_BUILDER.CreateTrunc(window_func_context->getRowNumber(),
@@ -1662,6 +1691,50 @@ extern "C" void agg_count_distinct_skip_val(int64_t* agg,
   }
 }
 
+extern "C" void agg_count_distinct_hash_set(int64_t* agg, const int64_t val) {
+  reinterpret_cast<CountDistinctHashSet*>(*agg)->insert(val);
+}
+
+extern "C" void agg_count_distinct_hash_set_skip_val(int64_t* agg,
+                                                     const int64_t val,
+                                                     const int64_t skip_val) {
+  if (val != skip_val) {
+    agg_count_distinct_hash_set(agg, val);
+  }
+}
+
+extern "C" void agg_approx_percentile(int64_t* agg, const double val) {
+  // NaN doesn't order against the centroids, the sort of the digest needs an ordering
+  if (std::isnan(val)) {
+    return;
+  }
+  approx_percentile_add(reinterpret_cast<ApproxPercentileDigest*>(*agg), val, 1);
+}
+
+extern "C" void agg_approx_percentile_skip_val(int64_t* agg,
+                                               const double val,
+                                               const double skip_val) {
+  if (val != skip_val) {
+    agg_approx_percentile(agg, val);
+  }
+}
+
+void GroupByAndAggregate::codegenApproxPercentile(const TargetInfo& target_info,
+                                                  std::vector<llvm::Value*>& agg_args,
+                                                  const ExecutorDeviceType device_type) {
+  CHECK(device_type == ExecutorDeviceType::CPU);
+  // integer and decimal arguments are added to the digest as doubles, decimals unscaled
+  auto& val = agg_args.back();
+  val = executor_->cgen_state_->castToTypeIn(executor_->castToFP(val), 64);
+  std::string agg_fname{"agg_approx_percentile"};
+  if (target_info.skip_null_val) {
+    agg_fname += "_skip_val";
+    agg_args.push_back(executor_->cgen_state_->inlineFpNull(SQLTypeInfo(kDOUBLE, false)));
+  }
+  executor_->cgen_state_->emitExternalCall(
+      agg_fname, llvm::Type::getVoidTy(LL_CONTEXT), agg_args);
+}
+
 void GroupByAndAggregate::codegenCountDistinct(
     const size_t target_idx,
     const Analyzer::Expr* target_expr,
@@ -1696,6 +1769,8 @@ void GroupByAndAggregate::codegenCountDistinct(
   if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap) {
     agg_fname += "_bitmap";
     agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
+  } else if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::HashSet) {
+    agg_fname += "_hash_set";
   }
   if (agg_info.skip_null_val) {
     auto null_lv = executor_->cgen_state_->castToTypeIn(
@@ -40,6 +40,7 @@
 #include <vector>
 
 extern bool g_enable_smem_group_by;
+extern bool g_enable_tagged_baseline_hash;
 extern bool g_bigint_count;
 
 class ReductionRanOutOfSlots : public std::runtime_error {
@@ -278,6 +279,10 @@ class GroupByAndAggregate {
                             const QueryMemoryDescriptor&,
                             const ExecutorDeviceType);
 
+  void codegenApproxPercentile(const TargetInfo& target_info,
+                               std::vector<llvm::Value*>& agg_args,
+                               const ExecutorDeviceType);
+
   llvm::Value* getAdditionalLiteral(const int32_t off);
 
   std::vector<llvm::Value*> codegenAggArg(const Analyzer::Expr* target_expr,
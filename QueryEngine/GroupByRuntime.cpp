@@ -139,6 +139,77 @@ get_group_value_columnar_slot_with_watchdog(int64_t* groups_buffer,
   return -1;
 }
 
+// The tagged baseline layout has a power of two entry count and a tag byte per entry
+// after the entries, built from hash bits which don't pick the slot.
+// Tags are never zero, zero marks the entries whose key must be compared, either empty
+// or filled without a tag. Probing mostly reads the tags, 64 consecutive probes stay in
+// one cache line, and only compares the keys of the entries with a matching tag. Tags
+// are written without atomics, the layout is only used on CPU where every kernel owns
+// its output buffer.
+extern "C" ALWAYS_INLINE DEVICE int8_t key_hash_tag(const int64_t* key,
+                                                    const uint32_t key_count,
+                                                    const uint32_t key_width,
+                                                    const uint32_t hash,
+                                                    const uint32_t mask) {
+  // The top byte of the hash is only free of the slot bits below 2^24 entries, the
+  // bigger buffers hash the key again with another seed.
+  const uint32_t tag_hash =
+      mask >> 24 ? MurmurHash1(key, key_width * key_count, 0x9747b28c) : hash;
+  return static_cast<int8_t>((tag_hash >> 24) | 1);
+}
+
+extern "C" NEVER_INLINE DEVICE int64_t* get_group_value_tagged(
+    int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad,
+    const int64_t* init_vals,
+    int8_t* tags) {
+  const uint32_t hash = key_hash(key, key_count, key_width);
+  const uint32_t mask = groups_buffer_entry_count - 1;
+  const int8_t tag = key_hash_tag(key, key_count, key_width, hash, mask);
+  uint32_t h_probe = hash & mask;
+  for (uint32_t i = 0; i < groups_buffer_entry_count; ++i) {
+    if (!tags[h_probe] || tags[h_probe] == tag) {
+      int64_t* matching_group = get_matching_group_value(
+          groups_buffer, h_probe, key, key_count, key_width, row_size_quad, init_vals);
+      if (matching_group) {
+        tags[h_probe] = tag;
+        return matching_group;
+      }
+    }
+    h_probe = (h_probe + 1) & mask;
+  }
+  return NULL;
+}
+
+extern "C" NEVER_INLINE DEVICE int32_t
+get_group_value_columnar_slot_tagged(int64_t* groups_buffer,
+                                     const uint32_t groups_buffer_entry_count,
+                                     const int64_t* key,
+                                     const uint32_t key_count,
+                                     const uint32_t key_width,
+                                     int8_t* tags) {
+  const uint32_t hash = key_hash(key, key_count, key_width);
+  const uint32_t mask = groups_buffer_entry_count - 1;
+  const int8_t tag = key_hash_tag(key, key_count, key_width, hash, mask);
+  uint32_t h_probe = hash & mask;
+  for (uint32_t i = 0; i < groups_buffer_entry_count; ++i) {
+    if (!tags[h_probe] || tags[h_probe] == tag) {
+      const int32_t matching_slot = get_matching_group_value_columnar_slot(
+          groups_buffer, groups_buffer_entry_count, h_probe, key, key_count, key_width);
+      if (matching_slot != -1) {
+        tags[h_probe] = tag;
+        return h_probe;
+      }
+    }
+    h_probe = (h_probe + 1) & mask;
+  }
+  return -1;
+}
+
 extern "C" NEVER_INLINE DEVICE int64_t* get_group_value_columnar(
     int64_t* groups_buffer,
     const uint32_t groups_buffer_entry_count,
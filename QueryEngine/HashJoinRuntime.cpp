@@ -119,7 +119,8 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
                                      const void* sd_outer_proxy,
                                      const int32_t cpu_thread_idx,
                                      const int32_t cpu_thread_count,
-                                     SLOT_SELECTOR slot_sel) {
+                                     SLOT_SELECTOR slot_sel,
+                                     const size_t first_elem = 0) {
 #ifdef __CUDACC__
   int32_t start = threadIdx.x + blockDim.x * blockIdx.x;
   int32_t step = blockDim.x * gridDim.x;
@@ -127,7 +128,7 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
   int32_t start = cpu_thread_idx;
   int32_t step = cpu_thread_count;
 #endif
-  for (size_t i = start; i < join_column.num_elems; i += step) {
+  for (size_t i = first_elem + start; i < join_column.num_elems; i += step) {
     int64_t elem = get_join_column_element_value(type_info, join_column, i);
     if (elem == type_info.null_val) {
       if (type_info.uses_bw_eq) {
@@ -181,6 +182,34 @@ DEVICE int SUFFIX(fill_hash_join_buff_bucketized)(int32_t* buff,
                                   slot_selector);
 }
 
+#ifndef __CUDACC__
+int extend_hash_join_buff_bucketized(int32_t* buff,
+                                     const int32_t invalid_slot_val,
+                                     const JoinColumn join_column,
+                                     const JoinColumnTypeInfo type_info,
+                                     const void* sd_inner_proxy,
+                                     const void* sd_outer_proxy,
+                                     const int32_t cpu_thread_idx,
+                                     const int32_t cpu_thread_count,
+                                     const int64_t bucket_normalization,
+                                     const size_t first_elem) {
+  auto slot_selector = [&](auto elem) {
+    return SUFFIX(get_bucketized_hash_slot)(
+        buff, elem, type_info.min_val, bucket_normalization);
+  };
+  return fill_hash_join_buff_impl(buff,
+                                  invalid_slot_val,
+                                  join_column,
+                                  type_info,
+                                  sd_inner_proxy,
+                                  sd_outer_proxy,
+                                  cpu_thread_idx,
+                                  cpu_thread_count,
+                                  slot_selector,
+                                  first_elem);
+}
+#endif
+
 DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
                                        const int32_t invalid_slot_val,
                                        const JoinColumn join_column,
@@ -136,6 +136,19 @@ int fill_hash_join_buff_bucketized(int32_t* buff,
                                    const int32_t cpu_thread_count,
                                    const int64_t bucket_normalization);
 
+// Fills the slots of the rows [first_elem, join_column.num_elems) into a table which
+// already holds the rows before first_elem.
+int extend_hash_join_buff_bucketized(int32_t* buff,
+                                     const int32_t invalid_slot_val,
+                                     const JoinColumn join_column,
+                                     const JoinColumnTypeInfo type_info,
+                                     const void* sd_inner,
+                                     const void* sd_outer,
+                                     const int32_t cpu_thread_idx,
+                                     const int32_t cpu_thread_count,
+                                     const int64_t bucket_normalization,
+                                     const size_t first_elem);
+
 int fill_hash_join_buff(int32_t* buff,
                         const int32_t invalid_slot_val,
                         const JoinColumn join_column,
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    HashTableCache.h
+ * @brief   Process wide cache of the CPU join hash tables built on physical tables.
+ *
+ * Keys provide a hash() method consistent with their equality. Every entry records the
+ * epoch of its inner table at build time; a lookup at a different epoch drops it, the
+ * table has changed since. Updates, deletes, truncate, vacuum and drop clear the caches
+ * through JoinHashTableCacheInvalidator. The cache holds at most
+ * g_join_hash_table_cache_max_bytes of hash tables (no limit if 0) and evicts the least
+ * recently used entries first.
+ */
+
+#ifndef QUERYENGINE_HASHTABLECACHE_H
+#define QUERYENGINE_HASHTABLECACHE_H
+
+#include "Shared/Logger.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+extern size_t g_join_hash_table_cache_max_bytes;
+
+template <class K, class V>
+class HashTableCache {
+ public:
+  struct Entry {
+    K key;
+    V value;
+    size_t size_bytes;
+    int32_t table_epoch;
+  };
+
+  HashTableCache() : memory_used_(0) {}
+
+  boost::optional<V> get(const K& key, const int32_t table_epoch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+      return boost::none;
+    }
+    if (it->second->table_epoch != table_epoch) {
+      eraseEntry(it);
+      return boost::none;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->value;
+  }
+
+  void put(const K& key,
+           const V& value,
+           const size_t size_bytes,
+           const int32_t table_epoch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index_.count(key)) {
+      return;
+    }
+    const auto max_bytes = g_join_hash_table_cache_max_bytes;
+    if (max_bytes && size_bytes > max_bytes) {
+      return;
+    }
+    while (max_bytes && !lru_.empty() && memory_used_ + size_bytes > max_bytes) {
+      eraseEntry(index_.find(lru_.back().key));
+    }
+    lru_.push_front(Entry{key, value, size_bytes, table_epoch});
+    index_.emplace(key, lru_.begin());
+    memory_used_ += size_bytes;
+  }
+
+  // Returns the most recently used entry for which pred(entry) holds.
+  template <typename PRED>
+  boost::optional<Entry> findIf(PRED pred) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : lru_) {
+      if (pred(entry)) {
+        return entry;
+      }
+    }
+    return boost::none;
+  }
+
+  void erase(const K& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_.find(key);
+    if (it != index_.end()) {
+      eraseEntry(it);
+    }
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    lru_.clear();
+    memory_used_ = 0;
+  }
+
+  size_t memoryUsed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_used_;
+  }
+
+ private:
+  struct KeyHasher {
+    size_t operator()(const K& key) const { return key.hash(); }
+  };
+
+  using LruList = std::list<Entry>;
+  using Index = std::unordered_map<K, typename LruList::iterator, KeyHasher>;
+
+  void eraseEntry(const typename Index::iterator it) {
+    CHECK(it != index_.end());
+    memory_used_ -= it->second->size_bytes;
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+
+  LruList lru_;  // most recently used first
+  Index index_;
+  size_t memory_used_;
+  mutable std::mutex mutex_;
+};
+
+#endif  // QUERYENGINE_HASHTABLECACHE_H
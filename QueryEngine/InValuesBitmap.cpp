@@ -122,6 +122,8 @@ InValuesBitmap::~InValuesBitmap() {
 llvm::Value* InValuesBitmap::codegen(llvm::Value* needle, Executor* executor) const {
   std::vector<std::shared_ptr<const Analyzer::Constant>> constants_owned;
   std::vector<const Analyzer::Constant*> constants;
+  // the handles become literals, which aren't hoisted for every query
+  executor->cgen_state_->embeds_host_addresses_ = true;
   for (const auto bitset : bitsets_) {
     const int64_t bitset_handle = reinterpret_cast<int64_t>(bitset);
     const auto bitset_handle_literal = std::dynamic_pointer_cast<Analyzer::Constant>(
@@ -134,6 +134,11 @@ InnerOuter normalize_column_pair(const Analyzer::Expr* lhs,
           "Can only apply hash join to integer-like types and dictionary encoded "
           "strings");
     }
+    if (inner_col_cd && (inner_col_real_ti.get_compression() == kENCODING_RL ||
+                         inner_col_real_ti.get_compression() == kENCODING_DIFF)) {
+      throw HashJoinFail("Cannot build a hash table on RL or DIFF encoded column " +
+                         inner_col_cd->columnName);
+    }
   }
   return {inner_col, outer_col ? outer_col : outer_expr};
 }
@@ -222,10 +227,9 @@ size_t get_hash_entry_count(const ExpressionRange& col_range, const bool is_bw_e
 
 }  // namespace
 
-std::vector<std::pair<JoinHashTable::JoinHashTableCacheKey,
-                      std::shared_ptr<std::vector<int32_t>>>>
+HashTableCache<JoinHashTable::JoinHashTableCacheKey,
+               std::shared_ptr<std::vector<int32_t>>>
     JoinHashTable::join_hash_table_cache_;
-std::mutex JoinHashTable::join_hash_table_cache_mutex_;
 
 size_t get_shard_count(const Analyzer::BinOper* join_condition,
                        const Executor* executor) {
@@ -789,6 +793,7 @@ void JoinHashTable::checkHashJoinReplicationConstraint(const int table_id) const
 }
 
 void JoinHashTable::initHashTableOnCpu(
+    const ChunkKey& chunk_key,
     const int8_t* col_buff,
     const size_t num_elements,
     const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
@@ -798,8 +803,6 @@ void JoinHashTable::initHashTableOnCpu(
   CHECK(inner_col);
   const auto& ti = inner_col->get_type_info();
   if (!cpu_hash_table_buff_) {
-    cpu_hash_table_buff_ = std::make_shared<std::vector<int32_t>>(
-        hash_entry_info.getNormalizedHashEntryCount());
     const StringDictionaryProxy* sd_inner_proxy{nullptr};
     const StringDictionaryProxy* sd_outer_proxy{nullptr};
     if (ti.is_string()) {
@@ -815,20 +818,33 @@ void JoinHashTable::initHashTableOnCpu(
     }
     int thread_count = cpu_threads();
     std::vector<std::thread> init_cpu_buff_threads;
-    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
-      init_cpu_buff_threads.emplace_back(
-          [this, hash_entry_info, hash_join_invalid_val, thread_idx, thread_count] {
-            init_hash_join_buff(&(*cpu_hash_table_buff_)[0],
-                                hash_entry_info.getNormalizedHashEntryCount(),
-                                hash_join_invalid_val,
-                                thread_idx,
-                                thread_count);
-          });
-    }
-    for (auto& t : init_cpu_buff_threads) {
-      t.join();
+    size_t first_elem{0};
+    const auto cached_prefix =
+        getHashTableOnCpuToExtend(chunk_key, num_elements, cols, hash_entry_info);
+    if (cached_prefix) {
+      // Only rows were appended to the inner table since the cached table was built,
+      // its rows are the first rows of the column and keep their slots.
+      cpu_hash_table_buff_ =
+          std::make_shared<std::vector<int32_t>>(*cached_prefix->value);
+      first_elem = cached_prefix->key.num_elements;
+    } else {
+      cpu_hash_table_buff_ = std::make_shared<std::vector<int32_t>>(
+          hash_entry_info.getNormalizedHashEntryCount());
+      for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        init_cpu_buff_threads.emplace_back(
+            [this, hash_entry_info, hash_join_invalid_val, thread_idx, thread_count] {
+              init_hash_join_buff(&(*cpu_hash_table_buff_)[0],
+                                  hash_entry_info.getNormalizedHashEntryCount(),
+                                  hash_join_invalid_val,
+                                  thread_idx,
+                                  thread_count);
+            });
+      }
+      for (auto& t : init_cpu_buff_threads) {
+        t.join();
+      }
+      init_cpu_buff_threads.clear();
     }
-    init_cpu_buff_threads.clear();
     int err{0};
     for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
       init_cpu_buff_threads.emplace_back([this,
@@ -839,31 +855,37 @@ void JoinHashTable::initHashTableOnCpu(
                                           sd_outer_proxy,
                                           thread_idx,
                                           thread_count,
+                                          first_elem,
                                           &ti,
                                           &err,
                                           hash_entry_info] {
         int partial_err =
-            fill_hash_join_buff_bucketized(&(*cpu_hash_table_buff_)[0],
-                                           hash_join_invalid_val,
-                                           {col_buff, num_elements},
-                                           {static_cast<size_t>(ti.get_size()),
-                                            col_range_.getIntMin(),
-                                            col_range_.getIntMax(),
-                                            inline_fixed_encoding_null_val(ti),
-                                            isBitwiseEq(),
-                                            col_range_.getIntMax() + 1,
-                                            get_join_column_type_kind(ti)},
-                                           sd_inner_proxy,
-                                           sd_outer_proxy,
-                                           thread_idx,
-                                           thread_count,
-                                           hash_entry_info.bucket_normalization);
+            extend_hash_join_buff_bucketized(&(*cpu_hash_table_buff_)[0],
+                                             hash_join_invalid_val,
+                                             {col_buff, num_elements},
+                                             {static_cast<size_t>(ti.get_size()),
+                                              col_range_.getIntMin(),
+                                              col_range_.getIntMax(),
+                                              inline_fixed_encoding_null_val(ti),
+                                              isBitwiseEq(),
+                                              col_range_.getIntMax() + 1,
+                                              get_join_column_type_kind(ti)},
+                                             sd_inner_proxy,
+                                             sd_outer_proxy,
+                                             thread_idx,
+                                             thread_count,
+                                             hash_entry_info.bucket_normalization,
+                                             first_elem);
         __sync_val_compare_and_swap(&err, 0, partial_err);
       });
     }
     for (auto& t : init_cpu_buff_threads) {
       t.join();
     }
+    if (cached_prefix) {
+      // superseded by the table on all the rows, or stale if those need a 1:many table
+      join_hash_table_cache_.erase(cached_prefix->key);
+    }
     if (err) {
       cpu_hash_table_buff_.reset();
       // Too many hash entries, need to retry with a 1:many table
@@ -1016,8 +1038,12 @@ void JoinHashTable::initHashTableForDevice(
     initHashTableOnCpuFromCache(chunk_key, num_elements, cols);
     {
       std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
-      initHashTableOnCpu(
-          col_buff, num_elements, cols, hash_entry_info, hash_join_invalid_val);
+      initHashTableOnCpu(chunk_key,
+                         col_buff,
+                         num_elements,
+                         cols,
+                         hash_entry_info,
+                         hash_join_invalid_val);
     }
     if (inner_col->get_table_id() > 0) {
       putHashTableOnCpuToCache(chunk_key, num_elements, cols);
@@ -1246,13 +1272,11 @@ void JoinHashTable::initHashTableOnCpuFromCache(
                                   num_elements,
                                   chunk_key,
                                   qual_bin_oper_->get_optype()};
-  std::lock_guard<std::mutex> join_hash_table_cache_lock(join_hash_table_cache_mutex_);
-  for (const auto& kv : join_hash_table_cache_) {
-    if (kv.first == cache_key) {
-      std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
-      cpu_hash_table_buff_ = kv.second;
-      break;
-    }
+  const auto cached_buff =
+      join_hash_table_cache_.get(cache_key, getInnerTableEpoch(cols.first));
+  if (cached_buff) {
+    std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
+    cpu_hash_table_buff_ = *cached_buff;
   }
 }
 
@@ -1267,13 +1291,47 @@ void JoinHashTable::putHashTableOnCpuToCache(
                                   num_elements,
                                   chunk_key,
                                   qual_bin_oper_->get_optype()};
-  std::lock_guard<std::mutex> join_hash_table_cache_lock(join_hash_table_cache_mutex_);
-  for (const auto& kv : join_hash_table_cache_) {
-    if (kv.first == cache_key) {
-      return;
-    }
+  join_hash_table_cache_.put(cache_key,
+                             cpu_hash_table_buff_,
+                             cpu_hash_table_buff_->size() * sizeof(int32_t),
+                             getInnerTableEpoch(cols.first));
+}
+
+boost::optional<
+    HashTableCache<JoinHashTable::JoinHashTableCacheKey,
+                   std::shared_ptr<std::vector<int32_t>>>::Entry>
+JoinHashTable::getHashTableOnCpuToExtend(
+    const ChunkKey& chunk_key,
+    const size_t num_elements,
+    const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+    const HashEntryInfo hash_entry_info) {
+  const auto inner_col = cols.first;
+  if (inner_col->get_table_id() <= 0) {
+    return boost::none;
   }
-  join_hash_table_cache_.emplace_back(cache_key, cpu_hash_table_buff_);
+  const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
+  const auto& outer = outer_col ? *outer_col : *inner_col;
+  const auto optype = qual_bin_oper_->get_optype();
+  const auto table_epoch = getInnerTableEpoch(inner_col);
+  const auto entry_count = hash_entry_info.getNormalizedHashEntryCount();
+  // Updates and deletes clear the cache, and so do truncate, vacuum and drop, which can
+  // start the epoch over or move rows. An entry of an older epoch on fewer rows with the
+  // same layout was built before rows were appended.
+  return join_hash_table_cache_.findIf([&](const auto& entry) {
+    const auto& key = entry.key;
+    return entry.table_epoch < table_epoch && key.num_elements < num_elements &&
+           key.chunk_key == chunk_key && key.optype == optype &&
+           key.col_range == col_range_ && key.inner_col == *inner_col &&
+           key.outer_col == outer && entry.value->size() == entry_count;
+  });
+}
+
+int32_t JoinHashTable::getInnerTableEpoch(const Analyzer::ColumnVar* inner_col) const {
+  if (inner_col->get_table_id() <= 0) {
+    return -1;
+  }
+  const auto catalog = executor_->getCatalog();
+  return catalog->getTableEpoch(catalog->getCurrentDB().dbId, inner_col->get_table_id());
 }
 
 llvm::Value* JoinHashTable::codegenHashTableLoad(const size_t table_idx) {
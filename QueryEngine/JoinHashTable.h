@@ -33,6 +33,7 @@
 #include "Descriptors/InputDescriptors.h"
 #include "Descriptors/RowSetMemoryOwner.h"
 #include "ExpressionRange.h"
+#include "HashTableCache.h"
 #include "InputMetadata.h"
 #include "JoinHashTableInterface.h"
 
@@ -41,6 +42,8 @@
 #ifdef HAVE_CUDA
 #include <cuda.h>
 #endif
+#include <boost/functional/hash.hpp>
+
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -120,10 +123,7 @@ class JoinHashTable : public JoinHashTableInterface {
   static llvm::Value* codegenHashTableLoad(const size_t table_idx, Executor* executor);
 
   static auto yieldCacheInvalidator() -> std::function<void()> {
-    return []() -> void {
-      std::lock_guard<std::mutex> guard(join_hash_table_cache_mutex_);
-      join_hash_table_cache_.clear();
-    };
+    return []() -> void { join_hash_table_cache_.clear(); };
   }
 
   virtual ~JoinHashTable() {}
@@ -199,6 +199,7 @@ class JoinHashTable : public JoinHashTableInterface {
       const size_t num_elements,
       const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols);
   void initHashTableOnCpu(
+      const ChunkKey& chunk_key,
       const int8_t* col_buff,
       const size_t num_elements,
       const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
@@ -213,6 +214,8 @@ class JoinHashTable : public JoinHashTableInterface {
 
   const InputTableInfo& getInnerQueryInfo(const Analyzer::ColumnVar* inner_col) const;
 
+  int32_t getInnerTableEpoch(const Analyzer::ColumnVar* inner_col) const;
+
   size_t shardCount() const;
 
   llvm::Value* codegenHashTableLoad(const size_t table_idx);
@@ -271,12 +274,30 @@ class JoinHashTable : public JoinHashTableInterface {
              outer_col == that.outer_col && num_elements == that.num_elements &&
              chunk_key == that.chunk_key && optype == that.optype;
     }
+
+    size_t hash() const {
+      size_t seed = 0;
+      boost::hash_combine(seed, inner_col.get_table_id());
+      boost::hash_combine(seed, inner_col.get_column_id());
+      boost::hash_combine(seed, num_elements);
+      boost::hash_combine(seed, chunk_key);
+      boost::hash_combine(seed, static_cast<int>(optype));
+      return seed;
+    }
   };
 
-  static std::vector<
-      std::pair<JoinHashTableCacheKey, std::shared_ptr<std::vector<int32_t>>>>
+  // A cached one to one table on the first rows of the column, if the inner table has
+  // only been appended to since it was built.
+  boost::optional<
+      HashTableCache<JoinHashTableCacheKey, std::shared_ptr<std::vector<int32_t>>>::Entry>
+  getHashTableOnCpuToExtend(
+      const ChunkKey& chunk_key,
+      const size_t num_elements,
+      const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+      const HashEntryInfo hash_entry_info);
+
+  static HashTableCache<JoinHashTableCacheKey, std::shared_ptr<std::vector<int32_t>>>
       join_hash_table_cache_;
-  static std::mutex join_hash_table_cache_mutex_;
 };
 
 // TODO(alex): Functions below need to be moved to a separate translation unit, they don't
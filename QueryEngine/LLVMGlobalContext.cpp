@@ -40,3 +40,8 @@ llvm::LLVMContext& getGlobalLLVMContext() {
 }
 
 #endif
+
+std::recursive_mutex& getGlobalLLVMContextMutex() {
+  static std::recursive_mutex global_context_mutex;
+  return global_context_mutex;
+}
@@ -16,4 +16,11 @@
 
 #include <llvm/IR/LLVMContext.h>
 
+#include <mutex>
+
 llvm::LLVMContext& getGlobalLLVMContext();
+
+// The global context isn't thread safe: code generation and JIT compilation for
+// concurrently running queries, as well as destruction of their modules, happen under
+// this lock.
+std::recursive_mutex& getGlobalLLVMContextMutex();
@@ -38,11 +38,41 @@ std::shared_ptr<ResultSet> Executor::execute(
     const bool allow_multifrag,
     const bool allow_loop_joins,
     RenderInfo* render_info) {
-  catalog_ = &root_plan->getCatalog();
   const auto stmt_type = root_plan->get_stmt_type();
   // capture the lock acquistion time
   auto clock_begin = timer_start();
+  mapd_shared_lock<mapd_shared_mutex> gate_lock(execute_gate_mutex_);
+  if (stmt_type == kINSERT && root_plan->get_plan_dest() != Planner::RootPlan::kEXPLAIN) {
+    // The insert only appends through the fragmenter and doesn't touch the state of the
+    // executor, it doesn't wait for the query running on it. The query sees the new rows
+    // only if it gets the fragments of the table after the append.
+    auto& cat = session.getCatalog();
+    auto& sys_cat = Catalog_Namespace::SysCatalog::instance();
+    auto user_metadata = session.get_currentUser();
+    const int table_id = root_plan->get_result_table_id();
+    auto td = cat.getMetadataForTable(table_id);
+    DBObject dbObject(td->tableName, TableDBObjectType);
+    dbObject.loadKey(cat);
+    dbObject.setPrivileges(AccessPrivileges::INSERT_INTO_TABLE);
+    std::vector<DBObject> privObjects;
+    privObjects.push_back(dbObject);
+    if (!sys_cat.checkPrivileges(user_metadata, privObjects)) {
+      throw std::runtime_error("Violation of access privileges: user " +
+                               user_metadata.userName +
+                               " has no insert privileges for table " + td->tableName +
+                               ".");
+    }
+    executeSimpleInsert(root_plan);
+    auto empty_rs = std::make_shared<ResultSet>(std::vector<TargetInfo>{},
+                                                ExecutorDeviceType::CPU,
+                                                QueryMemoryDescriptor(),
+                                                nullptr,
+                                                this);
+    empty_rs->setQueueTime(timer_stop(clock_begin));
+    return empty_rs;
+  }
   std::lock_guard<std::mutex> lock(execute_mutex_);
+  catalog_ = &root_plan->getCatalog();
   if (g_enable_dynamic_watchdog) {
     resetInterrupt();
   }
@@ -54,35 +84,10 @@ std::shared_ptr<ResultSet> Executor::execute(
       throw std::runtime_error("The legacy SELECT path has been fully deprecated.");
     }
     case kINSERT: {
-      if (root_plan->get_plan_dest() == Planner::RootPlan::kEXPLAIN) {
-        auto explanation_rs = std::make_shared<ResultSet>("No explanation available.");
-        explanation_rs->setQueueTime(queue_time_ms);
-        return explanation_rs;
-      }
-      auto& cat = session.getCatalog();
-      auto& sys_cat = Catalog_Namespace::SysCatalog::instance();
-      auto user_metadata = session.get_currentUser();
-      const int table_id = root_plan->get_result_table_id();
-      auto td = cat.getMetadataForTable(table_id);
-      DBObject dbObject(td->tableName, TableDBObjectType);
-      dbObject.loadKey(cat);
-      dbObject.setPrivileges(AccessPrivileges::INSERT_INTO_TABLE);
-      std::vector<DBObject> privObjects;
-      privObjects.push_back(dbObject);
-      if (!sys_cat.checkPrivileges(user_metadata, privObjects)) {
-        throw std::runtime_error(
-            "Violation of access privileges: user " + user_metadata.userName +
-            " has no insert privileges for table " + td->tableName + ".");
-        break;
-      }
-      executeSimpleInsert(root_plan);
-      auto empty_rs = std::make_shared<ResultSet>(std::vector<TargetInfo>{},
-                                                  ExecutorDeviceType::CPU,
-                                                  QueryMemoryDescriptor(),
-                                                  nullptr,
-                                                  this);
-      empty_rs->setQueueTime(queue_time_ms);
-      return empty_rs;
+      CHECK(root_plan->get_plan_dest() == Planner::RootPlan::kEXPLAIN);
+      auto explanation_rs = std::make_shared<ResultSet>("No explanation available.");
+      explanation_rs->setQueueTime(queue_time_ms);
+      return explanation_rs;
     }
     default:
       CHECK(false);
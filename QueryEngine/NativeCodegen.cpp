@@ -19,7 +19,9 @@
 #include "ExtensionFunctionsWhitelist.h"
 #include "LLVMFunctionAttributesUtil.h"
 #include "OutputBufferInitialization.h"
+#include "PersistentCodeCache.h"
 #include "QueryTemplateGenerator.h"
+#include "VectorizedCodegen.h"
 
 #include "Shared/mapdpath.h"
 
@@ -27,6 +29,8 @@
 static_assert(false, "LLVM Version >= 4 is required.");
 #endif
 
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
@@ -39,11 +43,13 @@ static_assert(false, "LLVM Version >= 4 is required.");
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/FormattedStream.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_os_ostream.h>
+#include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <llvm/Transforms/InstCombine/InstCombine.h>
@@ -51,6 +57,7 @@ static_assert(false, "LLVM Version >= 4 is required.");
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Vectorize.h>
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Intrinsics.h"
 
@@ -71,6 +78,17 @@ std::unique_ptr<llvm::Module> rt_udf_cpu_module;
 extern std::unique_ptr<llvm::Module> g_rt_module;
 namespace {
 
+std::vector<std::string> get_host_cpu_attrs() {
+  std::vector<std::string> attrs;
+  llvm::StringMap<bool> host_features;
+  if (llvm::sys::getHostCPUFeatures(host_features)) {
+    for (const auto& feature : host_features) {
+      attrs.push_back((feature.second ? "+" : "-") + feature.first().str());
+    }
+  }
+  return attrs;
+}
+
 #if defined(HAVE_CUDA) || !defined(WITH_JIT_DEBUG)
 void eliminate_dead_self_recursive_funcs(
     llvm::Module& M,
@@ -97,11 +115,35 @@ void eliminate_dead_self_recursive_funcs(
   }
 }
 
+// Target machine for the CPU the server runs on, with all the vector extensions it has.
+std::unique_ptr<llvm::TargetMachine> create_host_target_machine() {
+  auto init_err = llvm::InitializeNativeTarget();
+  CHECK(!init_err);
+  const auto triple = llvm::sys::getProcessTriple();
+  std::string err_str;
+  const auto target = llvm::TargetRegistry::lookupTarget(triple, err_str);
+  CHECK(target) << err_str;
+  const auto cpu_attrs = get_host_cpu_attrs();
+  return std::unique_ptr<llvm::TargetMachine>(
+      target->createTargetMachine(triple,
+                                  llvm::sys::getHostCPUName(),
+                                  llvm::join(cpu_attrs.begin(), cpu_attrs.end(), ","),
+                                  llvm::TargetOptions(),
+                                  llvm::None));
+}
+
 void optimize_ir(llvm::Function* query_func,
                  llvm::Module* module,
                  const std::unordered_set<llvm::Function*>& live_funcs,
                  const CompilationOptions& co) {
+  std::unique_ptr<llvm::TargetMachine> host_target_machine;
   llvm::legacy::PassManager pass_manager;
+  if (co.vectorize_) {
+    // the loop vectorizer picks the vector width from the cost model of the target
+    host_target_machine = create_host_target_machine();
+    pass_manager.add(llvm::createTargetTransformInfoWrapperPass(
+        host_target_machine->getTargetIRAnalysis()));
+  }
 
   pass_manager.add(llvm::createAlwaysInlinerLegacyPass());
   pass_manager.add(llvm::createPromoteMemoryToRegisterPass());
@@ -114,6 +156,15 @@ void optimize_ir(llvm::Function* query_func,
   pass_manager.add(llvm::createGlobalOptimizerPass());
 
   pass_manager.add(llvm::createLICMPass());
+  if (co.vectorize_) {
+    pass_manager.add(llvm::createCFGSimplificationPass());
+    pass_manager.add(llvm::createLoopRotatePass());
+    pass_manager.add(llvm::createIndVarSimplifyPass());
+    pass_manager.add(llvm::createLoopVectorizePass());
+    pass_manager.add(llvm::createSLPVectorizerPass());
+    pass_manager.add(llvm::createInstructionCombiningPass());
+    pass_manager.add(llvm::createCFGSimplificationPass());
+  }
   if (co.opt_level_ == ExecutorOptLevel::LoopStrengthReduction) {
     pass_manager.add(llvm::createLoopStrengthReducePass());
   }
@@ -222,11 +273,14 @@ void Executor::addCodeToCache(
 ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
     llvm::Function* func,
     const std::unordered_set<llvm::Function*>& live_funcs,
-    const CompilationOptions& co) {
+    const CompilationOptions& co,
+    PersistentObjectCache* object_cache) {
   auto module = func->getParent();
-  // run optimizations
+  // run optimizations, unless the object code comes from the persistent cache
 #ifndef WITH_JIT_DEBUG
-  optimize_ir(func, module, live_funcs, co);
+  if (!object_cache || !object_cache->hasObject()) {
+    optimize_ir(func, module, live_funcs, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   auto init_err = llvm::InitializeNativeTarget();
@@ -247,11 +301,23 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   if (co.opt_level_ == ExecutorOptLevel::ReductionJIT) {
     eb.setOptLevel(llvm::CodeGenOpt::None);
   }
+  if (co.vectorize_) {
+    // the default target is the baseline of the architecture, e.g. SSE2 only on x86-64
+    eb.setMCPU(llvm::sys::getHostCPUName());
+    eb.setMAttrs(get_host_cpu_attrs());
+  }
 
   ExecutionEngineWrapper execution_engine(eb.create(), co);
   CHECK(execution_engine.get());
+  if (object_cache) {
+    execution_engine->setObjectCache(object_cache);
+  }
 
   execution_engine->finalizeObject();
+  if (object_cache) {
+    // only consulted while the module is compiled
+    execution_engine->setObjectCache(nullptr);
+  }
 
   return execution_engine;
 }
@@ -272,8 +338,17 @@ std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenCPU(
     return cached_code;
   }
 
-  auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+  std::unique_ptr<PersistentObjectCache> object_cache;
+  auto persistent_code_cache = PersistentCodeCache::get();
+  // code which embeds host addresses or links user defined functions can't be reused
+  // by another server process
+  if (persistent_code_cache && !cgen_state_->embeds_host_addresses_ &&
+      !is_udf_module_present(true) && !is_rt_udf_module_present(true)) {
+    object_cache = persistent_code_cache->getObjectCache(key, co);
+  }
+
+  auto execution_engine = CodeGenerator::generateNativeCPUCode(
+      query_func, live_funcs, co, object_cache.get());
   auto native_code = execution_engine->getPointerToFunction(multifrag_query_func);
   CHECK(native_code);
 
@@ -920,6 +995,7 @@ bool CodeGenerator::alwaysCloneRuntimeFunction(const llvm::Function* func) {
          func->getName() == "fixed_width_double_decode" ||
          func->getName() == "fixed_width_float_decode" ||
          func->getName() == "fixed_width_small_date_decode" ||
+         func->getName() == "run_length_int_decode" ||
          func->getName() == "record_error_code";
 }
 
@@ -1208,6 +1284,9 @@ std::vector<std::string> get_agg_fnames(const std::vector<Analyzer::Expr*>& targ
       case kAPPROX_COUNT_DISTINCT:
         result.emplace_back("agg_approximate_count_distinct");
         break;
+      case kAPPROX_PERCENTILE:
+        result.emplace_back("agg_approx_percentile");
+        break;
       default:
         CHECK(false);
     }
@@ -1609,11 +1688,18 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
       if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::StdSet ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::HashSet ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals_)) {
         throw QueryMustRunOnCpu();
       }
     }
+    // the digests of APPROX_PERCENTILE are only allocated in host memory
+    for (const auto target_expr : ra_exe_unit.target_exprs) {
+      if (is_approx_percentile_target(get_target_info(target_expr, g_bigint_count))) {
+        throw QueryMustRunOnCpu();
+      }
+    }
   }
 
   // Read the module template and target either CPU or GPU
@@ -1671,6 +1757,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   const auto agg_slot_count = ra_exe_unit.estimator ? size_t(1) : agg_fnames.size();
 
   const bool is_group_by{query_mem_desc->isGroupBy()};
+  CHECK(!co.vectorize_ || !is_group_by);
   auto query_func = is_group_by ? query_group_by_template(cgen_state_->module_,
                                                           co.hoist_literals_,
                                                           *query_mem_desc,
@@ -1679,7 +1766,8 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                                 : query_template(cgen_state_->module_,
                                                  agg_slot_count,
                                                  co.hoist_literals_,
-                                                 !!ra_exe_unit.estimator);
+                                                 !!ra_exe_unit.estimator,
+                                                 co.vectorize_);
   bind_pos_placeholders("pos_start", true, query_func, cgen_state_->module_);
   bind_pos_placeholders("group_buff_idx", false, query_func, cgen_state_->module_);
   bind_pos_placeholders("pos_step", false, query_func, cgen_state_->module_);
@@ -1740,29 +1828,43 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
     // we have some hoisted literals...
     hoisted_literals = inlineHoistedLiterals();
   }
+  llvm::Function* batch_filter_func{nullptr};
+  if (co.vectorize_) {
+    batch_filter_func = vectorized_codegen::create_batch_filter_function(
+        cgen_state_->row_func_, cgen_state_->batch_filter_br_);
+    cgen_state_->helper_functions_.push_back(batch_filter_func);
+  }
   // iterate through all the instruction in the query template function and
-  // replace the call to the filter placeholder with the call to the actual filter
+  // replace the calls to the filter placeholders with the calls to the actual filters
+  std::vector<std::pair<llvm::CallInst*, llvm::Function*>> filter_calls;
   for (auto it = llvm::inst_begin(query_func), e = llvm::inst_end(query_func); it != e;
        ++it) {
     if (!llvm::isa<llvm::CallInst>(*it)) {
       continue;
     }
     auto& filter_call = llvm::cast<llvm::CallInst>(*it);
-    if (std::string(filter_call.getCalledFunction()->getName()) == "row_process") {
-      std::vector<llvm::Value*> args;
-      for (size_t i = 0; i < filter_call.getNumArgOperands(); ++i) {
-        args.push_back(filter_call.getArgOperand(i));
-      }
-      args.insert(args.end(), col_heads.begin(), col_heads.end());
-      args.push_back(get_arg_by_name(query_func, "join_hash_tables"));
-      // push hoisted literals arguments, if any
-      args.insert(args.end(), hoisted_literals.begin(), hoisted_literals.end());
-
-      llvm::ReplaceInstWithInst(&filter_call,
-                                llvm::CallInst::Create(cgen_state_->row_func_, args, ""));
-      break;
+    const std::string callee_name{filter_call.getCalledFunction()->getName()};
+    if (callee_name == "row_process") {
+      filter_calls.emplace_back(&filter_call, cgen_state_->row_func_);
+    } else if (callee_name == "batch_filter") {
+      CHECK(batch_filter_func);
+      filter_calls.emplace_back(&filter_call, batch_filter_func);
     }
   }
+  for (const auto& filter_call_and_func : filter_calls) {
+    auto& filter_call = *filter_call_and_func.first;
+    std::vector<llvm::Value*> args;
+    for (size_t i = 0; i < filter_call.getNumArgOperands(); ++i) {
+      args.push_back(filter_call.getArgOperand(i));
+    }
+    args.insert(args.end(), col_heads.begin(), col_heads.end());
+    args.push_back(get_arg_by_name(query_func, "join_hash_tables"));
+    // push hoisted literals arguments, if any
+    args.insert(args.end(), hoisted_literals.begin(), hoisted_literals.end());
+
+    llvm::ReplaceInstWithInst(
+        &filter_call, llvm::CallInst::Create(filter_call_and_func.second, args, ""));
+  }
   plan_state_->init_agg_vals_ =
       init_agg_val_vec(ra_exe_unit.target_exprs, ra_exe_unit.quals, *query_mem_desc);
 
@@ -1863,8 +1965,34 @@ bool Executor::compileBody(const RelAlgExecutionUnit& ra_exe_unit,
             << "short-circuited and deferred " << std::to_string(deferred_quals.size())
             << " quals";
   }
-  llvm::Value* filter_lv = cgen_state_->llBool(true);
   CodeGenerator code_generator(this);
+  if (co.vectorize_) {
+    // the batchable quals go first, behind a branch the batch filter is cut at
+    llvm::Value* batch_filter_lv = cgen_state_->llBool(true);
+    for (auto quals : {&primary_quals, &deferred_quals}) {
+      std::vector<Analyzer::Expr*> remaining_quals;
+      for (auto expr : *quals) {
+        if (!vectorized_codegen::is_batchable_qual(expr)) {
+          remaining_quals.push_back(expr);
+          continue;
+        }
+        batch_filter_lv = cgen_state_->ir_builder_.CreateAnd(
+            batch_filter_lv,
+            code_generator.toBool(code_generator.codegen(expr, true, co).front()));
+      }
+      quals->swap(remaining_quals);
+    }
+    auto batch_filter_true = llvm::BasicBlock::Create(
+        cgen_state_->context_, "batch_filter_true", cgen_state_->row_func_);
+    auto batch_filter_false = llvm::BasicBlock::Create(
+        cgen_state_->context_, "batch_filter_false", cgen_state_->row_func_);
+    cgen_state_->batch_filter_br_ = cgen_state_->ir_builder_.CreateCondBr(
+        batch_filter_lv, batch_filter_true, batch_filter_false);
+    cgen_state_->ir_builder_.SetInsertPoint(batch_filter_false);
+    cgen_state_->ir_builder_.CreateRet(cgen_state_->llInt(int32_t(0)));
+    cgen_state_->ir_builder_.SetInsertPoint(batch_filter_true);
+  }
+  llvm::Value* filter_lv = cgen_state_->llBool(true);
   for (auto expr : primary_quals) {
     // Generate the filter for primary quals
     auto cond = code_generator.toBool(code_generator.codegen(expr, true, co).front());
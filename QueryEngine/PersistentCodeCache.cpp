@@ -0,0 +1,257 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PersistentCodeCache.h"
+#include "MurmurHash.h"
+
+#include "Shared/Logger.h"
+#include "Shared/mapdpath.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+std::unique_ptr<PersistentCodeCache> g_persistent_code_cache;
+
+const std::string kFingerprintFileName{"FINGERPRINT"};
+
+std::string read_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return "";
+  }
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+std::string to_hex(const uint64_t val) {
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << val;
+  return oss.str();
+}
+
+uint64_t hash_string(const std::string& str) {
+  return MurmurHash64A(str.data(), static_cast<int>(str.size()), 0);
+}
+
+// Anything which changes the generated object code without changing the query IR.
+std::string environment_fingerprint() {
+  std::string fingerprint = "llvm:" LLVM_VERSION_STRING "\ncpu:";
+  fingerprint += llvm::sys::getHostCPUName().str();
+  fingerprint += "\nfeatures:";
+  llvm::StringMap<bool> host_features;
+  if (llvm::sys::getHostCPUFeatures(host_features)) {
+    // StringMap iteration order is unspecified, sort for a stable fingerprint
+    std::map<std::string, bool> sorted_features;
+    for (const auto& feature : host_features) {
+      sorted_features.emplace(feature.first().str(), feature.second);
+    }
+    for (const auto& feature : sorted_features) {
+      fingerprint += (feature.second ? "+" : "-") + feature.first + ",";
+    }
+  }
+  const auto runtime_bitcode =
+      read_file(mapd_root_abs_path() + "/QueryEngine/RuntimeFunctions.bc");
+  CHECK(!runtime_bitcode.empty());
+  fingerprint += "\nruntime:" + to_hex(hash_string(runtime_bitcode)) + "\n";
+  return fingerprint;
+}
+
+std::string serialize_key(const CodeCacheKey& key, const CompilationOptions& co) {
+  std::string serialized_key =
+      "opt_level:" + std::to_string(static_cast<int>(co.opt_level_)) + "\n" +
+      "vectorize:" + std::to_string(co.vectorize_) + "\n";
+  for (const auto& ir : key) {
+    serialized_key += std::to_string(ir.size()) + ":" + ir;
+  }
+  return serialized_key;
+}
+
+}  // namespace
+
+PersistentObjectCache::PersistentObjectCache(PersistentCodeCache* cache,
+                                             const std::string& key,
+                                             const std::string& path)
+    : cache_(cache), key_(key), path_(path) {
+  auto buffer_or_error = llvm::MemoryBuffer::getFile(path_, -1, false);
+  if (buffer_or_error.getError()) {
+    return;
+  }
+  const auto& buffer = buffer_or_error.get();
+  const auto entry = buffer->getBuffer();
+  uint64_t key_size{0};
+  if (entry.size() < sizeof(key_size)) {
+    return;
+  }
+  memcpy(&key_size, entry.data(), sizeof(key_size));
+  const auto object_offset = sizeof(key_size) + key_size;
+  if (entry.size() <= object_offset ||
+      entry.substr(sizeof(key_size), key_size) != llvm::StringRef(key_)) {
+    // hash collision or truncated entry, it gets overwritten after the compilation
+    return;
+  }
+  object_ = llvm::MemoryBuffer::getMemBufferCopy(entry.substr(object_offset), path_);
+  boost::system::error_code ec;
+  // touch the entry for the eviction order
+  boost::filesystem::last_write_time(path_, std::time(nullptr), ec);
+}
+
+void PersistentObjectCache::notifyObjectCompiled(const llvm::Module* module,
+                                                 llvm::MemoryBufferRef object) {
+  if (hasObject()) {
+    return;
+  }
+  cache_->storeEntry(key_, path_, object);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentObjectCache::getObject(
+    const llvm::Module* module) {
+  if (!object_) {
+    return nullptr;
+  }
+  ++cache_->hit_count_;
+  return llvm::MemoryBuffer::getMemBufferCopy(object_->getBuffer(),
+                                              object_->getBufferIdentifier());
+}
+
+void PersistentCodeCache::init(const std::string& base_path, const size_t max_size) {
+  CHECK(!g_persistent_code_cache);
+  const auto cache_dir = boost::filesystem::path(base_path) / "mapd_jit_cache";
+  boost::filesystem::create_directories(cache_dir);
+  g_persistent_code_cache.reset(new PersistentCodeCache(cache_dir.string(), max_size));
+  LOG(INFO) << "Persistent JIT code cache enabled at " << cache_dir.string();
+}
+
+PersistentCodeCache* PersistentCodeCache::get() {
+  return g_persistent_code_cache.get();
+}
+
+PersistentCodeCache::PersistentCodeCache(const std::string& cache_dir,
+                                         const size_t max_size)
+    : cache_dir_(cache_dir), max_size_(max_size) {
+  checkFingerprint();
+  evictIfNeeded();
+}
+
+std::unique_ptr<PersistentObjectCache> PersistentCodeCache::getObjectCache(
+    const CodeCacheKey& key,
+    const CompilationOptions& co) {
+  const auto serialized_key = serialize_key(key, co);
+  return std::make_unique<PersistentObjectCache>(
+      this, serialized_key, entryPath(serialized_key));
+}
+
+void PersistentCodeCache::checkFingerprint() {
+  const auto fingerprint = environment_fingerprint();
+  const auto fingerprint_path =
+      (boost::filesystem::path(cache_dir_) / kFingerprintFileName).string();
+  if (read_file(fingerprint_path) == fingerprint) {
+    return;
+  }
+  LOG(INFO) << "LLVM, CPU or runtime functions changed, clearing the persistent JIT "
+               "code cache";
+  for (boost::filesystem::directory_iterator it(cache_dir_), end; it != end; ++it) {
+    if (it->path().extension() == ".o") {
+      boost::filesystem::remove(it->path());
+    }
+  }
+  std::ofstream out(fingerprint_path, std::ios::binary | std::ios::trunc);
+  out << fingerprint;
+}
+
+void PersistentCodeCache::evictIfNeeded() {
+  std::lock_guard<std::mutex> lock(eviction_mutex_);
+  std::vector<std::pair<std::time_t, boost::filesystem::path>> entries;
+  size_t total_size{0};
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator it(cache_dir_), end; it != end; ++it) {
+    if (it->path().extension() != ".o") {
+      continue;
+    }
+    const auto size = boost::filesystem::file_size(it->path(), ec);
+    if (ec) {
+      continue;
+    }
+    total_size += size;
+    entries.emplace_back(boost::filesystem::last_write_time(it->path(), ec), it->path());
+  }
+  if (total_size <= max_size_) {
+    return;
+  }
+  std::sort(entries.begin(), entries.end());
+  for (const auto& entry : entries) {
+    if (total_size <= max_size_) {
+      break;
+    }
+    const auto size = boost::filesystem::file_size(entry.second, ec);
+    if (!ec && boost::filesystem::remove(entry.second, ec)) {
+      total_size -= size;
+    }
+  }
+}
+
+std::string PersistentCodeCache::entryPath(const std::string& key) const {
+  return (boost::filesystem::path(cache_dir_) / (to_hex(hash_string(key)) + ".o"))
+      .string();
+}
+
+void PersistentCodeCache::storeEntry(const std::string& key,
+                                     const std::string& path,
+                                     llvm::MemoryBufferRef object) {
+  // write under a temporary name first, concurrent readers never see a partial entry
+  const auto tmp_path =
+      path + "." + to_hex(std::hash<std::thread::id>{}(std::this_thread::get_id())) +
+      ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      LOG(WARNING) << "Could not write persistent JIT code cache entry " << tmp_path;
+      return;
+    }
+    const uint64_t key_size = key.size();
+    out.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    out.write(key.data(), key.size());
+    out.write(object.getBufferStart(), object.getBufferSize());
+    if (!out) {
+      out.close();
+      boost::system::error_code ec;
+      boost::filesystem::remove(tmp_path, ec);
+      return;
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    boost::filesystem::remove(tmp_path, ec);
+    return;
+  }
+  evictIfNeeded();
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PersistentCodeCache.h
+ * @brief   On-disk cache of the object code of CPU query kernels, which survives server
+ * restarts and clears of the in-memory code caches.
+ *
+ * Entries live under <base path>/mapd_jit_cache, one file per kernel. A file holds the
+ * full cache key (the serialized query IR and the optimization level) followed by the
+ * object code, and is only used if the stored key matches exactly. The directory is
+ * tagged with a fingerprint of the LLVM version, the host CPU and its features and the
+ * runtime functions bitcode; all entries are dropped when the fingerprint changes. When
+ * the cache grows past its size limit, the least recently used entries are removed.
+ */
+
+#pragma once
+
+#include "CodeCache.h"
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+class PersistentCodeCache;
+
+/**
+ * Per kernel adapter handed to MCJIT. The cached object, if any, is loaded on
+ * construction so the caller can skip IR optimization on a hit.
+ */
+class PersistentObjectCache : public llvm::ObjectCache {
+ public:
+  PersistentObjectCache(PersistentCodeCache* cache,
+                        const std::string& key,
+                        const std::string& path);
+
+  bool hasObject() const { return object_ != nullptr; }
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef object) override;
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+ private:
+  PersistentCodeCache* cache_;
+  const std::string key_;
+  const std::string path_;
+  std::unique_ptr<llvm::MemoryBuffer> object_;
+};
+
+class PersistentCodeCache {
+ public:
+  /// Enables the cache under the given base path. Called once at server start.
+  static void init(const std::string& base_path, const size_t max_size);
+
+  /// Returns nullptr unless the cache has been enabled.
+  static PersistentCodeCache* get();
+
+  std::unique_ptr<PersistentObjectCache> getObjectCache(const CodeCacheKey& key,
+                                                        const CompilationOptions& co);
+
+  /// Number of kernels loaded from the cache instead of compiled.
+  size_t getHitCount() const { return hit_count_; }
+
+ private:
+  PersistentCodeCache(const std::string& cache_dir, const size_t max_size);
+
+  void checkFingerprint();
+  void evictIfNeeded();
+
+  std::string entryPath(const std::string& key) const;
+  void storeEntry(const std::string& key,
+                  const std::string& path,
+                  llvm::MemoryBufferRef object);
+
+  const std::string cache_dir_;
+  const size_t max_size_;
+  std::mutex eviction_mutex_;
+  std::atomic<size_t> hit_count_{0};
+
+  friend class PersistentObjectCache;
+};
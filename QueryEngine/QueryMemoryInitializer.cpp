@@ -16,6 +16,7 @@
 
 #include "QueryMemoryInitializer.h"
 
+#include "ApproxPercentile.h"
 #include "Execute.h"
 #include "GpuInitGroups.h"
 #include "GpuMemUtils.h"
@@ -28,7 +29,23 @@
 
 namespace {
 
-inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc) {
+// Bitmap sizes of the deferred count distinct sets, which have no bitmap.
+constexpr ssize_t kDeferredStdSet{-1};
+constexpr ssize_t kDeferredHashSet{-2};
+
+// Percentile of the slots which don't hold the digest of an APPROX_PERCENTILE.
+constexpr double kNoApproxPercentile{-1};
+
+double get_approx_percentile(const Analyzer::Expr* target_expr) {
+  const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+  CHECK(agg_expr);
+  const auto percentile = agg_expr->get_arg1();
+  // APPROX_MEDIAN doesn't take a percentile
+  return percentile ? percentile->get_constval().doubleval : 0.5;
+}
+
+inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc,
+                                      const Executor* executor) {
   const int32_t groups_buffer_entry_count = query_mem_desc.getEntryCount();
   if (g_enable_watchdog) {
     checked_int64_t total_bytes_per_group = 0;
@@ -41,6 +58,12 @@ inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_des
       }
       total_bytes_per_group += count_distinct_desc.bitmapPaddedSizeBytes();
     }
+    for (const auto target_expr : executor->plan_state_->target_exprs_) {
+      if (is_approx_percentile_target(get_target_info(target_expr, g_bigint_count))) {
+        total_bytes_per_group +=
+            approx_percentile_buffer_size(g_approx_percentile_compression);
+      }
+    }
     int64_t total_bytes{0};
     // Using OutOfHostMemory until we can verify that SlabTooBig would also be properly
     // caught
@@ -182,7 +205,7 @@ QueryMemoryInitializer::QueryMemoryInitializer(
     return;
   }
   if (!ra_exe_unit.use_bump_allocator) {
-    check_total_bitmap_memory(query_mem_desc);
+    check_total_bitmap_memory(query_mem_desc, executor);
   }
   if (device_type == ExecutorDeviceType::GPU) {
     allocateCountDistinctGpuMem(query_mem_desc);
@@ -190,6 +213,7 @@ QueryMemoryInitializer::QueryMemoryInitializer(
 
   if (render_allocator_map || !query_mem_desc.isGroupBy()) {
     allocateCountDistinctBuffers(query_mem_desc, false, executor);
+    allocateApproxPercentileBuffers(query_mem_desc, false, 1, executor);
     if (render_info && render_info->useCudaBuffers()) {
       return;
     }
@@ -250,6 +274,13 @@ QueryMemoryInitializer::QueryMemoryInitializer(
                  warp_size,
                  executor);
     }
+    if (query_mem_desc.hasHashTags()) {
+      const auto tags_off = query_mem_desc.getHashTagsOffInBytes();
+      CHECK_LT(tags_off, group_buffer_size);
+      memset(reinterpret_cast<int8_t*>(group_by_buffer_template.get()) + tags_off,
+             0,
+             group_buffer_size - tags_off);
+    }
   }
 
   if (query_mem_desc.interleavedBins(device_type)) {
@@ -399,6 +430,11 @@ void QueryMemoryInitializer::initGroups(const QueryMemoryDescriptor& query_mem_d
   const size_t col_base_off{query_mem_desc.getColOffInBytes(0)};
 
   auto agg_bitmap_size = allocateCountDistinctBuffers(query_mem_desc, true, executor);
+  const auto digest_percentiles = allocateApproxPercentileBuffers(
+      query_mem_desc,
+      true,
+      groups_buffer_entry_count * (query_mem_desc.hasKeylessHash() ? warp_size : 1),
+      executor);
   auto buffer_ptr = reinterpret_cast<int8_t*>(groups_buffer);
 
   const auto query_mem_desc_fixedup =
@@ -414,7 +450,8 @@ void QueryMemoryInitializer::initGroups(const QueryMemoryDescriptor& query_mem_d
                          &buffer_ptr[col_base_off],
                          bin,
                          init_vals,
-                         agg_bitmap_size);
+                         agg_bitmap_size,
+                         digest_percentiles);
       }
     }
     return;
@@ -427,7 +464,8 @@ void QueryMemoryInitializer::initGroups(const QueryMemoryDescriptor& query_mem_d
                      &buffer_ptr[col_base_off],
                      bin,
                      init_vals,
-                     agg_bitmap_size);
+                     agg_bitmap_size,
+                     digest_percentiles);
   }
 }
 
@@ -502,18 +540,26 @@ void QueryMemoryInitializer::initColumnarGroups(
   }
 }
 
-void QueryMemoryInitializer::initColumnPerRow(const QueryMemoryDescriptor& query_mem_desc,
-                                              int8_t* row_ptr,
-                                              const size_t bin,
-                                              const std::vector<int64_t>& init_vals,
-                                              const std::vector<ssize_t>& bitmap_sizes) {
+void QueryMemoryInitializer::initColumnPerRow(
+    const QueryMemoryDescriptor& query_mem_desc,
+    int8_t* row_ptr,
+    const size_t bin,
+    const std::vector<int64_t>& init_vals,
+    const std::vector<ssize_t>& bitmap_sizes,
+    const std::vector<double>& digest_percentiles) {
   int8_t* col_ptr = row_ptr;
   size_t init_vec_idx = 0;
   for (size_t col_idx = 0; col_idx < query_mem_desc.getSlotCount();
        col_ptr += query_mem_desc.getNextColOffInBytes(col_ptr, bin, col_idx++)) {
     const ssize_t bm_sz{bitmap_sizes[col_idx]};
     int64_t init_val{0};
-    if (!bm_sz || !query_mem_desc.isGroupBy()) {
+    if (query_mem_desc.isGroupBy() &&
+        digest_percentiles[col_idx] != kNoApproxPercentile) {
+      CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
+               sizeof(int64_t));
+      init_val = allocateApproxPercentileBuffer(digest_percentiles[col_idx]);
+      ++init_vec_idx;
+    } else if (!bm_sz || !query_mem_desc.isGroupBy()) {
       if (query_mem_desc.getPaddedSlotWidthBytes(col_idx) > 0) {
         CHECK_LT(init_vec_idx, init_vals.size());
         init_val = init_vals[init_vec_idx++];
@@ -521,8 +567,14 @@ void QueryMemoryInitializer::initColumnPerRow(const QueryMemoryDescriptor& query
     } else {
       CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
                sizeof(int64_t));
-      init_val =
-          bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
+      if (bm_sz > 0) {
+        init_val = allocateCountDistinctBitmap(bm_sz);
+      } else {
+        CHECK(bm_sz == kDeferredStdSet || bm_sz == kDeferredHashSet);
+        init_val = allocateCountDistinctSet(bm_sz == kDeferredHashSet
+                                                ? CountDistinctImplType::HashSet
+                                                : CountDistinctImplType::StdSet);
+      }
       ++init_vec_idx;
     }
     switch (query_mem_desc.getPaddedSlotWidthBytes(col_idx)) {
@@ -613,11 +665,16 @@ std::vector<ssize_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
           init_agg_vals_[agg_col_idx] = allocateCountDistinctBitmap(bitmap_byte_sz);
         }
       } else {
-        CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
+        CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet ||
+              count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
         if (deferred) {
-          agg_bitmap_size[agg_col_idx] = -1;
+          agg_bitmap_size[agg_col_idx] =
+              count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet
+                  ? kDeferredHashSet
+                  : kDeferredStdSet;
         } else {
-          init_agg_vals_[agg_col_idx] = allocateCountDistinctSet();
+          init_agg_vals_[agg_col_idx] =
+              allocateCountDistinctSet(count_distinct_desc.impl_type_);
         }
       }
     }
@@ -639,12 +696,72 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
   return reinterpret_cast<int64_t>(count_distinct_buffer);
 }
 
-int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
+int64_t QueryMemoryInitializer::allocateCountDistinctSet(
+    const CountDistinctImplType impl_type) {
+  if (impl_type == CountDistinctImplType::HashSet) {
+    auto count_distinct_set = new CountDistinctHashSet();
+    row_set_mem_owner_->addCountDistinctHashSet(count_distinct_set);
+    return reinterpret_cast<int64_t>(count_distinct_set);
+  }
+  CHECK(impl_type == CountDistinctImplType::StdSet);
   auto count_distinct_set = new std::set<int64_t>();
   row_set_mem_owner_->addCountDistinctSet(count_distinct_set);
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
+// deferred is true for group by queries; initGroups will allocate a digest for each
+// of the entry_count rows at the returned percentiles. The digests of all the rows are
+// carved from a single buffer.
+std::vector<double> QueryMemoryInitializer::allocateApproxPercentileBuffers(
+    const QueryMemoryDescriptor& query_mem_desc,
+    const bool deferred,
+    const size_t entry_count,
+    const Executor* executor) {
+  const size_t agg_col_count{query_mem_desc.getSlotCount()};
+  std::vector<double> digest_percentiles(deferred ? agg_col_count : 0,
+                                         kNoApproxPercentile);
+  std::vector<size_t> digest_target_indices;
+  for (size_t target_idx = 0; target_idx < executor->plan_state_->target_exprs_.size();
+       ++target_idx) {
+    const auto target_expr = executor->plan_state_->target_exprs_[target_idx];
+    if (is_approx_percentile_target(get_target_info(target_expr, g_bigint_count))) {
+      digest_target_indices.push_back(target_idx);
+    }
+  }
+  if (digest_target_indices.empty()) {
+    return digest_percentiles;
+  }
+  const auto buffer_size = approx_percentile_buffer_size(g_approx_percentile_compression);
+  const auto digests_mem_bytes = digest_target_indices.size() * entry_count * buffer_size;
+  approx_percentile_crt_ptr_ = static_cast<int8_t*>(checked_malloc(digests_mem_bytes));
+  approx_percentile_end_ptr_ = approx_percentile_crt_ptr_ + digests_mem_bytes;
+  row_set_mem_owner_->addApproxPercentileBuffer(approx_percentile_crt_ptr_);
+  for (const auto target_idx : digest_target_indices) {
+    const auto target_expr = executor->plan_state_->target_exprs_[target_idx];
+    const auto agg_col_idx = query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
+    CHECK_LT(static_cast<size_t>(agg_col_idx), agg_col_count);
+    CHECK_EQ(static_cast<size_t>(query_mem_desc.getLogicalSlotWidthBytes(agg_col_idx)),
+             sizeof(int64_t));
+    const auto percentile = get_approx_percentile(target_expr);
+    if (deferred) {
+      digest_percentiles[agg_col_idx] = percentile;
+    } else {
+      init_agg_vals_[agg_col_idx] = allocateApproxPercentileBuffer(percentile);
+    }
+  }
+  return digest_percentiles;
+}
+
+int64_t QueryMemoryInitializer::allocateApproxPercentileBuffer(const double percentile) {
+  const auto buffer_size = approx_percentile_buffer_size(g_approx_percentile_compression);
+  CHECK(approx_percentile_crt_ptr_);
+  CHECK_LE(approx_percentile_crt_ptr_ + buffer_size, approx_percentile_end_ptr_);
+  auto buffer = approx_percentile_crt_ptr_;
+  approx_percentile_crt_ptr_ += buffer_size;
+  approx_percentile_init(buffer, percentile, g_approx_percentile_compression);
+  return reinterpret_cast<int64_t>(buffer);
+}
+
 #ifdef HAVE_CUDA
 GpuGroupByBuffers QueryMemoryInitializer::prepareTopNHeapsDevBuffer(
     const QueryMemoryDescriptor& query_mem_desc,
@@ -137,7 +137,8 @@ class QueryMemoryInitializer {
                         int8_t* row_ptr,
                         const size_t bin,
                         const std::vector<int64_t>& init_vals,
-                        const std::vector<ssize_t>& bitmap_sizes);
+                        const std::vector<ssize_t>& bitmap_sizes,
+                        const std::vector<double>& digest_percentiles);
 
   void allocateCountDistinctGpuMem(const QueryMemoryDescriptor& query_mem_desc);
 
@@ -148,7 +149,15 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctBitmap(const size_t bitmap_byte_sz);
 
-  int64_t allocateCountDistinctSet();
+  int64_t allocateCountDistinctSet(const CountDistinctImplType impl_type);
+
+  std::vector<double> allocateApproxPercentileBuffers(
+      const QueryMemoryDescriptor& query_mem_desc,
+      const bool deferred,
+      const size_t entry_count,
+      const Executor* executor);
+
+  int64_t allocateApproxPercentileBuffer(const double percentile);
 
 #ifdef HAVE_CUDA
   GpuGroupByBuffers prepareTopNHeapsDevBuffer(const QueryMemoryDescriptor& query_mem_desc,
@@ -209,6 +218,10 @@ class QueryMemoryInitializer {
   int8_t* count_distinct_bitmap_crt_ptr_;
   int8_t* count_distinct_bitmap_host_mem_;
 
+  // next free digest and end of the digests buffer of the approximate percentiles
+  int8_t* approx_percentile_crt_ptr_{nullptr};
+  int8_t* approx_percentile_end_ptr_{nullptr};
+
   DeviceAllocator* device_allocator_{nullptr};
 
   friend class Executor;  // Accesses result_sets_
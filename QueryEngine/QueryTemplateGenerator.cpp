@@ -16,6 +16,7 @@
 
 #include "QueryTemplateGenerator.h"
 #include "Shared/Logger.h"
+#include "VectorizedCodegen.h"
 
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Instructions.h>
@@ -184,7 +185,8 @@ template <class Attributes>
 llvm::Function* query_template_impl(llvm::Module* mod,
                                     const size_t aggr_col_count,
                                     const bool hoist_literals,
-                                    const bool is_estimate_query) {
+                                    const bool is_estimate_query,
+                                    const bool vectorized) {
   using namespace llvm;
 
   auto func_pos_start = pos_start<Attributes>(mod);
@@ -305,7 +307,22 @@ llvm::Function* query_template_impl(llvm::Module* mod,
   auto bb_entry = BasicBlock::Create(mod->getContext(), ".entry", query_func_ptr, 0);
   auto bb_preheader =
       BasicBlock::Create(mod->getContext(), ".loop.preheader", query_func_ptr, 0);
+  BasicBlock* bb_batch{nullptr};
+  BasicBlock* bb_batch_filter{nullptr};
+  if (vectorized) {
+    bb_batch = BasicBlock::Create(mod->getContext(), ".batch", query_func_ptr, 0);
+    bb_batch_filter =
+        BasicBlock::Create(mod->getContext(), ".batch.filter", query_func_ptr, 0);
+  }
   auto bb_forbody = BasicBlock::Create(mod->getContext(), ".for.body", query_func_ptr, 0);
+  BasicBlock* bb_row{nullptr};
+  BasicBlock* bb_for_inc{nullptr};
+  BasicBlock* bb_batch_inc{nullptr};
+  if (vectorized) {
+    bb_row = BasicBlock::Create(mod->getContext(), ".row", query_func_ptr, 0);
+    bb_for_inc = BasicBlock::Create(mod->getContext(), ".for.inc", query_func_ptr, 0);
+    bb_batch_inc = BasicBlock::Create(mod->getContext(), ".batch.inc", query_func_ptr, 0);
+  }
   auto bb_crit_edge =
       BasicBlock::Create(mod->getContext(), "._crit_edge", query_func_ptr, 0);
   auto bb_exit = BasicBlock::Create(mod->getContext(), ".exit", query_func_ptr, 0);
@@ -320,6 +337,15 @@ llvm::Function* query_template_impl(llvm::Module* mod,
     }
   }
 
+  AllocaInst* batch_mask{nullptr};
+  if (vectorized) {
+    batch_mask = new AllocaInst(ArrayType::get(i8_type, vectorized_codegen::kBatchSize),
+                                0,
+                                "batch_mask",
+                                bb_entry);
+    batch_mask->setAlignment(64);
+  }
+
   LoadInst* row_count = new LoadInst(row_count_ptr, "row_count", false, bb_entry);
   row_count->setAlignment(8);
   row_count->setName("row_count");
@@ -363,42 +389,139 @@ llvm::Function* query_template_impl(llvm::Module* mod,
       new ICmpInst(*bb_entry, ICmpInst::ICMP_SLT, pos_start_i64, row_count, "");
   BranchInst::Create(bb_preheader, bb_exit, enter_or_not, bb_entry);
 
-  // Block .loop.preheader
-  CastInst* pos_step_i64 = new SExtInst(pos_step, i64_type, "", bb_preheader);
-  BranchInst::Create(bb_forbody, bb_preheader);
+  auto row_process_params = [&](Value* pos, BasicBlock* bb) {
+    std::vector<Value*> params;
+    params.insert(params.end(), result_ptr_vec.begin(), result_ptr_vec.end());
+    if (is_estimate_query) {
+      params.push_back(new LoadInst(out, "", false, bb));
+    }
+    params.push_back(agg_init_val);
+    params.push_back(pos);
+    params.push_back(frag_row_off_ptr);
+    params.push_back(row_count_ptr);
+    if (hoist_literals) {
+      CHECK(literals);
+      params.push_back(literals);
+    }
+    return params;
+  };
+
+  if (vectorized) {
+    // Rows are visited contiguously, the CPU kernels have a step of one. The batch filter
+    // loop has no side effects besides the mask stores, which lets LLVM vectorize it.
+    auto func_batch_filter = mod->getFunction("batch_filter");
+    if (!func_batch_filter) {
+      func_batch_filter = Function::Create(func_row_process->getFunctionType(),
+                                           GlobalValue::ExternalLinkage,
+                                           "batch_filter",
+                                           mod);
+      func_batch_filter->setCallingConv(CallingConv::C);
+    }
+    auto one_i64 = ConstantInt::get(i64_type, 1);
+    auto zero_i64 = ConstantInt::get(i64_type, 0);
+
+    // Block .loop.preheader
+    BranchInst::Create(bb_batch, bb_preheader);
+
+    // Block .batch
+    PHINode* batch_start = PHINode::Create(i64_type, 2, "batch_start", bb_batch);
+    auto batch_full_end = BinaryOperator::CreateNSW(
+        Instruction::Add,
+        batch_start,
+        ConstantInt::get(i64_type, vectorized_codegen::kBatchSize),
+        "",
+        bb_batch);
+    ICmpInst* is_last_batch =
+        new ICmpInst(*bb_batch, ICmpInst::ICMP_SLT, row_count, batch_full_end, "");
+    auto batch_end = SelectInst::Create(
+        is_last_batch, row_count, batch_full_end, "batch_end", bb_batch);
+    BranchInst::Create(bb_batch_filter, bb_batch);
+
+    // Block .batch.filter
+    PHINode* filter_pos = PHINode::Create(i64_type, 2, "filter_pos", bb_batch_filter);
+    CallInst* batch_filter =
+        CallInst::Create(func_batch_filter,
+                         row_process_params(filter_pos, bb_batch_filter),
+                         "",
+                         bb_batch_filter);
+    batch_filter->setCallingConv(CallingConv::C);
+    auto selected = new TruncInst(batch_filter, i8_type, "", bb_batch_filter);
+    auto filter_mask_idx = BinaryOperator::CreateNSW(
+        Instruction::Sub, filter_pos, batch_start, "", bb_batch_filter);
+    auto filter_mask_gep = GetElementPtrInst::CreateInBounds(
+        batch_mask, {zero_i64, filter_mask_idx}, "", bb_batch_filter);
+    new StoreInst(selected, filter_mask_gep, false, bb_batch_filter);
+    auto filter_pos_inc = BinaryOperator::CreateNSW(
+        Instruction::Add, filter_pos, one_i64, "", bb_batch_filter);
+    ICmpInst* filter_loop_or_exit = new ICmpInst(
+        *bb_batch_filter, ICmpInst::ICMP_SLT, filter_pos_inc, batch_end, "");
+    BranchInst::Create(bb_batch_filter, bb_forbody, filter_loop_or_exit, bb_batch_filter);
+    filter_pos->addIncoming(batch_start, bb_batch);
+    filter_pos->addIncoming(filter_pos_inc, bb_batch_filter);
+
+    // Block .for.body
+    PHINode* pos = PHINode::Create(i64_type, 2, "pos", bb_forbody);
+    auto mask_idx =
+        BinaryOperator::CreateNSW(Instruction::Sub, pos, batch_start, "", bb_forbody);
+    auto mask_gep = GetElementPtrInst::CreateInBounds(
+        batch_mask, {zero_i64, mask_idx}, "", bb_forbody);
+    auto mask_val = new LoadInst(mask_gep, "", false, bb_forbody);
+    ICmpInst* is_selected = new ICmpInst(
+        *bb_forbody, ICmpInst::ICMP_NE, mask_val, ConstantInt::get(i8_type, 0), "");
+    BranchInst::Create(bb_row, bb_for_inc, is_selected, bb_forbody);
+
+    // Block .row
+    CallInst* row_process =
+        CallInst::Create(func_row_process, row_process_params(pos, bb_row), "", bb_row);
+    row_process->setCallingConv(CallingConv::C);
+    row_process->setTailCall(false);
+    Attributes row_process_pal;
+    row_process->setAttributes(row_process_pal);
+    BranchInst::Create(bb_for_inc, bb_row);
+
+    // Block .for.inc
+    auto pos_inc =
+        BinaryOperator::CreateNSW(Instruction::Add, pos, one_i64, "", bb_for_inc);
+    ICmpInst* loop_or_exit =
+        new ICmpInst(*bb_for_inc, ICmpInst::ICMP_SLT, pos_inc, batch_end, "");
+    BranchInst::Create(bb_forbody, bb_batch_inc, loop_or_exit, bb_for_inc);
+    pos->addIncoming(batch_start, bb_batch_filter);
+    pos->addIncoming(pos_inc, bb_for_inc);
+
+    // Block .batch.inc
+    ICmpInst* batch_loop_or_exit =
+        new ICmpInst(*bb_batch_inc, ICmpInst::ICMP_SLT, batch_end, row_count, "");
+    BranchInst::Create(bb_batch, bb_crit_edge, batch_loop_or_exit, bb_batch_inc);
+    batch_start->addIncoming(pos_start_i64, bb_preheader);
+    batch_start->addIncoming(batch_end, bb_batch_inc);
+  } else {
+    // Block .loop.preheader
+    CastInst* pos_step_i64 = new SExtInst(pos_step, i64_type, "", bb_preheader);
+    BranchInst::Create(bb_forbody, bb_preheader);
 
-  // Block  .forbody
-  Argument* pos_inc_pre = new Argument(i64_type);
-  PHINode* pos = PHINode::Create(i64_type, 2, "pos", bb_forbody);
-  pos->addIncoming(pos_start_i64, bb_preheader);
-  pos->addIncoming(pos_inc_pre, bb_forbody);
+    // Block  .forbody
+    Argument* pos_inc_pre = new Argument(i64_type);
+    PHINode* pos = PHINode::Create(i64_type, 2, "pos", bb_forbody);
+    pos->addIncoming(pos_start_i64, bb_preheader);
+    pos->addIncoming(pos_inc_pre, bb_forbody);
+
+    CallInst* row_process = CallInst::Create(
+        func_row_process, row_process_params(pos, bb_forbody), "", bb_forbody);
+    row_process->setCallingConv(CallingConv::C);
+    row_process->setTailCall(false);
+    Attributes row_process_pal;
+    row_process->setAttributes(row_process_pal);
+
+    BinaryOperator* pos_inc =
+        BinaryOperator::CreateNSW(Instruction::Add, pos, pos_step_i64, "", bb_forbody);
+    ICmpInst* loop_or_exit =
+        new ICmpInst(*bb_forbody, ICmpInst::ICMP_SLT, pos_inc, row_count, "");
+    BranchInst::Create(bb_forbody, bb_crit_edge, loop_or_exit, bb_forbody);
 
-  std::vector<Value*> row_process_params;
-  row_process_params.insert(
-      row_process_params.end(), result_ptr_vec.begin(), result_ptr_vec.end());
-  if (is_estimate_query) {
-    row_process_params.push_back(new LoadInst(out, "", false, bb_forbody));
+    // Resolve Forward References
+    pos_inc_pre->replaceAllUsesWith(pos_inc);
+    delete pos_inc_pre;
   }
-  row_process_params.push_back(agg_init_val);
-  row_process_params.push_back(pos);
-  row_process_params.push_back(frag_row_off_ptr);
-  row_process_params.push_back(row_count_ptr);
-  if (hoist_literals) {
-    CHECK(literals);
-    row_process_params.push_back(literals);
-  }
-  CallInst* row_process =
-      CallInst::Create(func_row_process, row_process_params, "", bb_forbody);
-  row_process->setCallingConv(CallingConv::C);
-  row_process->setTailCall(false);
-  Attributes row_process_pal;
-  row_process->setAttributes(row_process_pal);
-
-  BinaryOperator* pos_inc =
-      BinaryOperator::CreateNSW(Instruction::Add, pos, pos_step_i64, "", bb_forbody);
-  ICmpInst* loop_or_exit =
-      new ICmpInst(*bb_forbody, ICmpInst::ICMP_SLT, pos_inc, row_count, "");
-  BranchInst::Create(bb_forbody, bb_crit_edge, loop_or_exit, bb_forbody);
 
   // Block ._crit_edge
   std::vector<Instruction*> result_vec_pre;
@@ -444,10 +567,6 @@ llvm::Function* query_template_impl(llvm::Module* mod,
 
   ReturnInst::Create(mod->getContext(), bb_exit);
 
-  // Resolve Forward References
-  pos_inc_pre->replaceAllUsesWith(pos_inc);
-  delete pos_inc_pre;
-
   if (verifyFunction(*query_func_ptr)) {
     LOG(FATAL) << "Generated invalid code. ";
   }
@@ -808,9 +927,10 @@ llvm::Function* query_group_by_template_impl(llvm::Module* mod,
 llvm::Function* query_template(llvm::Module* module,
                                const size_t aggr_col_count,
                                const bool hoist_literals,
-                               const bool is_estimate_query) {
+                               const bool is_estimate_query,
+                               const bool vectorized) {
   return query_template_impl<llvm::AttributeList>(
-      module, aggr_col_count, hoist_literals, is_estimate_query);
+      module, aggr_col_count, hoist_literals, is_estimate_query, vectorized);
 }
 llvm::Function* query_group_by_template(llvm::Module* module,
                                         const bool hoist_literals,
@@ -824,9 +944,10 @@ llvm::Function* query_group_by_template(llvm::Module* module,
 llvm::Function* query_template(llvm::Module* module,
                                const size_t aggr_col_count,
                                const bool hoist_literals,
-                               const bool is_estimate_query) {
+                               const bool is_estimate_query,
+                               const bool vectorized) {
   return query_template_impl<llvm::AttributeSet>(
-      module, aggr_col_count, hoist_literals, is_estimate_query);
+      module, aggr_col_count, hoist_literals, is_estimate_query, vectorized);
 }
 llvm::Function* query_group_by_template(llvm::Module* module,
                                         const bool hoist_literals,
@@ -27,7 +27,8 @@
 llvm::Function* query_template(llvm::Module*,
                                const size_t aggr_col_count,
                                const bool hoist_literals,
-                               const bool is_estimate_query);
+                               const bool is_estimate_query,
+                               const bool vectorized);
 llvm::Function* query_group_by_template(llvm::Module*,
                                         const bool hoist_literals,
                                         const QueryMemoryDescriptor& query_mem_desc,
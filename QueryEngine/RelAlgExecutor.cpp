@@ -24,6 +24,7 @@
 #include "EquiJoinCondition.h"
 #include "ErrorHandling.h"
 #include "ExpressionRewrite.h"
+#include "ExternalAggregation.h"
 #include "FromTableReordering.h"
 #include "InputMetadata.h"
 #include "JoinFilterPushDown.h"
@@ -83,7 +84,8 @@ ExecutionResult RelAlgExecutor::executeRelAlgQuery(const CompilationOptions& co,
                             co.opt_level_,
                             co.with_dynamic_watchdog_,
                             co.explain_type_,
-                            co.register_intel_jit_listener_};
+                            co.register_intel_jit_listener_,
+                            co.vectorize_};
   if (render_info) {
     render_info->setForceNonInSituData();
   }
@@ -100,6 +102,7 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
 
   // capture the lock acquistion time
   auto clock_begin = timer_start();
+  mapd_shared_lock<mapd_shared_mutex> gate_lock(Executor::execute_gate_mutex_);
   std::lock_guard<std::mutex> lock(executor_->execute_mutex_);
   int64_t queue_time_ms = timer_stop(clock_begin);
   if (g_enable_dynamic_watchdog) {
@@ -1454,6 +1457,38 @@ std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionConte
     CHECK_EQ(join_col_elem_count, elem_count);
     context->addOrderColumn(column, order_col.get(), chunks_owner);
   }
+  const auto& args = window_func->getArgs();
+  if (window_func->getFrame() && !args.empty()) {
+    // aggregates over a ROWS frame are computed upfront from the argument column
+    const auto arg_col = std::dynamic_pointer_cast<const Analyzer::ColumnVar>(args[0]);
+    if (!arg_col) {
+      throw std::runtime_error(
+          "Only column arguments supported for aggregates with a ROWS frame for now");
+    }
+    const auto& arg_ti = arg_col->get_type_info();
+    const bool is_count_of_string =
+        window_func->getKind() == SqlWindowFunctionKind::COUNT &&
+        arg_ti.is_dict_encoded_string();
+    if (arg_ti.is_date_in_days() ||
+        !(arg_ti.is_integer() || arg_ti.is_decimal() || arg_ti.is_fp() ||
+          arg_ti.is_time() || arg_ti.is_boolean() || is_count_of_string)) {
+      throw std::runtime_error(
+          "Type not supported yet for aggregates with a ROWS frame: " +
+          arg_ti.get_type_name());
+    }
+    const int8_t* column;
+    size_t arg_col_elem_count;
+    std::tie(column, arg_col_elem_count) =
+        ColumnFetcher::getOneColumnFragment(executor_,
+                                            *arg_col,
+                                            query_infos.front().info.fragments.front(),
+                                            memory_level,
+                                            0,
+                                            chunks_owner,
+                                            column_cache_map);
+    CHECK_EQ(arg_col_elem_count, elem_count);
+    context->setAggregateArgColumn(column, chunks_owner);
+  }
   return context;
 }
 
@@ -1799,7 +1834,7 @@ RelAlgExecutionUnit decide_approx_count_distinct_implementation(
         get_count_distinct_sub_bitmap_count(bitmap_sz_bits, ra_exe_unit, device_type);
     int64_t approx_bitmap_sz_bits{0};
     const auto error_rate =
-        static_cast<Analyzer::AggExpr*>(target_expr)->get_error_rate();
+        static_cast<Analyzer::AggExpr*>(target_expr)->get_arg1();
     if (error_rate) {
       CHECK(error_rate->get_type_info().get_type() == kINT);
       CHECK_GE(error_rate->get_constval().intval, 1);
@@ -1941,6 +1976,18 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     // Create a local copy so we can track those changes if we need to attempt a retry due
     // to OOM
     auto local_groups_buffer_entry_guess = max_groups_buffer_entry_guess_in;
+    if (g_enable_external_aggregation && is_agg && has_cardinality_estimation &&
+        !render_info && co.device_type_ == ExecutorDeviceType::CPU &&
+        local_groups_buffer_entry_guess > g_external_aggregation_threshold &&
+        external_aggregation::get_partition_key_idx(ra_exe_unit) >= 0) {
+      return executeWorkUnitPartitioned(ra_exe_unit,
+                                        targets_meta,
+                                        is_agg,
+                                        co,
+                                        eo,
+                                        local_groups_buffer_entry_guess,
+                                        queue_time_ms);
+    }
     try {
       return {executor_->executeWorkUnit(local_groups_buffer_entry_guess,
                                          is_agg,
@@ -2175,8 +2222,23 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
                                            column_cache),
                 targets_meta};
     } catch (const QueryExecutionError& e) {
+      const bool out_of_slots = e.getErrorCode() < 0;
+      if (g_enable_external_aggregation && is_agg && !render_info &&
+          ((out_of_slots && (g_enable_watchdog || iteration_ctr > 1)) ||
+           e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM) &&
+          external_aggregation::get_partition_key_idx(ra_exe_unit) >= 0) {
+        LOG(WARNING) << "Query ran out of memory for its groups, retrying partitioned.";
+        CHECK(max_groups_buffer_entry_guess);
+        return executeWorkUnitPartitioned(ra_exe_unit,
+                                          targets_meta,
+                                          is_agg,
+                                          co_cpu,
+                                          eo_no_multifrag,
+                                          max_groups_buffer_entry_guess,
+                                          queue_time_ms);
+      }
       // Ran out of slots
-      if (e.getErrorCode() < 0) {
+      if (out_of_slots) {
         // Even the conservative guess failed; it should only happen when we group
         // by a huge cardinality array. Maybe we should throw an exception instead?
         // Such a heavy query is entirely capable of exhausting all the host memory.
@@ -2202,6 +2264,85 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   return result;
 }
 
+ExecutionResult RelAlgExecutor::executeWorkUnitPartitioned(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const size_t groups_buffer_entry_guess,
+    const int64_t queue_time_ms) {
+  constexpr size_t max_partitions{4096};
+  const auto key_idx = external_aggregation::get_partition_key_idx(ra_exe_unit);
+  CHECK_GE(key_idx, 0);
+  CompilationOptions co_cpu{ExecutorDeviceType::CPU,
+                            co.hoist_literals_,
+                            co.opt_level_,
+                            co.with_dynamic_watchdog_};
+  const auto table_infos = get_table_infos(ra_exe_unit, executor_);
+  auto num_partitions = std::max(g_external_aggregation_partitions, size_t(2));
+  while (true) {
+    external_aggregation::PassResults pass_results(executor_->row_set_mem_owner_,
+                                                   executor_);
+    // room for twice the expected number of groups of a partition
+    auto pass_entry_guess =
+        std::max(2 * groups_buffer_entry_guess / num_partitions, size_t(1));
+    bool partition_too_big{false};
+    for (size_t partition = 0; partition < num_partitions && !partition_too_big;
+         ++partition) {
+      const auto partition_exe_unit = external_aggregation::partition_execution_unit(
+          ra_exe_unit, key_idx, num_partitions, partition);
+      for (int attempt = 0;; ++attempt) {
+        // The output buffers of a pass belong to its own memory owner, which frees them
+        // once the result has been copied.
+        auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>();
+        auto entry_guess = pass_entry_guess;
+        ColumnCacheMap column_cache;
+        try {
+          const auto rows = executor_->executeWorkUnit(entry_guess,
+                                                       is_agg,
+                                                       table_infos,
+                                                       partition_exe_unit,
+                                                       co_cpu,
+                                                       eo,
+                                                       cat_,
+                                                       row_set_mem_owner,
+                                                       nullptr,
+                                                       true,
+                                                       column_cache);
+          pass_results.add(*rows);
+          break;
+        } catch (const QueryExecutionError& e) {
+          if (e.getErrorCode() >= 0 && e.getErrorCode() != Executor::ERR_OUT_OF_CPU_MEM) {
+            handlePersistentError(e.getErrorCode());
+          }
+          if (e.getErrorCode() < 0 && attempt < 2) {
+            pass_entry_guess *= 2;
+            continue;
+          }
+          partition_too_big = true;
+          break;
+        }
+      }
+    }
+    if (partition_too_big) {
+      if (num_partitions >= max_partitions) {
+        throw std::runtime_error("Query ran out of output slots in the result");
+      }
+      num_partitions *= 2;
+      LOG(WARNING) << "A partition of the group by query didn't fit, retrying with "
+                   << num_partitions << " partitions";
+      continue;
+    }
+    LOG(INFO) << "Partitioned group by query ran " << num_partitions
+              << " passes, their results take " << pass_results.bytes() << " bytes";
+    CHECK(pass_results.getRows());
+    ExecutionResult result{pass_results.getRows(), targets_meta};
+    result.setQueueTime(queue_time_ms);
+    return result;
+  }
+}
+
 void RelAlgExecutor::handlePersistentError(const int32_t error_code) {
   LOG(ERROR) << "Query execution failed with error "
              << getErrorMessageFromCode(error_code);
@@ -295,6 +295,17 @@ class RelAlgExecutor : private StorageIOFacility<RelAlgExecutorTraits> {
                                          const bool was_multifrag_kernel_launch,
                                          const int64_t queue_time_ms);
 
+  // Runs a group by work unit on CPU once per partition of one of its group keys, see
+  // ExternalAggregation.h. The number of partitions doubles until every partition fits.
+  ExecutionResult executeWorkUnitPartitioned(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const size_t groups_buffer_entry_guess,
+      const int64_t queue_time_ms);
+
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   static void handlePersistentError(const int32_t error_code);
@@ -207,6 +207,9 @@ bool is_agg_supported_for_type(const SQLAgg& agg_kind, const SQLTypeInfo& arg_ti
       !(arg_ti.is_number() || arg_ti.is_boolean() || arg_ti.is_time())) {
     return false;
   }
+  if (agg_kind == kAPPROX_PERCENTILE && !arg_ti.is_number()) {
+    return false;
+  }
 
   return true;
 }
@@ -220,22 +223,36 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateAggregateRex(
   const bool is_distinct = rex->isDistinct();
   const bool takes_arg{rex->size() > 0};
   std::shared_ptr<Analyzer::Expr> arg_expr;
-  std::shared_ptr<Analyzer::Constant> err_rate;
+  std::shared_ptr<Analyzer::Constant> arg1;
   if (takes_arg) {
     const auto operand = rex->getOperand(0);
     CHECK_LT(operand, scalar_sources.size());
     CHECK_LE(rex->size(), 2u);
     arg_expr = scalar_sources[operand];
     if (agg_kind == kAPPROX_COUNT_DISTINCT && rex->size() == 2) {
-      err_rate = std::dynamic_pointer_cast<Analyzer::Constant>(
+      arg1 = std::dynamic_pointer_cast<Analyzer::Constant>(
           scalar_sources[rex->getOperand(1)]);
-      if (!err_rate || err_rate->get_type_info().get_type() != kINT ||
-          err_rate->get_constval().intval < 1 || err_rate->get_constval().intval > 100) {
+      if (!arg1 || arg1->get_type_info().get_type() != kINT ||
+          arg1->get_constval().intval < 1 || arg1->get_constval().intval > 100) {
         throw std::runtime_error(
             "APPROX_COUNT_DISTINCT's second parameter should be SMALLINT literal between "
             "1 and 100");
       }
     }
+    if (agg_kind == kAPPROX_PERCENTILE && rex->size() == 2) {
+      const auto percentile = std::dynamic_pointer_cast<Analyzer::Constant>(
+          scalar_sources[rex->getOperand(1)]);
+      if (percentile && percentile->get_type_info().is_number() &&
+          !percentile->get_is_null()) {
+        arg1 = std::dynamic_pointer_cast<Analyzer::Constant>(
+            percentile->deep_copy()->add_cast(SQLTypeInfo(kDOUBLE, false)));
+      }
+      if (!arg1 || arg1->get_constval().doubleval < 0 ||
+          arg1->get_constval().doubleval > 1) {
+        throw std::runtime_error(
+            "APPROX_PERCENTILE's second parameter should be a literal between 0 and 1");
+      }
+    }
     const auto& arg_ti = arg_expr->get_type_info();
     if (!is_agg_supported_for_type(agg_kind, arg_ti)) {
       throw std::runtime_error("Aggregate on " + arg_ti.get_type_name() +
@@ -243,7 +260,7 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateAggregateRex(
     }
   }
   const auto agg_ti = get_agg_type(agg_kind, arg_expr.get());
-  return makeExpr<Analyzer::AggExpr>(agg_ti, agg_kind, arg_expr, is_distinct, err_rate);
+  return makeExpr<Analyzer::AggExpr>(agg_ti, agg_kind, arg_expr, is_distinct, arg1);
 }
 
 std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateLiteral(
@@ -383,6 +400,11 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInput(
   const size_t col_id = rex_input->getIndex();
   CHECK_LT(col_id, in_metainfo.size());
   auto col_ti = in_metainfo[col_id].get_type_info();
+  if (col_ti.get_compression() == kENCODING_RL ||
+      col_ti.get_compression() == kENCODING_DIFF) {
+    // intermediate results hold the decoded values of RL and DIFF columns
+    col_ti = get_logical_type_info(col_ti);
+  }
   CHECK_LE(static_cast<size_t>(rte_idx), join_types_.size());
   if (rte_idx > 0 && join_types_[rte_idx - 1] == JoinType::LEFT) {
     col_ti.set_notnull(false);
@@ -1619,16 +1641,88 @@ bool supported_upper_bound(const RexWindowFunctionOperator* rex_window_function)
   }
 }
 
+// Translates a bound of an explicit ROWS frame to a row offset relative to the current
+// row, see Analyzer::WindowFrame.
+int64_t translate_rows_frame_bound(
+    const RexWindowFunctionOperator::RexWindowBound& window_bound,
+    const std::shared_ptr<Analyzer::Expr>& offset) {
+  if (window_bound.unbounded) {
+    return window_bound.preceding ? std::numeric_limits<int64_t>::min()
+                                  : std::numeric_limits<int64_t>::max();
+  }
+  if (window_bound.is_current_row) {
+    return 0;
+  }
+  const auto offset_constant = dynamic_cast<const Analyzer::Constant*>(offset.get());
+  if (!offset_constant || offset_constant->get_is_null()) {
+    throw std::runtime_error("Frame offset must be an integer literal");
+  }
+  const auto& offset_ti = offset_constant->get_type_info();
+  const auto& offset_datum = offset_constant->get_constval();
+  int64_t offset_val{0};
+  switch (offset_ti.get_type()) {
+    case kTINYINT: {
+      offset_val = offset_datum.tinyintval;
+      break;
+    }
+    case kSMALLINT: {
+      offset_val = offset_datum.smallintval;
+      break;
+    }
+    case kINT: {
+      offset_val = offset_datum.intval;
+      break;
+    }
+    case kBIGINT: {
+      offset_val = offset_datum.bigintval;
+      break;
+    }
+    case kDECIMAL:
+    case kNUMERIC: {
+      const auto scale = exp_to_scale(offset_ti.get_scale());
+      if (offset_datum.bigintval % scale) {
+        throw std::runtime_error("Frame offset must be an integer literal");
+      }
+      offset_val = offset_datum.bigintval / scale;
+      break;
+    }
+    default: {
+      throw std::runtime_error("Frame offset must be an integer literal");
+    }
+  }
+  if (offset_val < 0) {
+    throw std::runtime_error("Frame offset cannot be negative");
+  }
+  return window_bound.preceding ? -offset_val : offset_val;
+}
+
 }  // namespace
 
 std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateWindowFunction(
     const RexWindowFunctionOperator* rex_window_function) const {
-  if (!supported_lower_bound(rex_window_function->getLowerBound()) ||
-      !supported_upper_bound(rex_window_function) ||
-      ((rex_window_function->getKind() == SqlWindowFunctionKind::ROW_NUMBER) !=
-       rex_window_function->isRows())) {
+  // Aggregates with an explicit ROWS frame are computed upfront, over the sorted
+  // partitions, see WindowFunctionContext.
+  const bool is_rows_frame = rex_window_function->isRows() &&
+                             window_function_is_aggregate(rex_window_function->getKind());
+  if (!is_rows_frame &&
+      (!supported_lower_bound(rex_window_function->getLowerBound()) ||
+       !supported_upper_bound(rex_window_function) ||
+       ((rex_window_function->getKind() == SqlWindowFunctionKind::ROW_NUMBER) !=
+        rex_window_function->isRows()))) {
     throw std::runtime_error("Frame specification not supported");
   }
+  std::optional<Analyzer::WindowFrame> frame;
+  if (is_rows_frame) {
+    const auto translate_bound =
+        [this](const RexWindowFunctionOperator::RexWindowBound& window_bound) {
+          return translate_rows_frame_bound(
+              window_bound,
+              window_bound.offset ? translateScalarRex(window_bound.offset.get())
+                                  : nullptr);
+        };
+    frame = Analyzer::WindowFrame{translate_bound(rex_window_function->getLowerBound()),
+                                  translate_bound(rex_window_function->getUpperBound())};
+  }
   std::vector<std::shared_ptr<Analyzer::Expr>> args;
   for (size_t i = 0; i < rex_window_function->size(); ++i) {
     args.push_back(translateScalarRex(rex_window_function->getOperand(i)));
@@ -1652,7 +1746,8 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateWindowFunction(
       args,
       partition_keys,
       order_keys,
-      translate_collation(rex_window_function->getCollation()));
+      translate_collation(rex_window_function->getCollation()),
+      frame);
 }
 
 Analyzer::ExpressionPtrVector RelAlgTranslator::translateFunctionArgs(
@@ -25,6 +25,7 @@
 #include "ResultSet.h"
 
 #include "Allocators/CudaAllocator.h"
+#include "ApproxPercentile.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
 #include "Execute.h"
 #include "GpuMemUtils.h"
@@ -51,7 +52,8 @@ ResultSetStorage::ResultSetStorage(const std::vector<TargetInfo>& targets,
     , buff_is_provided_(buff_is_provided) {
   for (const auto& target_info : targets_) {
     if (target_info.agg_kind == kCOUNT ||
-        target_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
+        target_info.agg_kind == kAPPROX_COUNT_DISTINCT ||
+        is_approx_percentile_target(target_info)) {
       target_init_vals_.push_back(0);
       continue;
     }
@@ -622,6 +624,32 @@ ResultSet::StorageLookupResult ResultSet::findStorage(const size_t entry_idx) co
           stg_idx};
 }
 
+template <typename BUFFER_ITERATOR_TYPE>
+void ResultSet::ResultSetComparator<
+    BUFFER_ITERATOR_TYPE>::materializeApproxPercentileColumns() {
+  for (const auto& order_entry : order_entries_) {
+    const size_t target_idx = order_entry.tle_no - 1;
+    if (!is_approx_percentile_target(result_set_->targets_[target_idx])) {
+      continue;
+    }
+    approx_percentile_values_.resize(result_set_->targets_.size());
+    auto& values = approx_percentile_values_[target_idx];
+    const auto entry_count = result_set_->query_mem_desc_.getEntryCount();
+    values.resize(entry_count, NULL_DOUBLE);
+    for (size_t entry_idx = 0; entry_idx < entry_count; ++entry_idx) {
+      const auto storage_lookup_result = result_set_->findStorage(entry_idx);
+      const auto storage = storage_lookup_result.storage_ptr;
+      const auto fixedup_entry_idx = storage_lookup_result.fixedup_entry_idx;
+      if (storage->isEmptyEntry(fixedup_entry_idx)) {
+        continue;
+      }
+      const auto digest_handle = buffer_itr_.getColumnInternal(
+          storage->buff_, fixedup_entry_idx, target_idx, storage_lookup_result);
+      values[entry_idx] = approx_percentile_value(digest_handle.i1);
+    }
+  }
+}
+
 template <typename BUFFER_ITERATOR_TYPE>
 bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
     const uint32_t lhs,
@@ -703,6 +731,22 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
         }
         return use_desc_cmp ? lhs_sz > rhs_sz : lhs_sz < rhs_sz;
       }
+      if (UNLIKELY(is_approx_percentile_target(
+              result_set_->targets_[order_entry.tle_no - 1]))) {
+        const auto& values = approx_percentile_values_[order_entry.tle_no - 1];
+        const auto lhs_dval = values[lhs];
+        const auto rhs_dval = values[rhs];
+        if (lhs_dval == rhs_dval) {
+          continue;
+        }
+        if (lhs_dval == NULL_DOUBLE) {
+          return use_heap_ ? !order_entry.nulls_first : order_entry.nulls_first;
+        }
+        if (rhs_dval == NULL_DOUBLE) {
+          return use_heap_ ? order_entry.nulls_first : !order_entry.nulls_first;
+        }
+        return use_desc_cmp ? lhs_dval > rhs_dval : lhs_dval < rhs_dval;
+      }
       if (lhs_v.i1 == rhs_v.i1) {
         continue;
       }
@@ -866,6 +910,15 @@ std::shared_ptr<const std::vector<std::string>> ResultSet::getStringDictionaryPa
   return sdp->getDictionary()->copyStrings();
 }
 
+StringDictionaryProxy* ResultSet::getStringDictionaryProxy(const int dict_id) const {
+  if (!dict_id) {
+    return row_set_mem_owner_->getLiteralStringDictProxy();
+  }
+  return executor_
+             ? executor_->getStringDictionaryProxy(dict_id, row_set_mem_owner_, false)
+             : row_set_mem_owner_->getStringDictProxy(dict_id);
+}
+
 bool can_use_parallel_algorithms(const ResultSet& rows) {
   return !rows.isTruncated();
 }
@@ -932,7 +985,7 @@ std::tuple<std::vector<bool>, size_t> ResultSet::getSupportedSingleSlotTargetBit
   for (size_t target_idx = 0; target_idx < single_slot_targets.size(); target_idx++) {
     const auto& target = targets_[target_idx];
     if (single_slot_targets[target_idx] &&
-        (is_distinct_target(target) ||
+        (is_distinct_target(target) || is_approx_percentile_target(target) ||
          (target.is_agg && target.agg_kind == kSAMPLE && target.sql_type == kFLOAT))) {
       single_slot_targets[target_idx] = false;
       num_single_slot_targets--;
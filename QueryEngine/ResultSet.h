@@ -186,6 +186,8 @@ class ResultSetStorage {
                                   const size_t target_logical_idx,
                                   const ResultSetStorage& that) const;
 
+  void reduceOneApproxPercentileSlot(int8_t* this_ptr1, const int8_t* that_ptr1) const;
+
   void fillOneEntryRowWise(const std::vector<int64_t>& entry);
 
   void fillOneEntryColWise(const std::vector<int64_t>& entry);
@@ -225,6 +227,7 @@ struct OrderEntry;
 }  // namespace Analyzer
 
 class Executor;
+class StringDictionaryProxy;
 
 struct ColumnLazyFetchInfo {
   const bool is_lazily_fetched;
@@ -527,6 +530,10 @@ class ResultSet {
   std::shared_ptr<const std::vector<std::string>> getStringDictionaryPayloadCopy(
       const int dict_id) const;
 
+  // Returns the proxy which translates the ids of the given dictionary, or of the literal
+  // dictionary for dict_id 0, to strings.
+  StringDictionaryProxy* getStringDictionaryProxy(const int dict_id) const;
+
   template <typename ENTRY_TYPE, QueryDescriptionType QUERY_TYPE, bool COLUMNAR_FORMAT>
   ENTRY_TYPE getEntryAt(const size_t row_idx,
                         const size_t target_idx,
@@ -732,7 +739,11 @@ class ResultSet {
         : order_entries_(order_entries)
         , use_heap_(use_heap)
         , result_set_(result_set)
-        , buffer_itr_(result_set) {}
+        , buffer_itr_(result_set) {
+      materializeApproxPercentileColumns();
+    }
+
+    void materializeApproxPercentileColumns();
 
     bool operator()(const uint32_t lhs, const uint32_t rhs) const;
 
@@ -741,6 +752,9 @@ class ResultSet {
     const bool use_heap_;
     const ResultSet* result_set_;
     const BufferIteratorType buffer_itr_;
+    // values of the APPROX_PERCENTILE targets sorted on, by target and entry index;
+    // computing one from its digest is too expensive to repeat on every comparison
+    std::vector<std::vector<double>> approx_percentile_values_;
   };
 
   std::function<bool(const uint32_t, const uint32_t)> createComparator(
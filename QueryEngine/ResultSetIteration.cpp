@@ -24,6 +24,7 @@
 
 #include "../Shared/geo_types.h"
 #include "../Shared/likely.h"
+#include "ApproxPercentile.h"
 #include "Execute.h"
 #include "ParserNode.h"
 #include "QueryEngine/TargetValue.h"
@@ -790,6 +791,14 @@ int64_t lazy_decode(const ColumnLazyFetchInfo& col_lazy_fetch,
                     byte_stream, 2, NULL_SMALLINT, NULL_BIGINT, pos)
               : fixed_width_small_date_decode_noinline(
                     byte_stream, 4, NULL_INT, NULL_BIGINT, pos);
+  } else if (type_info.get_compression() == kENCODING_DIFF) {
+    const auto byte_width = type_info.get_comp_param() / 8;
+    const int64_t null_val =
+        byte_width == 1 ? NULL_TINYINT : byte_width == 2 ? NULL_SMALLINT : NULL_INT;
+    return diff_fixed_width_int_decode_noinline(
+        byte_stream, byte_width, null_val, inline_int_null_val(type_info), pos);
+  } else if (type_info.get_compression() == kENCODING_RL) {
+    return run_length_int_decode_noinline(byte_stream, type_info.get_size(), pos);
   } else {
     val = (type_info.get_compression() == kENCODING_DICT &&
            type_info.get_size() < type_info.get_logical_size() &&
@@ -1766,6 +1775,14 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
   }
 
   auto ival = read_int_from_buff(ptr, actual_compact_sz);
+  if (is_approx_percentile_target(target_info)) {
+    auto dval = approx_percentile_value(ival);
+    // the digest holds the unscaled values of a decimal argument
+    if (dval != NULL_DOUBLE && target_info.agg_arg_type.is_decimal()) {
+      dval /= exp_to_scale(target_info.agg_arg_type.get_scale());
+    }
+    return ScalarTargetValue(dval);
+  }
   const auto& chosen_type = get_compact_type(target_info);
   if (!lazy_fetch_info_.empty()) {
     CHECK_LT(target_logical_idx, lazy_fetch_info_.size());
@@ -1823,15 +1840,7 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
           NULL_INT) {  // TODO(alex): this isn't nice, fix it
         return NullableString(nullptr);
       }
-      StringDictionaryProxy* sdp{nullptr};
-      if (!chosen_type.get_comp_param()) {
-        sdp = row_set_mem_owner_->getLiteralStringDictProxy();
-      } else {
-        sdp = executor_
-                  ? executor_->getStringDictionaryProxy(
-                        chosen_type.get_comp_param(), row_set_mem_owner_, false)
-                  : row_set_mem_owner_->getStringDictProxy(chosen_type.get_comp_param());
-      }
+      const auto sdp = getStringDictionaryProxy(chosen_type.get_comp_param());
       return NullableString(sdp->getString(ival));
     } else {
       return static_cast<int64_t>(static_cast<int32_t>(ival));
@@ -22,6 +22,7 @@
  * Copyright (c) 2014 MapD Technologies, Inc.  All rights reserved.
  */
 
+#include "ApproxPercentile.h"
 #include "DynamicWatchdog.h"
 #include "Execute.h"
 #include "ResultSet.h"
@@ -612,26 +613,41 @@ GroupValueInfo get_matching_group_value_columnar_reduction(int64_t* groups_buffe
   return {&groups_buffer[off], false};
 }
 
+// Power of two entry counts, e.g. of the tagged baseline layout, wrap the probes with
+// a mask instead of a division. Returns 0 for the other entry counts.
+uint32_t get_probe_mask(const uint32_t entry_count) {
+  return (entry_count & (entry_count - 1)) == 0 ? entry_count - 1 : 0;
+}
+
+uint32_t wrap_probe(const uint32_t h,
+                    const uint32_t entry_count,
+                    const uint32_t probe_mask) {
+  return probe_mask ? h & probe_mask : h % entry_count;
+}
+
 // TODO(alex): fix synchronization when we enable it
 GroupValueInfo get_group_value_columnar_reduction(
     int64_t* groups_buffer,
     const uint32_t groups_buffer_entry_count,
     const int64_t* key,
     const uint32_t key_qw_count) {
-  uint32_t h = key_hash(key, key_qw_count, sizeof(int64_t)) % groups_buffer_entry_count;
+  const auto probe_mask = get_probe_mask(groups_buffer_entry_count);
+  uint32_t h = wrap_probe(key_hash(key, key_qw_count, sizeof(int64_t)),
+                          groups_buffer_entry_count,
+                          probe_mask);
   auto matching_gvi = get_matching_group_value_columnar_reduction(
       groups_buffer, h, key, key_qw_count, groups_buffer_entry_count);
   if (matching_gvi.first) {
     return matching_gvi;
   }
-  uint32_t h_probe = (h + 1) % groups_buffer_entry_count;
+  uint32_t h_probe = wrap_probe(h + 1, groups_buffer_entry_count, probe_mask);
   while (h_probe != h) {
     matching_gvi = get_matching_group_value_columnar_reduction(
         groups_buffer, h_probe, key, key_qw_count, groups_buffer_entry_count);
     if (matching_gvi.first) {
       return matching_gvi;
     }
-    h_probe = (h_probe + 1) % groups_buffer_entry_count;
+    h_probe = wrap_probe(h_probe + 1, groups_buffer_entry_count, probe_mask);
   }
   return {nullptr, true};
 }
@@ -738,7 +754,9 @@ GroupValueInfo get_group_value_reduction(int64_t* groups_buffer,
                                          const size_t that_entry_idx,
                                          const size_t that_entry_count,
                                          const uint32_t row_size_quad) {
-  uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
+  const auto probe_mask = get_probe_mask(groups_buffer_entry_count);
+  uint32_t h = wrap_probe(
+      key_hash(key, key_count, key_width), groups_buffer_entry_count, probe_mask);
   auto matching_gvi = get_matching_group_value_reduction(groups_buffer,
                                                          h,
                                                          key,
@@ -752,7 +770,7 @@ GroupValueInfo get_group_value_reduction(int64_t* groups_buffer,
   if (matching_gvi.first) {
     return matching_gvi;
   }
-  uint32_t h_probe = (h + 1) % groups_buffer_entry_count;
+  uint32_t h_probe = wrap_probe(h + 1, groups_buffer_entry_count, probe_mask);
   while (h_probe != h) {
     matching_gvi = get_matching_group_value_reduction(groups_buffer,
                                                       h_probe,
@@ -767,7 +785,7 @@ GroupValueInfo get_group_value_reduction(int64_t* groups_buffer,
     if (matching_gvi.first) {
       return matching_gvi;
     }
-    h_probe = (h_probe + 1) % groups_buffer_entry_count;
+    h_probe = wrap_probe(h_probe + 1, groups_buffer_entry_count, probe_mask);
   }
   return {nullptr, true};
 }
@@ -1438,6 +1456,11 @@ void ResultSetStorage::reduceOneSlot(
         AGGREGATE_ONE_COUNT(this_ptr1, that_ptr1, chosen_bytes);
         break;
       }
+      case kAPPROX_PERCENTILE: {
+        CHECK_EQ(static_cast<size_t>(chosen_bytes), sizeof(int64_t));
+        reduceOneApproxPercentileSlot(this_ptr1, that_ptr1);
+        break;
+      }
       case kAVG: {
         // Ignore float argument compaction for count component for fear of its overflow
         AGGREGATE_ONE_COUNT(this_ptr2,
@@ -1557,6 +1580,13 @@ void ResultSetStorage::reduceOneCountDistinctSlot(int8_t* this_ptr1,
       *new_set_ptr, *old_set_ptr, new_count_distinct_desc, old_count_distinct_desc);
 }
 
+void ResultSetStorage::reduceOneApproxPercentileSlot(int8_t* this_ptr1,
+                                                     const int8_t* that_ptr1) const {
+  CHECK(this_ptr1 && that_ptr1);
+  approx_percentile_merge(*reinterpret_cast<const int64_t*>(that_ptr1),
+                          reinterpret_cast<int64_t*>(this_ptr1));
+}
+
 bool ResultSetStorage::reduceSingleRow(const int8_t* row_ptr,
                                        const int8_t warp_count,
                                        const bool is_columnar,
@@ -1636,6 +1666,10 @@ bool ResultSetStorage::reduceSingleRow(const int8_t* row_ptr,
                   chosen_bytes,
                   agg_info);
               break;
+            case kAPPROX_PERCENTILE:
+              approx_percentile_merge(partial_agg_vals[agg_col_idx],
+                                      &agg_vals[agg_col_idx]);
+              break;
             case kAVG:
               // Ignore float argument compaction for count component for fear of its
               // overflow
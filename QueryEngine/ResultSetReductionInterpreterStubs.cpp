@@ -172,6 +172,7 @@ StubGenerator::Stub StubGenerator::generateStub(const std::string& name,
                                                 const bool is_external) {
   const auto stub_name = name + "_stub";
   CodeCacheKey key{stub_name};
+  std::lock_guard<std::recursive_mutex> llvm_lock(getGlobalLLVMContextMutex());
   std::lock_guard<std::mutex> s_stubs_cache_lock(s_stubs_cache_mutex);
   const auto val_ptr = s_stubs_cache.get(key);
   if (val_ptr) {
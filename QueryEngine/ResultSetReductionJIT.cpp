@@ -18,6 +18,7 @@
 #include "ResultSetReductionCodegen.h"
 #include "ResultSetReductionInterpreterStubs.h"
 
+#include "ApproxPercentile.h"
 #include "CodeGenerator.h"
 #include "DynamicWatchdog.h"
 #include "Execute.h"
@@ -457,6 +458,12 @@ extern "C" void count_distinct_set_union_jit_rt(const int64_t new_set_handle,
       new_set_handle, old_set_handle, new_count_distinct_desc, old_count_distinct_desc);
 }
 
+extern "C" void approx_percentile_merge_jit_rt(const int64_t new_digest_handle,
+                                               int8_t* old_digest_handle_ptr) {
+  approx_percentile_merge(new_digest_handle,
+                          reinterpret_cast<int64_t*>(old_digest_handle_ptr));
+}
+
 extern "C" void get_group_value_reduction_rt(int8_t* groups_buffer,
                                              const int8_t* key,
                                              const uint32_t key_count,
@@ -557,6 +564,7 @@ ReductionCode ResultSetReductionJIT::codegen() const {
       (!query_mem_desc_.getExecutor() || query_mem_desc_.blocksShareMemory())) {
     return reduction_code;
   }
+  std::lock_guard<std::recursive_mutex> llvm_lock(getGlobalLLVMContextMutex());
   std::lock_guard<std::mutex> reduction_guard(ReductionCode::s_reduction_mutex);
   CodeCacheKey key{cacheKey()};
   const auto val_ptr = s_code_cache.get(key);
@@ -1118,6 +1126,11 @@ void ResultSetReductionJIT::reduceOneAggregateSlot(Value* this_ptr1,
       emit_aggregate_one_count(this_ptr1, that_ptr1, chosen_bytes, ir_reduce_one_entry);
       break;
     }
+    case kAPPROX_PERCENTILE: {
+      CHECK_EQ(static_cast<size_t>(chosen_bytes), sizeof(int64_t));
+      reduceOneApproxPercentileSlot(this_ptr1, that_ptr1, ir_reduce_one_entry);
+      break;
+    }
     case kAVG: {
       // Ignore float argument compaction for count component for fear of its overflow
       emit_aggregate_one_count(this_ptr2,
@@ -1183,6 +1196,18 @@ void ResultSetReductionJIT::reduceOneCountDistinctSlot(
       "");
 }
 
+void ResultSetReductionJIT::reduceOneApproxPercentileSlot(
+    Value* this_ptr1,
+    Value* that_ptr1,
+    Function* ir_reduce_one_entry) const {
+  const auto new_digest_handle = emit_load_i64(that_ptr1, ir_reduce_one_entry);
+  ir_reduce_one_entry->add<ExternalCall>(
+      "approx_percentile_merge_jit_rt",
+      Type::Void,
+      std::vector<const Value*>{new_digest_handle, this_ptr1},
+      "");
+}
+
 ReductionCode ResultSetReductionJIT::finalizeReductionCode(
     ReductionCode reduction_code,
     const llvm::Function* ir_is_empty,
@@ -137,6 +137,15 @@ extern "C" int64_t* get_group_value_with_watchdog(
     const uint32_t row_size_quad,
     const int64_t* init_val = nullptr);
 
+extern "C" int64_t* get_group_value_tagged(int64_t* groups_buffer,
+                                           const uint32_t groups_buffer_entry_count,
+                                           const int64_t* key,
+                                           const uint32_t key_count,
+                                           const uint32_t key_width,
+                                           const uint32_t row_size_quad,
+                                           const int64_t* init_vals,
+                                           int8_t* tags);
+
 extern "C" int64_t* get_group_value_columnar(int64_t* groups_buffer,
                                              const uint32_t groups_buffer_entry_count,
                                              const int64_t* key,
@@ -224,6 +233,16 @@ extern "C" int64_t fixed_width_small_date_decode_noinline(const int8_t* byte_str
                                                           const int64_t ret_null_val,
                                                           const int64_t pos);
 
+extern "C" int64_t diff_fixed_width_int_decode_noinline(const int8_t* byte_stream,
+                                                        const int32_t byte_width,
+                                                        const int64_t null_val,
+                                                        const int64_t ret_null_val,
+                                                        const int64_t pos);
+
+extern "C" int64_t run_length_int_decode_noinline(const int8_t* byte_stream,
+                                                  const int32_t byte_width,
+                                                  const int64_t pos);
+
 extern "C" int8_t* extract_str_ptr_noinline(const uint64_t str_and_len);
 
 extern "C" int32_t extract_str_len_noinline(const uint64_t str_and_len);
@@ -115,7 +115,7 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LowerExpr* expr,
 
   std::vector<llvm::Value*> args{
       str_id_lv[0],
-      cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
+      cgen_state_->llHostAddress(string_dictionary_proxy)};
 
   return cgen_state_->emitExternalCall(
       "lower_encoded", get_int_type(32, cgen_state_->context_), args);
@@ -114,6 +114,8 @@ inline ExecutionOptions get_execution_options() {
 
 void TableOptimizer::recomputeMetadata() const {
   INJECT_TIMER(optimizeMetadata);
+  // no query may read the metadata while it is recomputed
+  mapd_unique_lock<mapd_shared_mutex> gate_lock(Executor::execute_gate_mutex_);
   std::lock_guard<std::mutex> lock(executor_->execute_mutex_);
 
   LOG(INFO) << "Recomputing metadata for " << td_->tableName;
@@ -63,6 +63,8 @@ std::vector<std::string> agg_fn_base_names(const TargetInfo& target_info) {
       return {"agg_sum"};
     case kAPPROX_COUNT_DISTINCT:
       return {"agg_approximate_count_distinct"};
+    case kAPPROX_PERCENTILE:
+      return {"agg_approx_percentile"};
     case kSINGLE_VALUE:
       return {"checked_single_agg_id"};
     case kSAMPLE:
@@ -111,7 +113,8 @@ void TargetExprCodegen::codegen(
   if (window_row_ptr) {
     agg_out_ptr_w_idx =
         std::make_tuple(window_row_ptr, std::get<1>(agg_out_ptr_w_idx_in));
-    if (window_function_is_aggregate(window_func->getKind())) {
+    if (window_function_is_aggregate(window_func->getKind()) &&
+        !window_func->getFrame()) {
       out_row_idx = window_row_ptr;
     }
   }
@@ -253,8 +256,13 @@ void TargetExprCodegen::codegen(
         CHECK_EQ(size_t(0), col_off % sizeof(int64_t));
         col_off /= sizeof(int64_t);
       }
+      const auto& count_distinct_desc =
+          query_mem_desc.getCountDistinctDescriptor(target_idx);
       executor->cgen_state_->emitExternalCall(
-          "agg_count_distinct_array_" + numeric_type_name(elem_ti),
+          "agg_count_distinct_array_" + numeric_type_name(elem_ti) +
+              (count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet
+                   ? "_hash_set"
+                   : ""),
           llvm::Type::getVoidTy(LL_CONTEXT),
           {is_group_by
                ? LL_BUILDER.CreateGEP(std::get<0>(agg_out_ptr_w_idx), LL_INT(col_off))
@@ -356,6 +364,9 @@ void TargetExprCodegen::codegen(
       CHECK(!chosen_type.is_fp());
       group_by_and_agg->codegenCountDistinct(
           target_idx, target_expr, agg_args, query_mem_desc, co.device_type_);
+    } else if (is_approx_percentile_target(target_info)) {
+      CHECK_EQ(agg_chosen_bytes, sizeof(int64_t));
+      group_by_and_agg->codegenApproxPercentile(target_info, agg_args, co.device_type_);
     } else {
       const auto& arg_ti = target_info.agg_arg_type;
       if (need_skip_null && !arg_ti.is_geometry()) {
@@ -428,7 +439,7 @@ void TargetExprCodegen::codegen(
         }
       }
       const auto partition_end =
-          LL_INT(reinterpret_cast<int64_t>(window_func_context->partitionEnd()));
+          executor->cgen_state_->llHostAddress(window_func_context->partitionEnd());
       executor->cgen_state_->emitExternalCall(apply_window_pending_outputs_name,
                                               llvm::Type::getVoidTy(LL_CONTEXT),
                                               {pending_outputs,
@@ -185,6 +185,7 @@ inline TCountDistinctImplType::type count_distinct_impl_type_to_thrift(
     THRIFT_COUNTDESCRIPTORIMPL_CASE(Invalid)
     THRIFT_COUNTDESCRIPTORIMPL_CASE(Bitmap)
     THRIFT_COUNTDESCRIPTORIMPL_CASE(StdSet)
+    THRIFT_COUNTDESCRIPTORIMPL_CASE(HashSet)
     default:
       CHECK(false);
   }
@@ -220,6 +221,7 @@ inline CountDistinctImplType count_distinct_impl_type_from_thrift(
     UNTHRIFT_COUNTDESCRIPTORIMPL_CASE(Invalid)
     UNTHRIFT_COUNTDESCRIPTORIMPL_CASE(Bitmap)
     UNTHRIFT_COUNTDESCRIPTORIMPL_CASE(StdSet)
+    UNTHRIFT_COUNTDESCRIPTORIMPL_CASE(HashSet)
     default:
       CHECK(false);
   }
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VectorizedCodegen.h"
+#include "Shared/Logger.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/Local.h>
+
+namespace vectorized_codegen {
+
+namespace {
+
+// Fixed width values whose comparisons compile to plain integer or floating point
+// compares, without calls to the runtime or error codes.
+bool is_batchable_type(const SQLTypeInfo& ti) {
+  return ti.is_integer() || ti.is_decimal() || ti.is_fp() || ti.is_boolean() ||
+         ti.is_time();
+}
+
+bool is_batchable_operand(const Analyzer::Expr* expr) {
+  if (!is_batchable_type(expr->get_type_info())) {
+    return false;
+  }
+  if (dynamic_cast<const Analyzer::Var*>(expr)) {
+    return false;
+  }
+  if (dynamic_cast<const Analyzer::ColumnVar*>(expr) ||
+      dynamic_cast<const Analyzer::Constant*>(expr)) {
+    return true;
+  }
+  const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr);
+  if (uoper && uoper->get_optype() == kCAST) {
+    // integer widening only, anything else can overflow or needs a runtime function
+    const auto& ti = uoper->get_type_info();
+    const auto& operand_ti = uoper->get_operand()->get_type_info();
+    return ti.is_integer() && operand_ti.is_integer() &&
+           ti.get_size() >= operand_ti.get_size() &&
+           is_batchable_operand(uoper->get_operand());
+  }
+  return false;
+}
+
+}  // namespace
+
+bool is_batchable_qual(const Analyzer::Expr* qual) {
+  if (!qual->get_type_info().is_boolean()) {
+    return false;
+  }
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual);
+  if (bin_oper) {
+    const auto optype = bin_oper->get_optype();
+    if (optype == kAND || optype == kOR) {
+      return is_batchable_qual(bin_oper->get_left_operand()) &&
+             is_batchable_qual(bin_oper->get_right_operand());
+    }
+    return IS_COMPARISON(optype) && bin_oper->get_qualifier() == kONE &&
+           is_batchable_operand(bin_oper->get_left_operand()) &&
+           is_batchable_operand(bin_oper->get_right_operand());
+  }
+  const auto uoper = dynamic_cast<const Analyzer::UOper*>(qual);
+  if (uoper) {
+    switch (uoper->get_optype()) {
+      case kNOT:
+        return is_batchable_qual(uoper->get_operand());
+      case kISNULL:
+        return is_batchable_operand(uoper->get_operand());
+      default:
+        return false;
+    }
+  }
+  return is_batchable_operand(qual);
+}
+
+bool can_vectorize(const RelAlgExecutionUnit& ra_exe_unit, const ExecutionOptions& eo) {
+  if (eo.with_dynamic_watchdog || ra_exe_unit.estimator ||
+      ra_exe_unit.input_descs.size() != 1 || !ra_exe_unit.join_quals.empty()) {
+    return false;
+  }
+  if (ra_exe_unit.groupby_exprs.size() != 1 || ra_exe_unit.groupby_exprs.front()) {
+    return false;
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    if (!dynamic_cast<const Analyzer::AggExpr*>(target_expr)) {
+      return false;
+    }
+  }
+  for (const auto quals : {&ra_exe_unit.simple_quals, &ra_exe_unit.quals}) {
+    for (const auto& qual : *quals) {
+      if (is_batchable_qual(qual.get())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+llvm::Function* create_batch_filter_function(llvm::Function* row_func,
+                                             llvm::BranchInst* batch_filter_br) {
+  CHECK(batch_filter_br);
+  CHECK(batch_filter_br->isConditional());
+  CHECK_EQ(batch_filter_br->getParent()->getParent(), row_func);
+  auto& context = row_func->getContext();
+  llvm::ValueToValueMapTy vmap;
+  auto batch_filter_func = llvm::CloneFunction(row_func, vmap);
+  batch_filter_func->setName("batch_filter_func");
+  llvm::Value* cloned_br_lv = vmap[batch_filter_br];
+  auto cloned_br = llvm::cast<llvm::BranchInst>(cloned_br_lv);
+  auto selected_bb = llvm::BasicBlock::Create(context, "selected", batch_filter_func);
+  llvm::ReturnInst::Create(
+      context, llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 1), selected_bb);
+  cloned_br->setSuccessor(0, selected_bb);
+  llvm::removeUnreachableBlocks(*batch_filter_func);
+
+  batch_filter_br->setCondition(llvm::ConstantInt::getTrue(context));
+  return batch_filter_func;
+}
+
+}  // namespace vectorized_codegen
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    VectorizedCodegen.h
+ * @brief   Batch-at-a-time evaluation of the simple filters of CPU aggregate queries.
+ *
+ * The query template of a vectorized work unit walks the fragment in batches of
+ * kBatchSize rows. For each batch it first evaluates the batch filter, i.e. the quals
+ * which only compare fixed width columns and constants, into a selection mask, in a
+ * loop without calls or early exits which the loop vectorizer turns into SIMD code for
+ * the host CPU. Then it runs the row function, which evaluates the remaining quals and
+ * the aggregates, for the selected rows only.
+ *
+ * The batch filter function is a clone of the row function cut right after the branch on
+ * the batchable quals, so that both share the column fetch code.
+ */
+
+#pragma once
+
+#include "CompilationOptions.h"
+#include "RelAlgExecutionUnit.h"
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+
+namespace vectorized_codegen {
+
+constexpr size_t kBatchSize{1024};
+
+/// Whether the qual can be evaluated by the batch filter.
+bool is_batchable_qual(const Analyzer::Expr* qual);
+
+/**
+ * Whether the work unit can run with the vectorized query template: a non-grouped
+ * aggregate over a single table, without dynamic watchdog, with at least one batchable
+ * qual.
+ */
+bool can_vectorize(const RelAlgExecutionUnit& ra_exe_unit, const ExecutionOptions& eo);
+
+/**
+ * Clones the batch filter out of the complete row function. The clone returns 1 where
+ * batch_filter_br goes to its true successor. The branch is made unconditional in the
+ * row function, the rows which reach it passed the batch filter already.
+ */
+llvm::Function* create_batch_filter_function(llvm::Function* row_func,
+                                             llvm::BranchInst* batch_filter_br);
+
+}  // namespace vectorized_codegen
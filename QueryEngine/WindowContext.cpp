@@ -15,21 +15,28 @@
  */
 
 #include "WindowContext.h"
+#include <atomic>
+#include <deque>
+#include <future>
 #include <numeric>
 #include "../Shared/checked_alloc.h"
 #include "../Shared/sql_window_function_to_string.h"
+#include "../Shared/WorkStealingPool.h"
 #include "Descriptors/CountDistinctDescriptor.h"
 #include "OutputBufferInitialization.h"
 #include "ResultSetBufferAccessors.h"
 #include "RuntimeFunctions.h"
 #include "TypePunning.h"
 
+extern size_t g_max_cpu_kernels_per_query;
+
 WindowFunctionContext::WindowFunctionContext(
     const Analyzer::WindowFunction* window_func,
     const std::shared_ptr<JoinHashTableInterface>& partitions,
     const size_t elem_count,
     const ExecutorDeviceType device_type)
     : window_func_(window_func)
+    , aggregate_arg_column_(nullptr)
     , partitions_(partitions)
     , elem_count_(elem_count)
     , output_(nullptr)
@@ -51,6 +58,14 @@ void WindowFunctionContext::addOrderColumn(
   order_columns_.push_back(column);
 }
 
+void WindowFunctionContext::setAggregateArgColumn(
+    const int8_t* column,
+    const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner) {
+  CHECK(window_func_->getFrame());
+  aggregate_arg_column_owner_ = chunks_owner;
+  aggregate_arg_column_ = column;
+}
+
 namespace {
 
 // Converts the sorted indices to a mapping from row position to row number.
@@ -262,20 +277,26 @@ void apply_last_value_to_partition(const int32_t* original_indices,
       original_indices, original_indices + partition_size, output_for_partition_buff);
 }
 
+// Sets a bit of a bitmap shared by partitions computed concurrently: the partitions are
+// disjoint ranges of bits, but the bytes at their boundaries are not.
+void set_bit_atomic(int8_t* bitmap, const size_t pos) {
+  __atomic_fetch_or(
+      &bitmap[pos >> 3], static_cast<int8_t>(1 << (pos & 7)), __ATOMIC_RELAXED);
+}
+
 void index_to_partition_end(
-    const int8_t* partition_end,
+    int8_t* partition_end,
     const size_t off,
     const int64_t* index,
     const size_t index_size,
     const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
-  int64_t partition_end_handle = reinterpret_cast<int64_t>(partition_end);
   for (size_t i = 0; i < index_size; ++i) {
     if (advance_current_rank(comparator, index, i)) {
-      agg_count_distinct_bitmap(&partition_end_handle, off + i - 1, 0);
+      set_bit_atomic(partition_end, off + i - 1);
     }
   }
   CHECK(index_size);
-  agg_count_distinct_bitmap(&partition_end_handle, off + index_size - 1, 0);
+  set_bit_atomic(partition_end, off + index_size - 1);
 }
 
 bool pos_is_set(const int64_t bitset, const int64_t pos) {
@@ -299,6 +320,317 @@ void apply_window_pending_outputs_int(const int64_t handle,
   pending_output_slots.clear();
 }
 
+template <class T>
+struct IntegerComparator {
+  const T* values;
+  const int32_t* partition_indices;
+  T null_val;
+  bool nulls_first;
+
+  bool operator()(const int64_t lhs, const int64_t rhs) const {
+    const auto lhs_val = values[partition_indices[lhs]];
+    const auto rhs_val = values[partition_indices[rhs]];
+    if (lhs_val == null_val && rhs_val == null_val) {
+      return false;
+    }
+    if (lhs_val == null_val && rhs_val != null_val) {
+      return nulls_first;
+    }
+    if (rhs_val == null_val && lhs_val != null_val) {
+      return !nulls_first;
+    }
+    return lhs_val < rhs_val;
+  }
+};
+
+template <class T, class NullPatternType>
+struct FpComparator {
+  const T* values;
+  const int32_t* partition_indices;
+  NullPatternType null_bit_pattern;
+  bool nulls_first;
+
+  bool operator()(const int64_t lhs, const int64_t rhs) const {
+    const auto lhs_val = values[partition_indices[lhs]];
+    const auto rhs_val = values[partition_indices[rhs]];
+    const auto lhs_bit_pattern =
+        *reinterpret_cast<const NullPatternType*>(may_alias_ptr(&lhs_val));
+    const auto rhs_bit_pattern =
+        *reinterpret_cast<const NullPatternType*>(may_alias_ptr(&rhs_val));
+    if (lhs_bit_pattern == null_bit_pattern && rhs_bit_pattern == null_bit_pattern) {
+      return false;
+    }
+    if (lhs_bit_pattern == null_bit_pattern && rhs_bit_pattern != null_bit_pattern) {
+      return nulls_first;
+    }
+    if (rhs_bit_pattern == null_bit_pattern && lhs_bit_pattern != null_bit_pattern) {
+      return !nulls_first;
+    }
+    return lhs_val < rhs_val;
+  }
+};
+
+template <class T>
+IntegerComparator<T> make_integer_comparator(const int8_t* order_column_buffer,
+                                             const int32_t* partition_indices,
+                                             const int64_t null_val,
+                                             const bool nulls_first) {
+  return {reinterpret_cast<const T*>(order_column_buffer),
+          partition_indices,
+          static_cast<T>(null_val),
+          nulls_first};
+}
+
+// Calls the visitor with the ascending comparator for the type of the order column.
+template <class Visitor>
+void visit_typed_comparator(const SQLTypeInfo& ti,
+                            const int8_t* order_column_buffer,
+                            const int32_t* partition_indices,
+                            const bool nulls_first,
+                            Visitor&& visitor) {
+  if (ti.is_integer() || ti.is_decimal() || ti.is_time() || ti.is_boolean()) {
+    const auto null_val = inline_fixed_encoding_null_val(ti);
+    switch (ti.get_size()) {
+      case 8: {
+        visitor(make_integer_comparator<int64_t>(
+            order_column_buffer, partition_indices, null_val, nulls_first));
+        return;
+      }
+      case 4: {
+        visitor(make_integer_comparator<int32_t>(
+            order_column_buffer, partition_indices, null_val, nulls_first));
+        return;
+      }
+      case 2: {
+        visitor(make_integer_comparator<int16_t>(
+            order_column_buffer, partition_indices, null_val, nulls_first));
+        return;
+      }
+      case 1: {
+        visitor(make_integer_comparator<int8_t>(
+            order_column_buffer, partition_indices, null_val, nulls_first));
+        return;
+      }
+      default: {
+        LOG(FATAL) << "Invalid type size: " << ti.get_size();
+      }
+    }
+  }
+  if (ti.is_fp()) {
+    const auto null_bit_pattern = null_val_bit_pattern(ti, ti.get_type() == kFLOAT);
+    switch (ti.get_type()) {
+      case kFLOAT: {
+        visitor(FpComparator<float, int32_t>{
+            reinterpret_cast<const float*>(order_column_buffer),
+            partition_indices,
+            static_cast<int32_t>(null_bit_pattern),
+            nulls_first});
+        return;
+      }
+      case kDOUBLE: {
+        visitor(FpComparator<double, int64_t>{
+            reinterpret_cast<const double*>(order_column_buffer),
+            partition_indices,
+            null_bit_pattern,
+            nulls_first});
+        return;
+      }
+      default: {
+        LOG(FATAL) << "Invalid float type";
+      }
+    }
+  }
+  throw std::runtime_error("Type not supported yet");
+}
+
+// Sums over ranges of a fixed sequence of values, in logarithmic time.
+template <class T>
+class SumSegmentTree {
+ public:
+  SumSegmentTree(const std::vector<T>& vals, const std::vector<int8_t>& is_null)
+      : leaf_count_(vals.size()), tree_(2 * vals.size(), 0) {
+    for (size_t i = 0; i < leaf_count_; ++i) {
+      tree_[leaf_count_ + i] = is_null[i] ? 0 : vals[i];
+    }
+    for (size_t i = leaf_count_ - 1; i > 0; --i) {
+      tree_[i] = tree_[2 * i] + tree_[2 * i + 1];
+    }
+  }
+
+  // Returns the sum of the values in [lo, hi].
+  T sum(size_t lo, size_t hi) const {
+    T result{0};
+    for (lo += leaf_count_, hi += leaf_count_ + 1; lo < hi; lo >>= 1, hi >>= 1) {
+      if (lo & 1) {
+        result += tree_[lo++];
+      }
+      if (hi & 1) {
+        result += tree_[--hi];
+      }
+    }
+    return result;
+  }
+
+ private:
+  const size_t leaf_count_;
+  std::vector<T> tree_;
+};
+
+// Computes an aggregate over a ROWS frame for every row of a sorted partition:
+// agg_vals[k] is the aggregate of the frame of the k-th row and agg_counts[k] the number
+// of non-null values in it. Sums come from a segment tree and counts from prefix sums.
+// Both ends of the frame only move forward, therefore MIN and MAX keep the candidates for
+// the extremum in a monotonic queue, which makes them linear.
+template <class T>
+void aggregate_rows_frame(const SqlWindowFunctionKind kind,
+                          const Analyzer::WindowFrame& frame,
+                          const std::vector<T>& vals,
+                          const std::vector<int8_t>& is_null,
+                          std::vector<T>& agg_vals,
+                          std::vector<int64_t>& agg_counts) {
+  const int64_t partition_size = vals.size();
+  CHECK_GT(partition_size, 0);
+  // clamping the offsets to the partition keeps the bounds below from overflowing
+  const auto lower = std::max(frame.lower, -partition_size);
+  const auto upper = std::min(frame.upper, partition_size);
+  std::vector<int64_t> prefix_counts(partition_size + 1, 0);
+  for (int64_t k = 0; k < partition_size; ++k) {
+    prefix_counts[k + 1] = prefix_counts[k] + (is_null[k] ? 0 : 1);
+  }
+  agg_vals.assign(partition_size, 0);
+  agg_counts.assign(partition_size, 0);
+  const bool is_min_max =
+      kind == SqlWindowFunctionKind::MIN || kind == SqlWindowFunctionKind::MAX;
+  std::unique_ptr<SumSegmentTree<T>> sums;
+  if (kind == SqlWindowFunctionKind::SUM || kind == SqlWindowFunctionKind::AVG) {
+    sums = std::make_unique<SumSegmentTree<T>>(vals, is_null);
+  }
+  std::deque<int64_t> candidates;
+  int64_t next_candidate = 0;
+  for (int64_t k = 0; k < partition_size; ++k) {
+    const auto lo = std::max(k + lower, int64_t(0));
+    const auto hi = std::min(k + upper, partition_size - 1);
+    if (lo > hi) {
+      continue;
+    }
+    agg_counts[k] = prefix_counts[hi + 1] - prefix_counts[lo];
+    if (sums) {
+      agg_vals[k] = sums->sum(lo, hi);
+    }
+    if (!is_min_max) {
+      continue;
+    }
+    for (; next_candidate <= hi; ++next_candidate) {
+      if (is_null[next_candidate]) {
+        continue;
+      }
+      const auto val = vals[next_candidate];
+      while (!candidates.empty() &&
+             (kind == SqlWindowFunctionKind::MIN ? vals[candidates.back()] >= val
+                                                 : vals[candidates.back()] <= val)) {
+        candidates.pop_back();
+      }
+      candidates.push_back(next_candidate);
+    }
+    while (!candidates.empty() && candidates.front() < lo) {
+      candidates.pop_front();
+    }
+    if (!candidates.empty()) {
+      agg_vals[k] = vals[candidates.front()];
+    }
+  }
+}
+
+// Reads the argument of a framed aggregate, widened to 64 bits. Returns false for nulls.
+bool read_frame_arg(const int8_t* column,
+                    const SQLTypeInfo& ti,
+                    const int64_t row,
+                    int64_t& val) {
+  switch (ti.get_size()) {
+    case 8: {
+      val = reinterpret_cast<const int64_t*>(column)[row];
+      break;
+    }
+    case 4: {
+      val = reinterpret_cast<const int32_t*>(column)[row];
+      break;
+    }
+    case 2: {
+      val = reinterpret_cast<const int16_t*>(column)[row];
+      break;
+    }
+    case 1: {
+      val = column[row];
+      break;
+    }
+    default: {
+      LOG(FATAL) << "Invalid type size: " << ti.get_size();
+    }
+  }
+  return val != inline_fixed_encoding_null_val(ti);
+}
+
+bool read_frame_arg(const int8_t* column,
+                    const SQLTypeInfo& ti,
+                    const int64_t row,
+                    double& val) {
+  if (ti.get_type() == kFLOAT) {
+    const auto float_val = reinterpret_cast<const float*>(column)[row];
+    val = float_val;
+    return float_val != NULL_FLOAT;
+  }
+  CHECK_EQ(kDOUBLE, ti.get_type());
+  val = reinterpret_cast<const double*>(column)[row];
+  return val != NULL_DOUBLE;
+}
+
+// Computes a framed aggregate for the rows of a partition, sorted by index, and writes
+// the results to the positions of the rows in the partition: 64-bit integers, with the
+// inline null of the window function type, or doubles for floating point and AVG.
+template <class T>
+void compute_rows_frame_aggregate(const Analyzer::WindowFunction* window_func,
+                                  const int8_t* arg_column,
+                                  const int32_t* partition_row_offsets,
+                                  const std::vector<int64_t>& index,
+                                  int64_t* output_for_partition_buff) {
+  const auto kind = window_func->getKind();
+  const auto& args = window_func->getArgs();
+  const auto& window_ti = window_func->get_type_info();
+  std::vector<T> vals(index.size(), 0);
+  std::vector<int8_t> is_null(index.size(), 0);
+  SQLTypeInfo arg_ti;
+  if (!args.empty()) {
+    arg_ti = args.front()->get_type_info();
+    CHECK(arg_column);
+    for (size_t k = 0; k < index.size(); ++k) {
+      const auto row = partition_row_offsets[index[k]];
+      is_null[k] = !read_frame_arg(arg_column, arg_ti, row, vals[k]);
+    }
+  }
+  std::vector<T> agg_vals;
+  std::vector<int64_t> agg_counts;
+  aggregate_rows_frame(
+      kind, *window_func->getFrame(), vals, is_null, agg_vals, agg_counts);
+  auto output_fp = reinterpret_cast<double*>(may_alias_ptr(output_for_partition_buff));
+  const double fp_null_val = window_ti.get_type() == kFLOAT ? NULL_FLOAT : NULL_DOUBLE;
+  for (size_t k = 0; k < index.size(); ++k) {
+    const auto pos = index[k];
+    if (kind == SqlWindowFunctionKind::COUNT) {
+      output_for_partition_buff[pos] = agg_counts[k];
+    } else if (kind == SqlWindowFunctionKind::AVG) {
+      const double scale = arg_ti.is_decimal() ? exp_to_scale(arg_ti.get_scale()) : 1;
+      output_fp[pos] = agg_counts[k]
+                           ? static_cast<double>(agg_vals[k]) / agg_counts[k] / scale
+                           : NULL_DOUBLE;
+    } else if (window_ti.is_fp()) {
+      output_fp[pos] = agg_counts[k] ? static_cast<double>(agg_vals[k]) : fp_null_val;
+    } else {
+      output_for_partition_buff[pos] = agg_counts[k] ? static_cast<int64_t>(agg_vals[k])
+                                                     : inline_int_null_val(window_ti);
+    }
+  }
+}
+
 }  // namespace
 
 extern "C" void apply_window_pending_outputs_int64(const int64_t handle,
@@ -379,7 +711,7 @@ extern "C" void add_window_pending_output(void* pending_output, const int64_t ha
 // Returns true iff the aggregate window function requires special multiplicity handling
 // to ensure that peer rows have the same value for the window function.
 bool window_function_requires_peer_handling(const Analyzer::WindowFunction* window_func) {
-  if (!window_function_is_aggregate(window_func->getKind())) {
+  if (!window_function_is_aggregate(window_func->getKind()) || window_func->getFrame()) {
     return false;
   }
   if (window_func->getOrderKeys().empty()) {
@@ -400,27 +732,105 @@ void WindowFunctionContext::compute() {
   CHECK(!output_);
   output_ = static_cast<int8_t*>(checked_malloc(
       elem_count_ * window_function_buffer_element_size(window_func_->getKind())));
-  if (window_function_is_aggregate(window_func_->getKind())) {
+  // Aggregates over an explicit frame are computed here, the other ones are accumulated
+  // by the generated code, in the iteration order written to the output buffer.
+  const bool is_cumulative_aggregate =
+      window_function_is_aggregate(window_func_->getKind()) && !window_func_->getFrame();
+  if (is_cumulative_aggregate) {
     fillPartitionStart();
     if (window_function_requires_peer_handling(window_func_)) {
       fillPartitionEnd();
     }
   }
   std::unique_ptr<int64_t[]> scratchpad(new int64_t[elem_count_]);
-  int64_t off = 0;
-  for (size_t i = 0; i < partitionCount(); ++i) {
-    auto partition_size = counts()[i];
-    if (partition_size == 0) {
-      continue;
+  const size_t partition_count = partitionCount();
+  if (window_function_is_value(window_func_->getKind()) || is_cumulative_aggregate) {
+    CHECK_EQ(std::accumulate(counts(), counts() + partition_count, size_t(0)),
+             elem_count_);
+  }
+  // The partitions are independent, the workers pick the next one to sort and compute
+  // until there are none left. They run in the CPU kernel pool, under the same per query
+  // limit as the fragment kernels, along with this thread. Small inputs aren't worth it.
+  auto& cpu_kernel_pool = WorkStealingPool::getCpuKernelPool();
+  const size_t max_worker_count =
+      g_max_cpu_kernels_per_query
+          ? std::min(g_max_cpu_kernels_per_query, cpu_kernel_pool.numWorkers())
+          : cpu_kernel_pool.numWorkers();
+  const size_t worker_count =
+      elem_count_ < 100000
+          ? 1
+          : std::max(std::min(max_worker_count, partition_count), size_t(1));
+  std::atomic<size_t> next_partition_idx{0};
+  const auto compute_partitions = [&]() {
+    for (size_t i = next_partition_idx++; i < partition_count; i = next_partition_idx++) {
+      sortAndComputePartition(i, scratchpad.get());
+    }
+  };
+  std::vector<std::future<void>> workers;
+  {
+    // waits for the workers which didn't get to run before this thread was done
+    WorkStealingPool::TaskGroup worker_group(cpu_kernel_pool, worker_count - 1);
+    for (size_t i = 1; i < worker_count; ++i) {
+      workers.push_back(worker_group.submit(compute_partitions));
+    }
+    compute_partitions();
+  }
+  for (auto& worker : workers) {
+    worker.get();
+  }
+  auto output_i64 = reinterpret_cast<int64_t*>(output_);
+  if (is_cumulative_aggregate) {
+    std::copy(scratchpad.get(), scratchpad.get() + elem_count_, output_i64);
+  } else {
+    for (size_t i = 0; i < elem_count_; ++i) {
+      output_i64[payload()[i]] = scratchpad[i];
     }
-    auto output_for_partition_buff = scratchpad.get() + offsets()[i];
-    std::iota(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              int64_t(0));
+  }
+}
+
+void WindowFunctionContext::sortAndComputePartition(const size_t partition_idx,
+                                                    int64_t* scratchpad) {
+  const size_t partition_size = counts()[partition_idx];
+  if (partition_size == 0) {
+    return;
+  }
+  const size_t off = offsets()[partition_idx];
+  auto output_for_partition_buff = scratchpad + off;
+  std::iota(
+      output_for_partition_buff, output_for_partition_buff + partition_size, int64_t(0));
+  const auto& order_keys = window_func_->getOrderKeys();
+  const auto& collation = window_func_->getCollation();
+  CHECK_EQ(order_keys.size(), collation.size());
+  Comparator col_tuple_comparator;
+  if (order_columns_.size() == 1) {
+    // Sort with the typed comparator, which the compiler can inline, instead of going
+    // through the type erased one for every comparison.
+    const auto order_col = dynamic_cast<const Analyzer::ColumnVar*>(order_keys[0].get());
+    CHECK(order_col);
+    visit_typed_comparator(
+        order_col->get_type_info(),
+        order_columns_[0],
+        payload() + off,
+        collation[0].nulls_first,
+        [&](const auto& asc_comparator) {
+          if (collation[0].is_desc) {
+            const auto desc_comparator = [asc_comparator](const int64_t lhs,
+                                                          const int64_t rhs) {
+              return asc_comparator(rhs, lhs);
+            };
+            std::sort(output_for_partition_buff,
+                      output_for_partition_buff + partition_size,
+                      desc_comparator);
+            col_tuple_comparator = desc_comparator;
+          } else {
+            std::sort(output_for_partition_buff,
+                      output_for_partition_buff + partition_size,
+                      asc_comparator);
+            col_tuple_comparator = asc_comparator;
+          }
+        });
+  } else {
     std::vector<Comparator> comparators;
-    const auto& order_keys = window_func_->getOrderKeys();
-    const auto& collation = window_func_->getCollation();
-    CHECK_EQ(order_keys.size(), collation.size());
     for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
          ++order_column_idx) {
       auto order_column_buffer = order_columns_[order_column_idx];
@@ -430,7 +840,7 @@ void WindowFunctionContext::compute() {
       const auto& order_col_collation = collation[order_column_idx];
       const auto asc_comparator = makeComparator(order_col,
                                                  order_column_buffer,
-                                                 payload() + offsets()[i],
+                                                 payload() + off,
                                                  order_col_collation.nulls_first);
       auto comparator = asc_comparator;
       if (order_col_collation.is_desc) {
@@ -440,40 +850,26 @@ void WindowFunctionContext::compute() {
       }
       comparators.push_back(comparator);
     }
-    const auto col_tuple_comparator = [&comparators](const int64_t lhs,
-                                                     const int64_t rhs) {
+    // Lexicographic order: a later key only decides between rows equal on the previous.
+    col_tuple_comparator = [comparators](const int64_t lhs, const int64_t rhs) {
       for (const auto& comparator : comparators) {
         if (comparator(lhs, rhs)) {
           return true;
         }
+        if (comparator(rhs, lhs)) {
+          return false;
+        }
       }
       return false;
     };
-    std::sort(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              col_tuple_comparator);
-    computePartition(output_for_partition_buff,
-                     partition_size,
-                     off,
-                     window_func_,
-                     col_tuple_comparator);
-    if (window_function_is_value(window_func_->getKind()) ||
-        window_function_is_aggregate(window_func_->getKind())) {
-      off += partition_size;
-    }
-  }
-  if (window_function_is_value(window_func_->getKind()) ||
-      window_function_is_aggregate(window_func_->getKind())) {
-    CHECK_EQ(static_cast<size_t>(off), elem_count_);
-  }
-  auto output_i64 = reinterpret_cast<int64_t*>(output_);
-  if (window_function_is_aggregate(window_func_->getKind())) {
-    std::copy(scratchpad.get(), scratchpad.get() + elem_count_, output_i64);
-  } else {
-    for (size_t i = 0; i < elem_count_; ++i) {
-      output_i64[payload()[i]] = scratchpad[i];
+    if (!comparators.empty()) {
+      std::sort(output_for_partition_buff,
+                output_for_partition_buff + partition_size,
+                col_tuple_comparator);
     }
   }
+  computePartition(
+      output_for_partition_buff, partition_size, off, window_func_, col_tuple_comparator);
 }
 
 const Analyzer::WindowFunction* WindowFunctionContext::getWindowFunction() const {
@@ -519,123 +915,20 @@ llvm::Value* WindowFunctionContext::getRowNumber() const {
   return aggregate_state_.row_number;
 }
 
-namespace {
-
-template <class T>
-bool integer_comparator(const int8_t* order_column_buffer,
-                        const SQLTypeInfo& ti,
-                        const int32_t* partition_indices,
-                        const int64_t lhs,
-                        const int64_t rhs,
-                        const bool nulls_first) {
-  const auto values = reinterpret_cast<const T*>(order_column_buffer);
-  const auto lhs_val = values[partition_indices[lhs]];
-  const auto rhs_val = values[partition_indices[rhs]];
-  const auto null_val = inline_fixed_encoding_null_val(ti);
-  if (lhs_val == null_val && rhs_val == null_val) {
-    return false;
-  }
-  if (lhs_val == null_val && rhs_val != null_val) {
-    return nulls_first;
-  }
-  if (rhs_val == null_val && lhs_val != null_val) {
-    return !nulls_first;
-  }
-  return lhs_val < rhs_val;
-}
-
-template <class T, class NullPatternType>
-bool fp_comparator(const int8_t* order_column_buffer,
-                   const SQLTypeInfo& ti,
-                   const int32_t* partition_indices,
-                   const int64_t lhs,
-                   const int64_t rhs,
-                   const bool nulls_first) {
-  const auto values = reinterpret_cast<const T*>(order_column_buffer);
-  const auto lhs_val = values[partition_indices[lhs]];
-  const auto rhs_val = values[partition_indices[rhs]];
-  const auto null_bit_pattern = null_val_bit_pattern(ti, ti.get_type() == kFLOAT);
-  const auto lhs_bit_pattern =
-      *reinterpret_cast<const NullPatternType*>(may_alias_ptr(&lhs_val));
-  const auto rhs_bit_pattern =
-      *reinterpret_cast<const NullPatternType*>(may_alias_ptr(&rhs_val));
-  if (lhs_bit_pattern == null_bit_pattern && rhs_bit_pattern == null_bit_pattern) {
-    return false;
-  }
-  if (lhs_bit_pattern == null_bit_pattern && rhs_bit_pattern != null_bit_pattern) {
-    return nulls_first;
-  }
-  if (rhs_bit_pattern == null_bit_pattern && lhs_bit_pattern != null_bit_pattern) {
-    return !nulls_first;
-  }
-  return lhs_val < rhs_val;
-}
-
-}  // namespace
-
 std::function<bool(const int64_t lhs, const int64_t rhs)>
 WindowFunctionContext::makeComparator(const Analyzer::ColumnVar* col_var,
                                       const int8_t* order_column_buffer,
                                       const int32_t* partition_indices,
                                       const bool nulls_first) {
-  const auto& ti = col_var->get_type_info();
-  if (ti.is_integer() || ti.is_decimal() || ti.is_time() || ti.is_boolean()) {
-    switch (ti.get_size()) {
-      case 8: {
-        return [order_column_buffer, nulls_first, partition_indices, &ti](
-                   const int64_t lhs, const int64_t rhs) {
-          return integer_comparator<int64_t>(
-              order_column_buffer, ti, partition_indices, lhs, rhs, nulls_first);
-        };
-      }
-      case 4: {
-        return [order_column_buffer, nulls_first, partition_indices, &ti](
-                   const int64_t lhs, const int64_t rhs) {
-          return integer_comparator<int32_t>(
-              order_column_buffer, ti, partition_indices, lhs, rhs, nulls_first);
-        };
-      }
-      case 2: {
-        return [order_column_buffer, nulls_first, partition_indices, &ti](
-                   const int64_t lhs, const int64_t rhs) {
-          return integer_comparator<int16_t>(
-              order_column_buffer, ti, partition_indices, lhs, rhs, nulls_first);
-        };
-      }
-      case 1: {
-        return [order_column_buffer, nulls_first, partition_indices, &ti](
-                   const int64_t lhs, const int64_t rhs) {
-          return integer_comparator<int8_t>(
-              order_column_buffer, ti, partition_indices, lhs, rhs, nulls_first);
-        };
-      }
-      default: {
-        LOG(FATAL) << "Invalid type size: " << ti.get_size();
-      }
-    }
-  }
-  if (ti.is_fp()) {
-    switch (ti.get_type()) {
-      case kFLOAT: {
-        return [order_column_buffer, nulls_first, partition_indices, &ti](
-                   const int64_t lhs, const int64_t rhs) {
-          return fp_comparator<float, int32_t>(
-              order_column_buffer, ti, partition_indices, lhs, rhs, nulls_first);
-        };
-      }
-      case kDOUBLE: {
-        return [order_column_buffer, nulls_first, partition_indices, &ti](
-                   const int64_t lhs, const int64_t rhs) {
-          return fp_comparator<double, int64_t>(
-              order_column_buffer, ti, partition_indices, lhs, rhs, nulls_first);
-        };
-      }
-      default: {
-        LOG(FATAL) << "Invalid float type";
-      }
-    }
-  }
-  throw std::runtime_error("Type not supported yet");
+  Comparator comparator;
+  visit_typed_comparator(col_var->get_type_info(),
+                         order_column_buffer,
+                         partition_indices,
+                         nulls_first,
+                         [&comparator](const auto& typed_comparator) {
+                           comparator = typed_comparator;
+                         });
+  return comparator;
 }
 
 void WindowFunctionContext::computePartition(
@@ -713,9 +1006,13 @@ void WindowFunctionContext::computePartition(
     case SqlWindowFunctionKind::SUM:
     case SqlWindowFunctionKind::COUNT: {
       const auto partition_row_offsets = payload() + off;
+      if (window_func->getFrame()) {
+        computeRowsFramePartition(output_for_partition_buff, partition_size, off);
+        break;
+      }
       if (window_function_requires_peer_handling(window_func)) {
         index_to_partition_end(
-            partitionEnd(), off, output_for_partition_buff, partition_size, comparator);
+            partition_end_, off, output_for_partition_buff, partition_size, comparator);
       }
       apply_permutation_to_partition(
           output_for_partition_buff, partition_row_offsets, partition_size);
@@ -728,6 +1025,27 @@ void WindowFunctionContext::computePartition(
   }
 }
 
+void WindowFunctionContext::computeRowsFramePartition(int64_t* output_for_partition_buff,
+                                                      const size_t partition_size,
+                                                      const size_t off) {
+  const std::vector<int64_t> index(output_for_partition_buff,
+                                   output_for_partition_buff + partition_size);
+  const auto& args = window_func_->getArgs();
+  if (!args.empty() && args.front()->get_type_info().is_fp()) {
+    compute_rows_frame_aggregate<double>(window_func_,
+                                         aggregate_arg_column_,
+                                         payload() + off,
+                                         index,
+                                         output_for_partition_buff);
+  } else {
+    compute_rows_frame_aggregate<int64_t>(window_func_,
+                                          aggregate_arg_column_,
+                                          payload() + off,
+                                          index,
+                                          output_for_partition_buff);
+  }
+}
+
 void WindowFunctionContext::fillPartitionStart() {
   CountDistinctDescriptor partition_start_bitmap{CountDistinctImplType::Bitmap,
                                                  0,
@@ -57,10 +57,11 @@ inline bool window_function_is_aggregate(const SqlWindowFunctionKind kind) {
 
 // Per-window function context which encapsulates the logic for computing the various
 // window function kinds and keeps ownership of buffers which contain the results. For
-// rank functions, the code generated for the projection simply reads the values and
-// writes them to the result set. For value and aggregate functions, only the iteration
-// order is written to the buffer, the rest is handled by generating code in a similar way
-// we do for non-window queries.
+// rank functions and aggregates over an explicit ROWS frame, the code generated for the
+// projection simply reads the values and writes them to the result set. For value and
+// the other aggregate functions, only the iteration order is written to the buffer, the
+// rest is handled by generating code in a similar way we do for non-window queries. The
+// partitions are sorted and computed in parallel.
 class WindowFunctionContext {
  public:
   WindowFunctionContext(const Analyzer::WindowFunction* window_func,
@@ -79,6 +80,12 @@ class WindowFunctionContext {
                       const Analyzer::ColumnVar* col_var,
                       const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
 
+  // Adds the argument column of an aggregate over a ROWS frame to the context and keeps
+  // ownership of it.
+  void setAggregateArgColumn(
+      const int8_t* column,
+      const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
+
   // Computes the window function result to be used during the actual projection query.
   void compute();
 
@@ -128,6 +135,10 @@ class WindowFunctionContext {
                                    const int32_t* partition_indices,
                                    const bool nulls_first);
 
+  // Sorts the partition at the given index by the order keys and computes the window
+  // function for it, into its range of the scratchpad.
+  void sortAndComputePartition(const size_t partition_idx, int64_t* scratchpad);
+
   void computePartition(
       int64_t* output_for_partition_buff,
       const size_t partition_size,
@@ -135,6 +146,11 @@ class WindowFunctionContext {
       const Analyzer::WindowFunction* window_func,
       const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator);
 
+  // Computes an aggregate over a ROWS frame for a sorted partition.
+  void computeRowsFramePartition(int64_t* output_for_partition_buff,
+                                 const size_t partition_size,
+                                 const size_t off);
+
   void fillPartitionStart();
 
   void fillPartitionEnd();
@@ -152,6 +168,10 @@ class WindowFunctionContext {
   std::vector<std::vector<std::shared_ptr<Chunk_NS::Chunk>>> order_columns_owner_;
   // Order column buffers.
   std::vector<const int8_t*> order_columns_;
+  // Keeps ownership of the argument column of an aggregate over a ROWS frame.
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> aggregate_arg_column_owner_;
+  // Argument column buffer of an aggregate over a ROWS frame.
+  const int8_t* aggregate_arg_column_;
   // Hash table which contains the partitions specified by the window.
   std::shared_ptr<JoinHashTableInterface> partitions_;
   // The number of elements in the table.
@@ -41,7 +41,8 @@ bool matches_gt_bigint_zero(const Analyzer::BinOper* window_gt_zero) {
 bool window_sum_and_count_match(const Analyzer::WindowFunction* sum_window_expr,
                                 const Analyzer::WindowFunction* count_window_expr) {
   CHECK_EQ(count_window_expr->get_type_info().get_type(), kBIGINT);
-  return expr_list_match(sum_window_expr->getArgs(), count_window_expr->getArgs());
+  return expr_list_match(sum_window_expr->getArgs(), count_window_expr->getArgs()) &&
+         sum_window_expr->getFrame() == count_window_expr->getFrame();
 }
 
 bool is_sum_kind(const SqlWindowFunctionKind kind) {
@@ -91,7 +92,8 @@ std::shared_ptr<Analyzer::WindowFunction> rewrite_sum_window(const Analyzer::Exp
                                             sum_window_expr->getArgs(),
                                             sum_window_expr->getPartitionKeys(),
                                             sum_window_expr->getOrderKeys(),
-                                            sum_window_expr->getCollation());
+                                            sum_window_expr->getCollation(),
+                                            sum_window_expr->getFrame());
 }
 
 std::shared_ptr<Analyzer::WindowFunction> rewrite_avg_window(const Analyzer::Expr* expr) {
@@ -129,5 +131,6 @@ std::shared_ptr<Analyzer::WindowFunction> rewrite_avg_window(const Analyzer::Exp
                                             sum_window_expr->getArgs(),
                                             sum_window_expr->getPartitionKeys(),
                                             sum_window_expr->getOrderKeys(),
-                                            sum_window_expr->getCollation());
+                                            sum_window_expr->getCollation(),
+                                            sum_window_expr->getFrame());
 }
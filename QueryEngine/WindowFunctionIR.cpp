@@ -29,17 +29,17 @@ llvm::Value* Executor::codegenWindowFunction(const size_t target_index,
     case SqlWindowFunctionKind::RANK:
     case SqlWindowFunctionKind::DENSE_RANK:
     case SqlWindowFunctionKind::NTILE: {
-      return cgen_state_->emitCall("row_number_window_func",
-                                   {cgen_state_->llInt(reinterpret_cast<const int64_t>(
-                                        window_func_context->output())),
-                                    code_generator.posArg(nullptr)});
+      return cgen_state_->emitCall(
+          "row_number_window_func",
+          {cgen_state_->llHostAddress(window_func_context->output()),
+           code_generator.posArg(nullptr)});
     }
     case SqlWindowFunctionKind::PERCENT_RANK:
     case SqlWindowFunctionKind::CUME_DIST: {
-      return cgen_state_->emitCall("percent_window_func",
-                                   {cgen_state_->llInt(reinterpret_cast<const int64_t>(
-                                        window_func_context->output())),
-                                    code_generator.posArg(nullptr)});
+      return cgen_state_->emitCall(
+          "percent_window_func",
+          {cgen_state_->llHostAddress(window_func_context->output()),
+           code_generator.posArg(nullptr)});
     }
     case SqlWindowFunctionKind::LAG:
     case SqlWindowFunctionKind::LEAD:
@@ -57,6 +57,9 @@ llvm::Value* Executor::codegenWindowFunction(const size_t target_index,
     case SqlWindowFunctionKind::MAX:
     case SqlWindowFunctionKind::SUM:
     case SqlWindowFunctionKind::COUNT: {
+      if (window_func->getFrame()) {
+        return codegenWindowFunctionRowsFrame();
+      }
       return codegenWindowFunctionAggregate(co);
     }
     default: {
@@ -66,6 +69,28 @@ llvm::Value* Executor::codegenWindowFunction(const size_t target_index,
   return nullptr;
 }
 
+llvm::Value* Executor::codegenWindowFunctionRowsFrame() {
+  const auto window_func_context =
+      WindowProjectNodeContext::getActiveWindowFunctionContext();
+  const auto window_func = window_func_context->getWindowFunction();
+  const auto& window_func_ti = window_func->get_type_info();
+  CodeGenerator code_generator(this);
+  const std::vector<llvm::Value*> args{
+      cgen_state_->llHostAddress(window_func_context->output()),
+      code_generator.posArg(nullptr)};
+  if (window_func->getKind() == SqlWindowFunctionKind::AVG) {
+    return cgen_state_->emitCall("percent_window_func", args);
+  }
+  if (window_func_ti.is_fp()) {
+    const auto val = cgen_state_->emitCall("percent_window_func", args);
+    return window_func_ti.get_type() == kFLOAT
+               ? cgen_state_->ir_builder_.CreateFPTrunc(
+                     val, llvm::Type::getFloatTy(cgen_state_->context_))
+               : val;
+  }
+  return cgen_state_->emitCall("row_number_window_func", args);
+}
+
 namespace {
 
 std::string get_window_agg_name(const SqlWindowFunctionKind kind,
@@ -128,8 +153,8 @@ llvm::Value* Executor::aggregateWindowStatePtr() {
       arg_ti.get_type() == kFLOAT
           ? llvm::PointerType::get(get_int_type(32, cgen_state_->context_), 0)
           : llvm::PointerType::get(get_int_type(64, cgen_state_->context_), 0);
-  const auto aggregate_state_i64 = cgen_state_->llInt(
-      reinterpret_cast<const int64_t>(window_func_context->aggregateState()));
+  const auto aggregate_state_i64 =
+      cgen_state_->llHostAddress(window_func_context->aggregateState());
   return cgen_state_->ir_builder_.CreateIntToPtr(aggregate_state_i64,
                                                  aggregate_state_type);
 }
@@ -142,8 +167,8 @@ llvm::Value* Executor::codegenWindowFunctionAggregate(const CompilationOptions&
       WindowProjectNodeContext::getActiveWindowFunctionContext();
   const auto window_func = window_func_context->getWindowFunction();
   if (window_func->getKind() == SqlWindowFunctionKind::AVG) {
-    const auto aggregate_state_count_i64 = cgen_state_->llInt(
-        reinterpret_cast<const int64_t>(window_func_context->aggregateStateCount()));
+    const auto aggregate_state_count_i64 =
+        cgen_state_->llHostAddress(window_func_context->aggregateStateCount());
     const auto pi64_type =
         llvm::PointerType::get(get_int_type(64, cgen_state_->context_), 0);
     aggregate_state_count =
@@ -163,8 +188,7 @@ llvm::Value* Executor::codegenWindowFunctionAggregate(const CompilationOptions&
 llvm::BasicBlock* Executor::codegenWindowResetStateControlFlow() {
   const auto window_func_context =
       WindowProjectNodeContext::getActiveWindowFunctionContext();
-  const auto bitset = cgen_state_->llInt(
-      reinterpret_cast<const int64_t>(window_func_context->partitionStart()));
+  const auto bitset = cgen_state_->llHostAddress(window_func_context->partitionStart());
   const auto min_val = cgen_state_->llInt(int64_t(0));
   const auto max_val = cgen_state_->llInt(window_func_context->elementCount() - 1);
   const auto null_val = cgen_state_->llInt(inline_int_null_value<int64_t>());
@@ -292,8 +316,8 @@ void Executor::codegenWindowAvgEpilogue(llvm::Value* crt_val,
       llvm::PointerType::get(get_int_type(64, cgen_state_->context_), 0);
   const auto aggregate_state_type =
       window_func_ti.get_type() == kFLOAT ? pi32_type : pi64_type;
-  const auto aggregate_state_count_i64 = cgen_state_->llInt(
-      reinterpret_cast<const int64_t>(window_func_context->aggregateStateCount()));
+  const auto aggregate_state_count_i64 =
+      cgen_state_->llHostAddress(window_func_context->aggregateStateCount());
   auto aggregate_state_count = cgen_state_->ir_builder_.CreateIntToPtr(
       aggregate_state_count_i64, aggregate_state_type);
   std::string agg_count_func_name = "agg_count";
@@ -328,8 +352,8 @@ llvm::Value* Executor::codegenAggregateWindowState() {
       window_func_ti.get_type() == kFLOAT ? pi32_type : pi64_type;
   auto aggregate_state = aggregateWindowStatePtr();
   if (window_func->getKind() == SqlWindowFunctionKind::AVG) {
-    const auto aggregate_state_count_i64 = cgen_state_->llInt(
-        reinterpret_cast<const int64_t>(window_func_context->aggregateStateCount()));
+    const auto aggregate_state_count_i64 =
+        cgen_state_->llHostAddress(window_func_context->aggregateStateCount());
     auto aggregate_state_count = cgen_state_->ir_builder_.CreateIntToPtr(
         aggregate_state_count_i64, aggregate_state_type);
     const auto double_null_lv = cgen_state_->inlineFpNull(SQLTypeInfo(kDOUBLE));
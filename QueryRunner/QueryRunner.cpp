@@ -354,9 +354,14 @@ ExecutionResult run_select_query_with_filter_push_down(
     const bool with_filter_push_down) {
   auto const& query_state = query_state_proxy.getQueryState();
   const auto& cat = query_state.getConstSessionInfo()->getCatalog();
-  auto executor = Executor::getExecutor(cat.getCurrentDB().dbId);
-  CompilationOptions co = {
-      device_type, true, ExecutorOptLevel::LoopStrengthReduction, false};
+  auto executor_lease = Executor::leaseExecutor(cat.getCurrentDB().dbId);
+  CompilationOptions co = {device_type,
+                           true,
+                           ExecutorOptLevel::LoopStrengthReduction,
+                           false,
+                           ExecutorExplainType::Default,
+                           false,
+                           g_enable_vectorized_cpu_codegen};
   ExecutionOptions eo = {g_enable_columnar_output,
                          true,
                          just_explain,
@@ -378,8 +383,8 @@ ExecutionResult run_select_query_with_filter_push_down(
                                       false,
                                       false)
                             .plan_result;
-  auto result =
-      RelAlgExecutor(executor.get(), cat, query_ra).executeRelAlgQuery(co, eo, nullptr);
+  auto result = RelAlgExecutor(executor_lease->get(), cat, query_ra)
+                    .executeRelAlgQuery(co, eo, nullptr);
   const auto& filter_push_down_requests = result.getPushedDownFilterInfo();
   if (!filter_push_down_requests.empty()) {
     std::vector<TFilterPushDownInfo> filter_push_down_info;
@@ -410,7 +415,7 @@ ExecutionResult run_select_query_with_filter_push_down(
                                        /*find_push_down_candidates=*/false,
                                        /*just_calcite_explain=*/false,
                                        eo.gpu_input_mem_limit_percent};
-    return RelAlgExecutor(executor.get(), cat, new_query_ra)
+    return RelAlgExecutor(executor_lease->get(), cat, new_query_ra)
         .executeRelAlgQuery(co, eo_modified, nullptr);
   } else {
     return result;
@@ -438,9 +443,14 @@ ExecutionResult QueryRunner::runSelectQuery(const std::string& query_str,
   }
 
   const auto& cat = session_info_->getCatalog();
-  auto executor = Executor::getExecutor(cat.getCurrentDB().dbId);
-  CompilationOptions co = {
-      device_type, true, ExecutorOptLevel::LoopStrengthReduction, false};
+  auto executor_lease = Executor::leaseExecutor(cat.getCurrentDB().dbId);
+  CompilationOptions co = {device_type,
+                           true,
+                           ExecutorOptLevel::LoopStrengthReduction,
+                           false,
+                           ExecutorExplainType::Default,
+                           false,
+                           g_enable_vectorized_cpu_codegen};
   ExecutionOptions eo = {g_enable_columnar_output,
                          true,
                          just_explain,
@@ -462,7 +472,7 @@ ExecutionResult QueryRunner::runSelectQuery(const std::string& query_str,
                                       false,
                                       false)
                             .plan_result;
-  return RelAlgExecutor(executor.get(), cat, query_ra)
+  return RelAlgExecutor(executor_lease->get(), cat, query_ra)
       .executeRelAlgQuery(co, eo, nullptr);
 }
 
@@ -774,6 +774,10 @@ void print_memory_info(ClientContext& context, std::string memory_level) {
     }
     cur_host = nodeIt.host_name;
 
+    tss << sub_system << "[" << mgr_num << "]"
+        << " Eviction policy: " << nodeIt.eviction_policy << " hits: " << nodeIt.num_hits
+        << " misses: " << nodeIt.num_misses << " evictions: " << nodeIt.num_evictions
+        << std::endl;
     tss << sub_system << "[" << mgr_num << "]"
         << " Slab Information:" << std::endl;
     if (nodeIt.is_allocation_capped) {
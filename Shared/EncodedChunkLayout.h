@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    EncodedChunkLayout.h
+ * @brief   Chunk layouts of the RL and DIFF encodings, shared by the encoders which
+ * write them and the decoders which read them on CPU and GPU.
+ *
+ * Both layouts start with an 8 bytes header, so the chunk address is all a decoder needs.
+ *
+ * DIFF: the baseline of the chunk (its first non-null value) as int64_t, followed by the
+ * difference of every value from the baseline on comp_param bits. The smallest value of
+ * the difference type is the NULL sentinel.
+ *
+ * RL: the number of runs as int64_t, followed by the runs in position order. The run
+ * values are stored in the storage type of the column, so a run takes 8 bytes up to
+ * INTEGER columns and 16 bytes for BIGINT, decimal and time columns.
+ */
+
+#ifndef ENCODEDCHUNKLAYOUT_H
+#define ENCODEDCHUNKLAYOUT_H
+
+#include <cstdint>
+
+#define DIFF_ENCODING_HEADER_SIZE 8
+#define RL_ENCODING_HEADER_SIZE 8
+
+template <typename T>
+struct RunLengthRun {
+  T value;          // logical value, NULL runs hold the NULL sentinel of the type
+  int32_t end_pos;  // one past the position of the last element of the run
+};
+
+#endif  // ENCODEDCHUNKLAYOUT_H
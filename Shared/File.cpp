@@ -21,6 +21,8 @@
  *
  */
 #include "File.h"
+#include <fcntl.h>
+#include <unistd.h>
 #include <boost/filesystem.hpp>
 #include <cstdio>
 #include <cstring>
@@ -117,6 +119,38 @@ size_t read(FILE* f, const size_t offset, const size_t size, int8_t* buf) {
   return bytesRead;
 }
 
+int openDirect(const std::string& path) {
+#ifdef O_DIRECT
+  int fd = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+  if (fd < 0) {
+    LOG(WARNING) << "Could not open file '" << path
+                 << "' for direct I/O, the error was: " << std::strerror(errno);
+  }
+  return fd;
+#else
+  return -1;
+#endif
+}
+
+size_t readDirect(const int fd, const size_t offset, const size_t size, int8_t* buf) {
+  CHECK_EQ(offset % DIRECT_IO_ALIGNMENT, size_t(0));
+  CHECK_EQ(size % DIRECT_IO_ALIGNMENT, size_t(0));
+  CHECK_EQ(reinterpret_cast<uintptr_t>(buf) % DIRECT_IO_ALIGNMENT, uintptr_t(0));
+  size_t bytesRead = 0;
+  while (bytesRead < size) {
+    const auto ret = pread(fd, buf + bytesRead, size - bytesRead, offset + bytesRead);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      LOG(FATAL) << "Error trying to read from file (direct I/O) the error was: "
+                 << (ret < 0 ? std::strerror(errno) : "unexpected end of file");
+    }
+    bytesRead += ret;
+  }
+  return bytesRead;
+}
+
 size_t write(FILE* f, const size_t offset, const size_t size, int8_t* buf) {
   // write size bytes from the buffer to the offset location in the file
   if (fseek(f, offset, SEEK_SET) != 0) {
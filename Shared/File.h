@@ -26,6 +26,7 @@
 #define MAPD_FILE_EXT ".mapd"
 #define MAX_FILE_N_PAGES 256
 #define MAX_FILE_N_METADATA_PAGES 4096
+#define DIRECT_IO_ALIGNMENT 4096
 
 #include <iostream>
 #include <string>
@@ -78,6 +79,29 @@ bool removeFile(const std::string basePath, const std::string filename);
  */
 size_t read(FILE* f, const size_t offset, const size_t size, int8_t* buf);
 
+/**
+ * @brief Opens an existing file for reads that bypass the OS page cache (O_DIRECT).
+ *
+ * @param path The path of the file.
+ * @return int A file descriptor, or -1 if the platform or file system does not support
+ * direct I/O.
+ */
+int openDirect(const std::string& path);
+
+/**
+ * @brief Reads the specified number of bytes from the offset position of a file opened
+ * with openDirect into buf.
+ *
+ * The offset, size and buf address must all be multiples of DIRECT_IO_ALIGNMENT.
+ *
+ * @param fd The file descriptor returned by openDirect.
+ * @param offset The location within the file from which to read.
+ * @param size The number of bytes to be read.
+ * @param buf The destination buffer to where data is being read from the file.
+ * @return size_t The number of bytes read.
+ */
+size_t readDirect(const int fd, const size_t offset, const size_t size, int8_t* buf);
+
 /**
  * @brief Writes the specified number of bytes to the offset position in file f from buf.
  *
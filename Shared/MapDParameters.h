@@ -30,6 +30,7 @@ struct MapDParameters {
   size_t cuda_block_size = 0;       // block size for the kernel execution
   size_t cuda_grid_size = 0;        // grid size for the kernel execution
   size_t calcite_max_mem = 1024;    // max memory for calcite jvm in MB
+  size_t calcite_plan_cache_size = 0;  // max number of cached calcite plans, 0 disables
   int omnisci_server_port = 6274;   // default port omnisci_server runs on
   int calcite_port = 6279;          // default port for calcite server to run on
   std::string ha_group_id;          // name of the HA group this server is in
@@ -40,6 +41,12 @@ struct MapDParameters {
   size_t cpu_buffer_mem_bytes = 0;  // max size of memory reserved for CPU buffers [bytes]
   size_t gpu_buffer_mem_bytes = 0;  // max size of memory reserved for GPU buffers [bytes]
   double gpu_input_mem_limit = 0.9;  // Punt query to CPU if input mem exceeds % GPU mem
+  std::string buffer_eviction_policy = "lru";  // victim selection for CPU/GPU pools
+  std::string file_read_backend = "buffered";  // how data file pages are read from disk
+  bool enable_buffer_pool_warm_restart = false;  // reload the buffer pools at startup
+  size_t buffer_pool_warm_restart_save_interval = 600;  // [s], 0 saves at shutdown only
+  size_t buffer_pool_warm_restart_max_mb_per_sec = 256;  // reload rate, 0 is unthrottled
+  double buffer_pool_warm_restart_max_pool_fill = 0.8;  // stop reloading past this fill
   std::string config_file = "";
   std::string ssl_cert_file = "";    // file path to server's certified PKI certificate
   std::string ssl_key_file = "";     // file path to server's' private PKI key
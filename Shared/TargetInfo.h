@@ -118,6 +118,10 @@ inline bool is_distinct_target(const TargetInfo& target_info) {
   return target_info.is_distinct || target_info.agg_kind == kAPPROX_COUNT_DISTINCT;
 }
 
+inline bool is_approx_percentile_target(const TargetInfo& target_info) {
+  return target_info.is_agg && target_info.agg_kind == kAPPROX_PERCENTILE;
+}
+
 inline bool takes_float_argument(const TargetInfo& target_info) {
   return target_info.is_agg &&
          (target_info.agg_kind == kAVG || target_info.agg_kind == kSUM ||
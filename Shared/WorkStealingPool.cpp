@@ -0,0 +1,267 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkStealingPool.h"
+#include "Logger.h"
+#include "thread_count.h"
+
+#include <boost/algorithm/string.hpp>
+
+#include <fstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+thread_local const WorkStealingPool* tls_pool{nullptr};
+thread_local size_t tls_worker_idx{0};
+
+// Parses a kernel cpu list, e.g. "0-7,16-23".
+std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+  std::vector<int> cpus;
+  std::vector<std::string> ranges;
+  boost::split(ranges, boost::trim_copy(cpu_list), boost::is_any_of(","));
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash_pos = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash_pos));
+      const int last =
+          dash_pos == std::string::npos ? first : std::stoi(range.substr(dash_pos + 1));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+      return {};
+    }
+  }
+  return cpus;
+}
+
+// CPUs of every NUMA node, empty if the topology isn't available.
+std::vector<std::vector<int>> get_numa_node_cpus() {
+  std::vector<std::vector<int>> node_cpus;
+  for (size_t node = 0;; ++node) {
+    const auto cpu_list_path =
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+    std::ifstream cpu_list_file(cpu_list_path);
+    if (!cpu_list_file) {
+      break;
+    }
+    std::string cpu_list;
+    std::getline(cpu_list_file, cpu_list);
+    const auto cpus = parse_cpu_list(cpu_list);
+    if (!cpus.empty()) {
+      node_cpus.push_back(cpus);
+    }
+  }
+  return node_cpus;
+}
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(const size_t num_workers)
+    : next_worker_(0), num_queued_(0), stop_(false) {
+  CHECK_GT(num_workers, size_t(0));
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back(std::make_unique<Worker>());
+  }
+  placeWorkers();
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_[i]->thread = std::thread(&WorkStealingPool::workerLoop, this, i);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+WorkStealingPool& WorkStealingPool::getCpuKernelPool() {
+  static WorkStealingPool pool(cpu_threads());
+  return pool;
+}
+
+void WorkStealingPool::submit(Task&& task) {
+  const auto worker_idx = tls_pool == this
+                              ? tls_worker_idx
+                              : next_worker_.fetch_add(1) % workers_.size();
+  {
+    // the count goes up before the task is visible, so that it never underflows
+    std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+    ++num_queued_;
+    auto& worker = *workers_[worker_idx];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+  }
+  wake_cv_.notify_one();
+}
+
+void WorkStealingPool::workerLoop(const size_t worker_idx) {
+  tls_pool = this;
+  tls_worker_idx = worker_idx;
+#ifdef __linux__
+  const auto& cpus = workers_[worker_idx]->cpus;
+  if (!cpus.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const auto cpu : cpus) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &cpu_set);
+      }
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) {
+      LOG(WARNING) << "Could not pin a CPU kernel worker to its NUMA node";
+    }
+  }
+#endif  // __linux__
+  while (true) {
+    Task task;
+    if (popTask(worker_idx, task)) {
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_cv_.wait(lock, [this] { return stop_ || num_queued_ > 0; });
+    if (stop_ && num_queued_ == 0) {
+      return;
+    }
+  }
+}
+
+bool WorkStealingPool::popTask(const size_t worker_idx, Task& task) {
+  bool found{false};
+  {
+    auto& worker = *workers_[worker_idx];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+      found = true;
+    }
+  }
+  if (!found) {
+    for (const auto victim_idx : workers_[worker_idx]->steal_order) {
+      auto& victim = *workers_[victim_idx];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        // steal the most recently submitted task, the owner keeps the oldest ones
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        found = true;
+        break;
+      }
+    }
+  }
+  if (found) {
+    std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+    CHECK_GT(num_queued_, size_t(0));
+    --num_queued_;
+  }
+  return found;
+}
+
+void WorkStealingPool::placeWorkers() {
+  const auto node_cpus = get_numa_node_cpus();
+  const size_t node_count = std::max(node_cpus.size(), size_t(1));
+  const auto worker_node = [node_count](const size_t worker_idx) {
+    return worker_idx % node_count;
+  };
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    auto& steal_order = workers_[i]->steal_order;
+    for (size_t j = 1; j < workers_.size(); ++j) {
+      const auto victim_idx = (i + j) % workers_.size();
+      if (worker_node(victim_idx) == worker_node(i)) {
+        steal_order.push_back(victim_idx);
+      }
+    }
+    for (size_t j = 1; j < workers_.size(); ++j) {
+      const auto victim_idx = (i + j) % workers_.size();
+      if (worker_node(victim_idx) != worker_node(i)) {
+        steal_order.push_back(victim_idx);
+      }
+    }
+  }
+  if (node_cpus.size() < 2) {
+    return;
+  }
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i]->cpus = node_cpus[worker_node(i)];
+  }
+  LOG(INFO) << "Spread " << workers_.size() << " CPU kernel workers over "
+            << node_cpus.size() << " NUMA nodes";
+}
+
+WorkStealingPool::TaskGroup::TaskGroup(WorkStealingPool& pool,
+                                       const size_t max_concurrency)
+    : pool_(pool)
+    , max_concurrency_(max_concurrency ? max_concurrency : pool.numWorkers())
+    , in_pool_(0) {}
+
+WorkStealingPool::TaskGroup::~TaskGroup() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return in_pool_ == 0 && waiting_.empty(); });
+}
+
+std::future<void> WorkStealingPool::TaskGroup::submit(Task&& task) {
+  auto packaged_task = std::make_shared<std::packaged_task<void()>>(std::move(task));
+  auto future = packaged_task->get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_pool_ >= max_concurrency_) {
+      waiting_.push_back(packaged_task);
+      return future;
+    }
+    ++in_pool_;
+  }
+  launch(packaged_task);
+  return future;
+}
+
+void WorkStealingPool::TaskGroup::launch(
+    std::shared_ptr<std::packaged_task<void()>> task) {
+  pool_.submit([this, task] {
+    (*task)();
+    taskDone();
+  });
+}
+
+void WorkStealingPool::TaskGroup::taskDone() {
+  std::shared_ptr<std::packaged_task<void()>> next_task;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (waiting_.empty()) {
+      --in_pool_;
+      // notify under the lock, the group may be destroyed as soon as it is released
+      done_cv_.notify_all();
+      return;
+    }
+    next_task = waiting_.front();
+    waiting_.pop_front();
+  }
+  launch(next_task);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WorkStealingPool.h
+ * @brief   Fixed size pool of worker threads with a task deque per worker.
+ *
+ * Tasks submitted from outside the pool are spread round-robin over the worker deques,
+ * tasks submitted by a worker go to its own deque. A worker runs the tasks of its deque
+ * in submission order and, once it runs dry, steals from the other end of the deques of
+ * the workers on its NUMA node first, then from the remaining workers. On machines with
+ * several NUMA nodes, every worker is pinned to the CPUs of one node.
+ *
+ * TaskGroup bounds the number of tasks of one client (e.g. a query) which are queued
+ * or running in the pool at any time; the surplus waits in the group.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit WorkStealingPool(const size_t num_workers);
+
+  ~WorkStealingPool();
+
+  /// Process-wide pool for CPU query kernels, sized by cpu_threads().
+  static WorkStealingPool& getCpuKernelPool();
+
+  size_t numWorkers() const { return workers_.size(); }
+
+  void submit(Task&& task);
+
+  class TaskGroup {
+   public:
+    /// At most max_concurrency tasks of the group are in the pool at any time, 0 means
+    /// as many as the pool has workers.
+    TaskGroup(WorkStealingPool& pool, const size_t max_concurrency);
+
+    /// Waits for the tasks still in the pool.
+    ~TaskGroup();
+
+    std::future<void> submit(Task&& task);
+
+   private:
+    void launch(std::shared_ptr<std::packaged_task<void()>> task);
+    void taskDone();
+
+    WorkStealingPool& pool_;
+    const size_t max_concurrency_;
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+    std::deque<std::shared_ptr<std::packaged_task<void()>>> waiting_;
+    size_t in_pool_;
+  };
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::vector<size_t> steal_order;
+    std::vector<int> cpus;  // NUMA node of the worker, empty if not pinned
+    std::thread thread;
+  };
+
+  void workerLoop(const size_t worker_idx);
+  bool popTask(const size_t worker_idx, Task& task);
+  void placeWorkers();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> next_worker_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  size_t num_queued_;
+  bool stop_;
+};
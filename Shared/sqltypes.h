@@ -687,13 +687,12 @@ class SQLTypeInfoCore : public TYPE_FACET_PACK<SQLTypeInfoCore<TYPE_FACET_PACK..
       case kSMALLINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int16_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
           default:
             assert(false);
         }
@@ -701,13 +700,12 @@ class SQLTypeInfoCore : public TYPE_FACET_PACK<SQLTypeInfoCore<TYPE_FACET_PACK..
       case kINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int32_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
           default:
             assert(false);
         }
@@ -717,13 +715,12 @@ class SQLTypeInfoCore : public TYPE_FACET_PACK<SQLTypeInfoCore<TYPE_FACET_PACK..
       case kDECIMAL:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int64_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
           default:
             assert(false);
         }
@@ -763,14 +760,14 @@ class SQLTypeInfoCore : public TYPE_FACET_PACK<SQLTypeInfoCore<TYPE_FACET_PACK..
       case kDATE:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
             return sizeof(int64_t);
           case kENCODING_FIXED:
             if (type == kTIMESTAMP && dimension > 0) {
               assert(false);  // disable compression for timestamp precisions
             }
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
           case kENCODING_SPARSE:
             assert(false);
             break;
@@ -868,7 +865,8 @@ int64_t convert_decimal_value_to_scale(const int64_t decimal_value,
 
 inline SQLTypeInfo get_logical_type_info(const SQLTypeInfo& type_info) {
   EncodingType encoding = type_info.get_compression();
-  if (encoding == kENCODING_DATE_IN_DAYS ||
+  if (encoding == kENCODING_DATE_IN_DAYS || encoding == kENCODING_RL ||
+      encoding == kENCODING_DIFF ||
       (encoding == kENCODING_FIXED && type_info.get_type() != kARRAY)) {
     encoding = kENCODING_NONE;
   }
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef READER_EPOCHS_HPP
+#define READER_EPOCHS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Epoch based reclamation for structures which are read without locks.
+ *
+ * Readers pin the current epoch for the duration of a lookup with a Guard. A writer
+ * which replaced a shared structure calls synchronize() before freeing the old one: it
+ * advances the epoch and waits until every reader which may still see the old structure
+ * is done. Readers don't block on writers, although pinning retries if the epoch
+ * advances meanwhile. A thread must not call synchronize() while it holds a Guard on the
+ * same ReaderEpochs.
+ */
+class ReaderEpochs {
+ public:
+  class Guard {
+   public:
+    explicit Guard(ReaderEpochs& epochs) : reader_count_(epochs.enter()) {}
+    ~Guard() { reader_count_->fetch_sub(1); }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+   private:
+    std::atomic<int64_t>* reader_count_;
+  };
+
+  void synchronize() {
+    std::lock_guard<std::mutex> lock(synchronize_mutex_);
+    const auto parity = epoch_.fetch_add(1) & 1;
+    for (auto& slot : slots_) {
+      while (slot.reader_counts[parity].load() != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+ private:
+  std::atomic<int64_t>* enter() {
+    auto& slot = slots_[threadSlot()];
+    while (true) {
+      const auto epoch = epoch_.load();
+      auto& reader_count = slot.reader_counts[epoch & 1];
+      reader_count.fetch_add(1);
+      if (epoch_.load() == epoch) {
+        return &reader_count;
+      }
+      // a writer advanced the epoch before it could see this reader, retry
+      reader_count.fetch_sub(1);
+    }
+  }
+
+  static size_t threadSlot() {
+    static std::atomic<size_t> next_slot{0};
+    thread_local const size_t slot = next_slot++ % SLOT_COUNT;
+    return slot;
+  }
+
+  static constexpr size_t SLOT_COUNT = 64;
+
+  // Threads are spread over padded slots so readers don't contend on a cache line
+  struct alignas(64) Slot {
+    std::atomic<int64_t> reader_counts[2] = {{0}, {0}};
+  };
+
+  std::atomic<uint64_t> epoch_{0};
+  std::mutex synchronize_mutex_;
+  std::array<Slot, SLOT_COUNT> slots_;
+};
+
+#endif  // READER_EPOCHS_HPP
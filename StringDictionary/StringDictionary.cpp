@@ -102,6 +102,9 @@ uint32_t rk_hash(const std::string& str) {
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
+constexpr size_t StringDictionary::HASH_SHARD_BITS;
+constexpr size_t StringDictionary::HASH_SHARD_COUNT;
+constexpr size_t StringDictionary::MIN_SHARD_CAPACITY;
 
 StringDictionary::StringDictionary(const std::string& folder,
                                    const bool isTemp,
@@ -109,8 +112,6 @@ StringDictionary::StringDictionary(const std::string& folder,
                                    const bool materializeHashes,
                                    size_t initial_capacity)
     : str_count_(0)
-    , str_ids_(initial_capacity, INVALID_STR_ID)
-    , rk_hashes_(initial_capacity)
     , isTemp_(isTemp)
     , materialize_hashes_(materializeHashes)
     , payload_fd_(-1)
@@ -120,13 +121,19 @@ StringDictionary::StringDictionary(const std::string& folder,
     , offset_file_size_(0)
     , payload_file_size_(0)
     , payload_file_off_(0)
+    , inverted_index_str_count_(0)
     , strings_cache_(nullptr) {
+  // initial capacity must be a power of two for efficient bucket computation
+  CHECK_EQ(size_t(0), (initial_capacity & (initial_capacity - 1)));
+  const size_t shard_capacity =
+      std::max(initial_capacity / HASH_SHARD_COUNT, MIN_SHARD_CAPACITY);
+  for (auto& shard : hash_shards_) {
+    shard.table = new StringIdTable(shard_capacity, materialize_hashes_);
+  }
   if (!isTemp && folder.empty()) {
     return;
   }
 
-  // initial capacity must be a power of two for efficient bucket computation
-  CHECK_EQ(size_t(0), (initial_capacity & (initial_capacity - 1)));
   if (!isTemp_) {
     boost::filesystem::path storage_path(folder);
     offsets_path_ = (storage_path / boost::filesystem::path("DictOffsets")).string();
@@ -155,13 +162,13 @@ StringDictionary::StringDictionary(const std::string& folder,
       }
       const uint64_t str_count = bytes / sizeof(StringIdxEntry);
       // at this point we know the size of the StringDict we need to load
-      // so lets reallocate the vector to the correct size
+      // so lets reallocate the shard tables to the correct size
       const uint64_t max_entries = round_up_p2(str_count * 2 + 1);
-      std::vector<int32_t> new_str_ids(max_entries, INVALID_STR_ID);
-      str_ids_.swap(new_str_ids);
-      if (materialize_hashes_) {
-        std::vector<uint32_t> new_rk_hashes(max_entries / 2);
-        rk_hashes_.swap(new_rk_hashes);
+      const size_t recovered_shard_capacity =
+          std::max<size_t>(max_entries / HASH_SHARD_COUNT, shard_capacity);
+      for (auto& shard : hash_shards_) {
+        delete shard.table.load();
+        shard.table = new StringIdTable(recovered_shard_capacity, materialize_hashes_);
       }
       unsigned string_id = 0;
       mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
@@ -210,12 +217,10 @@ void StringDictionary::processDictionaryFutures(
     dictionary_future.wait();
     auto hashVec = dictionary_future.get();
     for (auto& hash : hashVec) {
-      uint32_t bucket = computeUniqueBucketWithHash(hash.first, str_ids_);
       payload_file_off_ += hash.second;
-      str_ids_[bucket] = static_cast<int32_t>(str_count_);
-      if (materialize_hashes_) {
-        rk_hashes_[str_count_] = hash.first;
-      }
+      insertInShard(hash_shards_[getShardIndex(hash.first)],
+                    hash.first,
+                    static_cast<int32_t>(str_count_));
       ++str_count_;
     }
   }
@@ -227,7 +232,20 @@ StringDictionary::StringDictionary(const LeafHostInfo& host, const DictRef dict_
     , client_(new StringDictionaryClient(host, dict_ref, true))
     , client_no_timeout_(new StringDictionaryClient(host, dict_ref, false)) {}
 
+StringDictionary::StringIdTable::StringIdTable(const size_t capacity,
+                                              const bool materialize_hashes)
+    : capacity(capacity)
+    , str_ids(new std::atomic<int32_t>[capacity])
+    , rk_hashes(materialize_hashes ? new uint32_t[capacity] : nullptr) {
+  for (size_t i = 0; i < capacity; ++i) {
+    str_ids[i].store(INVALID_STR_ID, std::memory_order_relaxed);
+  }
+}
+
 StringDictionary::~StringDictionary() noexcept {
+  for (auto& shard : hash_shards_) {
+    delete shard.table.load();
+  }
   if (client_) {
     return;
   }
@@ -289,7 +307,7 @@ void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
     return;
   }
   size_t out_idx{0};
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
 
   for (const auto& str : string_vec) {
     if (str.empty()) {
@@ -297,42 +315,17 @@ void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
       continue;
     }
     CHECK(str.size() <= MAX_STRLEN);
-    uint32_t bucket;
     const uint32_t hash = rk_hash(str);
-    bucket = computeBucket(hash, str, str_ids_, false);
-    if (str_ids_[bucket] != INVALID_STR_ID) {
-      encoded_vec[out_idx++] = str_ids_[bucket];
-      continue;
-    }
-    // need to add record to dictionary
-    // check there is room
-    if (str_count_ == static_cast<size_t>(max_valid_int_value<T>())) {
+    // a new string only gets an id if the id fits in T
+    const auto str_id =
+        getOrAddUnlocked(str, hash, static_cast<size_t>(max_valid_int_value<T>()));
+    if (str_id == INVALID_STR_ID) {
       log_encoding_error<T>(str);
       encoded_vec[out_idx++] = inline_int_null_value<T>();
       continue;
     }
-    if (str_ids_[bucket] == INVALID_STR_ID) {
-      CHECK_LT(str_count_, MAX_STRCOUNT)
-          << "Maximum number (" << str_count_
-          << ") of Dictionary encoded Strings reached for this column, offset path "
-             "for column is  "
-          << offsets_path_;
-      if (fillRateIsHigh()) {
-        // resize when more than 50% is full
-        increaseCapacity();
-        bucket = computeBucket(hash, str, str_ids_, false);
-      }
-      appendToStorage(str);
-
-      str_ids_[bucket] = static_cast<int32_t>(str_count_);
-      if (materialize_hashes_) {
-        rk_hashes_[str_count_] = hash;
-      }
-      ++str_count_;
-    }
-    encoded_vec[out_idx++] = str_ids_[bucket];
+    encoded_vec[out_idx++] = str_id;
   }
-  invalidateInvertedIndex();
 }
 template void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
                                              uint8_t* encoded_vec);
@@ -373,26 +366,25 @@ template void StringDictionary::getOrAddBulkRemote(
     int32_t* encoded_vec);
 
 int32_t StringDictionary::getIdOfString(const std::string& str) const {
-  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
     return client_->get(str);
   }
   return getUnlocked(str);
 }
 
 int32_t StringDictionary::getUnlocked(const std::string& str) const noexcept {
-  const uint32_t hash = rk_hash(str);
-  auto str_id = str_ids_[computeBucket(hash, str, str_ids_, false)];
-  return str_id;
+  return lookupStringId(rk_hash(str), str);
 }
 
 std::string StringDictionary::getString(int32_t string_id) const {
-  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
     std::string ret;
     client_->get_string(ret, string_id);
     return ret;
   }
+  ReaderEpochs::Guard read_guard(reader_epochs_);
   return getStringUnlocked(string_id);
 }
 
@@ -401,18 +393,9 @@ std::string StringDictionary::getStringUnlocked(int32_t string_id) const noexcep
   return getStringChecked(string_id);
 }
 
-std::pair<char*, size_t> StringDictionary::getStringBytes(int32_t string_id) const
-    noexcept {
-  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
-  CHECK(!client_);
-  CHECK_LE(0, string_id);
-  CHECK_LT(string_id, static_cast<int32_t>(str_count_));
-  return getStringBytesChecked(string_id);
-}
-
 size_t StringDictionary::storageEntryCount() const {
-  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
     return client_->storage_entry_count();
   }
   return str_count_;
@@ -453,6 +436,7 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
   if (client_) {
     return client_->get_like(pattern, icase, is_simple, escape, generation);
   }
+  invalidateStaleInvertedIndex();
   const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
   const auto it = like_cache_.find(cache_key);
   if (it != like_cache_.end()) {
@@ -564,6 +548,7 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
   if (client_) {
     return client_->get_compare(pattern, comp_operator, generation);
   }
+  invalidateStaleInvertedIndex();
   std::vector<int32_t> ret;
   if (str_count_ == 0) {
     return ret;
@@ -725,6 +710,7 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   if (client_) {
     return client_->get_regexp_like(pattern, escape, generation);
   }
+  invalidateStaleInvertedIndex();
   const auto cache_key = std::make_pair(pattern, escape);
   const auto it = regex_cache_.find(cache_key);
   if (it != regex_cache_.end()) {
@@ -777,9 +763,10 @@ std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings()
     return strings_cache_;
   }
 
+  const size_t str_count = str_count_;
   strings_cache_ = std::make_shared<std::vector<std::string>>();
-  strings_cache_->reserve(str_count_);
-  const bool multithreaded = str_count_ > 10000;
+  strings_cache_->reserve(str_count);
+  const bool multithreaded = str_count > 10000;
   const auto worker_count =
       multithreaded ? static_cast<size_t>(cpu_threads()) : size_t(1);
   CHECK_GT(worker_count, 0UL);
@@ -795,10 +782,10 @@ std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings()
   };
   if (multithreaded) {
     std::vector<std::future<void>> workers;
-    const auto stride = (str_count_ + (worker_count - 1)) / worker_count;
-    for (size_t worker_idx = 0, start = 0, end = std::min(start + stride, str_count_);
-         worker_idx < worker_count && start < str_count_;
-         ++worker_idx, start += stride, end = std::min(start + stride, str_count_)) {
+    const auto stride = (str_count + (worker_count - 1)) / worker_count;
+    for (size_t worker_idx = 0, start = 0, end = std::min(start + stride, str_count);
+         worker_idx < worker_count && start < str_count;
+         ++worker_idx, start += stride, end = std::min(start + stride, str_count)) {
       workers.push_back(std::async(
           std::launch::async, copy, std::ref(worker_results[worker_idx]), start, end));
     }
@@ -807,7 +794,7 @@ std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings()
     }
   } else {
     CHECK_EQ(worker_results.size(), size_t(1));
-    copy(worker_results[0], 0, str_count_);
+    copy(worker_results[0], 0, str_count);
   }
 
   for (const auto& worker_result : worker_results) {
@@ -817,31 +804,56 @@ std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings()
   return strings_cache_;
 }
 
-bool StringDictionary::fillRateIsHigh() const noexcept {
-  return str_ids_.size() < str_count_ * 2;
+size_t StringDictionary::getShardIndex(const uint32_t hash) noexcept {
+  // the low bits pick the bucket within the shard, mix all of them into the shard index
+  return static_cast<uint32_t>(hash * 0x9E3779B1U) >> (32 - HASH_SHARD_BITS);
 }
 
-void StringDictionary::increaseCapacity() noexcept {
-  std::vector<int32_t> new_str_ids(str_ids_.size() * 2, INVALID_STR_ID);
+bool StringDictionary::fillRateIsHigh(const HashShard& shard) const noexcept {
+  return shard.table.load(std::memory_order_relaxed)->capacity < shard.str_count * 2;
+}
 
-  if (materialize_hashes_) {
-    for (size_t i = 0; i < str_ids_.size(); ++i) {
-      if (str_ids_[i] != INVALID_STR_ID) {
-        const uint32_t hash = rk_hashes_[str_ids_[i]];
-        uint32_t bucket = computeUniqueBucketWithHash(hash, new_str_ids);
-        new_str_ids[bucket] = str_ids_[i];
+void StringDictionary::increaseCapacity(HashShard& shard) noexcept {
+  const auto old_table = shard.table.load(std::memory_order_relaxed);
+  auto new_table = new StringIdTable(old_table->capacity * 2, materialize_hashes_);
+  {
+    // inserts into other shards can remap the storage while we read strings from it
+    ReaderEpochs::Guard read_guard(reader_epochs_);
+    for (size_t i = 0; i < old_table->capacity; ++i) {
+      const auto str_id = old_table->str_ids[i].load(std::memory_order_relaxed);
+      if (str_id == INVALID_STR_ID) {
+        continue;
       }
-    }
-    rk_hashes_.resize(rk_hashes_.size() * 2);
-  } else {
-    for (size_t i = 0; i < str_count_; ++i) {
-      const auto str = getStringChecked(i);
-      const uint32_t hash = rk_hash(str);
-      uint32_t bucket = computeUniqueBucketWithHash(hash, new_str_ids);
-      new_str_ids[bucket] = i;
+      const uint32_t hash = materialize_hashes_ ? old_table->rk_hashes[i]
+                                                : rk_hash(getStringChecked(str_id));
+      const auto bucket = computeUniqueBucketWithHash(hash, *new_table);
+      if (materialize_hashes_) {
+        new_table->rk_hashes[bucket] = hash;
+      }
+      new_table->str_ids[bucket].store(str_id, std::memory_order_relaxed);
     }
   }
-  str_ids_.swap(new_str_ids);
+  shard.table.store(new_table, std::memory_order_release);
+  // wait for the lookups which may still probe the old table
+  reader_epochs_.synchronize();
+  delete old_table;
+}
+
+void StringDictionary::insertInShard(HashShard& shard,
+                                     const uint32_t hash,
+                                     const int32_t str_id) noexcept {
+  if (fillRateIsHigh(shard)) {
+    // resize when more than 50% is full
+    increaseCapacity(shard);
+  }
+  auto table = shard.table.load(std::memory_order_relaxed);
+  const auto bucket = computeUniqueBucketWithHash(hash, *table);
+  if (materialize_hashes_) {
+    table->rk_hashes[bucket] = hash;
+  }
+  // the string is already in the storage, publish it to the lookups
+  table->str_ids[bucket].store(str_id, std::memory_order_release);
+  ++shard.str_count;
 }
 
 int32_t StringDictionary::getOrAddImpl(const std::string& str) noexcept {
@@ -850,39 +862,40 @@ int32_t StringDictionary::getOrAddImpl(const std::string& str) noexcept {
     return inline_int_null_value<int32_t>();
   }
   CHECK(str.size() <= MAX_STRLEN);
-  uint32_t bucket;
   const uint32_t hash = rk_hash(str);
-  {
-    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
-    bucket = computeBucket(hash, str, str_ids_, false);
-    if (str_ids_[bucket] != INVALID_STR_ID) {
-      return str_ids_[bucket];
-    }
+  auto str_id = lookupStringId(hash, str);
+  if (str_id != INVALID_STR_ID) {
+    return str_id;
   }
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
-  // need to recalculate the bucket in case it changed before
-  // we got the lock
-  bucket = computeBucket(hash, str, str_ids_, false);
-  if (str_ids_[bucket] == INVALID_STR_ID) {
-    CHECK_LT(str_count_, MAX_STRCOUNT)
-        << "Maximum number (" << str_count_
-        << ") of Dictionary encoded Strings reached for this column, offset path "
-           "for column is  "
-        << offsets_path_;
-    if (fillRateIsHigh()) {
-      // resize when more than 50% is full
-      increaseCapacity();
-      bucket = computeBucket(hash, str, str_ids_, false);
-    }
-    appendToStorage(str);
-    str_ids_[bucket] = static_cast<int32_t>(str_count_);
-    if (materialize_hashes_) {
-      rk_hashes_[str_count_] = hash;
-    }
-    ++str_count_;
-    invalidateInvertedIndex();
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  str_id = getOrAddUnlocked(str, hash, MAX_STRCOUNT);
+  CHECK_NE(str_id, INVALID_STR_ID)
+      << "Maximum number (" << str_count_
+      << ") of Dictionary encoded Strings reached for this column, offset path "
+         "for column is  "
+      << offsets_path_;
+  return str_id;
+}
+
+int32_t StringDictionary::getOrAddUnlocked(const std::string& str,
+                                           const uint32_t hash,
+                                           const size_t max_str_count) noexcept {
+  auto str_id = lookupStringId(hash, str);
+  if (str_id != INVALID_STR_ID) {
+    return str_id;
+  }
+  auto& shard = hash_shards_[getShardIndex(hash)];
+  std::lock_guard<std::mutex> insert_lock(shard.insert_mutex);
+  // need to look again in case the string was added before we got the lock
+  str_id = lookupStringId(hash, str);
+  if (str_id != INVALID_STR_ID) {
+    return str_id;
+  }
+  str_id = appendToStorage(str, max_str_count);
+  if (str_id != INVALID_STR_ID) {
+    insertInShard(shard, hash, str_id);
   }
-  return str_ids_[bucket];
+  return str_id;
 }
 
 std::string StringDictionary::getStringChecked(const int string_id) const noexcept {
@@ -891,104 +904,91 @@ std::string StringDictionary::getStringChecked(const int string_id) const noexce
   return std::string(str_canary.c_str_ptr, str_canary.size);
 }
 
-std::pair<char*, size_t> StringDictionary::getStringBytesChecked(
-    const int string_id) const noexcept {
-  const auto str_canary = getStringFromStorage(string_id);
-  CHECK(!str_canary.canary);
-  return std::make_pair(str_canary.c_str_ptr, str_canary.size);
-}
-
-uint32_t StringDictionary::computeBucket(const uint32_t hash,
-                                         const std::string str,
-                                         const std::vector<int32_t>& data,
-                                         const bool unique) const noexcept {
-  auto bucket = hash & (data.size() - 1);
+int32_t StringDictionary::lookupStringId(const uint32_t hash,
+                                         const std::string& str) const noexcept {
+  ReaderEpochs::Guard read_guard(reader_epochs_);
+  const auto table =
+      hash_shards_[getShardIndex(hash)].table.load(std::memory_order_acquire);
+  auto bucket = hash & (table->capacity - 1);
   while (true) {
-    if (data[bucket] ==
-        INVALID_STR_ID) {  // In this case it means the slot is available for use
-      break;
+    const auto str_id = table->str_ids[bucket].load(std::memory_order_acquire);
+    if (str_id == INVALID_STR_ID) {  // the string isn't in the dictionary
+      return INVALID_STR_ID;
     }
-    // if records are unique I don't need to do this test as I know it will not be the
-    // same
-    if (!unique) {
-      if (materialize_hashes_) {
-        if (hash == rk_hashes_[data[bucket]]) {
-          // can't be the same string if hash is different
-          const auto old_str = getStringFromStorage(data[bucket]);
-          if (str.size() == old_str.size &&
-              !memcmp(str.c_str(), old_str.c_str_ptr, str.size())) {
-            // found the string
-            break;
-          }
-        }
-      } else {
-        const auto old_str = getStringFromStorage(data[bucket]);
-        if (str.size() == old_str.size &&
-            !memcmp(str.c_str(), old_str.c_str_ptr, str.size())) {
-          // found the string
-          break;
-        }
+    // can't be the same string if hash is different
+    if (!materialize_hashes_ || hash == table->rk_hashes[bucket]) {
+      const auto old_str = getStringFromStorage(str_id);
+      if (str.size() == old_str.size &&
+          !memcmp(str.c_str(), old_str.c_str_ptr, str.size())) {
+        // found the string
+        return str_id;
       }
     }
     // wrap around
-    if (++bucket == data.size()) {
+    if (++bucket == table->capacity) {
       bucket = 0;
     }
   }
-  return bucket;
 }
 
 uint32_t StringDictionary::computeUniqueBucketWithHash(
     const uint32_t hash,
-    const std::vector<int32_t>& data) const noexcept {
-  auto bucket = hash & (data.size() - 1);
+    const StringIdTable& table) const noexcept {
+  auto bucket = hash & (table.capacity - 1);
   while (true) {
-    if (data[bucket] ==
+    if (table.str_ids[bucket].load(std::memory_order_relaxed) ==
         INVALID_STR_ID) {  // In this case it means the slot is available for use
       break;
     }
     // wrap around
-    if (++bucket == data.size()) {
+    if (++bucket == table.capacity) {
       bucket = 0;
     }
   }
   return bucket;
 }
 
-void StringDictionary::appendToStorage(const std::string& str) noexcept {
+int32_t StringDictionary::appendToStorage(const std::string& str,
+                                          const size_t max_str_count) noexcept {
+  std::lock_guard<std::mutex> storage_lock(storage_mutex_);
+  // check there is room
+  if (str_count_ >= max_str_count) {
+    return INVALID_STR_ID;
+  }
   if (!isTemp_) {
     CHECK_GE(payload_fd_, 0);
     CHECK_GE(offset_fd_, 0);
   }
   // write the payload
   if (payload_file_off_ + str.size() > payload_file_size_) {
+    char* old_payload_map = payload_map_;
+    const auto old_payload_file_size = payload_file_size_;
+    addPayloadCapacity();
+    CHECK(payload_file_off_ + str.size() <= payload_file_size_);
     if (!isTemp_) {
-      checked_munmap(payload_map_, payload_file_size_);
-      addPayloadCapacity();
-      CHECK(payload_file_off_ + str.size() <= payload_file_size_);
       payload_map_ =
           reinterpret_cast<char*>(checked_mmap(payload_fd_, payload_file_size_));
-    } else {
-      addPayloadCapacity();
     }
+    releaseStorage(old_payload_map, old_payload_file_size);
   }
-  memcpy(payload_map_ + payload_file_off_, str.c_str(), str.size());
+  memcpy(payload_map_.load() + payload_file_off_, str.c_str(), str.size());
   // write the offset and length
   size_t offset_file_off = str_count_ * sizeof(StringIdxEntry);
   StringIdxEntry str_meta{static_cast<uint64_t>(payload_file_off_), str.size()};
   payload_file_off_ += str.size();
   if (offset_file_off + sizeof(str_meta) >= offset_file_size_) {
+    StringIdxEntry* old_offset_map = offset_map_;
+    const auto old_offset_file_size = offset_file_size_;
+    addOffsetCapacity();
+    CHECK(offset_file_off + sizeof(str_meta) <= offset_file_size_);
     if (!isTemp_) {
-      checked_munmap(offset_map_, offset_file_size_);
-      addOffsetCapacity();
-      CHECK(offset_file_off + sizeof(str_meta) <= offset_file_size_);
       offset_map_ =
           reinterpret_cast<StringIdxEntry*>(checked_mmap(offset_fd_, offset_file_size_));
-    } else {
-      addOffsetCapacity();
     }
+    releaseStorage(old_offset_map, old_offset_file_size);
   }
-  memcpy(offset_map_ + str_count_, &str_meta, sizeof(str_meta));
+  memcpy(offset_map_.load() + str_count_, &str_meta, sizeof(str_meta));
+  return static_cast<int32_t>(str_count_++);
 }
 
 StringDictionary::PayloadString StringDictionary::getStringFromStorage(
@@ -998,12 +998,15 @@ StringDictionary::PayloadString StringDictionary::getStringFromStorage(
     CHECK_GE(offset_fd_, 0);
   }
   CHECK_GE(string_id, 0);
-  const StringIdxEntry* str_meta = offset_map_ + string_id;
+  const StringIdxEntry* str_meta =
+      offset_map_.load(std::memory_order_acquire) + string_id;
   if (str_meta->size == 0xffff) {
     // hit the canary
     return {nullptr, 0, true};
   }
-  return {payload_map_ + str_meta->off, str_meta->size, false};
+  return {payload_map_.load(std::memory_order_acquire) + str_meta->off,
+          str_meta->size,
+          false};
 }
 
 void StringDictionary::addPayloadCapacity() noexcept {
@@ -1043,15 +1046,30 @@ void* StringDictionary::addMemoryCapacity(void* addr, size_t& mem_size) noexcept
     CHECK(CANARY_BUFFER);
     memset(CANARY_BUFFER, 0xff, CANARY_BUFF_SIZE);
   }
-  void* new_addr = realloc(addr, mem_size + CANARY_BUFF_SIZE);
+  // the old buffer can't be realloc'ed away under readers which don't lock, the caller
+  // releases it through releaseStorage
+  void* new_addr = malloc(mem_size + CANARY_BUFF_SIZE);
   CHECK(new_addr);
+  if (addr) {
+    memcpy(new_addr, addr, mem_size);
+  }
   void* write_addr = reinterpret_cast<void*>(static_cast<char*>(new_addr) + mem_size);
   CHECK(memcpy(write_addr, CANARY_BUFFER, CANARY_BUFF_SIZE));
   mem_size += CANARY_BUFF_SIZE;
   return new_addr;
 }
 
-void StringDictionary::invalidateInvertedIndex() noexcept {
+void StringDictionary::releaseStorage(void* addr, const size_t mem_size) noexcept {
+  // wait for the lookups which may still read the old storage
+  reader_epochs_.synchronize();
+  if (!isTemp_) {
+    checked_munmap(addr, mem_size);
+  } else {
+    free(addr);
+  }
+}
+
+void StringDictionary::invalidateInvertedIndex() const noexcept {
   if (!like_cache_.empty()) {
     decltype(like_cache_)().swap(like_cache_);
   }
@@ -1064,6 +1082,15 @@ void StringDictionary::invalidateInvertedIndex() noexcept {
   compare_cache_.invalidateInvertedIndex();
 }
 
+void StringDictionary::invalidateStaleInvertedIndex() const noexcept {
+  // inserts don't touch the caches, drop them here once the dictionary has grown. Called
+  // with rw_mutex_ held exclusively, so no insert is in flight.
+  if (inverted_index_str_count_ != str_count_) {
+    invalidateInvertedIndex();
+    inverted_index_str_count_ = str_count_;
+  }
+}
+
 char* StringDictionary::CANARY_BUFFER{nullptr};
 
 bool StringDictionary::checkpoint() noexcept {
@@ -1075,9 +1102,10 @@ bool StringDictionary::checkpoint() noexcept {
     }
   }
   CHECK(!isTemp_);
+  std::lock_guard<std::mutex> storage_lock(storage_mutex_);
   bool ret = true;
-  ret = ret && (msync((void*)offset_map_, offset_file_size_, MS_SYNC) == 0);
-  ret = ret && (msync((void*)payload_map_, payload_file_size_, MS_SYNC) == 0);
+  ret = ret && (msync((void*)offset_map_.load(), offset_file_size_, MS_SYNC) == 0);
+  ret = ret && (msync((void*)payload_map_.load(), payload_file_size_, MS_SYNC) == 0);
   ret = ret && (fsync(offset_fd_) == 0);
   ret = ret && (fsync(payload_fd_) == 0);
   return ret;
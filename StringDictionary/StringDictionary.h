@@ -20,9 +20,14 @@
 #include "../Shared/mapd_shared_mutex.h"
 #include "DictRef.h"
 #include "DictionaryCache.hpp"
+#include "ReaderEpochs.hpp"
 
+#include <array>
+#include <atomic>
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -38,6 +43,18 @@ class DictPayloadUnavailable : public std::runtime_error {
 
 class LeafHostInfo;
 
+/**
+ * @brief Append-only dictionary of strings to dense ids.
+ *
+ * Lookups of existing strings and ids don't take locks: the hash index is split into
+ * shards which are replaced rather than resized in place, and the storage is remapped
+ * rather than resized in place, with the old versions released through ReaderEpochs once
+ * no reader can see them. Lookups by id therefore return copies of the strings, which
+ * stay valid after the storage moves. Inserts lock the shard of the new string and
+ * append to the storage under a short storage lock. The operations which scan the whole
+ * dictionary and keep caches (LIKE, comparisons, ...) hold rw_mutex_ exclusively, while
+ * inserts hold it shared.
+ */
 class StringDictionary {
  public:
   StringDictionary(const std::string& folder,
@@ -55,7 +72,6 @@ class StringDictionary {
                          std::vector<std::vector<int32_t>>& ids_array_vec);
   int32_t getIdOfString(const std::string& str) const;
   std::string getString(int32_t string_id) const;
-  std::pair<char*, size_t> getStringBytes(int32_t string_id) const noexcept;
   size_t storageEntryCount() const;
 
   std::vector<int32_t> getLike(const std::string& pattern,
@@ -131,31 +147,54 @@ class StringDictionary {
     bool canary;
   };
 
+  // Open addressing table of the ids of the strings which hash to a shard. Its capacity
+  // never changes, a shard gets a new table instead.
+  struct StringIdTable {
+    StringIdTable(const size_t capacity, const bool materialize_hashes);
+
+    const size_t capacity;  // power of two
+    std::unique_ptr<std::atomic<int32_t>[]> str_ids;
+    std::unique_ptr<uint32_t[]> rk_hashes;  // hash of the string in each bucket, optional
+  };
+
+  struct HashShard {
+    std::mutex insert_mutex;
+    std::atomic<StringIdTable*> table{nullptr};
+    size_t str_count{0};  // guarded by insert_mutex
+  };
+
+  static constexpr size_t HASH_SHARD_BITS = 6;
+  static constexpr size_t HASH_SHARD_COUNT = size_t(1) << HASH_SHARD_BITS;
+  static constexpr size_t MIN_SHARD_CAPACITY = 16;
+
   void processDictionaryFutures(
       std::vector<std::future<std::vector<std::pair<uint32_t, unsigned int>>>>&
           dictionary_futures);
-  bool fillRateIsHigh() const noexcept;
-  void increaseCapacity() noexcept;
+  static size_t getShardIndex(const uint32_t hash) noexcept;
+  bool fillRateIsHigh(const HashShard& shard) const noexcept;
+  void increaseCapacity(HashShard& shard) noexcept;
+  void insertInShard(HashShard& shard, const uint32_t hash, const int32_t str_id) noexcept;
   int32_t getOrAddImpl(const std::string& str) noexcept;
+  int32_t getOrAddUnlocked(const std::string& str,
+                           const uint32_t hash,
+                           const size_t max_str_count) noexcept;
   template <class T>
   void getOrAddBulkRemote(const std::vector<std::string>& string_vec, T* encoded_vec);
   int32_t getUnlocked(const std::string& str) const noexcept;
   std::string getStringUnlocked(int32_t string_id) const noexcept;
   std::string getStringChecked(const int string_id) const noexcept;
-  std::pair<char*, size_t> getStringBytesChecked(const int string_id) const noexcept;
-  uint32_t computeBucket(const uint32_t hash,
-                         const std::string str,
-                         const std::vector<int32_t>& data,
-                         const bool unique) const noexcept;
+  int32_t lookupStringId(const uint32_t hash, const std::string& str) const noexcept;
   uint32_t computeUniqueBucketWithHash(const uint32_t hash,
-                                       const std::vector<int32_t>& data) const noexcept;
-  void appendToStorage(const std::string& str) noexcept;
+                                       const StringIdTable& table) const noexcept;
+  int32_t appendToStorage(const std::string& str, const size_t max_str_count) noexcept;
   PayloadString getStringFromStorage(const int string_id) const noexcept;
   void addPayloadCapacity() noexcept;
   void addOffsetCapacity() noexcept;
   size_t addStorageCapacity(int fd) noexcept;
   void* addMemoryCapacity(void* addr, size_t& mem_size) noexcept;
-  void invalidateInvertedIndex() noexcept;
+  void releaseStorage(void* addr, const size_t mem_size) noexcept;
+  void invalidateInvertedIndex() const noexcept;
+  void invalidateStaleInvertedIndex() const noexcept;
   std::vector<int32_t> getEquals(std::string pattern,
                                  std::string comp_operator,
                                  size_t generation);
@@ -165,21 +204,23 @@ class StringDictionary {
   void mergeSortedCache(std::vector<int32_t>& temp_sorted_cache);
   compare_cache_value_t* binary_search_cache(const std::string& pattern) const;
 
-  size_t str_count_;
-  std::vector<int32_t> str_ids_;
-  std::vector<uint32_t> rk_hashes_;
+  std::atomic<size_t> str_count_;
+  std::array<HashShard, HASH_SHARD_COUNT> hash_shards_;
   std::vector<int32_t> sorted_cache;
   bool isTemp_;
   bool materialize_hashes_;
   std::string offsets_path_;
   int payload_fd_;
   int offset_fd_;
-  StringIdxEntry* offset_map_;
-  char* payload_map_;
-  size_t offset_file_size_;
-  size_t payload_file_size_;
-  size_t payload_file_off_;
+  std::atomic<StringIdxEntry*> offset_map_;
+  std::atomic<char*> payload_map_;
+  size_t offset_file_size_;   // guarded by storage_mutex_
+  size_t payload_file_size_;  // guarded by storage_mutex_
+  size_t payload_file_off_;   // guarded by storage_mutex_
+  std::mutex storage_mutex_;
+  mutable ReaderEpochs reader_epochs_;
   mutable mapd_shared_mutex rw_mutex_;
+  mutable size_t inverted_index_str_count_;  // dictionary size the caches were built for
   mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>>
       like_cache_;
   mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
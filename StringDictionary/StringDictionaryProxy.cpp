@@ -208,7 +208,19 @@ int32_t StringDictionaryProxy::getOrAdd(const std::string& str) noexcept {
 
 std::pair<char*, size_t> StringDictionaryProxy::getStringBytes(int32_t string_id) const
     noexcept {
-  return string_dict_.get()->getStringBytes(string_id);
+  CHECK_LE(0, string_id);
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    const auto it = string_bytes_.find(string_id);
+    if (it != string_bytes_.end()) {
+      return std::make_pair(const_cast<char*>(it->second.data()), it->second.size());
+    }
+  }
+  auto str = string_dict_->getString(string_id);
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  // the nodes of the map don't move, neither do the strings in them
+  const auto& stored_str = string_bytes_.emplace(string_id, std::move(str)).first->second;
+  return std::make_pair(const_cast<char*>(stored_str.data()), stored_str.size());
 }
 
 size_t StringDictionaryProxy::storageEntryCount() const {
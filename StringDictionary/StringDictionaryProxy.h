@@ -23,6 +23,7 @@
 #include <map>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 // used to access a StringDictionary when transient strings are involved
@@ -38,6 +39,7 @@ class StringDictionaryProxy {
   int32_t getIdOfStringNoGeneration(
       const std::string& str) const;  // disregard generation, only used by QueryRenderer
   std::string getString(int32_t string_id) const;
+  // The bytes are owned by the proxy and stay valid for its lifetime.
   std::pair<char*, size_t> getStringBytes(int32_t string_id) const noexcept;
   size_t storageEntryCount() const;
   void updateGeneration(const ssize_t generation) noexcept;
@@ -60,6 +62,8 @@ class StringDictionaryProxy {
   std::shared_ptr<StringDictionary> string_dict_;
   std::map<int32_t, std::string> transient_int_to_str_;
   std::map<std::string, int32_t> transient_str_to_int_;
+  // copies of the strings handed out by getStringBytes, the dictionary storage can move
+  mutable std::unordered_map<int32_t, std::string> string_bytes_;
   ssize_t generation_;
   mutable mapd_shared_mutex rw_mutex_;
 };
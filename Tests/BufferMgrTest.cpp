@@ -0,0 +1,351 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
+#include "DataMgr/BufferMgr/EvictionPolicy.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+
+using namespace Buffer_Namespace;
+
+namespace {
+
+BufferSeg make_seg(const ChunkKey& key, const unsigned int last_touched = 0) {
+  BufferSeg seg(0, 1, USED, last_touched);
+  seg.chunk_key = key;
+  return seg;
+}
+
+// Stands for the file manager, fills every chunk with the last component of its key. A
+// read of the blocked key waits until unblock() is called.
+class FakeParentMgr : public Data_Namespace::AbstractBufferMgr {
+ public:
+  FakeParentMgr() : AbstractBufferMgr(0) {}
+
+  void block(const ChunkKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    blocked_key_ = key;
+  }
+
+  void unblock() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      blocked_key_.clear();
+    }
+    cv_.notify_all();
+  }
+
+  void waitForBlockedFetch() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return fetch_counts_.count(blocked_key_); });
+  }
+
+  size_t getFetchCount(const ChunkKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = fetch_counts_.find(key);
+    return it == fetch_counts_.end() ? 0 : it->second;
+  }
+
+  void fetchBuffer(const ChunkKey& key,
+                   Data_Namespace::AbstractBuffer* dest_buffer,
+                   const size_t num_bytes) override {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ++fetch_counts_[key];
+      cv_.notify_all();
+      cv_.wait(lock, [this, &key] { return blocked_key_ != key; });
+    }
+    dest_buffer->reserve(num_bytes);
+    std::fill(dest_buffer->getMemoryPtr(),
+              dest_buffer->getMemoryPtr() + num_bytes,
+              static_cast<int8_t>(key.back()));
+    dest_buffer->setSize(num_bytes);
+  }
+
+  Data_Namespace::AbstractBuffer* createBuffer(const ChunkKey&,
+                                               const size_t,
+                                               const size_t) override {
+    CHECK(false);
+    return nullptr;
+  }
+  void deleteBuffer(const ChunkKey&, const bool) override { CHECK(false); }
+  void deleteBuffersWithPrefix(const ChunkKey&, const bool) override { CHECK(false); }
+  Data_Namespace::AbstractBuffer* getBuffer(const ChunkKey&, const size_t) override {
+    CHECK(false);
+    return nullptr;
+  }
+  Data_Namespace::AbstractBuffer* putBuffer(const ChunkKey&,
+                                            Data_Namespace::AbstractBuffer*,
+                                            const size_t) override {
+    CHECK(false);
+    return nullptr;
+  }
+  void getChunkMetadataVec(std::vector<std::pair<ChunkKey, ChunkMetadata>>&) override {}
+  void getChunkMetadataVecForKeyPrefix(std::vector<std::pair<ChunkKey, ChunkMetadata>>&,
+                                       const ChunkKey&) override {}
+  bool isBufferOnDevice(const ChunkKey&) override { return true; }
+  std::string printSlabs() override { return ""; }
+  void clearSlabs() override {}
+  size_t getMaxSize() override { return 0; }
+  size_t getInUseSize() override { return 0; }
+  size_t getAllocated() override { return 0; }
+  bool isAllocationCapped() override { return false; }
+  void checkpoint() override {}
+  void checkpoint(const int, const int) override {}
+  Data_Namespace::AbstractBuffer* alloc(const size_t) override {
+    CHECK(false);
+    return nullptr;
+  }
+  void free(Data_Namespace::AbstractBuffer*) override { CHECK(false); }
+  MgrType getMgrType() override { return FILE_MGR; }
+  std::string getStringMgrType() override { return ToString(FILE_MGR); }
+  size_t getNumChunks() override { return 0; }
+
+ private:
+  ChunkKey blocked_key_;
+  std::map<ChunkKey, size_t> fetch_counts_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+constexpr size_t g_chunk_bytes{4096};
+
+std::unique_ptr<CpuBufferMgr> make_cpu_buffer_mgr(FakeParentMgr* parent_mgr) {
+  return std::make_unique<CpuBufferMgr>(0, 1 << 20, nullptr, 1 << 20, 512, parent_mgr);
+}
+
+}  // namespace
+
+TEST(Prefetch, LoadsUnpinnedChunk) {
+  FakeParentMgr parent_mgr;
+  auto buffer_mgr = make_cpu_buffer_mgr(&parent_mgr);
+  const ChunkKey key{1, 1, 1, 7};
+  ASSERT_TRUE(buffer_mgr->prefetchBuffer(key, g_chunk_bytes, 1.0));
+  ASSERT_TRUE(buffer_mgr->isBufferOnDevice(key));
+  // already resident
+  ASSERT_FALSE(buffer_mgr->prefetchBuffer(key, g_chunk_bytes, 1.0));
+  auto buffer = buffer_mgr->getBuffer(key, g_chunk_bytes);
+  EXPECT_EQ(1, buffer->getPinCount());
+  EXPECT_EQ(g_chunk_bytes, buffer->size());
+  EXPECT_EQ(int8_t(7), buffer->getMemoryPtr()[g_chunk_bytes - 1]);
+  buffer->unPin();
+  EXPECT_EQ(size_t(1), parent_mgr.getFetchCount(key));
+}
+
+TEST(Prefetch, DeclinesPastFillFraction) {
+  FakeParentMgr parent_mgr;
+  auto buffer_mgr = make_cpu_buffer_mgr(&parent_mgr);
+  // room for one chunk
+  const double max_fill_fraction = 1.5 * g_chunk_bytes / buffer_mgr->getMaxSize();
+  ASSERT_TRUE(buffer_mgr->prefetchBuffer({1, 1, 1, 0}, g_chunk_bytes, max_fill_fraction));
+  ASSERT_FALSE(
+      buffer_mgr->prefetchBuffer({1, 1, 1, 1}, g_chunk_bytes, max_fill_fraction));
+  ASSERT_FALSE(buffer_mgr->isBufferOnDevice({1, 1, 1, 1}));
+}
+
+TEST(Prefetch, DoesNotBlockOtherChunks) {
+  FakeParentMgr parent_mgr;
+  auto buffer_mgr = make_cpu_buffer_mgr(&parent_mgr);
+  const ChunkKey prefetched{1, 1, 1, 0};
+  const ChunkKey other{1, 1, 1, 1};
+  parent_mgr.block(prefetched);
+  auto prefetch = std::async(std::launch::async, [&] {
+    return buffer_mgr->prefetchBuffer(prefetched, g_chunk_bytes, 1.0);
+  });
+  parent_mgr.waitForBlockedFetch();
+  // the prefetch is reading from the parent, a query gets another chunk meanwhile
+  auto get_other = std::async(std::launch::async, [&] {
+    auto buffer = buffer_mgr->getBuffer(other, g_chunk_bytes);
+    buffer->unPin();
+  });
+  EXPECT_EQ(std::future_status::ready, get_other.wait_for(std::chrono::seconds(30)));
+  parent_mgr.unblock();
+  EXPECT_TRUE(prefetch.get());
+}
+
+TEST(Prefetch, GetBufferWaitsForPrefetch) {
+  FakeParentMgr parent_mgr;
+  auto buffer_mgr = make_cpu_buffer_mgr(&parent_mgr);
+  const ChunkKey key{1, 1, 1, 3};
+  parent_mgr.block(key);
+  auto prefetch = std::async(std::launch::async, [&] {
+    return buffer_mgr->prefetchBuffer(key, g_chunk_bytes, 1.0);
+  });
+  parent_mgr.waitForBlockedFetch();
+  auto get = std::async(std::launch::async, [&] {
+    auto buffer = buffer_mgr->getBuffer(key, g_chunk_bytes);
+    const auto last_byte = buffer->getMemoryPtr()[g_chunk_bytes - 1];
+    const auto size = buffer->size();
+    buffer->unPin();
+    return std::make_pair(size, last_byte);
+  });
+  // the chunk is in the pool but not loaded yet
+  EXPECT_EQ(std::future_status::timeout, get.wait_for(std::chrono::milliseconds(100)));
+  parent_mgr.unblock();
+  EXPECT_TRUE(prefetch.get());
+  const auto size_and_last_byte = get.get();
+  EXPECT_EQ(g_chunk_bytes, size_and_last_byte.first);
+  EXPECT_EQ(int8_t(3), size_and_last_byte.second);
+  // the chunk was read once, by the prefetch
+  EXPECT_EQ(size_t(1), parent_mgr.getFetchCount(key));
+}
+
+TEST(Prefetch, WaitingRequestDoesNotBlockOthers) {
+  FakeParentMgr parent_mgr;
+  auto buffer_mgr = make_cpu_buffer_mgr(&parent_mgr);
+  const ChunkKey prefetched{1, 1, 1, 4};
+  const ChunkKey other{1, 1, 1, 5};
+  parent_mgr.block(prefetched);
+  auto prefetch = std::async(std::launch::async, [&] {
+    return buffer_mgr->prefetchBuffer(prefetched, g_chunk_bytes, 1.0);
+  });
+  parent_mgr.waitForBlockedFetch();
+  auto get_prefetched = std::async(std::launch::async, [&] {
+    auto buffer = buffer_mgr->getBuffer(prefetched, g_chunk_bytes);
+    buffer->unPin();
+  });
+  EXPECT_EQ(std::future_status::timeout,
+            get_prefetched.wait_for(std::chrono::milliseconds(100)));
+  // the request waiting for the prefetch doesn't hold the global lock
+  auto get_other = std::async(std::launch::async, [&] {
+    auto buffer = buffer_mgr->getBuffer(other, g_chunk_bytes);
+    buffer->unPin();
+    return buffer_mgr->isFilledPast(1.0);
+  });
+  EXPECT_EQ(std::future_status::ready, get_other.wait_for(std::chrono::seconds(30)));
+  parent_mgr.unblock();
+  EXPECT_TRUE(prefetch.get());
+  get_prefetched.get();
+  EXPECT_FALSE(get_other.get());
+  EXPECT_EQ(size_t(1), parent_mgr.getFetchCount(prefetched));
+}
+
+TEST(BufferGrowth, PinnedReaderKeepsOldMemory) {
+  FakeParentMgr parent_mgr;
+  auto buffer_mgr = make_cpu_buffer_mgr(&parent_mgr);
+  const ChunkKey key{1, 1, 1, 8};
+  auto reader = buffer_mgr->getBuffer(key, g_chunk_bytes);
+  const auto old_mem = reader->getMemoryPtr();
+  // the next chunk keeps the segment from growing in place
+  buffer_mgr->getBuffer({1, 1, 1, 9}, g_chunk_bytes)->unPin();
+  auto grown = buffer_mgr->getBuffer(key, 2 * g_chunk_bytes);
+  ASSERT_EQ(reader, grown);
+  EXPECT_NE(old_mem, grown->getMemoryPtr());
+  EXPECT_EQ(int8_t(8), grown->getMemoryPtr()[2 * g_chunk_bytes - 1]);
+  grown->unPin();
+  // the old segment isn't handed out while the reader still pins the buffer
+  auto other = buffer_mgr->getBuffer({1, 1, 1, 10}, g_chunk_bytes);
+  EXPECT_NE(old_mem, other->getMemoryPtr());
+  EXPECT_EQ(int8_t(8), old_mem[g_chunk_bytes - 1]);
+  other->unPin();
+  reader->unPin();
+  auto reused = buffer_mgr->getBuffer({1, 1, 1, 11}, g_chunk_bytes);
+  EXPECT_EQ(old_mem, reused->getMemoryPtr());
+  reused->unPin();
+}
+
+TEST(EvictionPolicy, Lru) {
+  LruEvictionPolicy policy;
+  EXPECT_LT(policy.getEvictionScore(make_seg({1, 1, 1, 0}, 3)),
+            policy.getEvictionScore(make_seg({1, 1, 1, 1}, 7)));
+}
+
+TEST(EvictionPolicy, LruKScanResistance) {
+  LruKEvictionPolicy policy(2);
+  const ChunkKey hot{1, 1, 1, 0};
+  policy.recordAccess(hot, false);
+  policy.recordAccess(hot, true);
+  // A scan touches a lot of chunks exactly once, after the hot chunk was last used
+  std::vector<ChunkKey> scanned;
+  for (int frag_id = 1; frag_id < 10; ++frag_id) {
+    scanned.push_back({1, 2, 1, frag_id});
+    policy.recordAccess(scanned.back(), false);
+  }
+  const auto hot_score = policy.getEvictionScore(make_seg(hot));
+  for (const auto& key : scanned) {
+    EXPECT_LT(policy.getEvictionScore(make_seg(key)), hot_score);
+  }
+  // Among chunks without a full history, the least recently used goes first
+  EXPECT_LT(policy.getEvictionScore(make_seg(scanned.front())),
+            policy.getEvictionScore(make_seg(scanned.back())));
+
+  const auto stats = policy.getStats();
+  EXPECT_EQ(size_t(1), stats.num_hits);
+  EXPECT_EQ(size_t(10), stats.num_misses);
+  EXPECT_EQ(size_t(0), stats.num_evictions);
+}
+
+TEST(EvictionPolicy, LruKHistorySurvivesEviction) {
+  LruKEvictionPolicy policy(2, 1);
+  const ChunkKey hot{1, 1, 1, 0};
+  const ChunkKey cold{1, 1, 1, 1};
+  policy.recordAccess(hot, false);
+  policy.recordAccess(hot, true);
+  policy.recordEviction(hot);
+  policy.recordAccess(cold, false);
+  policy.recordAccess(hot, false);
+  EXPECT_LT(policy.getEvictionScore(make_seg(cold)),
+            policy.getEvictionScore(make_seg(hot)));
+
+  // Only one retired key is remembered
+  policy.recordEviction(cold);
+  policy.recordEviction(hot);
+  policy.recordAccess(cold, false);
+  EXPECT_EQ(size_t(3), policy.getStats().num_evictions);
+  policy.forgetKeysWithPrefix({1, 1});
+  EXPECT_EQ(size_t(0), policy.getEvictionScore(make_seg(cold)));
+  EXPECT_EQ(size_t(0), policy.getEvictionScore(make_seg(hot)));
+}
+
+TEST(EvictionPolicy, LruKTemporaryBuffersLast) {
+  LruKEvictionPolicy policy(2);
+  const ChunkKey hot{1, 1, 1, 0};
+  policy.recordAccess(hot, false);
+  policy.recordAccess(hot, true);
+  // the buffer epoch of the segment is far behind the clock of the policy
+  EXPECT_LT(policy.getEvictionScore(make_seg(hot)),
+            policy.getEvictionScore(make_seg({-1, 3}, 0)));
+  EXPECT_LT(policy.getEvictionScore(make_seg(hot, 1000)),
+            policy.getEvictionScore(make_seg({-1, 3}, 0)));
+}
+
+TEST(EvictionPolicy, Factory) {
+  EXPECT_EQ("lru", create_eviction_policy("lru")->getName());
+  EXPECT_EQ("lru-2", create_eviction_policy("lru-k")->getName());
+  EXPECT_THROW(create_eviction_policy("mru"), std::runtime_error);
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
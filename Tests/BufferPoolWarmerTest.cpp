@@ -0,0 +1,172 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include "DataMgr/BufferPoolWarmer.h"
+#include "DataMgr/DataMgr.h"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using namespace Data_Namespace;
+
+namespace {
+
+constexpr size_t g_chunk_bytes{4096};
+constexpr int g_db_id{1};
+constexpr int g_table_id{1};
+
+ChunkKey make_key(const int frag_id) {
+  return {g_db_id, g_table_id, 1, frag_id};
+}
+
+class BufferPoolWarmerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    data_path_ = std::string(BASE_PATH) + "/buffer_pool_warmer_test";
+    boost::filesystem::remove_all(data_path_);
+    boost::filesystem::create_directories(data_path_);
+    chunks_path_ = data_path_ + "/buffer_pool_chunks";
+    start();
+  }
+
+  void TearDown() override {
+    stop();
+    boost::filesystem::remove_all(data_path_);
+  }
+
+  void start(const double max_pool_fill = 1.0) {
+    MapDParameters mapd_parameters;
+    mapd_parameters.cpu_buffer_mem_bytes = 1 << 26;
+    data_mgr_ = std::make_unique<DataMgr>(data_path_, mapd_parameters, false, 0);
+    // unthrottled and saving at shutdown only
+    warmer_ = std::make_unique<BufferPoolWarmer>(
+        *data_mgr_, chunks_path_, 0, 0, max_pool_fill);
+    warmer_->waitUntilLoaded();
+  }
+
+  // The warmer goes first, it records the chunks at shutdown.
+  void stop() {
+    warmer_.reset();
+    data_mgr_.reset();
+  }
+
+  void restart(const double max_pool_fill = 1.0) {
+    stop();
+    start(max_pool_fill);
+  }
+
+  // Writes the chunk to disk, every byte set to the fragment id.
+  void writeChunk(const int frag_id) {
+    auto buffer =
+        data_mgr_->createChunkBuffer(make_key(frag_id), MemoryLevel::DISK_LEVEL);
+    std::vector<int8_t> data(g_chunk_bytes, static_cast<int8_t>(frag_id));
+    buffer->append(data.data(), data.size());
+  }
+
+  void loadChunk(const int frag_id) {
+    auto buffer = data_mgr_->getChunkBuffer(
+        make_key(frag_id), MemoryLevel::CPU_LEVEL, 0, g_chunk_bytes);
+    buffer->unPin();
+  }
+
+  bool isResident(const int frag_id) {
+    return data_mgr_->isBufferOnDevice(make_key(frag_id), MemoryLevel::CPU_LEVEL, 0);
+  }
+
+  std::string data_path_;
+  std::string chunks_path_;
+  std::unique_ptr<DataMgr> data_mgr_;
+  std::unique_ptr<BufferPoolWarmer> warmer_;
+};
+
+}  // namespace
+
+TEST_F(BufferPoolWarmerTest, ReloadsRecordedChunks) {
+  for (int frag_id = 0; frag_id < 3; ++frag_id) {
+    writeChunk(frag_id);
+  }
+  data_mgr_->checkpoint(g_db_id, g_table_id);
+  loadChunk(0);
+  loadChunk(2);
+  loadChunk(2);
+  restart();
+  EXPECT_TRUE(isResident(0));
+  EXPECT_FALSE(isResident(1));
+  EXPECT_TRUE(isResident(2));
+  auto buffer = data_mgr_->getChunkBuffer(make_key(2), MemoryLevel::CPU_LEVEL, 0, 0);
+  EXPECT_EQ(g_chunk_bytes, buffer->size());
+  EXPECT_EQ(int8_t(2), buffer->getMemoryPtr()[g_chunk_bytes - 1]);
+  buffer->unPin();
+}
+
+TEST_F(BufferPoolWarmerTest, SkipsMissingChunks) {
+  writeChunk(0);
+  data_mgr_->checkpoint(g_db_id, g_table_id);
+  stop();
+  {
+    std::ofstream out(chunks_path_, std::ios::trunc);
+    out << "not a chunk\n";
+    // a device this server doesn't have
+    out << "2 0 1 4096 1,1,1,0\n";
+    // a dropped table and a dropped fragment
+    out << "1 0 1 4096 1,2,1,0\n";
+    out << "1 0 1 4096 1,1,1,5\n";
+    out << "1 0 1 4096 1,1,1,0\n";
+  }
+  start();
+  EXPECT_TRUE(isResident(0));
+  EXPECT_FALSE(isResident(5));
+  EXPECT_FALSE(data_mgr_->isBufferOnDevice({1, 2, 1, 0}, MemoryLevel::CPU_LEVEL, 0));
+}
+
+TEST_F(BufferPoolWarmerTest, StopsAtMaxPoolFill) {
+  writeChunk(0);
+  data_mgr_->checkpoint(g_db_id, g_table_id);
+  loadChunk(0);
+  restart(0.0);
+  EXPECT_FALSE(isResident(0));
+}
+
+TEST_F(BufferPoolWarmerTest, RecordsAtShutdown) {
+  EXPECT_FALSE(boost::filesystem::exists(chunks_path_));
+  restart();
+  // the pools were empty
+  EXPECT_TRUE(boost::filesystem::exists(chunks_path_));
+  EXPECT_EQ(uintmax_t(0), boost::filesystem::file_size(chunks_path_));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Calcite/Calcite.h"
+#include "../QueryRunner/QueryRunner.h"
+#include "TestHelpers.h"
+#include "ThriftHandler/QueryState.h"
+#include "gen-cpp/CalciteServer.h"
+
+#include <gtest/gtest.h>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+std::shared_ptr<Calcite> g_calcite;
+
+void run_ddl_statement(const std::string& query_str) {
+  QR::get()->runDDLStatement(query_str);
+}
+
+TPlanResult get_plan(const std::string& query_str) {
+  auto query_state = QR::create_query_state(QR::get()->getSession(), query_str);
+  return g_calcite->process(query_state->createQueryStateProxy(),
+                            query_state->getQueryStr(),
+                            {},
+                            true,
+                            false,
+                            false);
+}
+
+class PlanCache : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    run_ddl_statement("DROP TABLE IF EXISTS plan_cache_test;");
+    run_ddl_statement("CREATE TABLE plan_cache_test (x INT, y INT);");
+    g_calcite->setPlanCacheSize(16);
+  }
+
+  void TearDown() override {
+    g_calcite->setPlanCacheSize(0);
+    run_ddl_statement("DROP TABLE IF EXISTS plan_cache_test;");
+  }
+};
+
+}  // namespace
+
+TEST_F(PlanCache, Hit) {
+  const auto plan = get_plan("SELECT x FROM plan_cache_test WHERE y > 1;");
+  auto hits = g_calcite->getPlanCacheHitCount();
+  EXPECT_EQ(plan.plan_result,
+            get_plan("SELECT x FROM plan_cache_test WHERE y > 1;").plan_result);
+  EXPECT_EQ(hits + 1, g_calcite->getPlanCacheHitCount());
+  // the whitespace outside of quotes doesn't matter
+  EXPECT_EQ(plan.plan_result,
+            get_plan("SELECT  x\nFROM plan_cache_test\tWHERE y > 1;").plan_result);
+  EXPECT_EQ(hits + 2, g_calcite->getPlanCacheHitCount());
+  hits = g_calcite->getPlanCacheHitCount();
+  // other literals, other plan
+  EXPECT_NE(plan.plan_result,
+            get_plan("SELECT x FROM plan_cache_test WHERE y > 2;").plan_result);
+  EXPECT_EQ(hits, g_calcite->getPlanCacheHitCount());
+}
+
+TEST_F(PlanCache, NotCached) {
+  for (const auto& query_str :
+       {"SELECT x FROM plan_cache_test WHERE y > EXTRACT(DAY FROM NOW());",
+        "SELECT x FROM plan_cache_test -- comment\n;"}) {
+    get_plan(query_str);
+    const auto hits = g_calcite->getPlanCacheHitCount();
+    get_plan(query_str);
+    EXPECT_EQ(hits, g_calcite->getPlanCacheHitCount()) << query_str;
+  }
+}
+
+TEST_F(PlanCache, ClearedByDDL) {
+  const std::string query_str{"SELECT * FROM plan_cache_test;"};
+  const auto plan = get_plan(query_str);
+  EXPECT_EQ(std::string::npos, plan.plan_result.find("\"z\""));
+  run_ddl_statement("ALTER TABLE plan_cache_test ADD COLUMN z INT;");
+  const auto hits = g_calcite->getPlanCacheHitCount();
+  const auto new_plan = get_plan(query_str);
+  EXPECT_EQ(hits, g_calcite->getPlanCacheHitCount());
+  EXPECT_NE(std::string::npos, new_plan.plan_result.find("\"z\""));
+  // the new plan is cached in turn
+  EXPECT_EQ(new_plan.plan_result, get_plan(query_str).plan_result);
+  EXPECT_EQ(hits + 1, g_calcite->getPlanCacheHitCount());
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+  g_calcite = QR::get()->getCatalog()->getCalciteMgr();
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  g_calcite.reset();
+  QR::reset();
+  return err;
+}
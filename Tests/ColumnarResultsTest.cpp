@@ -21,10 +21,13 @@
 #include "ResultSetTestUtils.h"
 #include "Shared/Logger.h"
 #include "Shared/TargetInfo.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 #include <gtest/gtest.h>
 
+extern bool g_enable_direct_columnarization;
+
 class ColumnarResultsTester : public ColumnarResults {
  public:
   ColumnarResultsTester(const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
@@ -828,6 +831,26 @@ TEST(BaselineHashColumnar, TwoCol_32_32_MixedAggs_w_avg) {
   }
 }
 
+TEST(Iteration, ParallelKeepsRowOrder) {
+  const auto enable_direct_columnarization = g_enable_direct_columnarization;
+  ScopeGuard reset_direct_columnarization = [enable_direct_columnarization] {
+    g_enable_direct_columnarization = enable_direct_columnarization;
+  };
+  g_enable_direct_columnarization = false;
+  std::vector<int8_t> key_column_widths{8};
+  const int8_t suggested_agg_width = 8;
+  std::vector<TargetInfo> target_infos = generate_custom_agg_target_infos(
+      key_column_widths,
+      {kSUM, kMIN, kMAX},
+      {kBIGINT, kDOUBLE, kINT},
+      {kBIGINT, kDOUBLE, kINT});
+  auto query_mem_desc =
+      perfect_hash_one_col_desc(target_infos, suggested_agg_width, 0, 30000);
+  for (auto step_size : {1, 3, 67}) {
+    test_columnar_conversion(target_infos, query_mem_desc, step_size, true);
+  }
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
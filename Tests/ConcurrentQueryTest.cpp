@@ -0,0 +1,235 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../LockMgr/LockMgr.h"
+#include "../QueryEngine/Execute.h"
+#include "../QueryRunner/QueryRunner.h"
+#include "Shared/measure.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+const size_t g_table_doublings{17};  // 10 * 2^17 rows, several fragments
+
+const std::vector<std::string> g_queries{
+    "SELECT COUNT(*) FROM concurrent_test WHERE x > 3;",
+    "SELECT SUM(y) FROM concurrent_test WHERE x < 7;",
+    "SELECT COUNT(DISTINCT y) FROM concurrent_test;",
+    "SELECT MAX(x * y) FROM concurrent_test WHERE y <> 40;",
+    "SELECT COUNT(*) FROM (SELECT x, COUNT(*) AS n FROM concurrent_test GROUP BY x) "
+    "WHERE n > 10;"};
+
+void run_ddl_statement(const std::string& query_str) {
+  QR::get()->runDDLStatement(query_str);
+}
+
+int64_t run_scalar_query(const std::string& query_str) {
+  const auto rows = QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, false);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  auto scalar_r = boost::get<ScalarTargetValue>(&crt_row[0]);
+  CHECK(scalar_r);
+  auto p = boost::get<int64_t>(scalar_r);
+  CHECK(p);
+  return *p;
+}
+
+// Runs num_sessions threads, each going through the query list runs_per_session times,
+// checks the results against the expected ones and returns the number of queries
+// completed per second.
+double run_sessions(const size_t num_sessions,
+                    const size_t runs_per_session,
+                    const std::vector<int64_t>& expected) {
+  std::vector<std::future<std::vector<int64_t>>> sessions;
+  std::vector<std::vector<int64_t>> session_results;
+  const auto elapsed_ms = measure<>::execution([&]() {
+    for (size_t session = 0; session < num_sessions; ++session) {
+      sessions.push_back(std::async(std::launch::async, [runs_per_session] {
+        std::vector<int64_t> results;
+        for (size_t run = 0; run < runs_per_session; ++run) {
+          for (const auto& query : g_queries) {
+            results.push_back(run_scalar_query(query));
+          }
+        }
+        return results;
+      }));
+    }
+    for (auto& session : sessions) {
+      session_results.push_back(session.get());
+    }
+  });
+  // gtest assertions only fail the test from the main thread
+  for (const auto& results : session_results) {
+    EXPECT_EQ(runs_per_session * g_queries.size(), results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+      const auto query_idx = i % g_queries.size();
+      EXPECT_EQ(expected[query_idx], results[i]) << g_queries[query_idx];
+    }
+  }
+  const auto num_queries = num_sessions * runs_per_session * g_queries.size();
+  return num_queries / (std::max(elapsed_ms, int64_t(1)) / 1000.);
+}
+
+class ConcurrentQueries : public ::testing::Test {
+ protected:
+  void SetUp() override { saved_max_concurrent_queries_ = g_max_concurrent_queries; }
+
+  void TearDown() override { g_max_concurrent_queries = saved_max_concurrent_queries_; }
+
+  std::vector<int64_t> serialResults() const {
+    std::vector<int64_t> results;
+    for (const auto& query : g_queries) {
+      results.push_back(run_scalar_query(query));
+    }
+    return results;
+  }
+
+ private:
+  size_t saved_max_concurrent_queries_;
+};
+
+}  // namespace
+
+TEST_F(ConcurrentQueries, SameResultsAsSerial) {
+  g_max_concurrent_queries = 1;
+  const auto expected = serialResults();
+  g_max_concurrent_queries = 4;
+  run_sessions(8, 3, expected);
+}
+
+TEST_F(ConcurrentQueries, Throughput) {
+  g_max_concurrent_queries = 1;
+  const auto expected = serialResults();
+  for (const size_t num_sessions : {1, 2, 4, 8}) {
+    g_max_concurrent_queries = num_sessions;
+    // warm the code caches of the executors
+    run_sessions(num_sessions, 1, expected);
+    const auto queries_per_sec = run_sessions(num_sessions, 10, expected);
+    std::cout << num_sessions << " sessions: " << queries_per_sec << " queries/s"
+              << std::endl;
+    if (HasFailure()) {
+      return;
+    }
+  }
+}
+
+TEST_F(ConcurrentQueries, NestedLease) {
+  g_max_concurrent_queries = 1;
+  const auto db_id = QR::get()->getCatalog()->getCurrentDB().dbId;
+  auto outer_lease = Executor::leaseExecutor(db_id);
+  // the only lease is held by this thread, waiting for it would never return
+  auto inner_lease = Executor::leaseExecutor(db_id);
+  ASSERT_NE(outer_lease->get(), inner_lease->get());
+  inner_lease.reset();
+  outer_lease.reset();
+  // the limit applies again to the next lease
+  auto leased_on_other_thread = std::async(std::launch::async, [db_id] {
+    return Executor::leaseExecutor(db_id) != nullptr;
+  });
+  ASSERT_TRUE(leased_on_other_thread.get());
+}
+
+TEST_F(ConcurrentQueries, InsertWhileSelecting) {
+  // Takes the read ExecutorOuterLock the way MapDHandler::sql_execute_impl does for both
+  // the SELECTs and the INSERTs, which grow the chunks the SELECTs are reading.
+  using namespace Lock_Namespace;
+  const size_t num_inserts{200};
+  g_max_concurrent_queries = 4;
+  run_ddl_statement("DROP TABLE IF EXISTS concurrent_insert_test;");
+  run_ddl_statement(
+      "CREATE TABLE concurrent_insert_test (x INT, y BIGINT) WITH (fragment_size=64);");
+  auto outer_mutex = LockMgr<mapd_shared_mutex, bool>::getMutex(ExecutorOuterLock, true);
+  std::atomic<bool> done{false};
+  auto inserts = std::async(std::launch::async, [&] {
+    for (size_t i = 0; i < num_inserts; ++i) {
+      mapd_shared_lock<mapd_shared_mutex> read_lock(*outer_mutex);
+      QR::get()->runSQL("INSERT INTO concurrent_insert_test VALUES(" +
+                            std::to_string(i) + ", " + std::to_string(i * 10) + ");",
+                        ExecutorDeviceType::CPU);
+    }
+    done = true;
+  });
+  std::vector<std::future<std::vector<int64_t>>> sessions;
+  for (size_t session = 0; session < 4; ++session) {
+    sessions.push_back(std::async(std::launch::async, [&done, outer_mutex] {
+      std::vector<int64_t> counts;
+      for (size_t run = 0; run < 1000 && !done; ++run) {
+        mapd_shared_lock<mapd_shared_mutex> read_lock(*outer_mutex);
+        // the count, if the rows seen are exactly x = 0 .. count - 1 with y = 10 * x
+        counts.push_back(run_scalar_query(
+            "SELECT CASE WHEN COALESCE(SUM(x), 0) = COUNT(*) * (COUNT(*) - 1) / 2 AND "
+            "COALESCE(SUM(y), 0) = 10 * COALESCE(SUM(x), 0) THEN COUNT(*) ELSE -1 END "
+            "FROM concurrent_insert_test;"));
+      }
+      return counts;
+    }));
+  }
+  inserts.get();
+  for (auto& session : sessions) {
+    int64_t prev_count{0};
+    for (const auto count : session.get()) {
+      EXPECT_LE(prev_count, count);
+      EXPECT_GE(static_cast<int64_t>(num_inserts), count);
+      prev_count = count;
+    }
+  }
+  EXPECT_EQ(static_cast<int64_t>(num_inserts),
+            run_scalar_query("SELECT COUNT(*) FROM concurrent_insert_test;"));
+  run_ddl_statement("DROP TABLE IF EXISTS concurrent_insert_test;");
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    run_ddl_statement("DROP TABLE IF EXISTS concurrent_test;");
+    run_ddl_statement(
+        "CREATE TABLE concurrent_test (x INT, y BIGINT) WITH (fragment_size=65536);");
+    for (int i = 0; i < 10; ++i) {
+      QR::get()->runSQL("INSERT INTO concurrent_test VALUES(" + std::to_string(i) + ", " +
+                            std::to_string(i * 10) + ");",
+                        ExecutorDeviceType::CPU);
+    }
+    for (size_t i = 0; i < g_table_doublings; ++i) {
+      run_ddl_statement("INSERT INTO concurrent_test SELECT * FROM concurrent_test;");
+    }
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  run_ddl_statement("DROP TABLE IF EXISTS concurrent_test;");
+  QR::reset();
+  return err;
+}
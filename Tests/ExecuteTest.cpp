@@ -19,6 +19,7 @@
 #include "../Import/Importer.h"
 #include "../Parser/parser.h"
 #include "../QueryEngine/ArrowResultSet.h"
+#include "../QueryEngine/ArrowUtil.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
 #include "../QueryEngine/ResultSetReductionJIT.h"
@@ -30,7 +31,12 @@
 #include "ClusterTester.h"
 #include "DistributedLoader.h"
 
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/api.h>
 #include <gtest/gtest.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/any.hpp>
 #include <boost/program_options.hpp>
@@ -47,6 +53,7 @@ bool g_aggregator{false};
 
 extern int g_test_against_columnId_gap;
 extern bool g_enable_smem_group_by;
+extern bool g_enable_tagged_baseline_hash;
 extern bool g_allow_cpu_retry;
 extern bool g_enable_watchdog;
 extern bool g_skip_intermediate_count;
@@ -57,6 +64,7 @@ extern double g_gpu_mem_limit_percent;
 
 extern bool g_enable_window_functions;
 extern bool g_enable_bump_allocator;
+extern bool g_enable_chunk_bloom_filters;
 
 extern size_t g_leaf_count;
 
@@ -475,6 +483,58 @@ void c_arrow(const std::string& query_string, const ExecutorDeviceType device_ty
   g_sqlite_comparator.compare_arrow_output(query_string, query_string, device_type);
 }
 
+std::shared_ptr<arrow::Buffer> attach_shm(const std::vector<char>& handle,
+                                          const int64_t size,
+                                          std::vector<void*>& shm_ptrs) {
+  CHECK_EQ(sizeof(key_t), handle.size());
+  key_t key;
+  memcpy(&key, handle.data(), sizeof(key_t));
+  const auto shmid = shmget(key, size, 0666);
+  CHECK_NE(-1, shmid);
+  const auto shm_ptr = shmat(shmid, NULL, 0);
+  CHECK_NE(reinterpret_cast<int64_t>(shm_ptr), -1);
+  shm_ptrs.push_back(shm_ptr);
+  // the segments are removed once the last attachment goes away
+  shmctl(shmid, IPC_RMID, 0);
+  return std::make_shared<arrow::Buffer>(static_cast<const uint8_t*>(shm_ptr), size);
+}
+
+// Reads back all the record batches of a CPU data frame, the way a client which opted
+// into several record batches reads them. The arrays point into the shared memory
+// segments, which stay attached at shm_ptrs.
+std::vector<std::shared_ptr<arrow::RecordBatch>> get_arrow_record_batches(
+    const std::shared_ptr<ResultSet>& rows,
+    const size_t record_batch_rows,
+    std::vector<void*>& shm_ptrs) {
+  std::vector<std::string> col_names;
+  for (size_t i = 0; i < rows->colCount(); ++i) {
+    col_names.push_back("col_" + std::to_string(i));
+  }
+  ArrowResultSetConverter converter(
+      rows, nullptr, ExecutorDeviceType::CPU, 0, col_names, -1, record_batch_rows);
+  const auto arrow_result = converter.getArrowResult();
+  arrow::io::BufferReader schema_reader(
+      attach_shm(arrow_result.sm_handle, arrow_result.sm_size, shm_ptrs));
+  std::shared_ptr<arrow::Schema> schema;
+  ARROW_THROW_NOT_OK(arrow::ipc::ReadSchema(&schema_reader, &schema));
+  std::vector<std::shared_ptr<arrow::RecordBatch>> record_batches;
+  if (!arrow_result.df_size) {
+    return record_batches;
+  }
+  arrow::io::BufferReader records_reader(
+      attach_shm(arrow_result.df_handle, arrow_result.df_size, shm_ptrs));
+  int64_t position{0};
+  ARROW_THROW_NOT_OK(records_reader.Tell(&position));
+  while (position < arrow_result.df_size) {
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    ARROW_THROW_NOT_OK(
+        arrow::ipc::ReadRecordBatch(schema, &records_reader, &record_batch));
+    record_batches.push_back(record_batch);
+    ARROW_THROW_NOT_OK(records_reader.Tell(&position));
+  }
+  return record_batches;
+}
+
 }  // namespace
 
 #define SKIP_NO_GPU()                                        \
@@ -1379,6 +1439,123 @@ TEST(Select, AggregateOnEmptyTable) {
   }
 }
 
+TEST(Select, RunLengthAndDiffEncoding) {
+  run_ddl_statement("DROP TABLE IF EXISTS rl_diff_test;");
+  g_sqlite_comparator.query("DROP TABLE IF EXISTS rl_diff_test;");
+  run_ddl_statement(
+      "CREATE TABLE rl_diff_test (status SMALLINT ENCODING RL, flag BOOLEAN ENCODING "
+      "RL, ts TIMESTAMP ENCODING DIFF(16), id INT ENCODING DIFF(8), amount BIGINT "
+      "ENCODING DIFF(32), total BIGINT ENCODING RL) WITH (fragment_size=7);");
+  g_sqlite_comparator.query(
+      "CREATE TABLE rl_diff_test (status SMALLINT, flag BOOLEAN, ts TIMESTAMP(0), id "
+      "INT, amount BIGINT, total BIGINT);");
+  for (int i = 0; i < 20; ++i) {
+    const std::string status = i % 5 == 4 ? "NULL" : std::to_string(i / 3);
+    const std::string id = i % 7 == 6 ? "NULL" : std::to_string(1000 + i);
+    const std::string insert_query =
+        "INSERT INTO rl_diff_test VALUES(" + status + ", " +
+        (i < 12 ? "'t'" : "'f'") + ", '2019-06-01 12:" + std::to_string(10 + i) +
+        ":00', " + id + ", " + std::to_string(5000000000 - 100000 * i) + ", " +
+        std::to_string(3000000000LL * (i / 4)) + ");";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*), COUNT(status), MIN(status), MAX(status), SUM(status) FROM "
+      "rl_diff_test;",
+      dt);
+    c("SELECT COUNT(id), MIN(id), MAX(id), SUM(id), MIN(amount), MAX(amount) FROM "
+      "rl_diff_test;",
+      dt);
+    c("SELECT status, COUNT(*) FROM rl_diff_test GROUP BY status ORDER BY status;", dt);
+    c("SELECT flag, SUM(amount) FROM rl_diff_test GROUP BY flag ORDER BY flag;", dt);
+    c("SELECT id, status FROM rl_diff_test WHERE id > 1005 AND status IS NOT NULL "
+      "ORDER BY id;",
+      dt);
+    c("SELECT COUNT(*) FROM rl_diff_test WHERE ts > '2019-06-01 12:20:00';", dt);
+    c("SELECT id FROM rl_diff_test WHERE id IS NULL;", dt);
+    c("SELECT total, COUNT(*), MIN(status) FROM rl_diff_test GROUP BY total ORDER BY "
+      "total;",
+      dt);
+  }
+  EXPECT_THROW(run_ddl_statement("CREATE TABLE rl_diff_bad (x INT ENCODING DIFF(32));"),
+               std::runtime_error);
+  EXPECT_THROW(run_ddl_statement("CREATE TABLE rl_diff_bad (x TEXT ENCODING RL);"),
+               std::runtime_error);
+  EXPECT_THROW(
+      run_multiple_agg("INSERT INTO rl_diff_test VALUES(1, 't', '2019-06-01 12:00:00', "
+                       "1000000, 0, 0);",
+                       ExecutorDeviceType::CPU),
+      std::runtime_error);
+  run_ddl_statement("DROP TABLE rl_diff_test;");
+  g_sqlite_comparator.query("DROP TABLE rl_diff_test;");
+}
+
+TEST(Select, ChunkBloomFilters) {
+  const auto save_bloom_filters = g_enable_chunk_bloom_filters;
+  ScopeGuard reset_bloom_filters = [save_bloom_filters] {
+    g_enable_chunk_bloom_filters = save_bloom_filters;
+  };
+  g_enable_chunk_bloom_filters = true;
+  run_ddl_statement("DROP TABLE IF EXISTS bloom_test;");
+  g_sqlite_comparator.query("DROP TABLE IF EXISTS bloom_test;");
+  run_ddl_statement(
+      "CREATE TABLE bloom_test (x INT, y BIGINT ENCODING FIXED(16), d DATE, str TEXT "
+      "ENCODING DICT) WITH (fragment_size=8);");
+  g_sqlite_comparator.query(
+      "CREATE TABLE bloom_test (x INT, y BIGINT, d DATE, str TEXT);");
+  for (int i = 0; i < 40; ++i) {
+    // every fragment spans most of the value range, min / max can't skip any of them
+    const auto x = i % 8 == 7 ? std::string("NULL") : std::to_string((i * 37) % 101);
+    const std::string insert_query =
+        "INSERT INTO bloom_test VALUES(" + x + ", " + std::to_string(1000 - 3 * i) +
+        ", '2019-0" + std::to_string(1 + i % 9) + "-1" + std::to_string(i % 5) +
+        "', 'str" + std::to_string((i * 7) % 23) + "');";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM bloom_test WHERE x = 74;", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE x = 75;", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE x IN (1, 2, 3, 74);", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE x = 2 OR x = 3;", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE y = 901 OR y = 904;", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE d = '2019-03-12';", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE str = 'str14';", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE str = 'str15';", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE str IN ('str3', 'str99');", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE str = 'not_there';", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE x = 74 AND str = 'str14';", dt);
+  }
+  // 5 fragments of 8 rows: 74 is only in the first one, 75 in none and 'str15' in the
+  // second and the last one
+  const auto skipped_fragments = [](const std::string& query_str) {
+    const auto skipped_before = Executor::getBloomFilterSkippedFragmentCount();
+    run_multiple_agg(query_str, ExecutorDeviceType::CPU);
+    return Executor::getBloomFilterSkippedFragmentCount() - skipped_before;
+  };
+  EXPECT_EQ(size_t(4),
+            skipped_fragments("SELECT COUNT(*) FROM bloom_test WHERE x = 74;"));
+  EXPECT_EQ(size_t(5),
+            skipped_fragments("SELECT COUNT(*) FROM bloom_test WHERE x = 75;"));
+  EXPECT_EQ(size_t(3),
+            skipped_fragments("SELECT COUNT(*) FROM bloom_test WHERE str = 'str15';"));
+  EXPECT_EQ(size_t(0),
+            skipped_fragments("SELECT COUNT(*) FROM bloom_test WHERE x > 74;"));
+  // the updated values aren't in the bloom filters anymore
+  run_multiple_agg("UPDATE bloom_test SET x = 75 WHERE x = 74;", ExecutorDeviceType::CPU);
+  g_sqlite_comparator.query("UPDATE bloom_test SET x = 75 WHERE x = 74;");
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM bloom_test WHERE x = 75;", dt);
+    c("SELECT COUNT(*) FROM bloom_test WHERE x IN (74, 75);", dt);
+  }
+  run_ddl_statement("DROP TABLE bloom_test;");
+  g_sqlite_comparator.query("DROP TABLE bloom_test;");
+}
+
 TEST(Select, LimitAndOffset) {
   CHECK(g_num_rows >= 4);
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
@@ -1576,6 +1753,91 @@ TEST(Select, GroupBy) {
   }
 }
 
+TEST(Select, ExternalAggregation) {
+  const auto save_external_aggregation = g_enable_external_aggregation;
+  const auto save_threshold = g_external_aggregation_threshold;
+  const auto save_partitions = g_external_aggregation_partitions;
+  ScopeGuard reset_external_aggregation =
+      [save_external_aggregation, save_threshold, save_partitions] {
+        g_enable_external_aggregation = save_external_aggregation;
+        g_external_aggregation_threshold = save_threshold;
+        g_external_aggregation_partitions = save_partitions;
+      };
+  g_enable_external_aggregation = true;
+  g_external_aggregation_threshold = 0;
+  g_external_aggregation_partitions = 4;
+  c("SELECT x, y, COUNT(*) FROM test GROUP BY x, y ORDER BY x, y;",
+    ExecutorDeviceType::CPU);
+  c("SELECT w, SUM(t), MIN(f), MAX(d) FROM test GROUP BY w ORDER BY w;",
+    ExecutorDeviceType::CPU);
+  c("SELECT ofd, COUNT(*) FROM test GROUP BY ofd;", ExecutorDeviceType::CPU);
+  c("SELECT str, AVG(y), COUNT(*) FROM test GROUP BY str ORDER BY str;",
+    ExecutorDeviceType::CPU);
+  c("SELECT null_str, SUM(x) FROM test GROUP BY null_str;", ExecutorDeviceType::CPU);
+  c("SELECT COUNT(*) FROM (SELECT y, z FROM test GROUP BY y, z);",
+    ExecutorDeviceType::CPU);
+  // passes without groups
+  c("SELECT x, COUNT(*) FROM test WHERE x = 7 GROUP BY x;", ExecutorDeviceType::CPU);
+  c("SELECT x, COUNT(*) FROM test WHERE x < 0 GROUP BY x;", ExecutorDeviceType::CPU);
+}
+
+TEST(Select, VectorizedFilter) {
+  const auto save_vectorized_cpu_codegen = g_enable_vectorized_cpu_codegen;
+  ScopeGuard reset_vectorized_cpu_codegen = [save_vectorized_cpu_codegen] {
+    g_enable_vectorized_cpu_codegen = save_vectorized_cpu_codegen;
+  };
+  g_enable_vectorized_cpu_codegen = true;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT COUNT(*) FROM test WHERE x > 7;", dt);
+  c("SELECT COUNT(*), SUM(y), MIN(t), MAX(f) FROM test WHERE x = 8 AND y < 43;", dt);
+  c("SELECT SUM(x), AVG(d) FROM test WHERE z > 100 OR NOT (t < 1001);", dt);
+  c("SELECT COUNT(*) FROM test WHERE ofd IS NULL;", dt);
+  c("SELECT COUNT(*) FROM test WHERE f > 1.0 AND d <= 2.6;", dt);
+  c("SELECT COUNT(*) FROM test WHERE dd > 100.0 AND b;", dt);
+  ASSERT_EQ(2 * g_num_rows,
+            v<int64_t>(run_simple_agg(
+                "SELECT COUNT(*) FROM test WHERE m > timestamp(0) '2014-12-13T000000';",
+                dt)));
+  // mixes batchable quals with quals the row function evaluates
+  c("SELECT SUM(y) FROM test WHERE x > 7 AND str = 'foo';", dt);
+  c("SELECT COUNT(*) FROM test WHERE x + y > 49 AND y < 43;", dt);
+  c("SELECT COUNT(DISTINCT y) FROM test WHERE x <> 8;", dt);
+  c("SELECT COUNT(*) FROM test WHERE x > 100;", dt);
+}
+
+TEST(Select, TaggedBaselineHash) {
+  const auto save_tagged_baseline_hash = g_enable_tagged_baseline_hash;
+  ScopeGuard reset_tagged_baseline_hash = [save_tagged_baseline_hash] {
+    g_enable_tagged_baseline_hash = save_tagged_baseline_hash;
+  };
+  g_enable_tagged_baseline_hash = true;
+  // floating point keys rule out the perfect hash layout
+  for (const auto& query :
+       {"SELECT x, d, COUNT(*) FROM test GROUP BY x, d;",
+        "SELECT str, f, SUM(y) FROM test GROUP BY str, f;",
+        "SELECT d, ofd, MAX(z) FROM test GROUP BY d, ofd;"}) {
+    const auto rows = run_multiple_agg(query, ExecutorDeviceType::CPU);
+    EXPECT_EQ(QueryDescriptionType::GroupByBaselineHash,
+              rows->getQueryMemDesc().getQueryDescriptionType())
+        << query;
+    EXPECT_TRUE(rows->getQueryMemDesc().hasHashTags()) << query;
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT x, d, COUNT(*) FROM test GROUP BY x, d ORDER BY x, d;", dt);
+    c("SELECT str, f, SUM(y) FROM test GROUP BY str, f ORDER BY str, f;", dt);
+    c("SELECT d, ofd, MAX(z) FROM test GROUP BY d, ofd ORDER BY d, ofd NULLS FIRST;",
+      dt);
+    c("SELECT x, dd, COUNT(*) FROM test GROUP BY x, dd ORDER BY x, dd;", dt);
+    c("SELECT x + 1 AS k0, x + y AS k1, SUM(z) FROM test GROUP BY k0, k1 ORDER BY k0, "
+      "k1;",
+      dt);
+    c("SELECT str, dd, MAX(f), AVG(y) FROM test GROUP BY str, dd ORDER BY str, dd;", dt);
+    c("SELECT y, ofd, COUNT(*) FROM test GROUP BY y, ofd ORDER BY y, ofd NULLS FIRST;",
+      dt);
+  }
+}
+
 TEST(Select, FilterAndGroupBy) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -1874,6 +2136,26 @@ TEST(Select, CountDistinct) {
   }
 }
 
+TEST(Select, CountDistinctSparseSets) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto save_count_distinct_hash_set = g_enable_count_distinct_hash_set;
+  ScopeGuard reset_count_distinct_hash_set = [save_count_distinct_hash_set] {
+    g_enable_count_distinct_hash_set = save_count_distinct_hash_set;
+  };
+  for (const bool enable_hash_set : {false, true}) {
+    g_enable_count_distinct_hash_set = enable_hash_set;
+    const auto dt = ExecutorDeviceType::CPU;
+    c("SELECT COUNT(distinct f) FROM test;", dt);
+    c("SELECT COUNT(distinct d) FROM test;", dt);
+    c("SELECT z, str, COUNT(distinct f) FROM test GROUP BY z, str ORDER BY str DESC;",
+      dt);
+    c("SELECT y, COUNT(distinct d), COUNT(distinct x) FROM test GROUP BY y ORDER BY y;",
+      dt);
+    c("SELECT COUNT(distinct f) AS n, COUNT(*) FROM test GROUP BY x ORDER BY n;", dt);
+  }
+}
+
 TEST(Select, ApproxCountDistinct) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -1987,6 +2269,92 @@ TEST(Select, ApproxCountDistinct) {
   }
 }
 
+TEST(Select, ApproxPercentile) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    // the digests keep every value of the small test table
+    ASSERT_EQ(7.0, v<double>(run_simple_agg("SELECT APPROX_MEDIAN(x) FROM test;", dt)));
+    ASSERT_EQ(
+        8.0,
+        v<double>(run_simple_agg("SELECT APPROX_PERCENTILE(x, 0.9) FROM test;", dt)));
+    ASSERT_EQ(-78.0,
+              v<double>(run_simple_agg("SELECT APPROX_PERCENTILE(z, 0) FROM test;", dt)));
+    ASSERT_EQ(102.0,
+              v<double>(run_simple_agg("SELECT APPROX_PERCENTILE(z, 1) FROM test;", dt)));
+    ASSERT_NEAR(2.3,
+                v<double>(run_simple_agg("SELECT APPROX_MEDIAN(d) FROM test;", dt)),
+                static_cast<double>(0.01));
+    ASSERT_NEAR(166.65,
+                v<double>(run_simple_agg("SELECT APPROX_MEDIAN(dd) FROM test;", dt)),
+                static_cast<double>(0.01));
+    c("SELECT APPROX_MEDIAN(x) FROM test_empty;", "SELECT AVG(x) FROM test_empty;", dt);
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT y, APPROX_MEDIAN(z) AS m, APPROX_PERCENTILE(z, 0.9) FROM test GROUP BY "
+          "y ORDER BY m;",
+          dt);
+      ASSERT_EQ(size_t(2), rows->rowCount());
+      auto crt_row = rows->getNextRow(true, true);
+      ASSERT_EQ(43, v<int64_t>(crt_row[0]));
+      ASSERT_NEAR(12, v<double>(crt_row[1]), static_cast<double>(0.01));
+      ASSERT_NEAR(102, v<double>(crt_row[2]), static_cast<double>(0.01));
+      crt_row = rows->getNextRow(true, true);
+      ASSERT_EQ(42, v<int64_t>(crt_row[0]));
+      ASSERT_NEAR(101, v<double>(crt_row[1]), static_cast<double>(0.01));
+      ASSERT_NEAR(101, v<double>(crt_row[2]), static_cast<double>(0.01));
+    }
+    EXPECT_THROW(run_multiple_agg("SELECT APPROX_PERCENTILE(x, 2) FROM test;", dt),
+                 std::runtime_error);
+  }
+}
+
+TEST(Select, ApproxPercentileManyValues) {
+  run_ddl_statement("DROP TABLE IF EXISTS approx_percentile_test;");
+  run_ddl_statement(
+      "CREATE TABLE approx_percentile_test (g INT, v DOUBLE) WITH (fragment_size=1000);");
+  // 4096 rows in 5 fragments, the values 0 .. 4095 and g the parity of the value. Each
+  // group has 2048 values, the digests get compressed many times over.
+  for (int i = 0; i < 16; ++i) {
+    run_multiple_agg("INSERT INTO approx_percentile_test VALUES(" +
+                         std::to_string(i % 2) + ", " + std::to_string(i) + ");",
+                     ExecutorDeviceType::CPU);
+  }
+  for (int row_count = 16; row_count < 4096; row_count *= 2) {
+    run_ddl_statement("INSERT INTO approx_percentile_test SELECT g, v + " +
+                      std::to_string(row_count) + " FROM approx_percentile_test;");
+  }
+  // fraction of the squared values of group g which aren't greater than value
+  const auto rank = [](const int g, const double value) {
+    int count{0};
+    for (int x = g; x < 4096; x += 2) {
+      count += static_cast<double>(x) * x <= value;
+    }
+    return count / 2048.;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    const auto rows = run_multiple_agg(
+        "SELECT g, APPROX_PERCENTILE(v * v, 0.1), APPROX_MEDIAN(v * v) AS m, "
+        "APPROX_PERCENTILE(v * v, 0.99) FROM approx_percentile_test GROUP BY g ORDER BY "
+        "m DESC;",
+        dt);
+    ASSERT_EQ(size_t(2), rows->rowCount());
+    for (const int g : {1, 0}) {
+      const auto crt_row = rows->getNextRow(true, true);
+      ASSERT_EQ(g, v<int64_t>(crt_row[0]));
+      EXPECT_NEAR(0.1, rank(g, v<double>(crt_row[1])), 0.01);
+      EXPECT_NEAR(0.5, rank(g, v<double>(crt_row[2])), 0.01);
+      EXPECT_NEAR(0.99, rank(g, v<double>(crt_row[3])), 0.005);
+    }
+    // the digests of the fragments merged into one
+    EXPECT_NEAR(2047.5,
+                v<double>(run_simple_agg(
+                    "SELECT APPROX_MEDIAN(v) FROM approx_percentile_test;", dt)),
+                41.);
+  }
+  run_ddl_statement("DROP TABLE approx_percentile_test;");
+}
+
 TEST(Select, ScanNoAggregation) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -8133,6 +8501,45 @@ TEST(Select, ArrowOutput) {
   }
 }
 
+TEST(Select, ArrowRecordBatches) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  std::vector<void*> shm_ptrs;
+  ScopeGuard detach_shm = [&shm_ptrs] {
+    for (const auto shm_ptr : shm_ptrs) {
+      shmdt(shm_ptr);
+    }
+  };
+  const auto check_record_batches = [&shm_ptrs](const std::string& query,
+                                                 const size_t record_batch_rows) {
+    const auto rows =
+        QR::get()->runSQL(query, ExecutorDeviceType::CPU, g_hoist_literals, true);
+    const auto row_count = rows->rowCount();
+    ASSERT_GT(row_count, record_batch_rows);
+    // clients which didn't opt into several record batches read a single one
+    const auto single_batch = get_arrow_record_batches(rows, 0, shm_ptrs);
+    ASSERT_EQ(size_t(1), single_batch.size());
+    ASSERT_EQ(row_count, static_cast<size_t>(single_batch.front()->num_rows()));
+    const auto record_batches =
+        get_arrow_record_batches(rows, record_batch_rows, shm_ptrs);
+    ASSERT_EQ((row_count + record_batch_rows - 1) / record_batch_rows,
+              record_batches.size());
+    int64_t offset{0};
+    for (const auto& record_batch : record_batches) {
+      ASSERT_LE(static_cast<size_t>(record_batch->num_rows()), record_batch_rows);
+      ASSERT_TRUE(
+          single_batch.front()->Slice(offset, record_batch->num_rows())->Equals(
+              *record_batch));
+      offset += record_batch->num_rows();
+    }
+    ASSERT_EQ(row_count, static_cast<size_t>(offset));
+  };
+  check_record_batches("SELECT x, y, str FROM test ORDER BY x ASC, y ASC;", 3);
+  // the later batches carry validity bitmaps the first one doesn't have, so they
+  // outgrow the segment sized from the first one
+  check_record_batches("SELECT x, fn FROM test ORDER BY fn ASC NULLS LAST;", 4);
+}
+
 TEST(Select, WatchdogTest) {
   const auto watchdog_state = g_enable_watchdog;
   g_enable_watchdog = true;
@@ -13065,6 +13472,88 @@ TEST(Join, BuildHashTable) {
   }
 }
 
+TEST(Join, AppendToInnerTable) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto dt = ExecutorDeviceType::CPU;
+  run_ddl_statement("DROP TABLE IF EXISTS join_append_outer;");
+  run_ddl_statement("DROP TABLE IF EXISTS join_append_inner;");
+  ScopeGuard drop_tables = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS join_append_outer;");
+    run_ddl_statement("DROP TABLE IF EXISTS join_append_inner;");
+  };
+  run_ddl_statement("CREATE TABLE join_append_outer (x INT);");
+  run_ddl_statement(
+      "CREATE TABLE join_append_inner (x INT, y INT) WITH (fragment_size=2);");
+  for (int i = 1; i <= 6; ++i) {
+    run_multiple_agg("INSERT INTO join_append_outer VALUES(" + std::to_string(i) + ");",
+                     dt);
+  }
+  const std::string query{
+      "SELECT COUNT(*), SUM(join_append_inner.y) FROM join_append_outer, "
+      "join_append_inner WHERE join_append_outer.x = join_append_inner.x;"};
+  const auto check = [&query, dt](const int64_t expected_count,
+                                  const int64_t expected_sum) {
+    const auto rows = run_multiple_agg(query, dt);
+    const auto crt_row = rows->getNextRow(true, true);
+    ASSERT_EQ(size_t(2), crt_row.size());
+    ASSERT_EQ(expected_count, v<int64_t>(crt_row[0]));
+    ASSERT_EQ(expected_sum, v<int64_t>(crt_row[1]));
+  };
+  // keep the range of x the same, the cached table gets extended with the new rows
+  run_multiple_agg("INSERT INTO join_append_inner VALUES(1, 10);", dt);
+  run_multiple_agg("INSERT INTO join_append_inner VALUES(6, 60);", dt);
+  check(2, 70);
+  run_multiple_agg("INSERT INTO join_append_inner VALUES(3, 30);", dt);
+  check(3, 100);
+  run_multiple_agg("INSERT INTO join_append_inner VALUES(4, 40);", dt);
+  check(4, 140);
+  // a duplicate key needs a one to many table
+  run_multiple_agg("INSERT INTO join_append_inner VALUES(4, 41);", dt);
+  check(5, 181);
+}
+
+TEST(Join, TruncateAndReloadInnerTable) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto dt = ExecutorDeviceType::CPU;
+  run_ddl_statement("DROP TABLE IF EXISTS join_reload_outer;");
+  run_ddl_statement("DROP TABLE IF EXISTS join_reload_inner;");
+  ScopeGuard drop_tables = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS join_reload_outer;");
+    run_ddl_statement("DROP TABLE IF EXISTS join_reload_inner;");
+  };
+  run_ddl_statement("CREATE TABLE join_reload_outer (x INT);");
+  run_ddl_statement(
+      "CREATE TABLE join_reload_inner (x INT, y INT) WITH (fragment_size=2);");
+  for (int i = 1; i <= 6; ++i) {
+    run_multiple_agg("INSERT INTO join_reload_outer VALUES(" + std::to_string(i) + ");",
+                     dt);
+  }
+  const std::string query{
+      "SELECT COUNT(*), SUM(join_reload_inner.y) FROM join_reload_outer, "
+      "join_reload_inner WHERE join_reload_outer.x = join_reload_inner.x;"};
+  const auto check = [&query, dt](const int64_t expected_count,
+                                  const int64_t expected_sum) {
+    const auto rows = run_multiple_agg(query, dt);
+    const auto crt_row = rows->getNextRow(true, true);
+    ASSERT_EQ(size_t(2), crt_row.size());
+    ASSERT_EQ(expected_count, v<int64_t>(crt_row[0]));
+    ASSERT_EQ(expected_sum, v<int64_t>(crt_row[1]));
+  };
+  run_multiple_agg("INSERT INTO join_reload_inner VALUES(1, 10);", dt);
+  run_multiple_agg("INSERT INTO join_reload_inner VALUES(6, 60);", dt);
+  check(2, 70);
+  run_ddl_statement("TRUNCATE TABLE join_reload_inner;");
+  // reload more rows over the same range, the epoch gets past the one of the cached
+  // table, which must not be extended
+  run_multiple_agg("INSERT INTO join_reload_inner VALUES(6, 61);", dt);
+  run_multiple_agg("INSERT INTO join_reload_inner VALUES(1, 11);", dt);
+  run_multiple_agg("INSERT INTO join_reload_inner VALUES(2, 21);", dt);
+  run_multiple_agg("INSERT INTO join_reload_inner VALUES(5, 51);", dt);
+  check(4, 144);
+}
+
 TEST(Join, ComplexQueries) {
   SKIP_ALL_ON_AGGREGATOR();
 
@@ -15788,6 +16277,24 @@ TEST(Select, WindowFunctionSum) {
   c(query + " NULLS FIRST;", query + ";", dt);
 }
 
+TEST(Select, WindowFunctionRowsFrame) {
+  SKIP_ALL_ON_AGGREGATOR();
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  c("SELECT t, SUM(x) OVER (PARTITION BY y ORDER BY t ASC ROWS BETWEEN 1 PRECEDING AND "
+    "1 FOLLOWING) s, COUNT(x) OVER (PARTITION BY y ORDER BY t ASC ROWS BETWEEN 2 "
+    "PRECEDING AND CURRENT ROW) c, MIN(x) OVER (PARTITION BY y ORDER BY t ASC ROWS "
+    "BETWEEN CURRENT ROW AND 2 FOLLOWING) m1, MAX(x) OVER (PARTITION BY y ORDER BY t "
+    "DESC ROWS BETWEEN UNBOUNDED PRECEDING AND 1 PRECEDING) m2 FROM test_window_func "
+    "ORDER BY t ASC;",
+    dt);
+  c("SELECT t, AVG(dd) OVER (PARTITION BY y ORDER BY x DESC, t ASC ROWS BETWEEN 3 "
+    "PRECEDING AND 1 FOLLOWING) a, MIN(f) OVER (PARTITION BY y ORDER BY x ASC, t DESC "
+    "ROWS BETWEEN 1 FOLLOWING AND UNBOUNDED FOLLOWING) m, "
+    "COUNT(*) OVER (PARTITION BY y ORDER BY t ASC ROWS BETWEEN UNBOUNDED PRECEDING AND "
+    "UNBOUNDED FOLLOWING) n FROM test_window_func ORDER BY t ASC;",
+    dt);
+}
+
 TEST(Select, WindowFunctionComplexExpressions) {
   SKIP_ALL_ON_AGGREGATOR();
   const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
@@ -1099,6 +1099,15 @@ TEST_F(ImportTest, One_tgz_with_many_csv_files) {
   EXPECT_TRUE(import_test_local("trip_data.tgz", 100000, 1.0));
 }
 
+TEST_F(ImportTest, One_tgz_with_many_csv_files_small_buffer) {
+  // several read ahead blocks, with rows straddling the block boundaries
+  EXPECT_TRUE(import_test_common(
+      "COPY trips FROM '../../Tests/Import/datafiles/trip_data.tgz' WITH "
+      "(header='true', buffer_size=1048576);",
+      100000,
+      1.0));
+}
+
 TEST_F(ImportTest, One_rar_with_many_csv_files) {
   EXPECT_TRUE(import_test_local("trip_data.rar", 1000, 1.0));
 }
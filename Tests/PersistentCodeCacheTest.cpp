@@ -0,0 +1,127 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../QueryEngine/Execute.h"
+#include "../QueryEngine/PersistentCodeCache.h"
+#include "../QueryRunner/QueryRunner.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+const boost::filesystem::path g_cache_dir =
+    boost::filesystem::path(BASE_PATH) / "mapd_jit_cache";
+
+void run_ddl_statement(const std::string& query_str) {
+  QR::get()->runDDLStatement(query_str);
+}
+
+int64_t run_scalar_query(const std::string& query_str) {
+  const auto rows = QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, false);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  auto scalar_r = boost::get<ScalarTargetValue>(&crt_row[0]);
+  CHECK(scalar_r);
+  auto p = boost::get<int64_t>(scalar_r);
+  CHECK(p);
+  return *p;
+}
+
+size_t count_entries() {
+  size_t count{0};
+  for (boost::filesystem::directory_iterator it(g_cache_dir), end; it != end; ++it) {
+    if (it->path().extension() == ".o") {
+      ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(PersistentCodeCache, ReloadAcrossExecutors) {
+  const auto cache = PersistentCodeCache::get();
+  ASSERT_TRUE(cache);
+  const std::string query{"SELECT SUM(x) FROM code_cache_test WHERE x > 1;"};
+  const auto expected = run_scalar_query(query);
+  const auto entries = count_entries();
+  ASSERT_GT(entries, size_t(0));
+  auto hits = cache->getHitCount();
+  {
+    // holding the first executor, the query runs on a second one with an empty
+    // in-memory code cache
+    auto lease = Executor::leaseExecutor(QR::get()->getCatalog()->getCurrentDB().dbId);
+    EXPECT_EQ(expected, run_scalar_query(query));
+  }
+  EXPECT_LT(hits, cache->getHitCount());
+  hits = cache->getHitCount();
+  // as far as the code caches are concerned, a server restart
+  Executor::nukeCacheOfExecutors();
+  EXPECT_EQ(expected, run_scalar_query(query));
+  EXPECT_LT(hits, cache->getHitCount());
+  EXPECT_EQ(entries, count_entries());
+}
+
+TEST(PersistentCodeCache, DictionaryProxiesNotPersisted) {
+  // the comparison decompresses str through the address of its dictionary proxy, which
+  // is only valid in this process and for this executor
+  const std::string query{"SELECT COUNT(*) FROM code_cache_test WHERE str = str_none;"};
+  const auto entries = count_entries();
+  const auto expected = run_scalar_query(query);
+  ASSERT_EQ(int64_t(2), expected);
+  EXPECT_EQ(entries, count_entries());
+  Executor::nukeCacheOfExecutors();
+  EXPECT_EQ(expected, run_scalar_query(query));
+  EXPECT_EQ(entries, count_entries());
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+  // start from an empty cache, entries of an earlier run would be hits right away
+  boost::filesystem::remove_all(g_cache_dir);
+  PersistentCodeCache::init(BASE_PATH, 1UL << 30);
+
+  int err{0};
+  try {
+    run_ddl_statement("DROP TABLE IF EXISTS code_cache_test;");
+    run_ddl_statement(
+        "CREATE TABLE code_cache_test (x INT, str TEXT ENCODING DICT(32), str_none TEXT "
+        "ENCODING NONE);");
+    for (const auto& values : {"1, 'a', 'a'", "2, 'b', 'c'", "3, 'ab', 'ab'"}) {
+      QR::get()->runSQL(
+          "INSERT INTO code_cache_test VALUES(" + std::string(values) + ");",
+          ExecutorDeviceType::CPU);
+    }
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  run_ddl_statement("DROP TABLE IF EXISTS code_cache_test;");
+  QR::reset();
+  return err;
+}
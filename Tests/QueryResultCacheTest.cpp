@@ -0,0 +1,140 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../ThriftHandler/QueryResultCache.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+const std::string g_scan_ra{
+    R"({"rels":[{"id":"0","relOp":"EnumerableTableScan","fieldNames":["x"],)"
+    R"("table":["omnisci","t"],"inputs":[]})"};
+
+std::string sort_ra(const int64_t fetch, const int64_t offset) {
+  return g_scan_ra +
+         R"(,{"id":"1","relOp":"LogicalSort","collation":[{"field":0,)"
+         R"("direction":"ASCENDING","nulls":"LAST"}],"fetch":{"literal":)" +
+         std::to_string(fetch) +
+         R"(,"type":"DECIMAL","target_type":"BIGINT","scale":0,"precision":2,)"
+         R"("type_scale":0,"type_precision":19},"offset":{"literal":)" +
+         std::to_string(offset) +
+         R"(,"type":"DECIMAL","target_type":"BIGINT","scale":0,"precision":1,)"
+         R"("type_scale":0,"type_precision":19}}]})";
+}
+
+TRowSet make_row_set(const int64_t first, const int64_t last) {
+  TRowSet row_set;
+  row_set.is_columnar = true;
+  TColumn column;
+  for (int64_t i = first; i <= last; ++i) {
+    column.data.int_col.push_back(i);
+    column.nulls.push_back(false);
+  }
+  row_set.columns.push_back(column);
+  return row_set;
+}
+
+QueryResultCache::Key make_key(const std::string& query_ra) {
+  const auto key = QueryResultCache::makeKey(query_ra, 1, true);
+  CHECK(key);
+  return *key;
+}
+
+}  // namespace
+
+TEST(QueryResultCache, Hit) {
+  QueryResultCache cache;
+  const auto key = make_key(g_scan_ra + "]}");
+  const QueryResultCache::TableEpochs epochs{{5, 1}};
+  TRowSet row_set;
+  ASSERT_FALSE(cache.get(key, epochs, row_set));
+  cache.put(key, epochs, make_row_set(1, 3), cache.getGeneration());
+  ASSERT_TRUE(cache.get(key, epochs, row_set));
+  ASSERT_EQ(std::vector<int64_t>({1, 2, 3}), row_set.columns.front().data.int_col);
+  ASSERT_EQ(size_t(1), cache.getHitCount());
+  ASSERT_EQ(size_t(1), cache.getMissCount());
+}
+
+TEST(QueryResultCache, EpochChange) {
+  QueryResultCache cache;
+  const auto key = make_key(g_scan_ra + "]}");
+  cache.put(key, {{5, 1}}, make_row_set(1, 3), cache.getGeneration());
+  TRowSet row_set;
+  // an insert bumped the epoch
+  ASSERT_FALSE(cache.get(key, {{5, 2}}, row_set));
+  // the entry was dropped
+  ASSERT_FALSE(cache.get(key, {{5, 1}}, row_set));
+}
+
+TEST(QueryResultCache, Subrange) {
+  QueryResultCache cache;
+  const QueryResultCache::TableEpochs epochs{{5, 1}};
+  const auto key = make_key(sort_ra(10, 0));
+  cache.put(key, epochs, make_row_set(1, 10), cache.getGeneration());
+  TRowSet row_set;
+  const auto smaller_key = make_key(sort_ra(3, 2));
+  ASSERT_EQ(key.plan, smaller_key.plan);
+  ASSERT_TRUE(cache.get(smaller_key, epochs, row_set));
+  ASSERT_EQ(std::vector<int64_t>({3, 4, 5}), row_set.columns.front().data.int_col);
+  // past the cached rows
+  ASSERT_FALSE(cache.get(make_key(sort_ra(5, 8)), epochs, row_set));
+}
+
+TEST(QueryResultCache, NotCached) {
+  ASSERT_FALSE(QueryResultCache::makeKey(g_scan_ra + R"(,{"op":"NOW"}]})", 1, true));
+  ASSERT_FALSE(QueryResultCache::makeKey("not a plan", 1, true));
+}
+
+TEST(QueryResultCache, ClearOnReload) {
+  QueryResultCache cache;
+  const auto key = make_key(g_scan_ra + "]}");
+  const QueryResultCache::TableEpochs epochs{{5, 1}};
+  cache.put(key, epochs, make_row_set(1, 3), cache.getGeneration());
+  // TRUNCATE and a reload, or DROP and a CREATE reusing the table id, bring back the
+  // same table id and epoch on other rows; the handler clears the cache after the DDL
+  cache.clear();
+  TRowSet row_set;
+  ASSERT_FALSE(cache.get(key, epochs, row_set));
+}
+
+TEST(QueryResultCache, NoPutAfterClear) {
+  QueryResultCache cache;
+  const auto key = make_key(g_scan_ra + "]}");
+  const QueryResultCache::TableEpochs epochs{{5, 1}};
+  // the query started before a DDL statement cleared the cache
+  const auto generation = cache.getGeneration();
+  cache.clear();
+  cache.put(key, epochs, make_row_set(1, 3), generation);
+  TRowSet row_set;
+  ASSERT_FALSE(cache.get(key, epochs, row_set));
+  cache.put(key, epochs, make_row_set(1, 3), cache.getGeneration());
+  ASSERT_TRUE(cache.get(key, epochs, row_set));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -27,6 +27,7 @@
 #include "../Analyzer/Analyzer.h"
 #include "../Catalog/Catalog.h"
 #include "../DataMgr/DataMgr.h"
+#include "../DataMgr/FileMgr/GlobalFileMgr.h"
 #include "../Fragmenter/Fragmenter.h"
 #include "../Parser/ParserNode.h"
 #include "../Parser/parser.h"
@@ -34,6 +35,7 @@
 #include "PopulateTableRandom.h"
 #include "ScanTable.h"
 #include "Shared/MapDParameters.h"
+#include "Shared/measure.h"
 #include "TestHelpers.h"
 #include "boost/filesystem.hpp"
 #include "boost/program_options.hpp"
@@ -88,8 +90,54 @@ static size_t load_data_for_thread_test_2(int num_rows, string table_name) {
   return insert_col_hashs.size();
 }
 
+// Reads a whole chunk through a freshly opened file manager, so nothing is served from
+// the FileMgr state of the writer, and returns the throughput in MB/s.
+double read_chunk_throughput(const std::string& data_path,
+                             const File_Namespace::FileReadBackend read_backend,
+                             const ChunkKey& chunk_key,
+                             const std::vector<int8_t>& expected_data) {
+  File_Namespace::GlobalFileMgr gfm(0, data_path);
+  gfm.setReadBackend(read_backend);
+  auto buffer = gfm.getBuffer(chunk_key);
+  CHECK_EQ(buffer->size(), expected_data.size());
+  std::vector<int8_t> data(expected_data.size());
+  const auto read_ms =
+      measure<>::execution([&]() { buffer->read(data.data(), data.size()); });
+  CHECK(data == expected_data);
+  return (data.size() / (1024. * 1024.)) / (std::max(read_ms, int64_t(1)) / 1000.);
+}
+
 }  // namespace
 
+TEST(FileRead, BufferedVsDirect) {
+  const std::string data_path = std::string(BASE_PATH) + "/file_read_backend_test";
+  boost::filesystem::remove_all(data_path);
+  const ChunkKey chunk_key{1, 1, 1, 0};
+  std::vector<int8_t> data(512 * 1024 * 1024);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int8_t>(i * 31);
+  }
+  {
+    File_Namespace::GlobalFileMgr gfm(0, data_path);
+    auto buffer = gfm.createBuffer(chunk_key);
+    buffer->append(data.data(), data.size());
+    gfm.checkpoint();
+  }
+  // Each backend reads the chunk twice, the second time with the file in the page cache
+  using File_Namespace::FileReadBackend;
+  for (const auto read_backend : {FileReadBackend::BUFFERED, FileReadBackend::DIRECT}) {
+    const auto backend_name =
+        read_backend == FileReadBackend::DIRECT ? "direct" : "buffered";
+    for (int run = 0; run < 2; ++run) {
+      const auto throughput =
+          read_chunk_throughput(data_path, read_backend, chunk_key, data);
+      std::cout << "File read backend " << backend_name << " run " << run << ": "
+                << throughput << " MB/s" << std::endl;
+    }
+  }
+  boost::filesystem::remove_all(data_path);
+}
+
 TEST(DataLoad, Numbers) {
   ASSERT_NO_THROW(run_ddl_statement("drop table if exists numbers;"););
   ASSERT_NO_THROW(
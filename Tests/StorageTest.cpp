@@ -29,6 +29,7 @@
 #include "../Analyzer/Analyzer.h"
 #include "../Catalog/Catalog.h"
 #include "../DataMgr/DataMgr.h"
+#include "../DataMgr/FileMgr/GlobalFileMgr.h"
 #include "../Fragmenter/Fragmenter.h"
 #include "../Parser/ParserNode.h"
 #include "../Parser/parser.h"
@@ -36,6 +37,7 @@
 #include "PopulateTableRandom.h"
 #include "ScanTable.h"
 #include "Shared/MapDParameters.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 #include "boost/filesystem.hpp"
 #include "boost/program_options.hpp"
@@ -173,6 +175,134 @@ TEST(StorageSmallParallel, AllTypes) {
   ASSERT_NO_THROW(run_ddl_statement("drop table alltypes;"););
 }
 
+TEST(StorageChunkIndexSnapshot, Reopen) {
+  const auto data_path = boost::filesystem::path(BASE_PATH) / "chunk_index_snapshot_test";
+  const auto snapshot_path = data_path / "table_1_1" / "chunk_index";
+  boost::filesystem::remove_all(data_path);
+  ScopeGuard reset = [orig = g_enable_chunk_index_snapshot, data_path] {
+    g_enable_chunk_index_snapshot = orig;
+    boost::filesystem::remove_all(data_path);
+  };
+  g_enable_chunk_index_snapshot = true;
+
+  const ChunkKey key{1, 1, 1, 0};
+  std::vector<int8_t> data(3 * 2097152);  // spans several pages
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 127;
+  }
+  auto read_chunk = [&key](File_Namespace::GlobalFileMgr& gfm) {
+    auto chunk = gfm.getBuffer(key);
+    std::vector<int8_t> contents(chunk->size());
+    chunk->read(contents.data(), contents.size());
+    return contents;
+  };
+
+  {
+    File_Namespace::GlobalFileMgr gfm(0, data_path.string());
+    gfm.createBuffer(key)->append(data.data(), data.size());
+    gfm.checkpoint();
+    EXPECT_TRUE(boost::filesystem::exists(snapshot_path));
+  }
+  {
+    File_Namespace::GlobalFileMgr gfm(0, data_path.string());
+    EXPECT_EQ(data, read_chunk(gfm));
+    // allocating pages removes the snapshot until the next checkpoint
+    gfm.getBuffer(key)->append(data.data(), data.size());
+    EXPECT_FALSE(boost::filesystem::exists(snapshot_path));
+  }
+  {
+    // the header scan drops the pages appended without a checkpoint
+    File_Namespace::GlobalFileMgr gfm(0, data_path.string());
+    EXPECT_EQ(data, read_chunk(gfm));
+    gfm.checkpoint();
+    EXPECT_TRUE(boost::filesystem::exists(snapshot_path));
+  }
+  {
+    File_Namespace::GlobalFileMgr gfm(0, data_path.string());
+    EXPECT_EQ(data, read_chunk(gfm));
+  }
+}
+
+namespace {
+
+// A chunk held in memory, stands in for a CPU buffer pool buffer.
+class MemoryChunkBuffer : public Data_Namespace::AbstractBuffer {
+ public:
+  MemoryChunkBuffer(const std::vector<int8_t>& data) : AbstractBuffer(0), data_(data) {
+    size_ = data_.size();
+  }
+
+  void read(int8_t* const dst,
+            const size_t num_bytes,
+            const size_t offset,
+            const MemoryLevel,
+            const int) override {
+    std::memcpy(dst, data_.data() + offset, num_bytes);
+  }
+  void write(int8_t* src,
+             const size_t num_bytes,
+             const size_t offset,
+             const MemoryLevel,
+             const int) override {
+    std::memcpy(data_.data() + offset, src, num_bytes);
+  }
+  void reserve(size_t num_bytes) override { data_.resize(num_bytes); }
+  void append(int8_t*, const size_t, const MemoryLevel, const int) override {
+    CHECK(false);
+  }
+  int8_t* getMemoryPtr() override { return data_.data(); }
+  size_t pageCount() const override { return 1; }
+  size_t pageSize() const override { return data_.size(); }
+  size_t size() const override { return size_; }
+  size_t reservedSize() const override { return data_.size(); }
+  MemoryLevel getType() const override { return CPU_LEVEL; }
+
+ private:
+  std::vector<int8_t> data_;
+};
+
+}  // namespace
+
+TEST(StorageUpdatedRanges, WriteBack) {
+  const auto data_path = boost::filesystem::path(BASE_PATH) / "updated_ranges_test";
+  boost::filesystem::remove_all(data_path);
+  ScopeGuard cleanup = [data_path] { boost::filesystem::remove_all(data_path); };
+
+  const ChunkKey key{1, 1, 1, 0};
+  std::vector<int8_t> data(3 * 2097152);  // spans several pages
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 127;
+  }
+  {
+    File_Namespace::GlobalFileMgr gfm(0, data_path.string());
+    gfm.createBuffer(key)->append(data.data(), data.size());
+    gfm.checkpoint();
+  }
+  MemoryChunkBuffer updated_chunk(data);
+  // within a page, across two pages and at the end of the chunk
+  for (const auto offset : {size_t(1000), size_t(2097152 - 5), data.size() - 10}) {
+    for (size_t i = offset; i < offset + 10; ++i) {
+      data[i] = -1;
+    }
+    updated_chunk.write(data.data() + offset, 10, offset, CPU_LEVEL, 0);
+    updated_chunk.setUpdated(offset, 10);
+  }
+  EXPECT_EQ(size_t(3), updated_chunk.getUpdatedRanges().size());
+  {
+    File_Namespace::GlobalFileMgr gfm(0, data_path.string());
+    gfm.putBuffer(key, &updated_chunk);
+    EXPECT_TRUE(updated_chunk.getUpdatedRanges().empty());
+    gfm.checkpoint();
+  }
+  {
+    File_Namespace::GlobalFileMgr gfm(0, data_path.string());
+    auto chunk = gfm.getBuffer(key);
+    std::vector<int8_t> contents(chunk->size());
+    chunk->read(contents.data(), contents.size());
+    EXPECT_EQ(data, contents);
+  }
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -15,8 +15,10 @@
  */
 
 #include "../StringDictionary/StringDictionary.h"
+#include "../StringDictionary/StringDictionaryProxy.h"
 #include "TestHelpers.h"
 
+#include <future>
 #include <limits>
 
 #include <gtest/gtest.h>
@@ -86,6 +88,46 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, ConcurrentAddsAndGets) {
+  StringDictionary string_dict("", true, false);
+  const int thread_count{8};
+  // every thread adds all the strings, in a different order, while looking up the
+  // strings added so far
+  std::vector<std::future<void>> workers;
+  for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    workers.emplace_back(std::async(std::launch::async, [&string_dict, thread_idx] {
+      for (int i = 0; i < g_op_count; ++i) {
+        const auto str = std::to_string((i * 7919 + thread_idx * 104729) % g_op_count);
+        const auto str_id = string_dict.getOrAdd(str);
+        CHECK_EQ(str_id, string_dict.getIdOfString(str));
+        CHECK_EQ(str, string_dict.getString(str_id));
+      }
+    }));
+  }
+  for (auto& worker : workers) {
+    worker.get();
+  }
+  ASSERT_EQ(size_t(g_op_count), string_dict.storageEntryCount());
+  for (int i = 0; i < g_op_count; ++i) {
+    const auto str_id = string_dict.getIdOfString(std::to_string(i));
+    ASSERT_NE(StringDictionary::INVALID_STR_ID, str_id);
+    ASSERT_EQ(std::to_string(i), string_dict.getString(str_id));
+  }
+}
+
+TEST(StringDictionaryProxy, StringBytesOutliveGrowth) {
+  auto string_dict = std::make_shared<StringDictionary>("", true, false);
+  StringDictionaryProxy string_dict_proxy(string_dict, -1);
+  const auto str_id = string_dict->getOrAdd("first");
+  const auto bytes = string_dict_proxy.getStringBytes(str_id);
+  // the storage of the dictionary is moved several times while the bytes are in use
+  for (int i = 0; i < g_op_count; ++i) {
+    string_dict->getOrAdd(std::to_string(i));
+  }
+  ASSERT_EQ("first", std::string(bytes.first, bytes.second));
+  ASSERT_EQ(bytes, string_dict_proxy.getStringBytes(str_id));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
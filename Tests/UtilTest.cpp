@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
+#include "../Shared/WorkStealingPool.h"
 #include "../Utils/Regexp.h"
 #include "../Utils/StringLike.h"
 #include "TestHelpers.h"
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 TEST(Utils, StringLike) {
   ASSERT_TRUE(string_like("abc", 3, "abc", 3, '\\'));
   ASSERT_FALSE(string_like("abc", 3, "ABC", 3, '\\'));
@@ -45,6 +48,54 @@ TEST(Utils, Regexp) {
   ASSERT_TRUE(regexp_like("hello [", 7, ".*\\[.*", 6, '\\'));
 }
 
+TEST(Utils, WorkStealingPool) {
+  WorkStealingPool pool(4);
+  std::atomic<int> sum{0};
+  {
+    WorkStealingPool::TaskGroup group(pool, 0);
+    std::vector<std::future<void>> futures;
+    for (int i = 1; i <= 1000; ++i) {
+      futures.push_back(group.submit([&sum, i] { sum += i; }));
+    }
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
+  ASSERT_EQ(500500, sum.load());
+}
+
+TEST(Utils, WorkStealingPoolGroupConcurrency) {
+  WorkStealingPool pool(8);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  WorkStealingPool::TaskGroup group(pool, 2);
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 64; ++i) {
+    futures.push_back(group.submit([&running, &max_running] {
+      const int now_running = ++running;
+      int prev_max = max_running.load();
+      while (prev_max < now_running &&
+             !max_running.compare_exchange_weak(prev_max, now_running)) {
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      --running;
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  ASSERT_LE(max_running.load(), 2);
+}
+
+TEST(Utils, WorkStealingPoolException) {
+  WorkStealingPool pool(2);
+  WorkStealingPool::TaskGroup group(pool, 1);
+  auto failed = group.submit([] { throw std::runtime_error("kernel failed"); });
+  auto succeeded = group.submit([] {});
+  ASSERT_THROW(failed.get(), std::runtime_error);
+  ASSERT_NO_THROW(succeeded.get());
+}
+
 int main(int argc, char* argv[]) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
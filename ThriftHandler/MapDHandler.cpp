@@ -537,19 +537,14 @@ void MapDHandler::interrupt(const TSessionId& session) {
     auto session_it = get_session_it_unsafe(session, read_lock);
     auto& cat = session_it->second.get()->getCatalog();
     const auto dbname = cat.getCurrentDB().dbName;
-    auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
-                                          jit_debug_ ? "/tmp" : "",
-                                          jit_debug_ ? "mapdquery" : "",
-                                          mapd_parameters_);
-    CHECK(executor);
-
     VLOG(1) << "Received interrupt: "
-            << "Session " << *session_it->second << ", Executor " << executor
-            << ", leafCount " << leaf_aggregator_.leafCount() << ", User "
+            << "Session " << *session_it->second << ", leafCount "
+            << leaf_aggregator_.leafCount() << ", User "
             << session_it->second->get_currentUser().userName << ", Database " << dbname
             << std::endl;
 
-    executor->interrupt();
+    // queries aren't tracked per session, interrupt whatever runs on the database
+    Executor::interruptExecutors(cat.getCurrentDB().dbId);
 
     LOG(INFO) << "User " << session_it->second->get_currentUser().userName
               << " interrupted session with database " << dbname << std::endl;
@@ -580,6 +575,8 @@ void MapDHandler::get_status(std::vector<TServerStatus>& _return,
   ret.start_time = start_time_;
   ret.edition = MAPD_EDITION;
   ret.host_name = get_hostname();
+  ret.result_cache_hits = query_result_cache_.getHitCount();
+  ret.result_cache_misses = query_result_cache_.getMissCount();
 
   // TSercivePort tcp_port{}
 
@@ -874,6 +871,7 @@ void MapDHandler::sql_execute(TQueryResult& _return,
     THROW_MAPD_EXCEPTION(std::string("At most one of first_n and at_most_n can be set"));
   }
 
+  bool result_cache_hit{false};
   if (leaf_aggregator_.leafCount() > 0) {
     if (!agg_handler_) {
       THROW_MAPD_EXCEPTION("Distributed support is disabled.");
@@ -906,7 +904,8 @@ void MapDHandler::sql_execute(TQueryResult& _return,
                                     nonce,
                                     session_ptr->get_executor_device_type(),
                                     first_n,
-                                    at_most_n);
+                                    at_most_n,
+                                    result_cache_hit);
     });
   }
 
@@ -940,6 +939,9 @@ void MapDHandler::sql_execute(TQueryResult& _return,
                               _return.execution_time_ms,
                               "total_time_ms",  // BE-3420 - Redundant with duration field
                               stdlog.duration<std::chrono::milliseconds>());
+  if (g_enable_query_result_cache) {
+    stdlog.appendNameValuePairs("result_cache_hit", result_cache_hit);
+  }
 }
 
 void MapDHandler::sql_execute_df(TDataFrame& _return,
@@ -947,7 +949,8 @@ void MapDHandler::sql_execute_df(TDataFrame& _return,
                                  const std::string& query_str,
                                  const TDeviceType::type device_type,
                                  const int32_t device_id,
-                                 const int32_t first_n) {
+                                 const int32_t first_n,
+                                 const int32_t record_batch_rows) {
   auto session_ptr = get_session_ptr(session);
   auto query_state = create_query_state(session_ptr, query_str);
   auto stdlog = STDLOG(session_ptr, query_state);
@@ -966,6 +969,9 @@ void MapDHandler::sql_execute_df(TDataFrame& _return,
           std::string("Exception: invalid device_id or unavailable GPU with this ID"));
     }
   }
+  if (record_batch_rows < 0) {
+    THROW_MAPD_EXCEPTION(std::string("Exception: record_batch_rows can't be negative"));
+  }
   _return.execution_time_ms = 0;
 
   SQLParser parser;
@@ -1004,7 +1010,8 @@ void MapDHandler::sql_execute_df(TDataFrame& _return,
                          device_type == TDeviceType::CPU ? ExecutorDeviceType::CPU
                                                          : ExecutorDeviceType::GPU,
                          static_cast<size_t>(device_id),
-                         first_n);
+                         first_n,
+                         static_cast<size_t>(record_batch_rows));
       if (!_return.sm_size) {
         throw std::runtime_error("schema is missing in returned result");
       }
@@ -1024,7 +1031,7 @@ void MapDHandler::sql_execute_gdf(TDataFrame& _return,
                                   const int32_t device_id,
                                   const int32_t first_n) {
   auto stdlog = STDLOG(get_session_ptr(session));
-  sql_execute_df(_return, session, query_str, TDeviceType::GPU, device_id, first_n);
+  sql_execute_df(_return, session, query_str, TDeviceType::GPU, device_id, first_n, 0);
 }
 
 // For now we have only one user of a data frame in all cases.
@@ -2140,6 +2147,10 @@ void MapDHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
     nodeInfo.max_num_pages = memInfo.maxNumPages;
     nodeInfo.num_pages_allocated = memInfo.numPageAllocated;
     nodeInfo.is_allocation_capped = memInfo.isAllocationCapped;
+    nodeInfo.eviction_policy = memInfo.evictionPolicy;
+    nodeInfo.num_hits = memInfo.evictionPolicyStats.num_hits;
+    nodeInfo.num_misses = memInfo.evictionPolicyStats.num_misses;
+    nodeInfo.num_evictions = memInfo.evictionPolicyStats.num_evictions;
     for (auto gpu : memInfo.nodeMemoryData) {
       TMemoryData md;
       md.slab = gpu.slabNum;
@@ -3609,6 +3620,7 @@ void MapDHandler::create_table(const TSessionId& session,
       col_stmt.append(" ENCODING " + thrift_to_encoding_name(col.col_type));
       if (thrift_to_encoding(col.col_type.encoding) == kENCODING_DICT ||
           thrift_to_encoding(col.col_type.encoding) == kENCODING_FIXED ||
+          thrift_to_encoding(col.col_type.encoding) == kENCODING_DIFF ||
           thrift_to_encoding(col.col_type.encoding) == kENCODING_GEOINT) {
         col_stmt.append("(" + std::to_string(col.col_type.comp_param) + ")");
       }
@@ -4507,7 +4519,8 @@ std::vector<PushedDownFilterInfo> MapDHandler::execute_rel_alg(
                            g_enable_dynamic_watchdog,
                            explain_optimized_ir ? ExecutorExplainType::Optimized
                                                 : ExecutorExplainType::Default,
-                           intel_jit_profile_};
+                           intel_jit_profile_,
+                           g_enable_vectorized_cpu_codegen};
   ExecutionOptions eo = {g_enable_columnar_output,
                          allow_multifrag_,
                          just_explain,
@@ -4520,11 +4533,11 @@ std::vector<PushedDownFilterInfo> MapDHandler::execute_rel_alg(
                          find_push_down_candidates,
                          just_calcite_explain,
                          mapd_parameters_.gpu_input_mem_limit};
-  auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
-                                        jit_debug_ ? "/tmp" : "",
-                                        jit_debug_ ? "mapdquery" : "",
-                                        mapd_parameters_);
-  RelAlgExecutor ra_executor(executor.get(),
+  auto executor_lease = Executor::leaseExecutor(cat.getCurrentDB().dbId,
+                                                jit_debug_ ? "/tmp" : "",
+                                                jit_debug_ ? "mapdquery" : "",
+                                                mapd_parameters_);
+  RelAlgExecutor ra_executor(executor_lease->get(),
                              cat,
                              query_ra,
                              query_state_proxy.getQueryState().shared_from_this());
@@ -4562,7 +4575,8 @@ void MapDHandler::execute_rel_alg_df(TDataFrame& _return,
                                      const Catalog_Namespace::SessionInfo& session_info,
                                      const ExecutorDeviceType device_type,
                                      const size_t device_id,
-                                     const int32_t first_n) const {
+                                     const int32_t first_n,
+                                     const size_t record_batch_rows) const {
   const auto& cat = session_info.getCatalog();
   CHECK(device_type == ExecutorDeviceType::CPU ||
         session_info.get_executor_device_type() == ExecutorDeviceType::GPU);
@@ -4571,7 +4585,8 @@ void MapDHandler::execute_rel_alg_df(TDataFrame& _return,
                            ExecutorOptLevel::Default,
                            g_enable_dynamic_watchdog,
                            ExecutorExplainType::Default,
-                           intel_jit_profile_};
+                           intel_jit_profile_,
+                           g_enable_vectorized_cpu_codegen};
   ExecutionOptions eo = {false,
                          allow_multifrag_,
                          false,
@@ -4584,11 +4599,11 @@ void MapDHandler::execute_rel_alg_df(TDataFrame& _return,
                          false,
                          false,
                          mapd_parameters_.gpu_input_mem_limit};
-  auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
-                                        jit_debug_ ? "/tmp" : "",
-                                        jit_debug_ ? "mapdquery" : "",
-                                        mapd_parameters_);
-  RelAlgExecutor ra_executor(executor.get(),
+  auto executor_lease = Executor::leaseExecutor(cat.getCurrentDB().dbId,
+                                                jit_debug_ ? "/tmp" : "",
+                                                jit_debug_ ? "mapdquery" : "",
+                                                mapd_parameters_);
+  RelAlgExecutor ra_executor(executor_lease->get(),
                              cat,
                              query_ra,
                              query_state_proxy.getQueryState().shared_from_this());
@@ -4608,7 +4623,8 @@ void MapDHandler::execute_rel_alg_df(TDataFrame& _return,
                                                 device_type,
                                                 device_id,
                                                 getTargetNames(result.getTargetsMeta()),
-                                                first_n);
+                                                first_n,
+                                                record_batch_rows);
   ArrowResult arrow_result;
 
   _return.arrow_conversion_time_ms +=
@@ -4634,19 +4650,30 @@ void MapDHandler::execute_root_plan(TQueryResult& _return,
                                     const Catalog_Namespace::SessionInfo& session_info,
                                     const ExecutorDeviceType executor_device_type,
                                     const int32_t first_n) const {
-  auto executor = Executor::getExecutor(root_plan->getCatalog().getCurrentDB().dbId,
-                                        jit_debug_ ? "/tmp" : "",
-                                        jit_debug_ ? "mapdquery" : "",
-                                        mapd_parameters_);
+  const auto db_id = root_plan->getCatalog().getCurrentDB().dbId;
+  const auto debug_dir = jit_debug_ ? "/tmp" : "";
+  const auto debug_file = jit_debug_ ? "mapdquery" : "";
+  std::unique_ptr<Executor::Lease> executor_lease;
+  std::shared_ptr<Executor> executor;
+  if (root_plan->get_stmt_type() == kINSERT &&
+      root_plan->get_plan_dest() != Planner::RootPlan::Dest::kEXPLAIN) {
+    // like the loaders, a simple insert doesn't wait for a lease, it runs on the executor
+    // the DDL and import paths share without locking it
+    executor = Executor::getExecutor(db_id, debug_dir, debug_file, mapd_parameters_);
+  } else {
+    executor_lease =
+        Executor::leaseExecutor(db_id, debug_dir, debug_file, mapd_parameters_);
+  }
   std::shared_ptr<ResultSet> results;
   _return.execution_time_ms += measure<>::execution([&]() {
-    results = executor->execute(root_plan,
-                                session_info,
-                                true,
-                                executor_device_type,
-                                ExecutorOptLevel::Default,
-                                allow_multifrag_,
-                                allow_loop_joins_);
+    auto executor_ptr = executor_lease ? executor_lease->get() : executor.get();
+    results = executor_ptr->execute(root_plan,
+                                    session_info,
+                                    true,
+                                    executor_device_type,
+                                    ExecutorOptLevel::Default,
+                                    allow_multifrag_,
+                                    allow_loop_joins_);
   });
   // reduce execution time by the time spent during queue waiting
   _return.execution_time_ms -= results->getQueueTime();
@@ -4750,6 +4777,9 @@ void MapDHandler::convert_rows(TQueryResult& _return,
   int32_t fetched{0};
   if (column_format) {
     _return.row_set.is_columnar = true;
+    if (convert_rows_columnar(_return, targets, results, first_n, at_most_n)) {
+      return;
+    }
     std::vector<TColumn> tcolumns(results.colCount());
     while (first_n == -1 || fetched < first_n) {
       const auto crt_row = results.getNextRow(true, true);
@@ -4792,6 +4822,148 @@ void MapDHandler::convert_rows(TQueryResult& _return,
   }
 }
 
+namespace {
+
+int64_t read_int_from_column_buffer(const int8_t* col_buffer,
+                                    const size_t byte_width,
+                                    const size_t row_idx) {
+  switch (byte_width) {
+    case 1:
+      return col_buffer[row_idx];
+    case 2:
+      return reinterpret_cast<const int16_t*>(col_buffer)[row_idx];
+    case 4:
+      return reinterpret_cast<const int32_t*>(col_buffer)[row_idx];
+    case 8:
+      return reinterpret_cast<const int64_t*>(col_buffer)[row_idx];
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
+// Fills a thrift column from a buffer of ColumnarResults, with the same values and nulls
+// value_to_thrift_column produces for the rows. Dictionary encoded strings are translated
+// once per distinct id.
+void column_buffer_to_thrift_column(const int8_t* col_buffer,
+                                    const size_t row_count,
+                                    const SQLTypeInfo& col_ti,
+                                    const SQLTypeInfo& ti,
+                                    const StringDictionaryProxy* sdp,
+                                    TColumn& column) {
+  const bool nullable = !ti.get_notnull();
+  column.nulls.resize(row_count);
+  if (col_ti.is_dict_encoded_string()) {
+    CHECK(sdp);
+    const auto ids = reinterpret_cast<const int32_t*>(col_buffer);
+    std::unordered_map<int32_t, std::string> strings;
+    column.data.str_col.resize(row_count);
+    for (size_t i = 0; i < row_count; ++i) {
+      const auto id = ids[i];
+      if (id == NULL_INT) {
+        column.nulls[i] = nullable;
+        continue;
+      }
+      auto it = strings.find(id);
+      if (it == strings.end()) {
+        it = strings.emplace(id, sdp->getString(id)).first;
+      }
+      column.data.str_col[i] = it->second;
+    }
+    return;
+  }
+  if (col_ti.get_type() == kFLOAT) {
+    const auto vals = reinterpret_cast<const float*>(col_buffer);
+    column.data.real_col.resize(row_count);
+    for (size_t i = 0; i < row_count; ++i) {
+      column.data.real_col[i] = vals[i];
+      column.nulls[i] = vals[i] == NULL_FLOAT && nullable;
+    }
+    return;
+  }
+  if (col_ti.get_type() == kDOUBLE) {
+    const auto vals = reinterpret_cast<const double*>(col_buffer);
+    column.data.real_col.resize(row_count);
+    for (size_t i = 0; i < row_count; ++i) {
+      column.data.real_col[i] = vals[i];
+      column.nulls[i] = vals[i] == NULL_DOUBLE && nullable;
+    }
+    return;
+  }
+  const auto byte_width = col_ti.get_size();
+  const auto null_val = inline_int_null_val(col_ti);
+  const bool is_decimal = is_member_of_typeset<kNUMERIC, kDECIMAL>(ti);
+  const double scale = ti.get_scale() > 0 ? pow(10.0, std::abs(ti.get_scale())) : 1;
+  if (is_decimal) {
+    column.data.real_col.resize(row_count);
+  } else {
+    column.data.int_col.resize(row_count);
+  }
+  for (size_t i = 0; i < row_count; ++i) {
+    const auto val = read_int_from_column_buffer(col_buffer, byte_width, i);
+    if (is_decimal) {
+      column.data.real_col[i] = static_cast<double>(val) / scale;
+    } else {
+      column.data.int_col[i] = val;
+    }
+    column.nulls[i] = val == null_val && nullable;
+  }
+}
+
+}  // namespace
+
+bool MapDHandler::convert_rows_columnar(TQueryResult& _return,
+                                        const std::vector<TargetMetaInfo>& targets,
+                                        const ResultSet& results,
+                                        const int32_t first_n,
+                                        const int32_t at_most_n) const {
+  const auto col_count = results.colCount();
+  // a limit on the fetched rows is cheaper to serve by iterating the first ones
+  if (first_n >= 0 || results.isExplain() || results.isTruncated() ||
+      !results.getRowSetMemOwner() || targets.size() != col_count) {
+    return false;
+  }
+  std::vector<SQLTypeInfo> col_types;
+  std::vector<const StringDictionaryProxy*> sdps(col_count, nullptr);
+  for (size_t i = 0; i < col_count; ++i) {
+    const auto& ti = targets[i].get_type_info();
+    const auto col_ti = get_logical_type_info(results.getColType(i));
+    if (ti.is_array() || ti.is_geometry() ||
+        (ti.is_string() && ti.get_compression() == kENCODING_NONE) ||
+        ti.get_type() != col_ti.get_type()) {
+      return false;
+    }
+    if (col_ti.is_dict_encoded_string()) {
+      sdps[i] = results.getStringDictionaryProxy(col_ti.get_comp_param());
+    }
+    col_types.push_back(col_ti);
+  }
+  const ColumnarResults columnar_results(
+      results.getRowSetMemOwner(), results, col_count, col_types);
+  const auto row_count = columnar_results.size();
+  if (at_most_n >= 0 && row_count > static_cast<size_t>(at_most_n)) {
+    THROW_MAPD_EXCEPTION("The result contains more rows than the specified cap of " +
+                         std::to_string(at_most_n));
+  }
+  std::vector<TColumn> tcolumns(col_count);
+  std::vector<std::future<void>> column_threads;
+  for (size_t i = 0; i < col_count; ++i) {
+    column_threads.push_back(std::async(std::launch::async, [&, i] {
+      column_buffer_to_thrift_column(columnar_results.getColumnBuffers()[i],
+                                     row_count,
+                                     col_types[i],
+                                     targets[i].get_type_info(),
+                                     sdps[i],
+                                     tcolumns[i]);
+    }));
+  }
+  for (auto& column_thread : column_threads) {
+    column_thread.get();
+  }
+  _return.row_set.columns = std::move(tcolumns);
+  return true;
+}
+
 TRowDescriptor MapDHandler::fixup_row_descriptor(const TRowDescriptor& row_desc,
                                                  const Catalog& cat) {
   TRowDescriptor fixedup_row_desc;
@@ -4896,13 +5068,35 @@ void MapDHandler::check_and_invalidate_sessions(Parser::DDLStmt* ddl) {
   }
 }
 
+namespace {
+
+// The epochs of the tables a query reads, none if the tables include a view or a
+// temporary table, whose epochs don't change with the data the query sees.
+boost::optional<QueryResultCache::TableEpochs> get_table_epochs(
+    const Catalog_Namespace::Catalog& cat,
+    const TableMap& table_map) {
+  QueryResultCache::TableEpochs table_epochs;
+  for (const auto& table : table_map) {
+    const auto td = cat.getMetadataForTable(table.first, false);
+    if (!td || td->isView || table_is_temporary(td)) {
+      return boost::none;
+    }
+    table_epochs.emplace_back(td->tableId,
+                              cat.getTableEpoch(cat.getCurrentDB().dbId, td->tableId));
+  }
+  return table_epochs;
+}
+
+}  // namespace
+
 void MapDHandler::sql_execute_impl(TQueryResult& _return,
                                    QueryStateProxy query_state_proxy,
                                    const bool column_format,
                                    const std::string& nonce,
                                    const ExecutorDeviceType executor_device_type,
                                    const int32_t first_n,
-                                   const int32_t at_most_n) {
+                                   const int32_t at_most_n,
+                                   bool& result_cache_hit) {
   if (leaf_handler_) {
     leaf_handler_->flush_queue();
   }
@@ -4940,6 +5134,8 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
     TableMap table_map;
     OptionalTableMap tableNames(table_map);
     if (pw.isCalcitePathPermissable(read_only_)) {
+      // a result computed on the tables from before a DDL statement isn't cached
+      const auto result_cache_generation = query_result_cache_.getGeneration();
       std::string query_ra;
       _return.execution_time_ms += measure<>::execution([&]() {
         query_ra =
@@ -4972,6 +5168,30 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
       TableLockMgr::getTableLocks(
           session_ptr->getCatalog(), tableNames.value(), table_locks);
 
+      boost::optional<QueryResultCache::Key> result_cache_key;
+      boost::optional<QueryResultCache::TableEpochs> result_cache_table_epochs;
+      if (g_enable_query_result_cache && !g_cluster && first_n < 0 &&
+          !pw.is_update_dml &&
+          pw.getExplainType() == ParserWrapper::ExplainType::None) {
+        result_cache_table_epochs = get_table_epochs(cat, tableNames.value());
+        if (result_cache_table_epochs) {
+          result_cache_key = QueryResultCache::makeKey(
+              query_ra, cat.getCurrentDB().dbId, column_format);
+        }
+        if (result_cache_key &&
+            query_result_cache_.get(
+                *result_cache_key, *result_cache_table_epochs, _return.row_set)) {
+          result_cache_hit = true;
+          const auto row_count = QueryResultCache::getRowCount(_return.row_set);
+          if (at_most_n >= 0 && row_count > static_cast<size_t>(at_most_n)) {
+            THROW_MAPD_EXCEPTION(
+                "The result contains more rows than the specified cap of " +
+                std::to_string(at_most_n));
+          }
+          return;
+        }
+      }
+
       const auto filter_push_down_requests =
           execute_rel_alg(_return,
                           query_state_proxy,
@@ -5027,6 +5247,12 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
         convert_explain(_return, ResultSet(query_ra), true);
         return;
       }
+      if (result_cache_key) {
+        query_result_cache_.put(*result_cache_key,
+                                *result_cache_table_epochs,
+                                _return.row_set,
+                                result_cache_generation);
+      }
       return;
     } else if (pw.is_optimize || pw.is_validate) {
       // Get the Stmt object
@@ -5067,6 +5293,7 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
           }
           optimizer.recomputeMetadata();
         });
+        query_result_cache_.clear();
 
         return;
       }
@@ -5227,6 +5454,9 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
       ddl->execute(*session_ptr);
       check_and_invalidate_sessions(ddl);
     });
+    // a dropped table's id can be reused and a truncate starts the epoch over, either
+    // can bring back the table id and epoch of a cached result
+    query_result_cache_.clear();
     return true;
   };
 
@@ -5269,11 +5499,15 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
         // InsertOrderFragmenter::insertData, or deadlock will occur w/o moving the
         // following lock back to here!!!
       } else if (auto stmtp = dynamic_cast<Parser::InsertValuesStmt*>(stmt.get())) {
-        // INSERT_VALUES: CheckpointLock >> write ExecutorOuterLock [ >>
+        // INSERT_VALUES: CheckpointLock >> read ExecutorOuterLock [ >>
         // TableWriteLocks ]
+        // Like the loaders, the insert doesn't block the SELECTs. They copy the fragment
+        // sizes and chunk metadata of the table when they start, the fragmenter only
+        // publishes the appended rows once they are written. A chunk which grows in a
+        // buffer pool keeps its old memory until the queries reading it unpin it.
         chkptlLock = getTableLock<mapd_shared_mutex, mapd_unique_lock>(
             session_ptr->getCatalog(), *stmtp->get_table(), LockType::CheckpointLock);
-        executeWriteLock = mapd_unique_lock<mapd_shared_mutex>(
+        executeReadLock = mapd_shared_lock<mapd_shared_mutex>(
             *LockMgr<mapd_shared_mutex, bool>::getMutex(ExecutorOuterLock, true));
         // [ TableWriteLocks ] lock is deferred in
         // InsertOrderFragmenter::deleteFragments
@@ -5645,6 +5879,7 @@ void MapDHandler::set_table_epoch(const TSessionId& session,
     return leaf_aggregator_.set_table_epochLeaf(*session_ptr, db_id, table_id, new_epoch);
   }
   cat.setTableEpoch(db_id, table_id, new_epoch);
+  query_result_cache_.clear();
 }
 
 // check and reset epoch if a request has been made
@@ -5666,6 +5901,7 @@ void MapDHandler::set_table_epoch_by_name(const TSessionId& session,
         *session_ptr, db_id, td->tableId, new_epoch);
   }
   cat.setTableEpoch(db_id, td->tableId, new_epoch);
+  query_result_cache_.clear();
 }
 
 int32_t MapDHandler::get_table_epoch(const TSessionId& session,
@@ -62,6 +62,7 @@
 #include "StringDictionary/StringDictionaryClient.h"
 #include "ThriftHandler/DistributedValidate.h"
 #include "ThriftHandler/MapDRenderHandler.h"
+#include "ThriftHandler/QueryResultCache.h"
 #include "ThriftHandler/QueryState.h"
 
 #include <sys/time.h>
@@ -220,7 +221,8 @@ class MapDHandler : public MapDIf {
                       const std::string& query,
                       const TDeviceType::type device_type,
                       const int32_t device_id,
-                      const int32_t first_n) override;
+                      const int32_t first_n,
+                      const int32_t record_batch_rows) override;
   void sql_execute_gdf(TDataFrame& _return,
                        const TSessionId& session,
                        const std::string& query,
@@ -528,7 +530,8 @@ class MapDHandler : public MapDIf {
                         const std::string& nonce,
                         const ExecutorDeviceType executor_device_type,
                         const int32_t first_n,
-                        const int32_t at_most_n);
+                        const int32_t at_most_n,
+                        bool& result_cache_hit);
 
   bool user_can_access_table(const Catalog_Namespace::SessionInfo&,
                              const TableDescriptor* td,
@@ -572,7 +575,8 @@ class MapDHandler : public MapDIf {
                           const Catalog_Namespace::SessionInfo& session_info,
                           const ExecutorDeviceType device_type,
                           const size_t device_id,
-                          const int32_t first_n) const;
+                          const int32_t first_n,
+                          const size_t record_batch_rows) const;
   TColumnType populateThriftColumnType(const Catalog_Namespace::Catalog* cat,
                                        const ColumnDescriptor* cd);
   TRowDescriptor fixup_row_descriptor(const TRowDescriptor& row_desc,
@@ -611,6 +615,14 @@ class MapDHandler : public MapDIf {
                     const int32_t first_n,
                     const int32_t at_most_n) const;
 
+  // Columnar serialization from column buffers instead of row iteration. Returns false,
+  // without touching _return, for the results it can't handle.
+  bool convert_rows_columnar(TQueryResult& _return,
+                             const std::vector<TargetMetaInfo>& targets,
+                             const ResultSet& results,
+                             const int32_t first_n,
+                             const int32_t at_most_n) const;
+
   void create_simple_result(TQueryResult& _return,
                             const ResultSet& results,
                             const bool column_format,
@@ -693,6 +705,8 @@ class MapDHandler : public MapDIf {
   Importer_NS::CopyParams _geo_copy_from_copy_params;
   std::string _geo_copy_from_partitions;
 
+  QueryResultCache query_result_cache_;
+
   // Only for IPC device memory deallocation
   mutable std::mutex handle_to_dev_ptr_mutex_;
   mutable std::unordered_map<std::string, int8_t*> ipc_handle_to_dev_ptr_;
@@ -0,0 +1,260 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryResultCache.h"
+#include "Shared/Logger.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+
+bool g_enable_query_result_cache{false};
+size_t g_query_result_cache_max_bytes{1UL << 28};  // 256MB
+
+namespace {
+
+// Reads the integer literal Calcite emits for the fetch and offset of a sort.
+boost::optional<int64_t> get_int_literal_field(const rapidjson::Value& obj,
+                                               const char field[]) {
+  const auto it = obj.FindMember(field);
+  if (it == obj.MemberEnd()) {
+    return boost::none;
+  }
+  const auto& lit = it->value;
+  if (!lit.IsObject() || !lit.HasMember("literal") || !lit["literal"].IsInt64()) {
+    return boost::none;
+  }
+  return lit["literal"].GetInt64();
+}
+
+template <typename T>
+std::vector<T> slice_vector(const std::vector<T>& values,
+                            const size_t first_row,
+                            const size_t row_count) {
+  if (values.empty()) {
+    return {};
+  }
+  CHECK_LE(first_row + row_count, values.size());
+  return std::vector<T>(values.begin() + first_row,
+                        values.begin() + first_row + row_count);
+}
+
+TColumn slice_column(const TColumn& column,
+                     const size_t first_row,
+                     const size_t row_count) {
+  TColumn sliced;
+  sliced.nulls = slice_vector(column.nulls, first_row, row_count);
+  sliced.data.int_col = slice_vector(column.data.int_col, first_row, row_count);
+  sliced.data.real_col = slice_vector(column.data.real_col, first_row, row_count);
+  sliced.data.str_col = slice_vector(column.data.str_col, first_row, row_count);
+  sliced.data.arr_col = slice_vector(column.data.arr_col, first_row, row_count);
+  return sliced;
+}
+
+TRowSet slice_row_set(const TRowSet& row_set,
+                      const size_t first_row,
+                      const size_t row_count) {
+  TRowSet sliced;
+  sliced.row_desc = row_set.row_desc;
+  sliced.is_columnar = row_set.is_columnar;
+  if (row_set.is_columnar) {
+    for (const auto& column : row_set.columns) {
+      sliced.columns.push_back(slice_column(column, first_row, row_count));
+    }
+  } else {
+    sliced.rows = slice_vector(row_set.rows, first_row, row_count);
+  }
+  return sliced;
+}
+
+size_t estimate_datum_bytes(const TDatum& datum) {
+  size_t size_bytes = sizeof(TDatum) + datum.val.str_val.size();
+  for (const auto& elem : datum.val.arr_val) {
+    size_bytes += estimate_datum_bytes(elem);
+  }
+  return size_bytes;
+}
+
+size_t estimate_column_bytes(const TColumn& column) {
+  size_t size_bytes = sizeof(TColumn) + column.nulls.size() / 8 +
+                      column.data.int_col.size() * sizeof(int64_t) +
+                      column.data.real_col.size() * sizeof(double);
+  for (const auto& str : column.data.str_col) {
+    size_bytes += sizeof(std::string) + str.size();
+  }
+  for (const auto& arr : column.data.arr_col) {
+    size_bytes += estimate_column_bytes(arr);
+  }
+  return size_bytes;
+}
+
+size_t estimate_row_set_bytes(const TRowSet& row_set) {
+  size_t size_bytes = sizeof(TRowSet);
+  for (const auto& row : row_set.rows) {
+    size_bytes += sizeof(TRow);
+    for (const auto& datum : row.cols) {
+      size_bytes += estimate_datum_bytes(datum);
+    }
+  }
+  for (const auto& column : row_set.columns) {
+    size_bytes += estimate_column_bytes(column);
+  }
+  return size_bytes;
+}
+
+}  // namespace
+
+boost::optional<QueryResultCache::Key> QueryResultCache::makeKey(
+    const std::string& query_ra,
+    const int db_id,
+    const bool column_format) {
+  // NOW() and the CURRENT_* functions, the results change with the time of the query
+  if (query_ra.find("NOW") != std::string::npos ||
+      query_ra.find("CURRENT_") != std::string::npos) {
+    return boost::none;
+  }
+  rapidjson::Document query_ast;
+  query_ast.Parse(query_ra.c_str());
+  if (query_ast.HasParseError() || !query_ast.IsObject()) {
+    return boost::none;
+  }
+  const auto rels_it = query_ast.FindMember("rels");
+  if (rels_it == query_ast.MemberEnd() || !rels_it->value.IsArray() ||
+      rels_it->value.Empty()) {
+    return boost::none;
+  }
+  auto& root = rels_it->value[rels_it->value.Size() - 1];
+  size_t limit{0};
+  size_t offset{0};
+  const auto rel_op_it = root.FindMember("relOp");
+  if (rel_op_it != root.MemberEnd() && rel_op_it->value.IsString() &&
+      rel_op_it->value.GetString() == std::string("LogicalSort")) {
+    const auto fetch = get_int_literal_field(root, "fetch");
+    if (fetch) {
+      if (*fetch <= 0) {
+        return boost::none;
+      }
+      limit = *fetch;
+      root.RemoveMember("fetch");
+    }
+    const auto sort_offset = get_int_literal_field(root, "offset");
+    if (sort_offset) {
+      if (*sort_offset < 0) {
+        return boost::none;
+      }
+      offset = *sort_offset;
+      root.RemoveMember("offset");
+    }
+  }
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  query_ast.Accept(writer);
+  return Key{std::to_string(db_id) + (column_format ? " columnar " : " rows ") +
+                 buffer.GetString(),
+             limit,
+             offset};
+}
+
+size_t QueryResultCache::getRowCount(const TRowSet& row_set) {
+  if (row_set.is_columnar) {
+    return row_set.columns.empty() ? 0 : row_set.columns.front().nulls.size();
+  }
+  return row_set.rows.size();
+}
+
+bool QueryResultCache::get(const Key& key,
+                           const TableEpochs& table_epochs,
+                           TRowSet& row_set) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(key.plan);
+  if (it == index_.end()) {
+    ++miss_count_;
+    return false;
+  }
+  const auto& entry = *it->second;
+  if (entry.table_epochs != table_epochs) {
+    eraseEntry(it->second);
+    ++miss_count_;
+    return false;
+  }
+  // The entry holds the rows from its offset on, all of them if it has fewer rows than
+  // its limit.
+  const bool all_rows = !entry.limit || entry.row_count < entry.limit;
+  if (key.offset < entry.offset ||
+      (!all_rows &&
+       (!key.limit || key.offset + key.limit > entry.offset + entry.limit))) {
+    ++miss_count_;
+    return false;
+  }
+  const auto first_row = std::min(key.offset - entry.offset, entry.row_count);
+  const auto row_count = key.limit ? std::min(key.limit, entry.row_count - first_row)
+                                   : entry.row_count - first_row;
+  if (first_row == 0 && row_count == entry.row_count) {
+    row_set = entry.row_set;
+  } else {
+    row_set = slice_row_set(entry.row_set, first_row, row_count);
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  ++hit_count_;
+  return true;
+}
+
+void QueryResultCache::put(const Key& key,
+                           const TableEpochs& table_epochs,
+                           const TRowSet& row_set,
+                           const size_t generation) {
+  const auto size_bytes = estimate_row_set_bytes(row_set);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (generation != generation_) {
+    return;
+  }
+  const auto it = index_.find(key.plan);
+  if (it != index_.end()) {
+    eraseEntry(it->second);
+  }
+  const auto max_bytes = g_query_result_cache_max_bytes;
+  if (size_bytes > max_bytes) {
+    return;
+  }
+  while (!lru_.empty() && memory_used_ + size_bytes > max_bytes) {
+    eraseEntry(std::prev(lru_.end()));
+  }
+  lru_.push_front(Entry{key.plan,
+                        key.limit,
+                        key.offset,
+                        table_epochs,
+                        row_set,
+                        getRowCount(row_set),
+                        size_bytes});
+  index_.emplace(key.plan, lru_.begin());
+  memory_used_ += size_bytes;
+}
+
+void QueryResultCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++generation_;
+  index_.clear();
+  lru_.clear();
+  memory_used_ = 0;
+}
+
+void QueryResultCache::eraseEntry(const LruList::iterator it) {
+  memory_used_ -= it->size_bytes;
+  index_.erase(it->plan);
+  lru_.erase(it);
+}
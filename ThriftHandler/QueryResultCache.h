@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    QueryResultCache.h
+ * @brief   Cache of the row sets returned for SELECT statements.
+ *
+ * A result is keyed by the relational algebra Calcite returned for the query, without the
+ * limit and offset of its top level sort, along with the database and the result format.
+ * It records the epochs of the tables the query reads and is dropped when looked up
+ * after any of them changed, i.e. after an insert, update or delete. A table id and an
+ * epoch can repeat after a drop, a truncate or a vacuum, the handler clears the cache
+ * after those and after any other DDL statement. The result of a query with a limit or
+ * an offset also serves the queries which only differ by those and ask for a subrange of
+ * its rows.
+ */
+
+#ifndef OMNISCI_THRIFTHANDLER_QUERYRESULTCACHE_H
+#define OMNISCI_THRIFTHANDLER_QUERYRESULTCACHE_H
+
+#include "gen-cpp/mapd_types.h"
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+extern bool g_enable_query_result_cache;
+extern size_t g_query_result_cache_max_bytes;
+
+class QueryResultCache {
+ public:
+  struct Key {
+    std::string plan;
+    size_t limit;  // 0 means no limit
+    size_t offset;
+  };
+
+  // (table id, epoch) of the tables read by a query
+  using TableEpochs = std::vector<std::pair<int, int32_t>>;
+
+  QueryResultCache() : memory_used_(0), generation_(0), hit_count_(0), miss_count_(0) {}
+
+  // Returns none if the result of the query can change between runs on the same data.
+  static boost::optional<Key> makeKey(const std::string& query_ra,
+                                      const int db_id,
+                                      const bool column_format);
+
+  static size_t getRowCount(const TRowSet& row_set);
+
+  bool get(const Key& key, const TableEpochs& table_epochs, TRowSet& row_set);
+
+  // Doesn't store the row set if the cache was cleared since getGeneration() returned
+  // generation, it could have been computed on the tables before the change.
+  void put(const Key& key,
+           const TableEpochs& table_epochs,
+           const TRowSet& row_set,
+           const size_t generation);
+
+  void clear();
+
+  size_t getGeneration() const { return generation_; }
+
+  size_t getHitCount() const { return hit_count_; }
+
+  size_t getMissCount() const { return miss_count_; }
+
+ private:
+  struct Entry {
+    std::string plan;
+    size_t limit;
+    size_t offset;
+    TableEpochs table_epochs;
+    TRowSet row_set;
+    size_t row_count;
+    size_t size_bytes;
+  };
+
+  using LruList = std::list<Entry>;
+
+  void eraseEntry(const LruList::iterator it);
+
+  LruList lru_;  // most recently used first
+  std::unordered_map<std::string, LruList::iterator> index_;
+  size_t memory_used_;
+  std::atomic<size_t> generation_;  // bumped by clear()
+  std::atomic<size_t> hit_count_;
+  std::atomic<size_t> miss_count_;
+  std::mutex mutex_;
+};
+
+#endif  // OMNISCI_THRIFTHANDLER_QUERYRESULTCACHE_H
@@ -20,6 +20,7 @@
  */
 
 #include "ChunkIter.h"
+#include "../Shared/EncodedChunkLayout.h"
 
 #include <cstdlib>
 
@@ -140,6 +141,103 @@ DEVICE static void decompress(const SQLTypeInfo& ti,
   result->is_null = ti.is_null(*datum);
 }
 
+template <typename T>
+DEVICE static int64_t run_length_nth(const int8_t* encoded_chunk, const int64_t n) {
+  const auto run_count = *reinterpret_cast<const int64_t*>(encoded_chunk);
+  const auto runs =
+      reinterpret_cast<const RunLengthRun<T>*>(encoded_chunk + RL_ENCODING_HEADER_SIZE);
+  int64_t lo = 0;
+  int64_t hi = run_count - 1;
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (runs[mid].end_pos <= n) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return runs[lo].value;
+}
+
+// RL and DIFF chunks have no fixed-size slot per element, decode the n-th element from
+// the start of the encoded chunk
+DEVICE static void decode_nth(const SQLTypeInfo& ti,
+                              const int8_t* encoded_chunk,
+                              const int64_t n,
+                              VarlenDatum* result,
+                              Datum* datum) {
+  int64_t val{0};
+  bool is_null{false};
+  if (ti.get_compression() == kENCODING_RL) {
+    switch (ti.get_size()) {
+      case 1:
+        val = run_length_nth<int8_t>(encoded_chunk, n);
+        break;
+      case 2:
+        val = run_length_nth<int16_t>(encoded_chunk, n);
+        break;
+      case 4:
+        val = run_length_nth<int32_t>(encoded_chunk, n);
+        break;
+      case 8:
+        val = run_length_nth<int64_t>(encoded_chunk, n);
+        break;
+      default:
+        assert(false);
+    }
+  } else {
+    assert(ti.get_compression() == kENCODING_DIFF);
+    const auto baseline = *reinterpret_cast<const int64_t*>(encoded_chunk);
+    const auto diffs = encoded_chunk + DIFF_ENCODING_HEADER_SIZE;
+    switch (ti.get_comp_param()) {
+      case 8: {
+        const auto diff = reinterpret_cast<const int8_t*>(diffs)[n];
+        is_null = diff == NULL_TINYINT;
+        val = baseline + diff;
+        break;
+      }
+      case 16: {
+        const auto diff = reinterpret_cast<const int16_t*>(diffs)[n];
+        is_null = diff == NULL_SMALLINT;
+        val = baseline + diff;
+        break;
+      }
+      case 32: {
+        const auto diff = reinterpret_cast<const int32_t*>(diffs)[n];
+        is_null = diff == NULL_INT;
+        val = baseline + diff;
+        break;
+      }
+      default:
+        assert(false);
+    }
+  }
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+      datum->boolval = static_cast<int8_t>(val);
+      result->pointer = (int8_t*)&datum->boolval;
+      break;
+    case kTINYINT:
+      datum->tinyintval = static_cast<int8_t>(val);
+      result->pointer = (int8_t*)&datum->tinyintval;
+      break;
+    case kSMALLINT:
+      datum->smallintval = static_cast<int16_t>(val);
+      result->pointer = (int8_t*)&datum->smallintval;
+      break;
+    case kINT:
+      datum->intval = static_cast<int32_t>(val);
+      result->pointer = (int8_t*)&datum->intval;
+      break;
+    default:
+      datum->bigintval = val;
+      result->pointer = (int8_t*)&datum->bigintval;
+      break;
+  }
+  result->length = static_cast<size_t>(ti.get_size());
+  result->is_null = is_null || ti.is_null(*datum);
+}
+
 void ChunkIter_reset(ChunkIter* it) {
   it->current_pos = it->start_pos;
 }
@@ -157,7 +255,15 @@ DEVICE void ChunkIter_get_next(ChunkIter* it,
   }
   *is_end = false;
 
-  if (it->skip_size > 0) {
+  if (it->type_info.get_compression() == kENCODING_RL ||
+      it->type_info.get_compression() == kENCODING_DIFF) {
+    decode_nth(it->type_info,
+               it->second_buf,
+               (it->current_pos - it->second_buf) / it->skip_size,
+               result,
+               &it->datum);
+    it->current_pos += it->skip * it->skip_size;
+  } else if (it->skip_size > 0) {
     // for fixed-size
     if (uncompress && (it->type_info.get_compression() != kENCODING_NONE)) {
       decompress(it->type_info, it->current_pos, result, &it->datum);
@@ -192,7 +298,10 @@ DEVICE void ChunkIter_get_nth(ChunkIter* it,
   }
   *is_end = false;
 
-  if (it->skip_size > 0) {
+  if (it->type_info.get_compression() == kENCODING_RL ||
+      it->type_info.get_compression() == kENCODING_DIFF) {
+    decode_nth(it->type_info, it->second_buf, n, result, &it->datum);
+  } else if (it->skip_size > 0) {
     // for fixed-size
     int8_t* current_pos = it->start_pos + n * it->skip_size;
     if (uncompress && (it->type_info.get_compression() != kENCODING_NONE)) {
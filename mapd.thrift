@@ -219,6 +219,8 @@ struct TServerStatus {
   6: string host_name
   7: bool poly_rendering_enabled
   8: TRole role
+  9: i64 result_cache_hits
+  10: i64 result_cache_misses
 }
 
 struct TPixel {
@@ -282,6 +284,10 @@ struct TNodeMemoryInfo {
   4: i64 num_pages_allocated
   5: bool is_allocation_capped
   6: list<TMemoryData> node_memory_data
+  7: string eviction_policy
+  8: i64 num_hits
+  9: i64 num_misses
+  10: i64 num_evictions
 }
 
 struct TTableMeta {
@@ -520,7 +526,7 @@ service MapD {
   TSessionInfo get_session_info(1: TSessionId session) throws (1: TMapDException e)
   # query, render
   TQueryResult sql_execute(1: TSessionId session, 2: string query 3: bool column_format, 4: string nonce, 5: i32 first_n = -1, 6: i32 at_most_n = -1) throws (1: TMapDException e)
-  TDataFrame sql_execute_df(1: TSessionId session, 2: string query 3: common.TDeviceType device_type 4: i32 device_id = 0 5: i32 first_n = -1) throws (1: TMapDException e)
+  TDataFrame sql_execute_df(1: TSessionId session, 2: string query 3: common.TDeviceType device_type 4: i32 device_id = 0 5: i32 first_n = -1 6: i32 record_batch_rows = 0) throws (1: TMapDException e)
   TDataFrame sql_execute_gdf(1: TSessionId session, 2: string query 3: i32 device_id = 0, 4: i32 first_n = -1) throws (1: TMapDException e)
   void deallocate_df(1: TSessionId session, 2: TDataFrame df, 3: common.TDeviceType device_type, 4: i32 device_id = 0) throws (1: TMapDException e)
   void interrupt(1: TSessionId session) throws (1: TMapDException e)